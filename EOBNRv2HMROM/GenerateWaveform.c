@@ -57,11 +57,16 @@ Arguments are as follows:\n\
  --tagh22fromfile      Tag choosing wether to load h22 FD downsampled Amp/Phase from file (default false) - NOTE: for now low-f cut depends on fstartobs that still depends on m1, m2- so one has to re-pass m1 and m2 !\n\
  --nsamplesinfile      Number of lines of inputs file\n\
  --binaryin            Tag for loading the data in gsl binary form instead of text (default false)\n\
+ --columnarin          Tag for loading the data in binary columnar form, self-describing and mapped without copy - --nsamplesinfile is then not needed (default false)\n\
  --indir               Input directory\n\
  --infile              Input file name\n\
  --binaryout           Tag for writnig the data in gsl binary form instead of text (default false)\n\
+ --columnarout         Tag for outputting the data in binary columnar form (default false)\n\
  --outdir              Output directory\n\
  --outfile             Output file name\n\
+ --fftplanner          FFTW planning effort for the FFTs: estimate, measure or patient - plans are cached and reused for transforms of the same size (default estimate)\n\
+ --fftwisdom           File to import FFTW wisdom from, and to export it to at exit - makes measure/patient planning cheap in later runs (default none)\n\
+ --fftthreads          Number of threads for large FFTs, needs compiling with FFTW_THREADS (default 1)\n\
 \n";
 
     ssize_t i;
@@ -97,6 +102,10 @@ Arguments are as follows:\n\
     strcpy(params->outdir, ".");
     strcpy(params->outfile, "generated_waveform.txt");
 
+    params->fftplanner = FFTestimate;
+    strcpy(params->fftwisdom, "");
+    params->fftthreads = 1;
+
     /* Consume command line */
     for (i = 1; i < argc; ++i) {
         if (strcmp(argv[i], "--help") == 0) {
@@ -146,16 +155,26 @@ Arguments are as follows:\n\
           params->nsamplesinfile = atoi(argv[++i]);
         } else if (strcmp(argv[i], "--binaryin") == 0) {
           params->binaryin = 1;
+        } else if (strcmp(argv[i], "--columnarin") == 0) {
+          params->binaryin = FILE_COLUMNAR;
         } else if (strcmp(argv[i], "--indir") == 0) {
             strcpy(params->indir, argv[++i]);
         } else if (strcmp(argv[i], "--infile") == 0) {
             strcpy(params->infile, argv[++i]);
         } else if (strcmp(argv[i], "--binaryout") == 0) {
           params->binaryout = 1;
+        } else if (strcmp(argv[i], "--columnarout") == 0) {
+          params->binaryout = FILE_COLUMNAR;
         } else if (strcmp(argv[i], "--outdir") == 0) {
             strcpy(params->outdir, argv[++i]);
         } else if (strcmp(argv[i], "--outfile") == 0) {
             strcpy(params->outfile, argv[++i]);
+        } else if (strcmp(argv[i], "--fftplanner") == 0) {
+            params->fftplanner = ParseFFTPlannertag(argv[++i]);
+        } else if (strcmp(argv[i], "--fftwisdom") == 0) {
+            strcpy(params->fftwisdom, argv[++i]);
+        } else if (strcmp(argv[i], "--fftthreads") == 0) {
+            params->fftthreads = atoi(argv[++i]);
         } else {
 	  printf("Error: invalid option: %s\n", argv[i]);
 	  goto fail;
@@ -174,20 +193,17 @@ Arguments are as follows:\n\
 /* NOTE: assumes Amp/Phase format in the file, i.e. no complex amplitude */
 static void Read_Wave_h22(const char dir[], const char file[], ListmodesCAmpPhaseFrequencySeries** listhlm, int nsamples, int binary)
 {
-  /* Initalize and read input */
-  gsl_matrix* inmatrix =  gsl_matrix_alloc(nsamples, 3);
-  if (!binary) Read_Text_Matrix(dir, file, inmatrix);
-  else Read_Matrix(dir, file, inmatrix);
-  gsl_vector_view freqview = gsl_matrix_column(inmatrix, 0);
-  gsl_vector_view ampview = gsl_matrix_column(inmatrix, 1);
-  gsl_vector_view phaseview = gsl_matrix_column(inmatrix, 2);
-
-  /* Copy in frequency series */
-  CAmpPhaseFrequencySeries* h22 = NULL;
-  CAmpPhaseFrequencySeries_Init(&h22, nsamples);
-  gsl_vector_memcpy(h22->freq, &freqview.vector);
-  gsl_vector_memcpy(h22->amp_real, &ampview.vector);
-  gsl_vector_memcpy(h22->phase, &phaseview.vector);
+  /* Read input */
+  gsl_vector* columns[3];
+  int nbrows;
+  if(Read_Columns(columns, 3, &nbrows, dir, file, nsamples, binary)==FAILURE) exit(1);
+
+  /* Set frequency series - the columns are taken over */
+  CAmpPhaseFrequencySeries* h22 = ArenaMalloc(sizeof(CAmpPhaseFrequencySeries));
+  h22->freq = columns[0];
+  h22->amp_real = columns[1];
+  h22->phase = columns[2];
+  h22->amp_imag = ArenaVectorAlloc(nbrows);
   gsl_vector_set_zero(h22->amp_imag);
 
   /* Output */
@@ -225,8 +241,7 @@ static void Write_Wave_hlm(const char dir[], const char file[], ListmodesCAmpPha
   }
 
   /* Output */
-  if (!binary) Write_Text_Matrix(dir, file, outmatrix);
-  else Write_Matrix(dir, file, outmatrix);
+  Write_Table(dir, file, outmatrix, binary);
 }
 /* Output waveform in frequency series form,Re/Im for hplus and hcross */
 static void Write_Wave_hphcFD(const char dir[], const char file[], ReImFrequencySeries* hptilde, ReImFrequencySeries* hctilde, int binary)
@@ -244,8 +259,7 @@ static void Write_Wave_hphcFD(const char dir[], const char file[], ReImFrequency
   gsl_matrix_set_col(outmatrix, 4, hctilde->h_imag);
 
   /* Output */
-  if (!binary) Write_Text_Matrix(dir, file, outmatrix);
-  else Write_Matrix(dir, file, outmatrix);
+  Write_Table(dir, file, outmatrix, binary);
 }
 /* Output waveform in frequency series form,Re/Im for hplus and hcross */
 static void Write_Wave_hphcTD(const char dir[], const char file[], RealTimeSeries* hp, RealTimeSeries* hc, int binary)
@@ -261,8 +275,7 @@ static void Write_Wave_hphcTD(const char dir[], const char file[], RealTimeSerie
   gsl_matrix_set_col(outmatrix, 2, hc->h);
 
   /* Output */
-  if (!binary) Write_Text_Matrix(dir, file, outmatrix);
-  else Write_Matrix(dir, file, outmatrix);
+  Write_Table(dir, file, outmatrix, binary);
 }
 /* Output waveform in frequency series form, Re/Im for hplus and hcross */
     // Output Re/Im because difference between numpy and C unwrapping
@@ -278,8 +291,7 @@ static void Write_Wave_h22TD(const char dir[], const char file[], AmpPhaseTimeSe
   gsl_matrix_set_col(outmatrix, 2, h22->h_phase);
 
   /* Output */
-  if (!binary) Write_Text_Matrix(dir, file, outmatrix);
-  else Write_Matrix(dir, file, outmatrix);
+  Write_Table(dir, file, outmatrix, binary);
 }
 
 /***************** Main program *****************/
@@ -295,6 +307,9 @@ int main(int argc, char *argv[])
   /* Parse commandline to read parameters */
   parse_args_GenerateWaveform(argc, argv, params);
 
+  /* Setup of the FFTW plans */
+  FFTSetup(params->fftplanner, params->fftwisdom, params->fftthreads);
+
   /* Generate waveform hlm FD, downsampled in amp/phase form */
   double fLowhlm = 0.;
   double fHighhlm = 0.;
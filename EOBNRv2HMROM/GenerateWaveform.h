@@ -72,12 +72,15 @@ typedef struct tagGenWaveParams {
   double f2windowend;        /* If generating h22TD/hphcTD, stop frequency for windowing at the end - set to 0 to ignore and use min(maxf, fHighROM), where fHighROM is the highest frequency covered by the ROM (Hz, default=0) */
   int tagh22fromfile;        /* Tag choosing wether to load h22 FD downsampled Amp/Phase from file (default 0) */
   int nsamplesinfile;        /* Number of lines of inputs file */
-  int binaryin;              /* Tag for loading the data in gsl binary form instead of text (default false) */
+  int binaryin;              /* Format of the input data: FILE_TEXT, FILE_BINARY (gsl binary) or FILE_COLUMNAR (default text) */
   char indir[256];           /* Input directory */
   char infile[256];          /* Input file name */
-  int binaryout;             /* Tag for outputting the data in gsl binary form instead of text (default 0) */
+  int binaryout;             /* Format of the output data: FILE_TEXT, FILE_BINARY (gsl binary) or FILE_COLUMNAR (default text) */
   char outdir[256];          /* Path for the output directory */
   char outfile[256];         /* Path for the output file */
+  FFTPlannertag fftplanner;  /* FFTW planning effort for the FFTs: estimate (default), measure or patient */
+  char fftwisdom[256];       /* File to import FFTW wisdom from and to export it to at exit (default none) */
+  int fftthreads;            /* Number of threads for large FFTs, needs FFTW_THREADS at compile time (default 1) */
 } GenWaveParams;
 
 #if 0
@@ -47,14 +47,24 @@ Arguments are as follows:\n\
  --frozenLISA          Freeze the orbital configuration to the time of peak of the injection (default 0)\n\
  --responseapprox      Approximation in the GAB and orb response - choices are full (full response, default), lowfL (keep orbital delay frequency-dependence but simplify constellation response) and lowf (simplify constellation and orbital response) - WARNING : at the moment noises are not consistent, and TDI combinations from the GAB are unchanged\n\
  --fromtditdfile       Option for loading time series for TDI observables and FFTing (default: false)\n\
- --nlinesinfile        Number of lines of inputs file when loading TDI time series from file\n\
+ --nlinesinfile        Number of lines of inputs file when loading TDI time series from file (0: counted from the file, except with streamfft)\n\
  --indir               Input directory when loading TDI time series from file\n\
  --infile              Input file name when loading TDI time series from file\n\
- --loadparamsfile      Option to load physical parameters from file and to output result to file (default false)\n\
- --nlinesparams        Number of lines in params file\n\
+ --streamfft           Option for computing the SNR from the TDI time series file by overlapping windowed segments, without loading the file - approximates the full FFT for noise smooth on the scale 1/(nsegment*deltat) (default: false)\n\
+ --nsegment            Number of samples in the segments for streamfft, power of 2 (default 65536)\n\
+ --binaryin            Option for reading the TDI time series file in binary format (gsl_matrix_fwrite of nlinesinfile x 4 values) (default: false)\n\
+ --columnarin          Option for reading the TDI time series file in binary columnar format, self-describing and mapped without copy - nlinesinfile is then not needed (default: false)\n\
+ --loadparamsfile      Option to load physical parameters from file and to output result to file - lines are processed in parallel (OMP_NUM_THREADS), and lines differing only by their distance share one waveform (default false)\n\
+ --nlinesparams        Number of lines in params file (default 0: counted from the file)\n\
  --paramsdir           Directory for input/output file\n\
  --paramsfile          Input file with the parameters\n\
  --outputfile          Output file\n\
+ --fisher              Option to also compute the Fisher matrix in (m1, m2, tRef, dist, phase, inc, lambda, beta, pol), from Fresnel overlaps of waveforms perturbed by central differences - printed after the SNR, or appended row-major to each line of the output with loadparamsfile (default false)\n\
+ --fishertol           Relative tolerance on the diagonal of the Fisher matrix when halving the finite-difference steps (default 1e-3)\n\
+ --fishermaxiter       Maximal number of halvings of the finite-difference steps (default 8)\n\
+ --fftplanner          FFTW planning effort for the FFTs: estimate, measure or patient - plans are cached and reused for transforms of the same size (default estimate)\n\
+ --fftwisdom           File to import FFTW wisdom from, and to export it to at exit - makes measure/patient planning cheap in later runs (default none)\n\
+ --fftthreads          Number of threads for large FFTs, needs compiling with FFTW_THREADS (default 1)\n\
 \n";
 
   ssize_t i;
@@ -89,11 +99,21 @@ Arguments are as follows:\n\
   params->nlinesinfile = 0;    /* No default; has to be provided */
   strcpy(params->indir, "");   /* No default; has to be provided */
   strcpy(params->infile, "");  /* No default; has to be provided */
+  params->streamfft = 0;
+  params->nsegment = 65536;
+  params->binaryin = 0;
   params->loadparamsfile = 0;
   params->nlinesparams = 0;
   strcpy(params->paramsdir, "");  /* No default; has to be provided */
   strcpy(params->paramsfile, "");  /* No default; has to be provided */
   strcpy(params->outputfile, "");  /* No default; has to be provided */
+  params->fisher = 0;
+  params->fishertol = 1e-3;
+  params->fishermaxiter = 8;
+
+  params->fftplanner = FFTestimate;
+  strcpy(params->fftwisdom, "");
+  params->fftthreads = 1;
 
   /* Consume command line */
   for (i = 1; i < argc; ++i) {
@@ -164,6 +184,14 @@ Arguments are as follows:\n\
       strcpy(params->indir, argv[++i]);
     } else if (strcmp(argv[i], "--infile") == 0) {
       strcpy(params->infile, argv[++i]);
+    } else if (strcmp(argv[i], "--streamfft") == 0) {
+      params->streamfft = 1;
+    } else if (strcmp(argv[i], "--nsegment") == 0) {
+      params->nsegment = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--binaryin") == 0) {
+      params->binaryin = 1;
+    } else if (strcmp(argv[i], "--columnarin") == 0) {
+      params->binaryin = FILE_COLUMNAR;
     } else if (strcmp(argv[i], "--loadparamsfile") == 0) {
       params->loadparamsfile = 1;
     } else if (strcmp(argv[i], "--nlinesparams") == 0) {
@@ -174,6 +202,18 @@ Arguments are as follows:\n\
       strcpy(params->paramsfile, argv[++i]);
     } else if (strcmp(argv[i], "--outputfile") == 0) {
       strcpy(params->outputfile, argv[++i]);
+    } else if (strcmp(argv[i], "--fisher") == 0) {
+      params->fisher = 1;
+    } else if (strcmp(argv[i], "--fishertol") == 0) {
+      params->fishertol = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--fishermaxiter") == 0) {
+      params->fishermaxiter = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--fftplanner") == 0) {
+      params->fftplanner = ParseFFTPlannertag(argv[++i]);
+    } else if (strcmp(argv[i], "--fftwisdom") == 0) {
+      strcpy(params->fftwisdom, argv[++i]);
+    } else if (strcmp(argv[i], "--fftthreads") == 0) {
+      params->fftthreads = atoi(argv[++i]);
     }  else {
       printf("Error: invalid option: %s\n", argv[i]);
       printf("argc-i=%i\n",argc-i);
@@ -195,31 +235,25 @@ Arguments are as follows:\n\
 
 /* Read waveform time series in Re/Im form for hpTD and hcTD a single file */
 /* NOTE: assumes the same number of points is used to represent each mode */
-static void Read_Text_TDITD3Chan( RealTimeSeries** TDI1, RealTimeSeries** TDI2, RealTimeSeries** TDI3, const char dir[], const char file[], const int nblines)
+static void Read_TDITD3Chan( RealTimeSeries** TDI1, RealTimeSeries** TDI2, RealTimeSeries** TDI3, const char dir[], const char file[], const int nblines, const int binary)
 {
-  /* Initalize and read input */
-  gsl_matrix* inmatrix =  gsl_matrix_alloc(nblines, 4);
-  Read_Text_Matrix(dir, file, inmatrix);
-
-  /* Initialize structures */
-  RealTimeSeries_Init(TDI1, nblines);
-  RealTimeSeries_Init(TDI2, nblines);
-  RealTimeSeries_Init(TDI3, nblines);
-
-  /* Set values */
-  gsl_vector_view timesview = gsl_matrix_column(inmatrix, 0);
-  gsl_vector_view TDI1view = gsl_matrix_column(inmatrix, 1);
-  gsl_vector_view TDI2view = gsl_matrix_column(inmatrix, 2);
-  gsl_vector_view TDI3view = gsl_matrix_column(inmatrix, 3);
-  gsl_vector_memcpy((*TDI1)->times, &timesview.vector);
-  gsl_vector_memcpy((*TDI2)->times, &timesview.vector);
-  gsl_vector_memcpy((*TDI3)->times, &timesview.vector);
-  gsl_vector_memcpy((*TDI1)->h, &TDI1view.vector);
-  gsl_vector_memcpy((*TDI2)->h, &TDI2view.vector);
-  gsl_vector_memcpy((*TDI3)->h, &TDI3view.vector);
-
-  /* Clean up */
-  gsl_matrix_free(inmatrix);
+  /* Read input - zero-copy for columnar files */
+  gsl_vector* columns[4];
+  int nbrows;
+  if(Read_Columns(columns, 4, &nbrows, dir, file, nblines, binary)==FAILURE) exit(1);
+
+  /* Set structures - the columns are taken over, each series but the first gets its own copy of the times */
+  *TDI1 = ArenaMalloc(sizeof(RealTimeSeries));
+  *TDI2 = ArenaMalloc(sizeof(RealTimeSeries));
+  *TDI3 = ArenaMalloc(sizeof(RealTimeSeries));
+  (*TDI1)->times = columns[0];
+  (*TDI2)->times = ArenaVectorAlloc(nbrows);
+  (*TDI3)->times = ArenaVectorAlloc(nbrows);
+  gsl_vector_memcpy((*TDI2)->times, columns[0]);
+  gsl_vector_memcpy((*TDI3)->times, columns[0]);
+  (*TDI1)->h = columns[1];
+  (*TDI2)->h = columns[2];
+  (*TDI3)->h = columns[3];
 }
 
 /***************** Function to control that the TDI tag is allowed *****************/
@@ -234,6 +268,59 @@ static int AllowedTDItag(TDItag tag) {
   return ret;
 }
 
+/***************** Functions for the SNR of generated injections *****************/
+
+/* SNR of the injection for the LISA params given - the injection is its own reference (tRefinj = tRef), the global injectedparams is not used, so that this can be called by several threads */
+static double ComputeInjectionSNR(LISAParams* injparams, const int tagint, const double minf, const int nbptsoverlap)
+{
+  double SNR = 0.;
+  /* Branch between the Fresnel or linear computation */
+  if(tagint==0) {
+    LISAInjectionCAmpPhase* injCAmpPhase = NULL;
+    LISAInjectionCAmpPhase_Init(&injCAmpPhase);
+    if(LISAGenerateInjectionCAmpPhaseResponse(injparams, injCAmpPhase, injparams->tRef, globalparams->frozenLISA, globalparams->responseapprox)==SUCCESS) SNR = sqrt(injCAmpPhase->TDI123ss);
+    LISAInjectionCAmpPhase_Cleanup(injCAmpPhase);
+  }
+  else if(tagint==1) {
+    LISAInjectionReIm* injReIm = NULL;
+    LISAInjectionReIm_Init(&injReIm);
+    LISAGenerateInjectionReImRefTime(injparams, minf, nbptsoverlap, 0, injReIm, injparams->tRef); /* Hardcoded linear sampling */
+
+    double SNRA2 = FDOverlapReImvsReIm(injReIm->TDI1Signal, injReIm->TDI1Signal, injReIm->noisevalues1);
+    double SNRE2 = FDOverlapReImvsReIm(injReIm->TDI2Signal, injReIm->TDI2Signal, injReIm->noisevalues2);
+    double SNRT2 = FDOverlapReImvsReIm(injReIm->TDI3Signal, injReIm->TDI3Signal, injReIm->noisevalues3);
+    SNR = sqrt(SNRA2 + SNRE2 + SNRT2);
+    LISAInjectionReIm_Cleanup(injReIm);
+  }
+  else {
+    printf("Error in ComputeLISASNR: integration tag not recognized.\n");
+    exit(1);
+  }
+  return SNR;
+}
+
+/* Ordering of the lines of the params file on all parameters but the distance (column 3), to group lines sharing the same waveform up to the amplitude */
+static const gsl_matrix* paramsmatrix = NULL;
+static int CompareParamsNoDistance(size_t i, size_t j)
+{
+  for(size_t k=0; k<paramsmatrix->size2; k++) {
+    if(k==3) continue;
+    double vi = gsl_matrix_get(paramsmatrix, i, k);
+    double vj = gsl_matrix_get(paramsmatrix, j, k);
+    if(vi<vj) return -1;
+    if(vi>vj) return 1;
+  }
+  return 0;
+}
+static int CompareParamsLinesNoDistance(const void* a, const void* b)
+{
+  size_t i = *((const size_t*) a);
+  size_t j = *((const size_t*) b);
+  int c = CompareParamsNoDistance(i, j);
+  if(c!=0) return c;
+  return (i<j) ? -1 : (i>j);
+}
+
 /***************** Main program *****************/
 
 int main(int argc, char *argv[])
@@ -257,6 +344,9 @@ int main(int argc, char *argv[])
   /* Parse commandline to read parameters */
   parse_args_ComputeLISASNR(argc, argv, params);
 
+  /* Setup of the FFTW plans */
+  FFTSetup(params->fftplanner, params->fftwisdom, params->fftthreads);
+
   /* NOTE: supports only AET(XYZ) (orthogonal) */
   if(!(AllowedTDItag(params->tagtdi))) {
     printf("Error in ComputeLISASNR: TDI tag not recognized.\n");
@@ -265,12 +355,52 @@ int main(int argc, char *argv[])
 
   else {
 
-    if(params->fromtditdfile) {
+    if(params->fromtditdfile && params->streamfft) {
+      /* Stream TD TDI from file by segments - only the accumulated power of the segments is kept */
+      double t0 = 0., deltat = 0.;
+      int nlines = params->nlinesinfile;
+      if(Read_TimeSeriesFileSampling(&t0, &deltat, &nlines, params->indir, params->infile, 4, params->binaryin)==FAILURE) exit(1);
+      double tend = t0 + (nlines - 1)*deltat;
+      double twindowbeg = 0.05 * (tend - t0); /* Here hardcoded relative window lengths */
+      double twindowend = 0.01 * (tend - t0); /* Here hardcoded relative window lengths */
+      StreamingSpectrum* spectrum = NULL;
+      StreamingSpectrum_Init(&spectrum, 3, params->nsegment, deltat, t0, tend, twindowbeg, twindowend);
+      if(StreamingSpectrum_PushFile(spectrum, params->indir, params->infile, nlines, params->binaryin)==FAILURE) exit(1);
+      StreamingSpectrum_Finalize(spectrum);
+
+      /* Compute SNR with linear integration of the segment-averaged power, weighting with non-rescaled noise functions */
+      double SNR2 = 0.;
+      for(int chan=0; chan<3; chan++) {
+        ReImFrequencySeries* TDIspectrum = NULL;
+        ReImFrequencySeries* TDIspectrumrestr = NULL;
+        StreamingSpectrum_GetFrequencySeries(&TDIspectrum, spectrum, chan);
+        RestrictFDReImFrequencySeries(&TDIspectrumrestr, TDIspectrum, params->minf, __LISASimFD_Noise_fHigh);
+        int size = TDIspectrumrestr->freq->size;
+        gsl_vector* noisevalues = gsl_vector_alloc(size);
+        for(int i=0; i<size; i++) {
+          double f = gsl_vector_get(TDIspectrumrestr->freq, i);
+          if(chan==0) gsl_vector_set(noisevalues, i, SnAXYZNoRescaling(params->variant, f));
+          else if(chan==1) gsl_vector_set(noisevalues, i, SnEXYZNoRescaling(params->variant, f));
+          else gsl_vector_set(noisevalues, i, SnTXYZNoRescaling(params->variant, f));
+        }
+        SNR2 += FDOverlapReImvsReIm(TDIspectrumrestr, TDIspectrumrestr, noisevalues);
+        gsl_vector_free(noisevalues);
+        ReImFrequencySeries_Cleanup(TDIspectrum);
+        ReImFrequencySeries_Cleanup(TDIspectrumrestr);
+      }
+      SNR = sqrt(SNR2);
+      StreamingSpectrum_Cleanup(spectrum);
+
+      /* Print SNR to stdout */
+      printf("%.8f\n", SNR);
+    }
+
+    else if(params->fromtditdfile) {
       /* Load TD TDI from file */
       RealTimeSeries* TDI1 = NULL;
       RealTimeSeries* TDI2 = NULL;
       RealTimeSeries* TDI3 = NULL;
-      Read_Text_TDITD3Chan(&TDI1, &TDI2, &TDI3, params->indir, params->infile, params->nlinesinfile);
+      Read_TDITD3Chan(&TDI1, &TDI2, &TDI3, params->indir, params->infile, params->nlinesinfile, params->binaryin);
 
       /* Compute FFT */
       ReImFrequencySeries* TDI1FFT = NULL;
@@ -358,89 +488,105 @@ int main(int argc, char *argv[])
 
       if(params->loadparamsfile==0) {
 
-        /* Branch between the Fresnel or linear computation */
-        if(params->tagint==0) {
-          LISAInjectionCAmpPhase* injCAmpPhase = NULL;
-          LISAInjectionCAmpPhase_Init(&injCAmpPhase);
-          LISAGenerateInjectionCAmpPhase(injectedparams, injCAmpPhase);
-          SNR = sqrt(injCAmpPhase->TDI123ss);
-        }
-        else if(params->tagint==1) {
-          LISAInjectionReIm* injReIm = NULL;
-          LISAInjectionReIm_Init(&injReIm);
-          LISAGenerateInjectionReIm(injectedparams, params->minf, params->nbptsoverlap, 0, injReIm); /* Hardcoded linear sampling */
-
-          double SNRA2 = FDOverlapReImvsReIm(injReIm->TDI1Signal, injReIm->TDI1Signal, injReIm->noisevalues1);
-          double SNRE2 = FDOverlapReImvsReIm(injReIm->TDI2Signal, injReIm->TDI2Signal, injReIm->noisevalues2);
-          double SNRT2 = FDOverlapReImvsReIm(injReIm->TDI3Signal, injReIm->TDI3Signal, injReIm->noisevalues3);
-          SNR = sqrt(SNRA2 + SNRE2 + SNRT2);
-        }
-        else {
-          printf("Error in ComputeLISASNR: integration tag not recognized.\n");
-          exit(1);
-        }
+        SNR = ComputeInjectionSNR(injectedparams, params->tagint, params->minf, params->nbptsoverlap);
 
         /* Print SNR to stdout */
         printf("%.8f\n", SNR);
+
+        /* Print Fisher matrix to stdout, one row per line */
+        if(params->fisher) {
+          gsl_matrix* fisher = gsl_matrix_alloc(LISAFISHER_NPARAMS, LISAFISHER_NPARAMS);
+          double err = 0.;
+          if(LISAFisherMatrix(fisher, NULL, &err, injectedparams, NULL, params->fishertol, params->fishermaxiter)==FAILURE) {
+            printf("Error in ComputeLISASNR: generation of the waveforms for the Fisher matrix failed.\n");
+            exit(1);
+          }
+          for(int i=0; i<LISAFISHER_NPARAMS; i++) {
+            for(int j=0; j<LISAFISHER_NPARAMS; j++) printf("%.12e%s", gsl_matrix_get(fisher, i, j), j<LISAFISHER_NPARAMS-1 ? " " : "\n");
+          }
+          gsl_matrix_free(fisher);
+        }
       }
       else {
 
-        int nlines = params->nlinesparams;
-
-        /* Load parameters file */
+        /* Load parameters file - the lines are counted if nlinesparams is 0 */
         /* Format (same as in the internals): m1, m2, tRef, dist, phase, inc, lambda, beta, pol */
-        gsl_matrix* inmatrix =  gsl_matrix_alloc(nlines, 9);
-        Read_Text_Matrix(params->paramsdir, params->paramsfile, inmatrix);
+        gsl_matrix* inmatrix = NULL;
+        if(Read_Text_Table(&inmatrix, params->paramsdir, params->paramsfile, params->nlinesparams, 9)==FAILURE) exit(1);
+        int nlines = (int) inmatrix->size1;
 
         /* Initialize output matrix */
         /* Format (same as in the internals): m1, m2, tRef, dist, phase, inc, lambda, beta, pol, SNR */
-        gsl_matrix* outmatrix =  gsl_matrix_alloc(nlines, 10);
-
+        /* With the Fisher matrix, its LISAFISHER_NPARAMS^2 entries follow, row-major */
+        int ncolsout = params->fisher ? 10 + LISAFISHER_NPARAMS*LISAFISHER_NPARAMS : 10;
+        gsl_matrix* outmatrix =  gsl_matrix_alloc(nlines, ncolsout);
+        gsl_matrix_view inview = gsl_matrix_submatrix(outmatrix, 0, 0, nlines, 9);
+        gsl_matrix_memcpy(&inview.matrix, inmatrix);
+
+        /* The SNR scales as 1/distance: lines differing only by their distance are grouped, and one waveform is generated per group */
+        size_t* order = (size_t*) malloc(nlines*sizeof(size_t));
+        for(int i=0; i<nlines; i++) order[i] = i;
+        paramsmatrix = inmatrix;
+        qsort(order, nlines, sizeof(size_t), CompareParamsLinesNoDistance);
+        int* groupstart = (int*) malloc((nlines+1)*sizeof(int));
+        int ngroups = 0;
         for(int i=0; i<nlines; i++) {
-          injectedparams->m1 = gsl_matrix_get(inmatrix, i, 0);
-          injectedparams->m2 = gsl_matrix_get(inmatrix, i, 1);
-          injectedparams->tRef = gsl_matrix_get(inmatrix, i, 2);
-          injectedparams->distance = gsl_matrix_get(inmatrix, i, 3);
-          injectedparams->phiRef = gsl_matrix_get(inmatrix, i, 4);
-          injectedparams->inclination = gsl_matrix_get(inmatrix, i, 5);
-          injectedparams->lambda = gsl_matrix_get(inmatrix, i, 6);
-          injectedparams->beta = gsl_matrix_get(inmatrix, i, 7);
-          injectedparams->polarization = gsl_matrix_get(inmatrix, i, 8);
-
-          /* Branch between the Fresnel or linear computation */
-          double SNR = 0;
-          if(params->tagint==0) {
-            LISAInjectionCAmpPhase* injCAmpPhase = NULL;
-            LISAInjectionCAmpPhase_Init(&injCAmpPhase);
-            LISAGenerateInjectionCAmpPhase(injectedparams, injCAmpPhase);
-            SNR = sqrt(injCAmpPhase->TDI123ss);
+          if(i==0 || CompareParamsNoDistance(order[i-1], order[i])!=0) groupstart[ngroups++] = i;
+        }
+        groupstart[ngroups] = nlines;
+
+        /* Load the ROM data before entering the parallel region - shared read-only by the threads */
+        if(EOBNRv2HMROM_Init_DATA()==FAILURE) exit(1);
+
+        /* Each thread works on its own copy of the LISA params - noise functions and ROM data are shared, response and memory caches are per-thread */
+        #pragma omp parallel for schedule(dynamic)
+        for(int g=0; g<ngroups; g++) {
+          LISAParams lineparams = *injectedparams;
+          size_t iref = order[groupstart[g]];
+          lineparams.m1 = gsl_matrix_get(inmatrix, iref, 0);
+          lineparams.m2 = gsl_matrix_get(inmatrix, iref, 1);
+          lineparams.tRef = gsl_matrix_get(inmatrix, iref, 2);
+          lineparams.distance = gsl_matrix_get(inmatrix, iref, 3);
+          lineparams.phiRef = gsl_matrix_get(inmatrix, iref, 4);
+          lineparams.inclination = gsl_matrix_get(inmatrix, iref, 5);
+          lineparams.lambda = gsl_matrix_get(inmatrix, iref, 6);
+          lineparams.beta = gsl_matrix_get(inmatrix, iref, 7);
+          lineparams.polarization = gsl_matrix_get(inmatrix, iref, 8);
+
+          double SNRref = ComputeInjectionSNR(&lineparams, params->tagint, params->minf, params->nbptsoverlap);
+
+          /* Set values in output matrix */
+          for(int i=groupstart[g]; i<groupstart[g+1]; i++) {
+            double distance = gsl_matrix_get(inmatrix, order[i], 3);
+            gsl_matrix_set(outmatrix, order[i], 9, SNRref * lineparams.distance / distance);
           }
-          else if(params->tagint==1) {
-            LISAInjectionReIm* injReIm = NULL;
-            LISAInjectionReIm_Init(&injReIm);
-            LISAGenerateInjectionReIm(injectedparams, params->minf, params->nbptsoverlap, 0, injReIm); /* Hardcoded linear sampling */
-
-            double SNRA2 = FDOverlapReImvsReIm(injReIm->TDI1Signal, injReIm->TDI1Signal, injReIm->noisevalues1);
-            double SNRE2 = FDOverlapReImvsReIm(injReIm->TDI2Signal, injReIm->TDI2Signal, injReIm->noisevalues2);
-            double SNRT2 = FDOverlapReImvsReIm(injReIm->TDI3Signal, injReIm->TDI3Signal, injReIm->noisevalues3);
-            SNR = sqrt(SNRA2 + SNRE2 + SNRT2);
+        }
+        free(order);
+        free(groupstart);
+
+        /* Fisher matrices, sources in parallel - no grouping in distance here, the derivative along the distance does not scale as the rest */
+        if(params->fisher) {
+          LISAParams* sources = (LISAParams*) malloc(nlines*sizeof(LISAParams));
+          double* fishers = (double*) malloc(nlines*LISAFISHER_NPARAMS*LISAFISHER_NPARAMS*sizeof(double));
+          for(int i=0; i<nlines; i++) {
+            sources[i] = *injectedparams;
+            sources[i].m1 = gsl_matrix_get(inmatrix, i, 0);
+            sources[i].m2 = gsl_matrix_get(inmatrix, i, 1);
+            sources[i].tRef = gsl_matrix_get(inmatrix, i, 2);
+            sources[i].distance = gsl_matrix_get(inmatrix, i, 3);
+            sources[i].phiRef = gsl_matrix_get(inmatrix, i, 4);
+            sources[i].inclination = gsl_matrix_get(inmatrix, i, 5);
+            sources[i].lambda = gsl_matrix_get(inmatrix, i, 6);
+            sources[i].beta = gsl_matrix_get(inmatrix, i, 7);
+            sources[i].polarization = gsl_matrix_get(inmatrix, i, 8);
           }
-          else {
-            printf("Error in ComputeLISASNR: integration tag not recognized.\n");
-            exit(1);
+          int nfailed = LISAFisherMatrixBatch(fishers, NULL, NULL, sources, nlines, NULL, params->fishertol, params->fishermaxiter);
+          if(nfailed>0) printf("Warning in ComputeLISASNR: Fisher matrix failed for %d lines, set to nan.\n", nfailed);
+          for(int i=0; i<nlines; i++) {
+            for(int k=0; k<LISAFISHER_NPARAMS*LISAFISHER_NPARAMS; k++) gsl_matrix_set(outmatrix, i, 10+k, fishers[i*LISAFISHER_NPARAMS*LISAFISHER_NPARAMS + k]);
           }
-
-          /* Set values in output matrix */
-          gsl_matrix_set(outmatrix, i, 0, injectedparams->m1);
-          gsl_matrix_set(outmatrix, i, 1, injectedparams->m2);
-          gsl_matrix_set(outmatrix, i, 2, injectedparams->tRef);
-          gsl_matrix_set(outmatrix, i, 3, injectedparams->distance);
-          gsl_matrix_set(outmatrix, i, 4, injectedparams->phiRef);
-          gsl_matrix_set(outmatrix, i, 5, injectedparams->inclination);
-          gsl_matrix_set(outmatrix, i, 6, injectedparams->lambda);
-          gsl_matrix_set(outmatrix, i, 7, injectedparams->beta);
-          gsl_matrix_set(outmatrix, i, 8, injectedparams->polarization);
-          gsl_matrix_set(outmatrix, i, 9, SNR);
+          free(sources);
+          free(fishers);
         }
 
         /* Output matrix */
@@ -40,6 +40,7 @@
 #include "LISAgeometry.h"
 #include "LISAFDresponse.h"
 #include "LISAutils.h"
+#include "LISAFisher.h"
 
 /********************************** Structures ******************************************/
 
@@ -72,11 +73,20 @@ typedef struct tagComputeLISASNRparams {
   int nlinesinfile;          /* Number of lines of input file */
   char indir[256];           /* Input directory */
   char infile[256];          /* Input file */
+  int streamfft;             /* Option for computing the SNR from the TDI time series file by segments, without loading it (default 0) */
+  int nsegment;              /* Number of samples in the segments of the streamed FFT, power of 2 (default 65536) */
+  int binaryin;              /* Format of the TDI time series file: FILE_TEXT, FILE_BINARY (gsl binary) or FILE_COLUMNAR (default text) */
   int loadparamsfile;        /* Option to load physical parameters from file and to output result to file (default 0) */
-  int nlinesparams;          /* Number of lines in params file */
+  int nlinesparams;          /* Number of lines in params file (0: counted from the file) */
   char paramsdir[256];       /* Directory for the input/output file */
   char paramsfile[256];      /* Input file with the parameters */
   char outputfile[256];      /* Output file */
+  int fisher;                /* Option to also compute the Fisher matrix, with Fresnel overlaps of finite-difference waveforms (default 0) */
+  double fishertol;          /* Relative tolerance on the diagonal of the Fisher matrix for the control of the steps (default 1e-3) */
+  int fishermaxiter;         /* Maximal number of halvings of the steps of the Fisher matrix (default 8) */
+  FFTPlannertag fftplanner;  /* FFTW planning effort for the FFTs: estimate (default), measure or patient */
+  char fftwisdom[256];       /* File to import FFTW wisdom from and to export it to at exit (default none) */
+  int fftthreads;            /* Number of threads for large FFTs, needs FFTW_THREADS at compile time (default 1) */
 } ComputeLISASNRparams;
 
 
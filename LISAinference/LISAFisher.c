@@ -0,0 +1,243 @@
+#include "LISAFisher.h"
+
+/* Default initial steps - relative for m1, m2 and dist, absolute otherwise (s for tRef, rad for the angles) */
+static const double LISAFisherDefaultSteps[LISAFISHER_NPARAMS] = {1e-5, 1e-5, 1., 1e-3, 1e-3, 1e-3, 1e-4, 1e-4, 1e-3};
+static const int LISAFisherRelativeSteps[LISAFISHER_NPARAMS] = {1, 1, 0, 1, 0, 0, 0, 0, 0};
+
+/* Parameter of index i, in the order of the params files */
+static double* LISAParamsComponent(LISAParams* params, const int i)
+{
+  switch(i) {
+  case 0: return &(params->m1);
+  case 1: return &(params->m2);
+  case 2: return &(params->tRef);
+  case 3: return &(params->distance);
+  case 4: return &(params->phiRef);
+  case 5: return &(params->inclination);
+  case 6: return &(params->lambda);
+  case 7: return &(params->beta);
+  case 8: return &(params->polarization);
+  default:
+    printf("Error in LISAParamsComponent: index out of range.\n");
+    exit(1);
+  }
+}
+
+/* Common frequencies of the derivatives, with the noise values of the three channels */
+typedef struct tagLISAFisherGrid {
+  gsl_vector* freq;
+  gsl_vector* noisevalues[3];
+} LISAFisherGrid;
+
+/* Grid from the waveform at the parameters of the source - globalparams->nbptsoverlap logarithmically spaced frequencies, as for the injections in ReIm form */
+static int LISAFisherGrid_Init(LISAFisherGrid* grid, double* SNR, LISAParams* params)
+{
+  LISASignalCAmpPhase* signal = NULL;
+  LISASignalCAmpPhase_Init(&signal);
+  if(LISAGenerateSignalCAmpPhaseRefTime(params, signal, params->tRef, globalparams->frozenLISA, globalparams->responseapprox)==FAILURE) {
+    LISASignalCAmpPhase_Cleanup(signal);
+    return FAILURE;
+  }
+  *SNR = sqrt(signal->TDI123hh);
+  double fstartobs = 0.;
+  if(!(globalparams->deltatobs==0.)) fstartobs = Newtonianfoft(params->m1, params->m2, globalparams->deltatobs);
+  double fLowCut = fmax(fmax(__LISASimFD_Noise_fLow, globalparams->minf), fstartobs);
+  double fHigh = fmin(__LISASimFD_Noise_fHigh, globalparams->maxf);
+  int nbpts = globalparams->nbptsoverlap;
+  grid->freq = gsl_vector_alloc(nbpts);
+  ListmodesSetFrequencies(signal->TDI1Signal, fLowCut, fHigh, nbpts, 1, grid->freq);
+  LISASignalCAmpPhase_Cleanup(signal);
+  for(int c=0; c<3; c++) {
+    ObjectFunction NoiseSn = NoiseFunction(globalparams->variant, globalparams->tagtdi, c+1);
+    grid->noisevalues[c] = gsl_vector_alloc(nbpts);
+    EvaluateNoise(grid->noisevalues[c], grid->freq, &NoiseSn, __LISASimFD_Noise_fLow, __LISASimFD_Noise_fHigh);
+  }
+  return SUCCESS;
+}
+
+static void LISAFisherGrid_Cleanup(LISAFisherGrid* grid)
+{
+  gsl_vector_free(grid->freq);
+  for(int c=0; c<3; c++) gsl_vector_free(grid->noisevalues[c]);
+}
+
+/* Overlap (a|b) summed over the three channels, by trapeze integration on the grid */
+static double LISAFisherOverlap(LISASignalReIm* a, LISASignalReIm* b, LISAFisherGrid* grid)
+{
+  return FDOverlapReImvsReIm(a->TDI1Signal, b->TDI1Signal, grid->noisevalues[0])
+    + FDOverlapReImvsReIm(a->TDI2Signal, b->TDI2Signal, grid->noisevalues[1])
+    + FDOverlapReImvsReIm(a->TDI3Signal, b->TDI3Signal, grid->noisevalues[2]);
+}
+
+/* Waveform on the grid at the given parameters - the reference time of the source is kept, so that tRef enters as a time shift */
+static LISASignalReIm* LISAFisherWaveform(LISAParams* params, const double tRefinj, LISAFisherGrid* grid)
+{
+  LISASignalReIm* signal = NULL;
+  LISASignalReIm_Init(&signal);
+  if(LISAGenerateSignalReImRefTime(params, grid->freq, signal, tRefinj)==FAILURE) {
+    LISASignalReIm_Cleanup(signal);
+    return NULL;
+  }
+  return signal;
+}
+
+/* Derivative d_i h = (h(theta+h_i) - h(theta-h_i))/(2h_i) on the grid, one frequency series per channel - NULL if a waveform could not be generated */
+static LISASignalReIm* LISAFisherDerivative(LISAParams* params, const int i, const double h, LISAFisherGrid* grid)
+{
+  LISAParams paramsp = *params;
+  LISAParams paramsm = *params;
+  *LISAParamsComponent(&paramsp, i) += h;
+  *LISAParamsComponent(&paramsm, i) -= h;
+  LISASignalReIm* deriv = LISAFisherWaveform(&paramsp, params->tRef, grid);
+  if(!deriv) return NULL;
+  LISASignalReIm* wfm = LISAFisherWaveform(&paramsm, params->tRef, grid);
+  if(!wfm) {
+    LISASignalReIm_Cleanup(deriv);
+    return NULL;
+  }
+  ReImFrequencySeries* seriesp[3] = {deriv->TDI1Signal, deriv->TDI2Signal, deriv->TDI3Signal};
+  ReImFrequencySeries* seriesm[3] = {wfm->TDI1Signal, wfm->TDI2Signal, wfm->TDI3Signal};
+  int nbpts = (int) grid->freq->size;
+  for(int c=0; c<3; c++) {
+    double* hrealp = seriesp[c]->h_real->data;
+    double* himagp = seriesp[c]->h_imag->data;
+    double* hrealm = seriesm[c]->h_real->data;
+    double* himagm = seriesm[c]->h_imag->data;
+    for(int k=0; k<nbpts; k++) {
+      hrealp[k] = (hrealp[k] - hrealm[k]) / (2*h);
+      himagp[k] = (himagp[k] - himagm[k]) / (2*h);
+    }
+  }
+  LISASignalReIm_Cleanup(wfm);
+  return deriv;
+}
+
+int LISAFisherMatrix(
+  gsl_matrix* fisher,
+  double* SNR,
+  double* err,
+  LISAParams* params,
+  const double* steps,
+  const double tol,
+  const int maxiter)
+{
+  int n = LISAFISHER_NPARAMS;
+  if(fisher->size1!=(size_t) n || fisher->size2!=(size_t) n) {
+    printf("Error in LISAFisherMatrix: incompatible size of the Fisher matrix.\n");
+    exit(1);
+  }
+  if(!steps) steps = LISAFisherDefaultSteps;
+
+  /* Load the ROM data before entering the parallel region - shared read-only by the threads */
+  if(EOBNRv2HMROM_Init_DATA()==FAILURE) exit(1);
+
+  /* Common frequencies for all the derivatives */
+  LISAFisherGrid grid;
+  double SNRsource = 0.;
+  if(LISAFisherGrid_Init(&grid, &SNRsource, params)==FAILURE) {
+    gsl_matrix_set_all(fisher, NAN);
+    if(SNR) *SNR = NAN;
+    if(err) *err = NAN;
+    return FAILURE;
+  }
+
+  LISASignalReIm* deriv[LISAFISHER_NPARAMS];
+  double h[LISAFISHER_NPARAMS];
+  double errdiag[LISAFISHER_NPARAMS];
+
+  /* Derivatives with step control - parameters in parallel */
+  /* The step is halved while the diagonal element converges: once the change grows again, roundoff dominates and the previous step is kept */
+  #pragma omp parallel for schedule(dynamic)
+  for(int i=0; i<n; i++) {
+    h[i] = steps[i];
+    if(LISAFisherRelativeSteps[i]) h[i] *= fabs(*LISAParamsComponent(params, i));
+    errdiag[i] = INFINITY;
+    deriv[i] = LISAFisherDerivative(params, i, h[i], &grid);
+    if(!deriv[i]) continue;
+    double Fii = LISAFisherOverlap(deriv[i], deriv[i], &grid);
+    for(int iter=0; iter<maxiter; iter++) {
+      LISASignalReIm* derivhalf = LISAFisherDerivative(params, i, h[i]/2, &grid);
+      if(!derivhalf) break;
+      double Fiihalf = LISAFisherOverlap(derivhalf, derivhalf, &grid);
+      double errhalf = fabs(Fiihalf - Fii)/fabs(Fiihalf);
+      if(errhalf>errdiag[i]) {
+        LISASignalReIm_Cleanup(derivhalf);
+        break;
+      }
+      LISASignalReIm_Cleanup(deriv[i]);
+      deriv[i] = derivhalf;
+      h[i] /= 2;
+      Fii = Fiihalf;
+      errdiag[i] = errhalf;
+      if(errdiag[i]<=tol) break;
+    }
+  }
+
+  int ret = SUCCESS;
+  for(int i=0; i<n; i++) if(!deriv[i]) ret = FAILURE;
+
+  if(ret==SUCCESS) {
+    /* Elements F_ij = (d_i h|d_j h) - pairs in parallel */
+    #pragma omp parallel for schedule(dynamic)
+    for(int ij=0; ij<n*n; ij++) {
+      int i = ij/n;
+      int j = ij%n;
+      if(j<i) continue;
+      double Fij = LISAFisherOverlap(deriv[i], deriv[j], &grid);
+      gsl_matrix_set(fisher, i, j, Fij);
+      gsl_matrix_set(fisher, j, i, Fij);
+    }
+
+    /* Check of the derivatives on the distance, for which h is proportional to 1/D: F_DD = (h|h)/D^2 on the same grid */
+    LISASignalReIm* wf0 = LISAFisherWaveform(params, params->tRef, &grid);
+    double errdist = INFINITY;
+    if(wf0) {
+      double FDDexact = LISAFisherOverlap(wf0, wf0, &grid) / (params->distance*params->distance);
+      errdist = fabs(gsl_matrix_get(fisher, 3, 3) - FDDexact)/FDDexact;
+      LISASignalReIm_Cleanup(wf0);
+    }
+    if(!(errdist<=fmax(tol, 1e-6))) printf("Warning in LISAFisherMatrix: F_DD differs from SNR^2/D^2 by %g relatively.\n", errdist);
+
+    if(SNR) *SNR = SNRsource;
+    if(err) {
+      *err = errdist;
+      for(int i=0; i<n; i++) *err = fmax(*err, errdiag[i]);
+    }
+  }
+  else {
+    gsl_matrix_set_all(fisher, NAN);
+    if(SNR) *SNR = NAN;
+    if(err) *err = NAN;
+  }
+
+  for(int i=0; i<n; i++) if(deriv[i]) LISASignalReIm_Cleanup(deriv[i]);
+  LISAFisherGrid_Cleanup(&grid);
+  return ret;
+}
+
+int LISAFisherMatrixBatch(
+  double* fishers,
+  double* SNRs,
+  double* errs,
+  LISAParams* params,
+  const int nsources,
+  const double* steps,
+  const double tol,
+  const int maxiter)
+{
+  int n = LISAFISHER_NPARAMS;
+  int nfailed = 0;
+
+  /* Load the ROM data before entering the parallel region - shared read-only by the threads */
+  if(EOBNRv2HMROM_Init_DATA()==FAILURE) exit(1);
+
+  /* Sources in parallel - the parallel loops of LISAFisherMatrix are then nested, and run serially in each thread */
+  #pragma omp parallel for schedule(dynamic) reduction(+:nfailed)
+  for(int k=0; k<nsources; k++) {
+    gsl_matrix_view fisherview = gsl_matrix_view_array(&(fishers[k*n*n]), n, n);
+    double* SNR = SNRs ? &(SNRs[k]) : NULL;
+    double* err = errs ? &(errs[k]) : NULL;
+    if(LISAFisherMatrix(&fisherview.matrix, SNR, err, &(params[k]), steps, tol, maxiter)==FAILURE) nfailed++;
+  }
+  return nfailed;
+}
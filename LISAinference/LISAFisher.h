@@ -0,0 +1,71 @@
+/**
+ * \author Sylvain Marsat, University of Maryland - NASA GSFC
+ *
+ * \brief C header for the computation of Fisher matrices of LISA signals, by finite differences of the waveforms and Fresnel overlaps.
+ *
+ */
+
+#ifndef _LISAFISHER_H
+#define _LISAFISHER_H
+
+#define _XOPEN_SOURCE 500
+
+#ifdef __GNUC__
+#define UNUSED __attribute__ ((unused))
+#else
+#define UNUSED
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+
+#include "constants.h"
+#include "struct.h"
+#include "LISAutils.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#elif 0
+} /* so that editors will match preceding brace */
+#endif
+
+/* Number of parameters of the Fisher matrix - in the order of the params files: m1, m2, tRef, dist, phase, inc, lambda, beta, pol */
+#define LISAFISHER_NPARAMS 9
+
+/* Fisher matrix F_ij = (d_i h|d_j h), with d_i h = (h(theta+h_i) - h(theta-h_i))/(2h_i) */
+/* The derivatives are formed on a common grid of globalparams->nbptsoverlap frequencies (log sampling), and the overlaps integrated by trapezes */
+/* Step control: each step is halved until the diagonal element changes by less than tol relatively, or maxiter halvings - */
+/* the halving stops as soon as that change grows again, roundoff in the differences then dominating */
+/* Check: h being proportional to 1/D, F_DD must equal (h|h)/D^2 - a warning is printed if not, and the deviation is included in err */
+/* The perturbed waveforms are generated in parallel, sharing the ROM data and noise functions - the settings are read from globalparams */
+/* Returns FAILURE if a waveform could not be generated (e.g. parameters out of the range of the ROM), with the matrix set to NAN */
+int LISAFisherMatrix(
+  gsl_matrix* fisher,           /* Output: Fisher matrix, LISAFISHER_NPARAMS x LISAFISHER_NPARAMS */
+  double* SNR,                  /* Output: SNR of the source (ignored if NULL) */
+  double* err,                  /* Output: largest of the relative changes of the diagonal at the last halving and of the F_DD check (ignored if NULL) */
+  LISAParams* params,           /* Input: parameters of the source */
+  const double* steps,          /* Input: initial steps, LISAFISHER_NPARAMS values - NULL for the defaults (relative for masses and distance) */
+  const double tol,             /* Input: relative tolerance for the step control */
+  const int maxiter);           /* Input: maximal number of halvings of the steps */
+
+/* Fisher matrices for many sources, processed in parallel - one matrix of LISAFISHER_NPARAMS^2 values per source, row-major */
+/* Returns the number of sources for which the computation failed */
+int LISAFisherMatrixBatch(
+  double* fishers,              /* Output: Fisher matrices, nsources*LISAFISHER_NPARAMS^2 values */
+  double* SNRs,                 /* Output: SNRs of the sources (ignored if NULL) */
+  double* errs,                 /* Output: step-control errors of the sources (ignored if NULL) */
+  LISAParams* params,           /* Input: parameters of the sources */
+  const int nsources,           /* Input: number of sources */
+  const double* steps,          /* Input: initial steps, LISAFISHER_NPARAMS values - NULL for the defaults */
+  const double tol,             /* Input: relative tolerance for the step control */
+  const int maxiter);           /* Input: maximal number of halvings of the steps */
+
+#if 0
+{ /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif /* _LISAFISHER_H */
@@ -0,0 +1,315 @@
+#include "LISAhorizon.h"
+
+#include <gsl/gsl_sort_double.h>
+#include <gsl/gsl_statistics_double.h>
+
+/* Cosmological parameters for LuminosityDistance - Planck 2015, as in astropy.cosmology.Planck15 */
+#define HORIZON_H0 67.74
+#define HORIZON_OM0 0.3075
+
+/* Radical inverse of i in base b - coordinates of the Halton sequence */
+static double RadicalInverse(int i, const int b)
+{
+  double inv = 1./b;
+  double fac = inv;
+  double r = 0.;
+  while(i>0) {
+    r += (i%b) * fac;
+    i /= b;
+    fac *= inv;
+  }
+  return r;
+}
+
+int LISASkyAveragedResponse_Init(
+  LISASkyAveragedResponse** response,
+  const LISAconstellation* variant,
+  const TDItag tagtdi,
+  const ResponseApproxtag responseapprox,
+  const int nbmode,
+  const int nsky,
+  const double fmin,
+  const double fmax,
+  const int nf,
+  const double deltatobs,
+  const int ntau)
+{
+  if(nbmode<1 || nbmode>nbmodemax) {
+    printf("Error in LISASkyAveragedResponse_Init: incorrect number of modes.\n");
+    return FAILURE;
+  }
+  if(nsky<1 || nf<2 || ntau<2 || deltatobs<=0.) {
+    printf("Error in LISASkyAveragedResponse_Init: need at least 1 sample, 2 frequencies, 2 times and a positive duration.\n");
+    return FAILURE;
+  }
+  if(fmin<__LISASimFD_Noise_fLow || fmax>__LISASimFD_Noise_fHigh || fmin>=fmax) {
+    printf("Error in LISASkyAveragedResponse_Init: frequency range outside of the range of the noise.\n");
+    return FAILURE;
+  }
+
+  LISASkyAveragedResponse* resp = (LISASkyAveragedResponse*) malloc(sizeof(LISASkyAveragedResponse));
+  resp->nbmode = nbmode;
+  resp->nsky = nsky;
+  resp->nf = nf;
+  resp->ntau = ntau;
+  resp->fmin = fmin;
+  resp->fmax = fmax;
+  resp->deltalnf = log(fmax/fmin)/(nf-1);
+  resp->taumax = deltatobs*YRSID_SI;
+  resp->deltatau = resp->taumax/(ntau-1);
+  resp->sky = (double*) malloc(5*nsky*sizeof(double));
+  resp->power = (double*) malloc((size_t) nbmode*nf*ntau*nsky*sizeof(double));
+
+  /* Samples of lambda, beta, psi, inclination and merger time, from the Halton sequence in bases 2, 3, 5, 7, 11 */
+  for(int s=0; s<nsky; s++) {
+    resp->sky[5*s] = 2*PI*RadicalInverse(s+1, 2);
+    resp->sky[5*s+1] = asin(2*RadicalInverse(s+1, 3) - 1.);
+    resp->sky[5*s+2] = PI*RadicalInverse(s+1, 5);
+    resp->sky[5*s+3] = acos(2*RadicalInverse(s+1, 7) - 1.);
+    resp->sky[5*s+4] = YRSID_SI*RadicalInverse(s+1, 11);
+  }
+
+  /* Frequencies and inverse noise of each channel - 0 for channels absent from the set of TDI observables */
+  double* freq = (double*) malloc(nf*sizeof(double));
+  double* invSn = (double*) malloc(3*nf*sizeof(double));
+  ObjectFunction NoiseSn1 = NoiseFunction(variant, tagtdi, 1);
+  ObjectFunction NoiseSn2 = NoiseFunction(variant, tagtdi, 2);
+  ObjectFunction NoiseSn3 = NoiseFunction(variant, tagtdi, 3);
+  for(int j=0; j<nf; j++) {
+    freq[j] = fmin*exp(j*resp->deltalnf);
+    invSn[3*j] = 1./ObjectFunctionCall(&NoiseSn1, freq[j]);
+    invSn[3*j+1] = 1./ObjectFunctionCall(&NoiseSn2, freq[j]);
+    invSn[3*j+2] = 1./ObjectFunctionCall(&NoiseSn3, freq[j]);
+  }
+
+  /* The geometric coefficients set by SetCoeffsG are per-thread */
+  #pragma omp parallel for schedule(dynamic)
+  for(int s=0; s<nsky; s++) {
+    double lambda = resp->sky[5*s];
+    double beta = resp->sky[5*s+1];
+    double psi = resp->sky[5*s+2];
+    double inclination = resp->sky[5*s+3];
+    double tmerger = resp->sky[5*s+4];
+    SetCoeffsG(lambda, beta, psi);
+    double complex* G = (double complex*) malloc(6*nf*sizeof(double complex));
+    double complex* factors = (double complex*) malloc(3*nf*sizeof(double complex));
+
+    for(int k=0; k<nbmode; k++) {
+      int l = listmode[k][0];
+      int m = listmode[k][1];
+
+      /* Computing the Ylm combined factors for plus and cross for this mode, as in LISASimFDResponseTDI3Chan */
+      double complex Yfactorplus;
+      double complex Yfactorcross;
+      if (!(l%2)) {
+        Yfactorplus = 1./2 * (SpinWeightedSphericalHarmonic(inclination, 0., -2, l, m) + conj(SpinWeightedSphericalHarmonic(inclination, 0., -2, l, -m)));
+        Yfactorcross = I/2 * (SpinWeightedSphericalHarmonic(inclination, 0., -2, l, m) - conj(SpinWeightedSphericalHarmonic(inclination, 0., -2, l, -m)));
+      }
+      else {
+        Yfactorplus = 1./2 * (SpinWeightedSphericalHarmonic(inclination, 0., -2, l, m) - conj(SpinWeightedSphericalHarmonic(inclination, 0., -2, l, -m)));
+        Yfactorcross = I/2 * (SpinWeightedSphericalHarmonic(inclination, 0., -2, l, m) + conj(SpinWeightedSphericalHarmonic(inclination, 0., -2, l, -m)));
+      }
+
+      /* For each time to merger, the TDI factors of all frequencies are computed at once, by a kernel specialized for the TDI tag */
+      for(int it=0; it<ntau; it++) {
+        double torb = tmerger - it*resp->deltatau;
+        for(int j=0; j<nf; j++) {
+          EvaluateGABmode(variant, &G[6*j], &G[6*j+1], &G[6*j+2], &G[6*j+3], &G[6*j+4], &G[6*j+5], freq[j], torb, Yfactorplus, Yfactorcross, 0, responseapprox);
+        }
+        EvaluateTDIfactor3ChanSeries(variant, factors, factors + nf, factors + 2*nf, G, freq, nf, tagtdi, responseapprox);
+        for(int j=0; j<nf; j++) {
+          double complex factor1 = factors[j];
+          double complex factor2 = factors[nf + j];
+          double complex factor3 = factors[2*nf + j];
+          double p = 0.;
+          if(factor1!=0.) p += (creal(factor1)*creal(factor1) + cimag(factor1)*cimag(factor1)) * invSn[3*j];
+          if(factor2!=0.) p += (creal(factor2)*creal(factor2) + cimag(factor2)*cimag(factor2)) * invSn[3*j+1];
+          if(factor3!=0.) p += (creal(factor3)*creal(factor3) + cimag(factor3)*cimag(factor3)) * invSn[3*j+2];
+          resp->power[(((size_t) k*nf + j)*ntau + it)*nsky + s] = p;
+        }
+      }
+    }
+    free(G);
+    free(factors);
+  }
+
+  free(freq);
+  free(invSn);
+  *response = resp;
+  return SUCCESS;
+}
+
+void LISASkyAveragedResponse_Cleanup(LISASkyAveragedResponse* response)
+{
+  free(response->sky);
+  free(response->power);
+  free(response);
+}
+
+int LISASkyAveragedSNR(
+  double* snrsky,
+  const LISASkyAveragedResponse* response,
+  const double m1,
+  const double m2,
+  const double distance,
+  const double minf,
+  const double maxf,
+  const int tagextpn,
+  const double Mfmatch)
+{
+  int ret;
+  int nsky = response->nsky;
+  int nf = response->nf;
+  int ntau = response->ntau;
+  ListmodesCAmpPhaseFrequencySeries* listROM = NULL;
+
+  /* Generate the waveform with the ROM - the peak of the 22 mode is at t=0, so that -tf is the time to merger */
+  /* NOTE: SimEOBNRv2HMROM accepts masses and distances in SI units */
+  if(!tagextpn) {
+    ret = SimEOBNRv2HMROM(&listROM, response->nbmode, 0., 0., 0., m1*MSUN_SI, m2*MSUN_SI, distance*1e6*PC_SI, 0);
+  } else {
+    double fstartobs = Newtonianfoft(m1, m2, response->taumax/YRSID_SI);
+    ret = SimEOBNRv2HMROMExtTF2(&listROM, response->nbmode, Mfmatch, fmax(fstartobs, minf), 0, 0., 0., 0., m1*MSUN_SI, m2*MSUN_SI, distance*1e6*PC_SI, 0);
+  }
+  if(ret==FAILURE) return FAILURE;
+
+  for(int s=0; s<nsky; s++) snrsky[s] = 0.;
+
+  /* Accumulate SNR^2 for all samples, mode by mode, on the frequencies of the table */
+  ListmodesCAmpPhaseFrequencySeries* listelement = listROM;
+  while(listelement) {
+    int k = 0;
+    while(k<response->nbmode && !(listmode[k][0]==listelement->l && listmode[k][1]==listelement->m)) k++;
+    CAmpPhaseFrequencySeries* freqseries = listelement->freqseries;
+    int len = (int) freqseries->freq->size;
+    if(k==response->nbmode || len<2) {
+      listelement = listelement->next;
+      continue;
+    }
+    double* freq = gsl_vector_ptr(freqseries->freq, 0);
+    gsl_spline* spline_amp_real = gsl_spline_alloc(gsl_interp_cspline, len);
+    gsl_spline* spline_amp_imag = gsl_spline_alloc(gsl_interp_cspline, len);
+    gsl_spline* spline_phase = gsl_spline_alloc(gsl_interp_cspline, len);
+    gsl_interp_accel* accel = gsl_interp_accel_alloc();
+    gsl_spline_init(spline_amp_real, freq, gsl_vector_const_ptr(freqseries->amp_real, 0), len);
+    gsl_spline_init(spline_amp_imag, freq, gsl_vector_const_ptr(freqseries->amp_imag, 0), len);
+    gsl_spline_init(spline_phase, freq, gsl_vector_const_ptr(freqseries->phase, 0), len);
+
+    /* Frequencies of the table covered by the mode */
+    double fLow = fmax(fmax(freq[0], minf), response->fmin);
+    double fHigh = fmin(fmin(freq[len-1], maxf), response->fmax);
+    int jmin = (int) ceil(log(fLow/response->fmin)/response->deltalnf - 1e-12);
+    int jmax = (int) floor(log(fHigh/response->fmin)/response->deltalnf + 1e-12);
+    if(jmax>nf-1) jmax = nf-1;
+
+    for(int j=jmin; j<=jmax; j++) {
+      double f = response->fmin*exp(j*response->deltalnf);
+      if(f<freq[0] || f>freq[len-1]) continue;
+      double areal = gsl_spline_eval(spline_amp_real, f, accel);
+      double aimag = gsl_spline_eval(spline_amp_imag, f, accel);
+      double tau = -gsl_spline_eval_deriv(spline_phase, f, accel)/(2*PI);
+      if(tau<0.) tau = 0.;
+      if(tau>response->taumax) continue;
+
+      /* Trapezoidal rule in ln(f) */
+      double weight = 4*(areal*areal + aimag*aimag) * f*response->deltalnf;
+      if(j==jmin || j==jmax) weight *= 0.5;
+
+      /* Linear interpolation in time to merger */
+      double u = tau/response->deltatau;
+      int it = (int) u;
+      if(it>ntau-2) it = ntau-2;
+      double c1 = weight*(u - it);
+      double c0 = weight - c1;
+      const double* power0 = &(response->power[(((size_t) k*nf + j)*ntau + it)*nsky]);
+      const double* power1 = power0 + nsky;
+      for(int s=0; s<nsky; s++) snrsky[s] += c0*power0[s] + c1*power1[s];
+    }
+
+    gsl_spline_free(spline_amp_real);
+    gsl_spline_free(spline_amp_imag);
+    gsl_spline_free(spline_phase);
+    gsl_interp_accel_free(accel);
+    listelement = listelement->next;
+  }
+
+  for(int s=0; s<nsky; s++) snrsky[s] = sqrt(snrsky[s]);
+  ListmodesCAmpPhaseFrequencySeries_Destroy(listROM);
+  return SUCCESS;
+}
+
+int LISAHorizonSNRGrid(
+  double* snrmean,
+  double* snrpercentiles,
+  const LISASkyAveragedResponse* response,
+  const double* Mtot,
+  const int nM,
+  const double* q,
+  const int nq,
+  const double* z,
+  const int nz,
+  const double* percentiles,
+  const int npercentiles,
+  const double minf,
+  const double maxf,
+  const int tagextpn,
+  const double Mfmatch)
+{
+  int nsky = response->nsky;
+
+  /* Load the ROM data before entering the parallel region - shared read-only by the threads */
+  if(EOBNRv2HMROM_Init_DATA()==FAILURE) return FAILURE;
+
+  double* distance = (double*) malloc(nz*sizeof(double));
+  for(int iz=0; iz<nz; iz++) distance[iz] = LuminosityDistance(z[iz]);
+
+  /* SNR computed at 1 Mpc, then scaled by 1/distance for all redshifts */
+  #pragma omp parallel for schedule(dynamic)
+  for(int imq=0; imq<nM*nq; imq++) {
+    int iM = imq/nq;
+    int iq = imq%nq;
+    double m1 = Mtot[iM]*q[iq]/(1.+q[iq]);
+    double m2 = Mtot[iM]/(1.+q[iq]);
+    double* snrsky = (double*) malloc(nsky*sizeof(double));
+    int ret = LISASkyAveragedSNR(snrsky, response, m1, m2, 1., minf, maxf, tagextpn, Mfmatch);
+
+    double mean = NAN;
+    if(ret==SUCCESS) {
+      mean = 0.;
+      for(int s=0; s<nsky; s++) mean += snrsky[s];
+      mean /= nsky;
+      gsl_sort(snrsky, 1, nsky);
+    }
+    for(int iz=0; iz<nz; iz++) {
+      int index = imq*nz + iz;
+      snrmean[index] = mean/distance[iz];
+      if(snrpercentiles) {
+        for(int ip=0; ip<npercentiles; ip++) {
+          if(ret==SUCCESS) snrpercentiles[index*npercentiles + ip] = gsl_stats_quantile_from_sorted_data(snrsky, 1, nsky, percentiles[ip]/100.)/distance[iz];
+          else snrpercentiles[index*npercentiles + ip] = NAN;
+        }
+      }
+    }
+    free(snrsky);
+  }
+
+  free(distance);
+  return SUCCESS;
+}
+
+/* Comoving distance integral with Simpson's rule - 1000 intervals are well below the accuracy of the SNR estimates */
+double LuminosityDistance(const double z)
+{
+  int n = 1000;
+  double h = z/n;
+  double sum = 0.;
+  for(int i=0; i<=n; i++) {
+    double zp = i*h;
+    double invE = 1./sqrt(HORIZON_OM0*(1.+zp)*(1.+zp)*(1.+zp) + 1. - HORIZON_OM0);
+    if(i==0 || i==n) sum += invE;
+    else if(i%2) sum += 4*invE;
+    else sum += 2*invE;
+  }
+  double dH = C_SI/1e3/HORIZON_H0; /* Hubble distance in Mpc */
+  return (1.+z) * dH * sum*h/3.;
+}
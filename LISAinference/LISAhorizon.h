@@ -0,0 +1,115 @@
+/**
+ * \author Sylvain Marsat, University of Maryland - NASA GSFC
+ *
+ * \brief C header for sky-, polarization- and inclination-averaged LISA SNRs, for horizon studies over grids of masses and redshifts.
+ *
+ */
+
+#ifndef _LISAHORIZON_H
+#define _LISAHORIZON_H
+
+#define _XOPEN_SOURCE 500
+
+#ifdef __GNUC__
+#define UNUSED __attribute__ ((unused))
+#else
+#define UNUSED
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include <string.h>
+
+#include "constants.h"
+#include "struct.h"
+#include "waveform.h"
+#include "EOBNRv2HMROMstruct.h"
+#include "EOBNRv2HMROM.h"
+#include "LISAgeometry.h"
+#include "LISAnoise.h"
+
+#if defined(__cplusplus)
+#define complex _Complex
+extern "C" {
+#elif 0
+} /* so that editors will match preceding brace */
+#endif
+
+/* Noise-weighted response power of the TDI channels, sum_chan |factor_chan|^2/Sn_chan(f), tabulated per mode of the ROM and per sample of the sky position, polarization, inclination and orbital time of merger */
+/* The dependence on the orbital motion is kept through the time to merger tau, the table covers the observation [0, taumax] */
+/* Samples are drawn from a Halton sequence (uniform in lambda, sin(beta), psi, cos(inclination) and merger time over a year), so that results are reproducible */
+/* Cross-terms between modes, oscillating in time, are neglected: SNR^2 = sum_lm 4 int |h_lm(f)|^2 P_lm(f, tau_lm(f)) df */
+typedef struct tagLISASkyAveragedResponse {
+  int nbmode;                /* Number of modes, in the order of listmode of the ROM */
+  int nsky;                  /* Number of samples of the sky position, polarization, inclination and merger time */
+  int nf;                    /* Number of frequencies, log-spaced */
+  int ntau;                  /* Number of times to merger, linearly spaced */
+  double fmin;               /* First frequency (Hz) */
+  double fmax;               /* Last frequency (Hz) */
+  double deltalnf;           /* Step of the frequency grid in ln(f) */
+  double taumax;             /* Duration of the observation, last time to merger (s) */
+  double deltatau;           /* Step of the grid in time to merger (s) */
+  double* sky;               /* Samples, 5 values per sample: lambda, beta, psi, inclination, orbital time of merger (s) */
+  double* power;             /* Table of the response power, index ((mode*nf + f)*ntau + tau)*nsky + sky */
+} LISASkyAveragedResponse;
+
+/* Tabulates the response power - the cost is nbmode*nsky*nf*ntau evaluations of the response, shared by all masses and distances */
+int LISASkyAveragedResponse_Init(
+  LISASkyAveragedResponse** response,      /* Output: table of the averaged response */
+  const LISAconstellation* variant,        /* Description of LISA variant */
+  const TDItag tagtdi,                     /* Selector for the set of TDI observables */
+  const ResponseApproxtag responseapprox,  /* Approximation used in the response (full, lowfL, lowf) */
+  const int nbmode,                        /* Number of modes (starting with the 22) */
+  const int nsky,                          /* Number of samples of the angles and merger time */
+  const double fmin,                       /* First frequency of the table (Hz) */
+  const double fmax,                       /* Last frequency of the table (Hz) */
+  const int nf,                            /* Number of frequencies, log-spaced */
+  const double deltatobs,                  /* Duration of the observation (years) */
+  const int ntau);                         /* Number of times to merger in [0, deltatobs] */
+void LISASkyAveragedResponse_Cleanup(LISASkyAveragedResponse* response);
+
+/* SNR for each sample of the table, from a single ROM evaluation - no time or phase shift is involved */
+/* Returns FAILURE if the ROM could not generate the waveform (e.g. mass ratio out of range) */
+int LISASkyAveragedSNR(
+  double* snrsky,                          /* Output: SNR for each sample of the table, nsky values */
+  const LISASkyAveragedResponse* response, /* Table of the averaged response */
+  const double m1,                         /* Mass of companion 1 (solar masses, redshifted) */
+  const double m2,                         /* Mass of companion 2 (solar masses, redshifted) */
+  const double distance,                   /* Luminosity distance (Mpc) */
+  const double minf,                       /* Minimal frequency (Hz) */
+  const double maxf,                       /* Maximal frequency (Hz) */
+  const int tagextpn,                      /* Tag to extend the ROM to low frequencies with TaylorF2 */
+  const double Mfmatch);                   /* Geometric frequency of the matching to TaylorF2 when extending */
+
+/* Averaged and percentile SNRs over grids of redshifted total mass, mass ratio and redshift */
+/* One ROM evaluation per mass pair, the SNR scales as 1/distance - mass pairs are processed in parallel */
+/* Outputs are indexed by (iM*nq + iq)*nz + iz, and (((iM*nq + iq)*nz + iz)*npercentiles + ip) for the percentiles - NAN where the ROM failed */
+int LISAHorizonSNRGrid(
+  double* snrmean,                         /* Output: mean SNR over the samples, nM*nq*nz values */
+  double* snrpercentiles,                  /* Output: percentiles of the SNR over the samples, nM*nq*nz*npercentiles values (ignored if NULL) */
+  const LISASkyAveragedResponse* response, /* Table of the averaged response */
+  const double* Mtot,                      /* Redshifted total masses (solar masses) */
+  const int nM,                            /* Number of total masses */
+  const double* q,                         /* Mass ratios m1/m2 >= 1 */
+  const int nq,                            /* Number of mass ratios */
+  const double* z,                         /* Redshifts */
+  const int nz,                            /* Number of redshifts */
+  const double* percentiles,               /* Percentiles to compute, in [0, 100] */
+  const int npercentiles,                  /* Number of percentiles */
+  const double minf,                       /* Minimal frequency (Hz) */
+  const double maxf,                       /* Maximal frequency (Hz) */
+  const int tagextpn,                      /* Tag to extend the ROM to low frequencies with TaylorF2 */
+  const double Mfmatch);                   /* Geometric frequency of the matching to TaylorF2 when extending */
+
+/* Luminosity distance (Mpc) in flat LambdaCDM with the Planck 2015 parameters (H0=67.74, Om0=0.3075), neglecting radiation */
+double LuminosityDistance(const double z);
+
+#if 0
+{ /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif /* _LISAHORIZON_H */
@@ -108,6 +108,13 @@ void addendum(int argc, char *argv[],LISARunParams *runParams, int *ndim, int *n
   if(globalparams->tagsimplelikelihoodHM) {
     LISAComputeSimpleLikelihoodPrecomputedValuesHM(simplelikelihoodinjvalsHM, injectedparams);
   }
+  /* Tabulate the overlaps over masses and time - cached in a file if requested, written by the first process only */
+  if(globalparams->tagsimplelikelihoodHM && globalparams->tagsimplelikelihoodgrid) {
+    if(LISALoadOrComputeSimpleLikelihoodPrecomputedGridHM(&(simplelikelihoodinjvalsHM->grid), injectedparams, globalparams->simplegridfile, myid==0)==FAILURE) {
+      printf("Error: failed to compute the grid for the simplified likelihood.\n");
+      exit(1);
+    }
+  }
 
   /* Print SNR */
   if (myid == 0) {
@@ -11,6 +11,9 @@
 #include <iomanip>
 #include <fstream>
 #include <ctime>
+#include <random>
+#include <map>
+#include <deque>
 #include "omp.h"
 #include "options.hh"
 #include "bayesian.hh"
@@ -32,6 +35,8 @@ const int Npar=9;
 int output_precision;
 double fisher_err_target=0.001;
 bool allow_m2gtm1=false;
+unsigned long da_seed=0;//seed for the delayed-acceptance stage-1 draws
+const size_t da_cache_size=1<<16;//number of log-likelihood values kept for the delayed acceptance
 
 //First we define the all-in-one likelihood function object
 class flare_likelihood : public bayes_likelihood {
@@ -41,19 +46,49 @@ class flare_likelihood : public bayes_likelihood {
   double best_post;
   state best;
   void *context;
+  //Delayed acceptance: cheap surrogate likelihood (22 mode, frozen-LISA lowf response), see da_proposal below
+  LISAInjectionCAmpPhase *surrogate;
+  int count_screened;
+  //Recent log-likelihood values, so that a state left unchanged by a stage-1 rejection is not recomputed
+  map<vector<double>,double> da_cache;
+  deque<vector<double> > da_cache_order;
 public:
   flare_likelihood(stateSpace *sp, void *context, sampleable_probability_function *prior=nullptr):context(context),prior(prior),bayes_likelihood(sp,nullptr,nullptr){
     setPrior(prior);
     best=state(sp,sp->size());
+    surrogate=nullptr;
     reset();
     nevery=0;
   };
   void info_every(int n){nevery=n;};
+  //Surrogate injection must come from LISAGenerateInjectionCAmpPhaseSurrogate.
+  void set_delayed_acceptance(LISAInjectionCAmpPhase *surrogate_injection){
+    surrogate=surrogate_injection;
+  };
+  bool delayed_acceptance(){return surrogate!=nullptr;};
+  //Surrogate log-likelihood, NAN where it is not defined (waveform generation failed or mass ordering violated)
+  double evaluate_surrogate_log(const state &s){
+    LISAParams templateparams =state2LISAParams(s);
+    if(not allow_m2gtm1)if(templateparams.m1<templateparams.m2)return NAN;
+    double surrlike=CalculateLogLCAmpPhaseSurrogate(&templateparams, surrogate);
+    if(!(surrlike>-DBL_MAX))return NAN;
+    return surrlike;
+  };
+  void count_stage1_rejection(){
+    #pragma omp atomic
+    count_screened++;
+  };
   void reset(){
     best_post=-INFINITY;
     best=best.scalar_mult(0);
     count=0;
+    count_screened=0;
     total_eval_time=0;
+    #pragma omp critical (da_cache)
+    {
+      da_cache.clear();
+      da_cache_order.clear();
+    }
   }
   state bestState(){return best;};
   double bestPost(){return best_post;};
@@ -70,6 +105,22 @@ public:
     if(not allow_m2gtm1)if(templateparams.m1<templateparams.m2){
       return -INFINITY;
     }
+    /* With delayed acceptance, a state unchanged by a stage-1 rejection is looked up - the value is always the full likelihood */
+    vector<double> key;
+    bool cached=false;
+    if(surrogate){
+      valarray<double> params=s.get_params();
+      key.assign(begin(params),end(params));
+      #pragma omp critical (da_cache)
+      {
+        auto it=da_cache.find(key);
+        if(it!=da_cache.end()){
+          result=it->second;
+          cached=true;
+        }
+      }
+      if(cached)return result;
+    }
     /* Note: context points to a LISAContext structure containing a LISASignal* */
     if(globalparams->tagint==0) {
       LISAInjectionCAmpPhase injection = *((LISAInjectionCAmpPhase*) context);
@@ -109,6 +160,18 @@ public:
         result=-INFINITY;
       }
     }
+    if(surrogate){
+      #pragma omp critical (da_cache)
+      {
+        if(da_cache.insert(make_pair(key,result)).second){
+          da_cache_order.push_back(key);
+          if(da_cache_order.size()>da_cache_size){
+            da_cache.erase(da_cache_order.front());
+            da_cache_order.pop_front();
+          }
+        }
+      }
+    }
     return result;
   };
 
@@ -146,7 +209,11 @@ public:
   //virtual void write(ostream &out,state &st){cout<<"flare_likelihood::write: No write routine defined!"<<endl;};
   //virtual void writeFine(ostream &out,state &st,int ns=-1, double ts=0, double te=0){cout<<"flare_likelihood::writeFine: No write routine defined!"<<endl;};
   //virtual void getFineGrid(int & nfine, double &tstart, double &tend)const{cout<<"flare_likelihood::getFineGrid: No routine defined!"<<endl;};
-  void print_info(){cout<<" mean = "<<total_eval_time/count<<" through "<<count<<" total evals"<<endl; };
+  void print_info(){
+    cout<<" mean = "<<total_eval_time/count<<" through "<<count<<" total evals";
+    if(surrogate)cout<<" ("<<count_screened<<" proposals rejected at stage 1 by the surrogate)";
+    cout<<endl;
+  };
   double getFisher(const state &s0, vector<vector<double> >&fisher_matrix)override{
     //First we must set the injection context
     /* Initialize the data structure for the injection */
@@ -478,6 +545,49 @@ public:
 
 };
 
+//Two-stage delayed acceptance, wrapping the proposal distribution selected by the sampler.
+//Stage 1 (here): a proposal y from the current state x is kept with probability min(1, exp(S(y)-S(x)) q(x|y)/q(y|x)),
+//with S the surrogate log-likelihood. Otherwise the chain stays at x - the proposal returns x, whose
+//log-likelihood is found in the cache of flare_likelihood, and the sampler accepts it with ratio 1.
+//Stage 2 (the Metropolis step of the sampler): the Hastings ratio returned is exp(-(S(y)-S(x))), so that the sampler
+//accepts with min(1, exp(beta(L(y)-L(x))) p(y)/p(x) exp(-(S(y)-S(x)))), p the prior.
+//The surrogate target exp(S) is not tempered, so that beta needs not be known - this is valid at all temperatures,
+//the hotter chains only reject more at stage 1. Moves where S is not defined at x or y skip stage 1.
+class da_proposal : public proposal_distribution {
+  proposal_distribution *inner;
+  flare_likelihood *like;
+  double da_log_hastings;
+  double uniform_draw(){
+    static thread_local mt19937_64 gen(da_seed+omp_get_thread_num());
+    return uniform_real_distribution<double>(0.0,1.0)(gen);
+  };
+public:
+  da_proposal(proposal_distribution *inner, flare_likelihood *like):inner(inner),like(like),da_log_hastings(0){};
+  virtual ~da_proposal(){delete inner;};
+  state draw(state &s,chain *caller){
+    state y=inner->draw(s,caller);
+    double log_hastings_inner=inner->log_hastings_ratio();
+    double surrx=like->evaluate_surrogate_log(s);
+    double surry=like->evaluate_surrogate_log(y);
+    if(std::isnan(surrx)||std::isnan(surry)){
+      da_log_hastings=log_hastings_inner;
+      return y;
+    }
+    if(log(uniform_draw())<surry-surrx+log_hastings_inner){
+      da_log_hastings=-(surry-surrx);
+      return y;
+    }
+    like->count_stage1_rejection();
+    da_log_hastings=0;
+    return s;
+  };
+  double log_hastings_ratio(){return da_log_hastings;};
+  void set_space(stateSpace *space){inner->set_space(space);};
+  bool is_ready(){return inner->is_ready();};
+  proposal_distribution* clone()const{return new da_proposal(inner->clone(),like);};
+  string show(){return "DelayedAcceptance("+inner->show()+")";};
+};
+
 //***************************************************************************************8
 //main test program
 int main(int argc, char*argv[]){
@@ -503,6 +613,7 @@ int main(int argc, char*argv[]){
   opt.add(Option("noFisher","Skip Fisher computation."));
   opt.add(Option("allow_m2gtm1","Unless this is set, reject cases with m2>m1."));
   opt.add(Option("Fisher_err_target","Set target for Fisher error measure. (Default 0.001).","0.001"));
+  opt.add(Option("delayed_accept","Two-stage delayed acceptance: proposals are first accepted or rejected with the cheap 22-mode frozen-LISA lowf likelihood, the full one is computed only for those kept (tagint 0 only)."));
   opt.add(Option("help","Print help message."));
   //First we parse the ptmcmc-related parameters like un gleam.
   opt.parse(argc,argv,false);
@@ -541,6 +652,7 @@ int main(int argc, char*argv[]){
 
   //if seed<0 set seed from clock
   if(seed<0)seed=fmod(time(NULL)/3.0e7,1);
+  da_seed=(unsigned long)(seed*4294967296.0);
   istringstream(opt.value("precision"))>>output_precision;
   ProbabilityDist::setSeed(seed);
   globalRNG.reset(ProbabilityDist::getPRNG());//just for safety to keep us from deleting main RNG in debugging.
@@ -668,6 +780,17 @@ int main(int argc, char*argv[]){
   flare_likelihood fl(&space, context, prior);
   fl.addOptions(opt,"");
   if(info_every>0)fl.info_every(info_every);
+  LISAInjectionCAmpPhase* surrogateinjection = NULL;
+  if(opt.set("delayed_accept")){
+    if(globalparams->tagint!=0){
+      cout<<" ** Delayed acceptance only supported with tagint 0.  Ignoring request! **"<<endl;
+    } else {
+      LISAInjectionCAmpPhase_Init(&surrogateinjection);
+      LISAGenerateInjectionCAmpPhaseSurrogate(injectedparams, surrogateinjection);
+      fl.set_delayed_acceptance(surrogateinjection);
+      cout<<"Two-stage delayed acceptance with the surrogate likelihood"<<endl;
+    }
+  }
   like = &fl;
   like->defWorkingStateSpace(space);
 
@@ -943,11 +1066,17 @@ int main(int argc, char*argv[]){
   //Set the proposal distribution
   int Ninit;
   proposal_distribution *prop=ptmcmc_sampler::new_proposal_distribution(Npar,Ninit,opt,prior,&halfwidths);
-  cout<<"Proposal distribution is:\n"<<prop->show()<<endl;
   //set up the mcmc sampler (assuming mcmc)
-  //mcmc.setup(Ninit,*like,*prior,*prop,output_precision);
-  mcmc.setup(*like,*prior,output_precision);
-  mcmc.select_proposal();
+  if(fl.delayed_acceptance()){
+    //Stage 1 of the delayed acceptance needs the current state, only seen by the proposal
+    prop=new da_proposal(prop,&fl);
+    cout<<"Proposal distribution is:\n"<<prop->show()<<endl;
+    mcmc.setup(Ninit,*like,*prior,*prop,output_precision);
+  } else {
+    cout<<"Proposal distribution is:\n"<<prop->show()<<endl;
+    mcmc.setup(*like,*prior,output_precision);
+    mcmc.select_proposal();
+  }
 
   //Loop over Nchains
   for(int ic=0;ic<Nchain;ic++){
@@ -961,4 +1090,5 @@ int main(int argc, char*argv[]){
   //Dump summary info
   cout<<"best_post "<<like->bestPost()<<", state="<<like->bestState().get_string()<<endl;
   fl.print_info();
+  if(surrogateinjection)LISAInjectionCAmpPhase_Cleanup(surrogateinjection);
 }
@@ -63,13 +63,12 @@ int main(int argc, char *argv[])
     printf("logL template = %.16e\n", logL);
   }
   else {
-    int nlines = addparams->nlinesparams;
-
-    /* Load parameters file */
+    /* Load parameters file - the lines are counted if nlinesparams is 0 */
     /* Format (same as in the internals): m1, m2, tRef, dist, phase, inc, lambda, beta, pol, loglike, posteriormode */
     /* Assumes not using mmodal */
-    gsl_matrix* inmatrix =  gsl_matrix_alloc(nlines, 10);
-    Read_Text_Matrix(addparams->indir, addparams->infile, inmatrix);
+    gsl_matrix* inmatrix = NULL;
+    if(Read_Text_Table(&inmatrix, addparams->indir, addparams->infile, addparams->nlinesparams, 10)==FAILURE) exit(1);
+    int nlines = (int) inmatrix->size1;
 
     /* Initialize output matrix */
     /* Format (same as in the internals): m1, m2, tRef, dist, phase, inc, lambda, beta, pol, loglike */
@@ -120,6 +119,9 @@ int main(int argc, char *argv[])
     /* Output matrix */
     Write_Text_Matrix(addparams->outdir, addparams->outfile, outmatrix);
 
+    /* Allocation counts over the run - should report no malloc in the last cycle */
+    if(globalparams->tagint==0) ReportLikelihoodArena(stdout);
+
     /* Cleanup */
     free(params);
   }
@@ -1,6 +1,11 @@
 #include "LISAutils.h"
 #include "omp.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 /************ Global Parameters ************/
 
 LISAParams* injectedparams = NULL;
@@ -11,6 +16,12 @@ double logZdata = 0.;
 SimpleLikelihoodPrecomputedValues22* simplelikelihoodinjvals22 = NULL;
 SimpleLikelihoodPrecomputedValuesHM* simplelikelihoodinjvalsHM = NULL;
 
+/* Per-thread arena holding the temporaries of CalculateLogLCAmpPhase - reset at the end of each call */
+/* Initial size is a guess, the arena grows after the first cycles that overflow and then stays put */
+#define LIKELIHOOD_ARENA_SIZE (16*1024*1024)
+static Arena* likelihoodarena = NULL;
+#pragma omp threadprivate(likelihoodarena)
+
 /***************** Pasring string to choose what masses set to sample for *****************/
 
 /* Function to convert string input SampleMassParams to tag */
@@ -43,16 +54,17 @@ void LISASignalCAmpPhase_Cleanup(LISASignalCAmpPhase* signal) {
   if(signal->TDI1Signal) ListmodesCAmpPhaseFrequencySeries_Destroy(signal->TDI1Signal);
   if(signal->TDI2Signal) ListmodesCAmpPhaseFrequencySeries_Destroy(signal->TDI2Signal);
   if(signal->TDI3Signal) ListmodesCAmpPhaseFrequencySeries_Destroy(signal->TDI3Signal);
-  free(signal);
+  ArenaFree(signal);
 }
 
 void LISASignalCAmpPhase_Init(LISASignalCAmpPhase** signal) {
   if(!signal) exit(1);
   /* Create storage for structures */
-  if(!*signal) *signal = malloc(sizeof(LISASignalCAmpPhase));
+  if(!*signal) *signal = ArenaMalloc(sizeof(LISASignalCAmpPhase));
   else
   {
     LISASignalCAmpPhase_Cleanup(*signal);
+    *signal = ArenaMalloc(sizeof(LISASignalCAmpPhase));
   }
   (*signal)->TDI1Signal = NULL;
   (*signal)->TDI2Signal = NULL;
@@ -154,6 +166,14 @@ void InitGlobalParams(void)
   globalparams->responseapprox = full;
   globalparams->tagsimplelikelihood22 = 0;
   globalparams->tagsimplelikelihoodHM = 0;
+  globalparams->tagsimplelikelihoodgrid = 0;
+  globalparams->simplegridnbm1 = 5;
+  globalparams->simplegridnbm2 = 5;
+  globalparams->simplegridnbtRef = 33;
+  globalparams->simplegriddeltam1 = 0.01;
+  globalparams->simplegriddeltam2 = 0.01;
+  globalparams->simplegriddeltatRef = 100.;
+  strcpy(globalparams->simplegridfile, "");
 
   injectedparams = (LISAParams *)malloc(sizeof(LISAParams));
   memset(injectedparams, 0, sizeof(LISAParams));
@@ -221,6 +241,16 @@ Arguments are as follows:\n\
  --responseapprox      Approximation in the GAB and orb response - choices are full (full response, default), lowfL (keep orbital delay frequency-dependence but simplify constellation response) and lowf (simplify constellation and orbital response) - WARNING : at the moment noises are not consistent, and TDI combinations from the GAB are unchanged\n\
  --simplelikelihood22  Tag to use simplified, frozen-LISA and lowf likelihood where mode overlaps are precomputed - 22-mode only - can only be used when the masses and time (tL) are pinned to injection values (Note: when using --snr, distance adjustment done using responseapprox, not the simple response)\n\
  --simplelikelihoodHM  Tag to use simplified, frozen-LISA and lowf likelihood where mode overlaps are precomputed - set of modes - can only be used when the masses and time (tL) are pinned to injection values (Note: when using --snr, distance adjustment done using responseapprox, not the simple response)\n\
+ --simplelikelihoodgrid Tag to tabulate the mode overlaps of --simplelikelihoodHM on a grid of (m1, m2, tRef) nodes around the injection, interpolated at runtime - masses and time need not be pinned, templates outside the grid get a vanishing likelihood (default 0)\n\
+ --simplegridnbm1      Number of grid nodes in m1 (default 5, 1 requires m1 pinned)\n\
+ --simplegridnbm2      Number of grid nodes in m2 (default 5, 1 requires m2 pinned)\n\
+ --simplegridnbtRef    Number of grid nodes in tRef (default 33, 1 requires tRef pinned)\n\
+                       The numbers of nodes are raised if needed to resolve the phase of the overlaps given the SNR, and the run fails if this needs more than 2^20 nodes -\n\
+                       the grid is then checked against overlaps computed directly between the nodes, to 0.1 + 1e-3 |logL|\n\
+ --simplegriddeltam1   Relative half-width of the grid in m1 (default 0.01)\n\
+ --simplegriddeltam2   Relative half-width of the grid in m2 (default 0.01)\n\
+ --simplegriddeltatRef Half-width of the grid in tRef (s, default 100)\n\
+ --simplegridfile      File caching the grid - memory-mapped if compatible with the injection and settings, recomputed and written otherwise (default none)\n\
 \n\
 --------------------------------------------------\n\
 ----- Prior Boundary Settings --------------------\n\
@@ -288,7 +318,7 @@ Syntax: --PARAM-min\n\
 -----------------------------------------------------------------\n\
  --addparams           To be followed by the value of parameters: m1 m2 tRef distance phiRef inclination lambda beta polarization. Used to compute a likelihood for these parameters in LISAlikelihood. Not used in LISAinference.\n\
  --loadparamsfile      Option to load a list of template parameters from file and to output results to file (default false).\n\
- --nlinesparams        Number of lines in input params file.\n\
+ --nlinesparams        Number of lines in input params file (default 0: counted from the file).\n\
  --indir               Input directory when loading input parameters file from file for LISAlikelihood.\n\
  --infile              Input file name when loading input parameters file from file for LISAlikelihood.\n\
  --outdir              Directory for input/output file.\n\
@@ -329,6 +359,14 @@ Syntax: --PARAM-min\n\
     globalparams->responseapprox = full;
     globalparams->tagsimplelikelihood22 = 0;
     globalparams->tagsimplelikelihoodHM = 0;
+    globalparams->tagsimplelikelihoodgrid = 0;
+    globalparams->simplegridnbm1 = 5;
+    globalparams->simplegridnbm2 = 5;
+    globalparams->simplegridnbtRef = 33;
+    globalparams->simplegriddeltam1 = 0.01;
+    globalparams->simplegriddeltam2 = 0.01;
+    globalparams->simplegriddeltatRef = 100.;
+    strcpy(globalparams->simplegridfile, "");
 
     /* set default values for the prior limits */
     prior->samplemassparams = m1m2;
@@ -412,7 +450,7 @@ Syntax: --PARAM-min\n\
     addparams->polarization = 0.;
     /* Note: nbmode used is nbmodetemp from globalparams */
     addparams->loadparamsfile = 0;
-    addparams->nlinesparams = 0;    /* No default; has to be provided */
+    addparams->nlinesparams = 0;    /* Counted from the file if not provided */
     strcpy(addparams->indir, "");   /* No default; has to be provided */
     strcpy(addparams->infile, "");  /* No default; has to be provided */
     strcpy(addparams->outdir, "");  /* No default; has to be provided */
@@ -477,6 +515,22 @@ Syntax: --PARAM-min\n\
             globalparams->tagsimplelikelihood22 = 1;
         } else if (strcmp(argv[i], "--simplelikelihoodHM") == 0) {
             globalparams->tagsimplelikelihoodHM = 1;
+        } else if (strcmp(argv[i], "--simplelikelihoodgrid") == 0) {
+            globalparams->tagsimplelikelihoodgrid = 1;
+        } else if (strcmp(argv[i], "--simplegridnbm1") == 0) {
+            globalparams->simplegridnbm1 = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--simplegridnbm2") == 0) {
+            globalparams->simplegridnbm2 = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--simplegridnbtRef") == 0) {
+            globalparams->simplegridnbtRef = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--simplegriddeltam1") == 0) {
+            globalparams->simplegriddeltam1 = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--simplegriddeltam2") == 0) {
+            globalparams->simplegriddeltam2 = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--simplegriddeltatRef") == 0) {
+            globalparams->simplegriddeltatRef = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--simplegridfile") == 0) {
+            strcpy(globalparams->simplegridfile, argv[++i]);
         } else if (strcmp(argv[i], "--samplemassparams") == 0) {
             prior->samplemassparams = ParseSampleMassParamstag(argv[++i]);
         } else if (strcmp(argv[i], "--sampletimeparam") == 0) {
@@ -669,12 +723,27 @@ Syntax: --PARAM-min\n\
     }
     /* If using the simplified likelihood, make sure that the masses and time are pinned to injection values - otherwise inconsistent */
     /* NOTE: slight inconsistency,  */
-    if(globalparams->tagsimplelikelihood22 || globalparams->tagsimplelikelihoodHM) {
+    /* The grid tabulation lifts this restriction, except for the directions where the grid has a single node */
+    if(globalparams->tagsimplelikelihoodgrid && !globalparams->tagsimplelikelihoodHM) {
+      printf("Error in parse_args_LISA: using tag simplelikelihoodgrid without simplelikelihoodHM - inconsistent.");
+      exit(1);
+    }
+    if((globalparams->tagsimplelikelihood22 || globalparams->tagsimplelikelihoodHM) && !globalparams->tagsimplelikelihoodgrid) {
       if((priorParams->pin_m1==0) || (priorParams->pin_m2==0) || (priorParams->pin_time==0)) {
         printf("Error in parse_args_LISA: using simplified likelihood while m1, m2 or tRef is not pinned to injection value - inconsistent.");
         exit(1);
       }
     }
+    if(globalparams->tagsimplelikelihoodgrid) {
+      if(globalparams->simplegridnbm1<1 || globalparams->simplegridnbm2<1 || globalparams->simplegridnbtRef<1) {
+        printf("Error in parse_args_LISA: simplified likelihood grid needs at least one node in each direction.");
+        exit(1);
+      }
+      if(((globalparams->simplegridnbm1==1) && (priorParams->pin_m1==0)) || ((globalparams->simplegridnbm2==1) && (priorParams->pin_m2==0)) || ((globalparams->simplegridnbtRef==1) && (priorParams->pin_time==0))) {
+        printf("Error in parse_args_LISA: simplified likelihood grid with a single node for m1, m2 or tRef not pinned to injection value - inconsistent.");
+        exit(1);
+      }
+    }
 
     return;
 }
@@ -748,6 +817,16 @@ int print_parameters_to_file_LISA(
   fprintf(f, "responseapprox: %d\n", globalparams->responseapprox);
   fprintf(f, "simplelikelihood22: %d\n", globalparams->tagsimplelikelihood22);
   fprintf(f, "simplelikelihoodHM: %d\n", globalparams->tagsimplelikelihoodHM);
+  fprintf(f, "simplelikelihoodgrid: %d\n", globalparams->tagsimplelikelihoodgrid);
+  if(globalparams->tagsimplelikelihoodgrid) {
+    fprintf(f, "simplegridnbm1:      %d\n", globalparams->simplegridnbm1);
+    fprintf(f, "simplegridnbm2:      %d\n", globalparams->simplegridnbm2);
+    fprintf(f, "simplegridnbtRef:    %d\n", globalparams->simplegridnbtRef);
+    fprintf(f, "simplegriddeltam1:   %.16e\n", globalparams->simplegriddeltam1);
+    fprintf(f, "simplegriddeltam2:   %.16e\n", globalparams->simplegriddeltam2);
+    fprintf(f, "simplegriddeltatRef: %.16e\n", globalparams->simplegriddeltatRef);
+    fprintf(f, "simplegridfile:      %s\n", globalparams->simplegridfile);
+  }
   fprintf(f, "-----------------------------------------------\n");
   fprintf(f, "\n");
 
@@ -926,6 +1005,45 @@ int listmodesCAmpPhaseTrim(ListmodesCAmpPhaseFrequencySeries* listSeries){
 int LISAGenerateSignalCAmpPhase(
   struct tagLISAParams* params,            /* Input: set of LISA parameters of the signal */
   struct tagLISASignalCAmpPhase* signal)   /* Output: structure for the generated signal */
+{
+  return LISAGenerateSignalCAmpPhaseResponse(params, signal, globalparams->frozenLISA, globalparams->responseapprox);
+}
+
+/* Same as LISAGenerateSignalCAmpPhase, with the approximations for the response given explicitly instead of read from globalparams */
+int LISAGenerateSignalCAmpPhaseResponse(
+  struct tagLISAParams* params,            /* Input: set of LISA parameters of the signal */
+  struct tagLISASignalCAmpPhase* signal,   /* Output: structure for the generated signal */
+  int frozenLISA,                          /* Input: tag for treating LISA as frozen at its position at tRef */
+  ResponseApproxtag responseapprox)        /* Input: approximation used in the response (full, lowfL, lowf) */
+{
+  /* Checking that the global injectedparams has been set up */
+  if (!injectedparams) {
+    printf("Error: when calling LISAGenerateSignal, injectedparams points to NULL.\n");
+    exit(1);
+  }
+  return LISAGenerateSignalCAmpPhaseRefTime(params, signal, injectedparams->tRef, frozenLISA, responseapprox);
+}
+
+/* Same as LISAGenerateSignalCAmpPhaseResponse, with the reference time of the injection given explicitly */
+int LISAGenerateSignalCAmpPhaseRefTime(
+  struct tagLISAParams* params,            /* Input: set of LISA parameters of the signal */
+  struct tagLISASignalCAmpPhase* signal,   /* Output: structure for the generated signal */
+  double tRefinj,                          /* Input: reference time of the injection, the ROM is shifted by params->tRef - tRefinj */
+  int frozenLISA,                          /* Input: tag for treating LISA as frozen at its position at tRef */
+  ResponseApproxtag responseapprox)        /* Input: approximation used in the response (full, lowfL, lowf) */
+{
+  LISAGlobalParams settings = *globalparams;
+  settings.frozenLISA = frozenLISA;
+  settings.responseapprox = responseapprox;
+  return LISAGenerateSignalCAmpPhaseSettings(params, signal, tRefinj, &settings);
+}
+
+/* Same as LISAGenerateSignalCAmpPhaseRefTime, with all the settings given explicitly - does not read any global variable */
+int LISAGenerateSignalCAmpPhaseSettings(
+  struct tagLISAParams* params,            /* Input: set of LISA parameters of the signal */
+  struct tagLISASignalCAmpPhase* signal,   /* Output: structure for the generated signal */
+  double tRefinj,                          /* Input: reference time of the injection, the ROM is shifted by params->tRef - tRefinj */
+  const LISAGlobalParams* settings)        /* Input: settings of the generation, in place of globalparams */
 {
   //
   //printf("in LISAGenerateSignalCAmpPhase: tRef= %g\n", params->tRef);
@@ -936,26 +1054,20 @@ int LISAGenerateSignalCAmpPhase(
   ListmodesCAmpPhaseFrequencySeries* listTDI2 = NULL;
   ListmodesCAmpPhaseFrequencySeries* listTDI3 = NULL;
 
-  /* Checking that the global injectedparams has been set up */
-  if (!injectedparams) {
-    printf("Error: when calling LISAGenerateSignal, injectedparams points to NULL.\n");
-    exit(1);
-  }
-
   /* Starting frequency corresponding to duration of observation deltatobs */
   double fstartobs = 0.;
-  if(!(globalparams->deltatobs==0.)) fstartobs = Newtonianfoft(params->m1, params->m2, globalparams->deltatobs);
+  if(!(settings->deltatobs==0.)) fstartobs = Newtonianfoft(params->m1, params->m2, settings->deltatobs);
 
   /* Generate the waveform with the ROM */
   /* NOTE: SimEOBNRv2HMROM accepts masses and distances in SI units, whereas LISA params is in solar masses and Mpc */
   /* NOTE: minf and deltatobs are taken into account if extension is allowed, but not maxf - restriction to the relevant frequency interval will occur in both the response prcessing and overlap computation */
   /* If extending, taking into account both fstartobs and minf */
-  if(!(globalparams->tagextpn)) {
-    //printf("Not Extending signal waveform.  Mfmatch=%g\n",globalparams->Mfmatch);
-    ret = SimEOBNRv2HMROM(&listROM, params->nbmode, params->tRef - injectedparams->tRef, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
+  if(!(settings->tagextpn)) {
+    //printf("Not Extending signal waveform.  Mfmatch=%g\n",settings->Mfmatch);
+    ret = SimEOBNRv2HMROM(&listROM, params->nbmode, params->tRef - tRefinj, params->phiRef, settings->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, settings->setphiRefatfRef);
   } else {
-    //printf("Extending signal waveform.  Mfmatch=%g\n",globalparams->Mfmatch);
-    ret = SimEOBNRv2HMROMExtTF2(&listROM, params->nbmode, globalparams->Mfmatch, fmax(fstartobs, globalparams->minf), 0, params->tRef - injectedparams->tRef, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
+    //printf("Extending signal waveform.  Mfmatch=%g\n",settings->Mfmatch);
+    ret = SimEOBNRv2HMROMExtTF2(&listROM, params->nbmode, settings->Mfmatch, fmax(fstartobs, settings->minf), 0, params->tRef - tRefinj, params->phiRef, settings->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, settings->setphiRefatfRef);
   }
   if(ret==FAILURE){
     //printf("LISAGenerateSignalCAmpPhase: Generation of ROM for injection failed!\n");
@@ -986,7 +1098,7 @@ int LISAGenerateSignalCAmpPhase(
     listelem=listelem->next;
   }*/
   //
-  //printf("%d|%g|%g|%g|%g|%g|%g\n", params->nbmode, params->tRef - injectedparams->tRef, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI);
+  //printf("%d|%g|%g|%g|%g|%g|%g\n", params->nbmode, params->tRef - tRefinj, params->phiRef, settings->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI);
 
   /* If the ROM waveform generation failed (e.g. parameters were out of bounds) return FAILURE */
   if(ret==FAILURE) return FAILURE;
@@ -998,7 +1110,7 @@ int LISAGenerateSignalCAmpPhase(
   //tbeg = clock();
 
   //#pragma omp critical(LISAgensig)
-  LISASimFDResponseTDI3Chan(globalparams->tagtRefatLISA, globalparams->variant, &listROM, &listTDI1, &listTDI2, &listTDI3, params->tRef, params->lambda, params->beta, params->inclination, params->polarization, params->m1, params->m2, globalparams->maxf, globalparams->tagtdi, globalparams->frozenLISA, globalparams->responseapprox);
+  LISASimFDResponseTDI3Chan(settings->tagtRefatLISA, settings->variant, &listROM, &listTDI1, &listTDI2, &listTDI3, params->tRef, params->lambda, params->beta, params->inclination, params->polarization, params->m1, params->m2, settings->maxf, settings->tagtdi, settings->frozenLISA, settings->responseapprox);
   //tend = clock();
   //printf("time LISASimFDResponse: %g\n", (double) (tend-tbeg)/CLOCKS_PER_SEC);
   //exit(0);
@@ -1013,11 +1125,11 @@ int LISAGenerateSignalCAmpPhase(
   BuildListmodesCAmpPhaseSpline(&listsplinesgen3, listTDI3);
 
   /* Precompute the inner product (h|h) - takes into account the length of the observation with deltatobs */
-  double fLow = fmax(__LISASimFD_Noise_fLow, globalparams->minf);
-  double fHigh = fmin(__LISASimFD_Noise_fHigh, globalparams->maxf);
-  ObjectFunction NoiseSn1 = NoiseFunction(globalparams->variant,globalparams->tagtdi, 1);
-  ObjectFunction NoiseSn2 = NoiseFunction(globalparams->variant,globalparams->tagtdi, 2);
-  ObjectFunction NoiseSn3 = NoiseFunction(globalparams->variant,globalparams->tagtdi, 3);
+  double fLow = fmax(__LISASimFD_Noise_fLow, settings->minf);
+  double fHigh = fmin(__LISASimFD_Noise_fHigh, settings->maxf);
+  ObjectFunction NoiseSn1 = NoiseFunction(settings->variant,settings->tagtdi, 1);
+  ObjectFunction NoiseSn2 = NoiseFunction(settings->variant,settings->tagtdi, 2);
+  ObjectFunction NoiseSn3 = NoiseFunction(settings->variant,settings->tagtdi, 3);
   //TESTING
   //tbeg = clock();
   double TDI123hh = FDListmodesFresnelOverlap3Chan(listTDI1, listTDI2, listTDI3, listsplinesgen1, listsplinesgen2, listsplinesgen3, &NoiseSn1, &NoiseSn2, &NoiseSn3, fLow, fHigh, fstartobs, fstartobs);
@@ -1043,6 +1155,22 @@ int LISAGenerateSignalCAmpPhase(
 int LISAGenerateInjectionCAmpPhase(
   struct tagLISAParams* params,       /* Input: set of LISA parameters of the signal */
   struct tagLISAInjectionCAmpPhase* signal)   /* Output: structure for the injected signal */
+{
+  /* Checking that the global injectedparams has been set up */
+  if (!injectedparams) {
+    printf("Error: when calling LISAGenerateInjectionCAmpPhase, injectedparams points to NULL.\n");
+    exit(1);
+  }
+  return LISAGenerateInjectionCAmpPhaseResponse(params, signal, injectedparams->tRef, globalparams->frozenLISA, globalparams->responseapprox);
+}
+
+/* Same as LISAGenerateInjectionCAmpPhase, with the reference time and the approximations for the response given explicitly instead of read from injectedparams and globalparams */
+int LISAGenerateInjectionCAmpPhaseResponse(
+  struct tagLISAParams* params,              /* Input: set of LISA parameters of the signal */
+  struct tagLISAInjectionCAmpPhase* signal,  /* Output: structure for the injected signal */
+  double tRefinj,                            /* Input: reference time of the injection, the ROM is shifted by params->tRef - tRefinj */
+  int frozenLISA,                            /* Input: tag for treating LISA as frozen at its position at tRef */
+  ResponseApproxtag responseapprox)          /* Input: approximation used in the response (full, lowfL, lowf) */
 {
   int ret;
   ListmodesCAmpPhaseFrequencySeries* listROM = NULL;
@@ -1058,12 +1186,13 @@ int LISAGenerateInjectionCAmpPhase(
   /* NOTE: SimEOBNRv2HMROM accepts masses and distances in SI units, whereas LISA params is in solar masses and Mpc */
   /* NOTE: minf and deltatobs are taken into account if extension is allowed, but not maxf - restriction to the relevant frequency interval will occur in both the response prcessing and overlap computation */
   /* If extending, taking into account both fstartobs and minf */
+  /* NOTE: the reference time tRefinj is given explicitly - the global injectedparams is not read, so that injections with different reference times can be generated concurrently */
   if(!(globalparams->tagextpn)) {
     //printf("Not Extending signal waveform.  Mfmatch=%g\n",globalparams->Mfmatch);
-    ret = SimEOBNRv2HMROM(&listROM, params->nbmode, params->tRef - injectedparams->tRef, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
+    ret = SimEOBNRv2HMROM(&listROM, params->nbmode, params->tRef - tRefinj, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
   } else {
     //printf("Extending signal waveform.  Mfmatch=%g\n",globalparams->Mfmatch);
-    ret = SimEOBNRv2HMROMExtTF2(&listROM, params->nbmode, globalparams->Mfmatch, fmax(fstartobs, globalparams->minf), 0, params->tRef - injectedparams->tRef, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
+    ret = SimEOBNRv2HMROMExtTF2(&listROM, params->nbmode, globalparams->Mfmatch, fmax(fstartobs, globalparams->minf), 0, params->tRef - tRefinj, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
   }
   /* If the ROM waveform generation failed (e.g. parameters were out of bounds) return FAILURE */
   if(ret==FAILURE){
@@ -1095,7 +1224,7 @@ int LISAGenerateInjectionCAmpPhase(
   //TESTING
   //clock_t tbeg, tend;
   //tbeg = clock();
-  LISASimFDResponseTDI3Chan(globalparams->tagtRefatLISA, globalparams->variant, &listROM, &listTDI1, &listTDI2, &listTDI3, injectedparams->tRef, params->lambda, params->beta, params->inclination, params->polarization, params->m1, params->m2, globalparams->maxf, globalparams->tagtdi, globalparams->frozenLISA, globalparams->responseapprox);
+  LISASimFDResponseTDI3Chan(globalparams->tagtRefatLISA, globalparams->variant, &listROM, &listTDI1, &listTDI2, &listTDI3, tRefinj, params->lambda, params->beta, params->inclination, params->polarization, params->m1, params->m2, globalparams->maxf, globalparams->tagtdi, frozenLISA, responseapprox);
   //tend = clock();
   //printf("time LISASimFDResponse: %g\n", (double) (tend-tbeg)/CLOCKS_PER_SEC);
   //
@@ -1141,17 +1270,26 @@ int LISAGenerateSignalReIm(
   gsl_vector* freq,                   /* Input: frequencies on which evaluating the waveform (from the injection) */
   struct tagLISASignalReIm* signal)   /* Output: structure for the generated signal */
 {
-  int ret;
-  ListmodesCAmpPhaseFrequencySeries* listROM = NULL;
-  ListmodesCAmpPhaseFrequencySeries* listTDI1 = NULL;
-  ListmodesCAmpPhaseFrequencySeries* listTDI2 = NULL;
-  ListmodesCAmpPhaseFrequencySeries* listTDI3 = NULL;
-
   /* Checking that the global injectedparams has been set up */
   if (!injectedparams) {
     printf("Error: when calling LISAGenerateSignalReIm, injectedparams points to NULL.\n");
     exit(1);
   }
+  return LISAGenerateSignalReImRefTime(params, freq, signal, injectedparams->tRef);
+}
+
+/* Same as LISAGenerateSignalReIm, with the reference time of the injection given explicitly instead of read from injectedparams */
+int LISAGenerateSignalReImRefTime(
+  struct tagLISAParams* params,       /* Input: set of LISA parameters of the template */
+  gsl_vector* freq,                   /* Input: frequencies on which evaluating the waveform (from the injection) */
+  struct tagLISASignalReIm* signal,   /* Output: structure for the generated signal */
+  double tRefinj)                     /* Input: reference time of the injection, the ROM is shifted by params->tRef - tRefinj */
+{
+  int ret;
+  ListmodesCAmpPhaseFrequencySeries* listROM = NULL;
+  ListmodesCAmpPhaseFrequencySeries* listTDI1 = NULL;
+  ListmodesCAmpPhaseFrequencySeries* listTDI2 = NULL;
+  ListmodesCAmpPhaseFrequencySeries* listTDI3 = NULL;
 
   /* Starting frequency corresponding to duration of observation deltatobs */
   double fstartobs = 0.;
@@ -1163,10 +1301,10 @@ int LISAGenerateSignalReIm(
   /* If extending, taking into account both fstartobs and minf */
   if(!(globalparams->tagextpn)) {
     //printf("Not Extending signal waveform.  Mfmatch=%g\n",globalparams->Mfmatch);
-    ret = SimEOBNRv2HMROM(&listROM, params->nbmode, params->tRef - injectedparams->tRef, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
+    ret = SimEOBNRv2HMROM(&listROM, params->nbmode, params->tRef - tRefinj, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
   } else {
     //printf("Extending signal waveform.  Mfmatch=%g\n",globalparams->Mfmatch);
-    ret = SimEOBNRv2HMROMExtTF2(&listROM, params->nbmode, globalparams->Mfmatch, fmax(fstartobs, globalparams->minf), 0, params->tRef - injectedparams->tRef, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
+    ret = SimEOBNRv2HMROMExtTF2(&listROM, params->nbmode, globalparams->Mfmatch, fmax(fstartobs, globalparams->minf), 0, params->tRef - tRefinj, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
   }
 
   /* If the ROM waveform generation failed (e.g. parameters were out of bounds) return FAILURE */
@@ -1179,7 +1317,7 @@ int LISAGenerateSignalReIm(
   //TESTING
   //clock_t tbeg, tend;
   //tbeg = clock();
-  LISASimFDResponseTDI3Chan(globalparams->tagtRefatLISA, globalparams->variant, &listROM, &listTDI1, &listTDI2, &listTDI3, injectedparams->tRef, params->lambda, params->beta, params->inclination, params->polarization, params->m1, params->m2, globalparams->maxf, globalparams->tagtdi, globalparams->frozenLISA, globalparams->responseapprox);
+  LISASimFDResponseTDI3Chan(globalparams->tagtRefatLISA, globalparams->variant, &listROM, &listTDI1, &listTDI2, &listTDI3, tRefinj, params->lambda, params->beta, params->inclination, params->polarization, params->m1, params->m2, globalparams->maxf, globalparams->tagtdi, globalparams->frozenLISA, globalparams->responseapprox);
   //tend = clock();
   //printf("time LISASimFDResponse: %g\n", (double) (tend-tbeg)/CLOCKS_PER_SEC);
   //
@@ -1224,6 +1362,23 @@ int LISAGenerateInjectionReIm(
   int nbpts,                                 /* Input: number of frequency samples */
   int tagsampling,                           /* Input: tag for using linear (0) or logarithmic (1) sampling */
   struct tagLISAInjectionReIm* injection)    /* Output: structure for the generated signal */
+{
+  /* Checking that the global injectedparams has been set up */
+  if (!injectedparams) {
+    printf("Error: when calling LISAGenerateInjectionReIm, injectedparams points to NULL.\n");
+    exit(1);
+  }
+  return LISAGenerateInjectionReImRefTime(params, fLow, nbpts, tagsampling, injection, injectedparams->tRef);
+}
+
+/* Same as LISAGenerateInjectionReIm, with the reference time given explicitly instead of read from injectedparams */
+int LISAGenerateInjectionReImRefTime(
+  struct tagLISAParams* params,              /* Input: set of LISA parameters of the template */
+  double fLow,                               /* Input: additional lower frequency limit (argument minf) */
+  int nbpts,                                 /* Input: number of frequency samples */
+  int tagsampling,                           /* Input: tag for using linear (0) or logarithmic (1) sampling */
+  struct tagLISAInjectionReIm* injection,    /* Output: structure for the generated signal */
+  double tRefinj)                            /* Input: reference time of the injection, the ROM is shifted by params->tRef - tRefinj */
 {
   int ret;
   ListmodesCAmpPhaseFrequencySeries* listROM = NULL;
@@ -1239,12 +1394,13 @@ int LISAGenerateInjectionReIm(
   /* NOTE: SimEOBNRv2HMROM accepts masses and distances in SI units, whereas LISA params is in solar masses and Mpc */
   /* NOTE: minf and deltatobs are taken into account if extension is allowed, but not maxf - restriction to the relevant frequency interval will occur in both the response prcessing and overlap computation */
   /* If extending, taking into account both fstartobs and minf */
+  /* NOTE: the reference time tRefinj is given explicitly - the global injectedparams is not read, so that injections with different reference times can be generated concurrently */
   if(!(globalparams->tagextpn)) {
     //printf("Not Extending signal waveform.  Mfmatch=%g\n",globalparams->Mfmatch);
-    ret = SimEOBNRv2HMROM(&listROM, params->nbmode, params->tRef - injectedparams->tRef, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
+    ret = SimEOBNRv2HMROM(&listROM, params->nbmode, params->tRef - tRefinj, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
   } else {
     //printf("Extending signal waveform.  Mfmatch=%g\n",globalparams->Mfmatch);
-    ret = SimEOBNRv2HMROMExtTF2(&listROM, params->nbmode, globalparams->Mfmatch, fmax(fstartobs, globalparams->minf), 0, params->tRef - injectedparams->tRef, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
+    ret = SimEOBNRv2HMROMExtTF2(&listROM, params->nbmode, globalparams->Mfmatch, fmax(fstartobs, globalparams->minf), 0, params->tRef - tRefinj, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
   }
 
   /* If the ROM waveform generation failed (e.g. parameters were out of bounds) return FAILURE */
@@ -1260,7 +1416,7 @@ int LISAGenerateInjectionReIm(
   //TESTING
   //clock_t tbeg, tend;
   //tbeg = clock();
-  LISASimFDResponseTDI3Chan(globalparams->tagtRefatLISA, globalparams->variant, &listROM, &listTDI1, &listTDI2, &listTDI3, params->tRef, params->lambda, params->beta, params->inclination, params->polarization, params->m1, params->m2, globalparams->maxf, globalparams->tagtdi, globalparams->frozenLISA, globalparams->responseapprox);
+  LISASimFDResponseTDI3Chan(globalparams->tagtRefatLISA, globalparams->variant, &listROM, &listTDI1, &listTDI2, &listTDI3, tRefinj, params->lambda, params->beta, params->inclination, params->polarization, params->m1, params->m2, globalparams->maxf, globalparams->tagtdi, globalparams->frozenLISA, globalparams->responseapprox);
   //tend = clock();
   //printf("time LISASimFDResponse: %g\n", (double) (tend-tbeg)/CLOCKS_PER_SEC);
   //
@@ -1420,6 +1576,9 @@ double CalculateLogLSimpleLikelihood22(SimpleLikelihoodPrecomputedValues22* simp
 
 double CalculateLogLSimpleLikelihoodHM(SimpleLikelihoodPrecomputedValuesHM* simplelikelihoodvalsHM, LISAParams* params)
 {
+  /* Masses and time free, overlaps interpolated on the grid */
+  if(simplelikelihoodvalsHM->grid) return CalculateLogLSimpleLikelihoodGridHM(simplelikelihoodvalsHM->grid, params);
+
   /* Modes in the injection and the modes in the template have to be the same because of the precomputed overlaps */
   if ( !((params->nbmode)==(injectedparams->nbmode)) ) {
     printf("Error in CalculateLogLSimpleLikelihoodHM: nbmode in injection and template must be the same.\n");
@@ -1486,18 +1645,152 @@ double CalculateLogLSimpleLikelihoodHM(SimpleLikelihoodPrecomputedValuesHM* simp
   return simplelogL;
 }
 
+/* Interpolation stencil along one direction of a uniform grid: 4-point Lagrange if at least 4 nodes, linear if 2 or 3 nodes */
+/* A single node only accepts x at that node */
+/* Returns the number of points in the stencil starting at index istart, 0 if x is outside the grid */
+static int SimpleLikelihoodGridStencil(int* istart, double* w, double x, double xmin, double xmax, int n)
+{
+  if(n==1) {
+    if(!(x==xmin)) return 0;
+    *istart = 0;
+    w[0] = 1.;
+    return 1;
+  }
+  if(!(x>=xmin && x<=xmax)) return 0;
+  double u = (x - xmin) / (xmax - xmin) * (n - 1);
+  int k = min((int) floor(u), n-2);
+  if(n<4) {
+    double t = u - k;
+    *istart = k;
+    w[0] = 1. - t;
+    w[1] = t;
+    return 2;
+  }
+  int i0 = max(0, min(k-1, n-4));
+  double t = u - i0;
+  *istart = i0;
+  w[0] = -(t-1)*(t-2)*(t-3)/6.;
+  w[1] = t*(t-2)*(t-3)/2.;
+  w[2] = -t*(t-1)*(t-3)/2.;
+  w[3] = t*(t-1)*(t-2)/6.;
+  return 4;
+}
+
+/* -1/2 (h-s|h-s) for the template params, from the overlaps <hlm|hl'm'>, <hlm|kl'm'> and <klm|kl'm'> at its masses and time, and the injection s_a^{lm}, s_e^{lm} */
+static double SimpleLikelihoodGridLogL(int nbmode, double complex* Lambda_temp, double complex* Lambda_cross, double complex* Lambda_inj, double complex* sinj_lm, LISAParams* params)
+{
+  /* Compute set of sa_lm and se_lm for template - the tabulated modes have the injection distance */
+  double phiL = funcphiL(params);
+  double lambdL = funclambdaL(params);
+  double betaL = funcbetaL(params);
+  double psiL = funcpsiL(params);
+  double inc = params->inclination;
+  double d = params->distance / injectedparams->distance;
+  double complex sa_lm[nbmode];
+  double complex se_lm[nbmode];
+  for(int i=0; i<nbmode; i++) {
+    sa_lm[i] = funcsa_lm(listmode[i][0], listmode[i][1], d, phiL, inc, lambdL, betaL, psiL);
+    se_lm[i] = funcse_lm(listmode[i][0], listmode[i][1], d, phiL, inc, lambdL, betaL, psiL);
+  }
+  double complex* sa_lm_inj = sinj_lm;
+  double complex* se_lm_inj = sinj_lm + nbmode;
+
+  /* Sum over pairs of modes - the hermitian symmetry of the overlaps makes (h|h) and (s|s) real */
+  double complex hh = 0., hs = 0., ss = 0.;
+  for(int i=0; i<nbmode; i++) {
+    for(int j=0; j<nbmode; j++) {
+      hh += (sa_lm[i]*conj(sa_lm[j]) + se_lm[i]*conj(se_lm[j])) * Lambda_temp[i*nbmode+j];
+      hs += (sa_lm[i]*conj(sa_lm_inj[j]) + se_lm[i]*conj(se_lm_inj[j])) * Lambda_cross[i*nbmode+j];
+      ss += (sa_lm_inj[i]*conj(sa_lm_inj[j]) + se_lm_inj[i]*conj(se_lm_inj[j])) * Lambda_inj[i*nbmode+j];
+    }
+  }
+
+  return -1./2 * (creal(hh) + creal(ss) - 2*creal(hs));
+}
+
+/* Simplified HM likelihood with the overlaps interpolated in (m1, m2, tRef) - frozen LISA, lowf */
+/* -1/2 (h-s|h-s) with (h|h), (h|s), (s|s) built from the tabulated <hlm|hl'm'>, <hlm|kl'm'>, <klm|kl'm'> */
+/* Templates outside the grid, or depending on nodes where the waveform generation failed, get -DBL_MAX */
+double CalculateLogLSimpleLikelihoodGridHM(SimpleLikelihoodPrecomputedGridHM* grid, LISAParams* params)
+{
+  int nbmode = grid->nbmode;
+  int nb2 = nbmode*nbmode;
+  if ( !((params->nbmode)==nbmode) ) {
+    printf("Error in CalculateLogLSimpleLikelihoodGridHM: nbmode in grid and template must be the same.\n");
+    exit(1);
+  }
+
+  /* Interpolation stencils */
+  int i1, i2, it;
+  double w1[4], w2[4], wt[4];
+  int n1 = SimpleLikelihoodGridStencil(&i1, w1, params->m1, grid->m1min, grid->m1max, grid->nbm1);
+  int n2 = SimpleLikelihoodGridStencil(&i2, w2, params->m2, grid->m2min, grid->m2max, grid->nbm2);
+  int nt = SimpleLikelihoodGridStencil(&it, wt, params->tRef, grid->tRefmin, grid->tRefmax, grid->nbtRef);
+  if(n1==0 || n2==0 || nt==0) return -DBL_MAX;
+
+  /* Interpolate the overlaps */
+  double complex Lambda_temp[nb2];
+  double complex Lambda_cross[nb2];
+  for(int k=0; k<nb2; k++) {
+    Lambda_temp[k] = 0.;
+    Lambda_cross[k] = 0.;
+  }
+  for(int a=0; a<n1; a++) {
+    for(int b=0; b<n2; b++) {
+      int nodem = (i1+a)*grid->nbm2 + (i2+b);
+      double wab = w1[a]*w2[b];
+      double complex* Lt = grid->Lambda_temp + nodem*nb2;
+      for(int k=0; k<nb2; k++) Lambda_temp[k] += wab*Lt[k];
+      for(int c=0; c<nt; c++) {
+        double w = wab*wt[c];
+        double complex* Lc = grid->Lambda_cross + (nodem*grid->nbtRef + it+c)*nb2;
+        for(int k=0; k<nb2; k++) Lambda_cross[k] += w*Lc[k];
+      }
+    }
+  }
+  if(isnan(creal(Lambda_temp[0])) || isnan(creal(Lambda_cross[0]))) return -DBL_MAX;
+
+  return SimpleLikelihoodGridLogL(nbmode, Lambda_temp, Lambda_cross, grid->Lambda_inj, grid->sinj_lm, params);
+}
+
 double CalculateLogLCAmpPhase(LISAParams *params, LISAInjectionCAmpPhase* injection)
+{
+  return CalculateLogLCAmpPhaseResponse(params, injection, globalparams->frozenLISA, globalparams->responseapprox);
+}
+
+/* Cheap surrogate for CalculateLogLCAmpPhase: 22 mode only, frozen-LISA and lowf response */
+/* The injection passed has to be generated with the same approximations, see LISAGenerateInjectionCAmpPhaseSurrogate */
+double CalculateLogLCAmpPhaseSurrogate(LISAParams *params, LISAInjectionCAmpPhase* surrogateinjection)
+{
+  LISAParams surrogateparams = *params;
+  surrogateparams.nbmode = 1;
+  return CalculateLogLCAmpPhaseResponse(&surrogateparams, surrogateinjection, 1, lowf);
+}
+
+/* Injection matching CalculateLogLCAmpPhaseSurrogate: 22 mode only, frozen-LISA and lowf response */
+int LISAGenerateInjectionCAmpPhaseSurrogate(LISAParams *params, LISAInjectionCAmpPhase* surrogateinjection)
+{
+  LISAParams surrogateparams = *params;
+  surrogateparams.nbmode = 1;
+  return LISAGenerateInjectionCAmpPhaseResponse(&surrogateparams, surrogateinjection, injectedparams->tRef, 1, lowf);
+}
+
+double CalculateLogLCAmpPhaseResponse(LISAParams *params, LISAInjectionCAmpPhase* injection, int frozenLISA, ResponseApproxtag responseapprox)
 {
   double logL = -DBL_MAX;
   int ret;
 
+  /* All the temporaries below are drawn from the arena of this thread, released at once at the end */
+  if(!likelihoodarena) Arena_Init(&likelihoodarena, LIKELIHOOD_ARENA_SIZE);
+  Arena* previousarena = Arena_Bind(likelihoodarena);
+
   /* Generating the signal in the three detectors for the input parameters */
   LISASignalCAmpPhase* generatedsignal = NULL;
   LISASignalCAmpPhase_Init(&generatedsignal);
   //TESTING
   //clock_t tbeg, tend;
   //tbeg = clock();
-  ret = LISAGenerateSignalCAmpPhase(params, generatedsignal);
+  ret = LISAGenerateSignalCAmpPhaseResponse(params, generatedsignal, frozenLISA, responseapprox);
   //tend = clock();
   //printf("time GenerateSignal: %g\n", (double) (tend-tbeg)/CLOCKS_PER_SEC);
   //
@@ -1539,10 +1832,21 @@ double CalculateLogLCAmpPhase(LISAParams *params, LISAInjectionCAmpPhase* inject
   }
   /* Clean up */
   LISASignalCAmpPhase_Cleanup(generatedsignal);
+  Arena_Reset(likelihoodarena);
+  Arena_Bind(previousarena);
 
   return logL;
 }
 
+void ReportLikelihoodArena(FILE* f)
+{
+  if(!likelihoodarena) {
+    fprintf(f, "Arena: not used by this thread.\n");
+    return;
+  }
+  Arena_Report(f, likelihoodarena);
+}
+
 double CalculateLogLReIm(LISAParams *params, LISAInjectionReIm* injection)
 {
   double logL = -DBL_MAX;
@@ -1866,6 +2170,47 @@ int LISAComputeSimpleLikelihoodPrecomputedValues22(SimpleLikelihoodPrecomputedVa
 
   return(SUCCESS);
 }
+/* Generate the modes hlm for the simplified likelihood, with amplitudes multiplied by 3L/2 * 2pi f / c - new convention */
+/* Same fstartobs and PN extension as in the GenerateInjectionCAmpPhase function */
+static int SimpleLikelihoodGenerateWeightedModes(ListmodesCAmpPhaseFrequencySeries** listROM, LISAParams* params)
+{
+  int ret;
+  /* Starting frequency corresponding to duration of observation deltatobs */
+  double fstartobs = 0.;
+  if(!(globalparams->deltatobs==0.)) fstartobs = Newtonianfoft(params->m1, params->m2, globalparams->deltatobs);
+  /* Generate the waveform with the ROM */
+  /* NOTE: SimEOBNRv2HMROM accepts masses and distances in SI units, whereas LISA params is in solar masses and Mpc */
+  /* NOTE: minf and deltatobs are taken into account if extension is allowed, but not maxf - restriction to the relevant frequency interval will occur in both the response prcessing and overlap computation */
+  /* If extending, taking into account both fstartobs and minf */
+  if(!(globalparams->tagextpn)) {
+    //printf("Not Extending signal waveform.  Mfmatch=%g\n",globalparams->Mfmatch);
+    ret = SimEOBNRv2HMROM(listROM, params->nbmode, params->tRef - injectedparams->tRef, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
+  } else {
+    //printf("Extending signal waveform.  Mfmatch=%g\n",globalparams->Mfmatch);
+    ret = SimEOBNRv2HMROMExtTF2(listROM, params->nbmode, globalparams->Mfmatch, fmax(fstartobs, globalparams->minf), 0, params->tRef - injectedparams->tRef, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
+  }
+  /* If the ROM waveform generation failed (e.g. parameters were out of bounds) return FAILURE */
+  if(ret==FAILURE) return FAILURE;
+
+  /* Multiply the hlm amplitudes by 3L/2 * 2pi f / c */
+  double L = globalparams->variant->ConstL;
+  for(int k=0; k<params->nbmode; k++) {
+    int l = listmode[k][0];
+    int m = listmode[k][1];
+    CAmpPhaseFrequencySeries* hlm = ListmodesCAmpPhaseFrequencySeries_GetMode(*listROM, l, m)->freqseries;
+    gsl_vector* vfreq = hlm->freq;
+    double* freq = vfreq->data;
+    double* areal = hlm->amp_real->data;
+    double* aimag = hlm->amp_imag->data;
+    for(int i=0; i<vfreq->size; i++) {
+      areal[i] *= 3*PI*L/C_SI*freq[i];
+      aimag[i] *= 3*PI*L/C_SI*freq[i];
+    }
+  }
+
+  return SUCCESS;
+}
+
 /* Generalization to set of modes, in new convention */
 /* NOTE: difference in convention, new convention has a factor 3 in the integrand defining <lm|l'm'> */
 /* <lm|l'm'> = \int df/Sn (3L/2 * 2\pi f)^2 h_{lm} h_{l'm'}^{*} */
@@ -1909,44 +2254,14 @@ int LISAComputeSimpleLikelihoodPrecomputedValuesHM(SimpleLikelihoodPrecomputedVa
     gsl_vector_set(simplelikelihoodvalsHM->se_lm_imag, k, cimag(se_lm));
   }
 
-  /* Generate 22 mode for the fixed mass and time parameters - same fstartobs and PN extension as in the GenerateInjectionCAmpPhase function */
+  /* Generate the frequency-weighted modes for the fixed mass and time parameters */
   ListmodesCAmpPhaseFrequencySeries* listROM = NULL;
-  /* Starting frequency corresponding to duration of observation deltatobs */
-  double fstartobs = 0.;
-  if(!(globalparams->deltatobs==0.)) fstartobs = Newtonianfoft(params->m1, params->m2, globalparams->deltatobs);
-  /* Generate the waveform with the ROM */
-  /* NOTE: SimEOBNRv2HMROM accepts masses and distances in SI units, whereas LISA params is in solar masses and Mpc */
-  /* NOTE: minf and deltatobs are taken into account if extension is allowed, but not maxf - restriction to the relevant frequency interval will occur in both the response prcessing and overlap computation */
-  /* If extending, taking into account both fstartobs and minf */
-  if(!(globalparams->tagextpn)) {
-    //printf("Not Extending signal waveform.  Mfmatch=%g\n",globalparams->Mfmatch);
-    ret = SimEOBNRv2HMROM(&listROM, params->nbmode, params->tRef - injectedparams->tRef, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
-  } else {
-    //printf("Extending signal waveform.  Mfmatch=%g\n",globalparams->Mfmatch);
-    ret = SimEOBNRv2HMROMExtTF2(&listROM, params->nbmode, globalparams->Mfmatch, fmax(fstartobs, globalparams->minf), 0, params->tRef - injectedparams->tRef, params->phiRef, globalparams->fRef, (params->m1)*MSUN_SI, (params->m2)*MSUN_SI, (params->distance)*1e6*PC_SI, globalparams->setphiRefatfRef);
-  }
-  /* If the ROM waveform generation failed (e.g. parameters were out of bounds) return FAILURE */
+  ret = SimpleLikelihoodGenerateWeightedModes(&listROM, params);
   if(ret==FAILURE){
     printf("Failed to generate injection ROM\n");
     return FAILURE;
   }
 
-  /* Multiply the hlm amplitudes by 3L/2 * 2pi f / c */
-  double L = globalparams->variant->ConstL;
-  for(int k=0; k<params->nbmode; k++) {
-    int l = listmode[k][0];
-    int m = listmode[k][1];
-    CAmpPhaseFrequencySeries* hlm = ListmodesCAmpPhaseFrequencySeries_GetMode(listROM, l, m)->freqseries;
-    gsl_vector* vfreq = hlm->freq;
-    double* freq = vfreq->data;
-    double* areal = hlm->amp_real->data;
-    double* aimag = hlm->amp_imag->data;
-    for(int i=0; i<vfreq->size; i++) {
-      areal[i] *= 3*PI*L/C_SI*freq[i];
-      aimag[i] *= 3*PI*L/C_SI*freq[i];
-    }
-  }
-
   /* Precompute overlap of frequency-weighted hlm modes with themselves */
   /* Build spline interpolation */
   ListmodesCAmpPhaseSpline* listsplines = NULL;
@@ -1978,6 +2293,480 @@ int LISAComputeSimpleLikelihoodPrecomputedValuesHM(SimpleLikelihoodPrecomputedVa
   return(SUCCESS);
 }
 
+/****************** Simplified HM likelihood with overlaps tabulated over (m1, m2, tRef) *****************/
+
+/* Header of the files caching SimpleLikelihoodPrecomputedGridHM - the arrays follow, in the order of the structure */
+/* Also records the injection and the settings entering the overlaps, to check compatibility when reading */
+typedef struct tagSimpleLikelihoodGridFileHeader {
+  char magic[8];
+  int nbmode;
+  int nbm1;
+  int nbm2;
+  int nbtRef;
+  double m1min;
+  double m1max;
+  double m2min;
+  double m2max;
+  double tRefmin;
+  double tRefmax;
+  double injparams[9];   /* m1, m2, tRef, distance, phiRef, inclination, lambda, beta, polarization */
+  double settings[6];    /* fRef, deltatobs, minf, maxf, Mfmatch, ConstL */
+  int tagextpn;
+  int setphiRefatfRef;
+  int tagtdi;
+  int padding;
+} SimpleLikelihoodGridFileHeader;
+
+/* Header expected for the injection params and the current global parameters - also defines the grid boundaries */
+static void SimpleLikelihoodGridFileHeaderSet(SimpleLikelihoodGridFileHeader* header, LISAParams* params)
+{
+  memset(header, 0, sizeof(SimpleLikelihoodGridFileHeader));
+  strncpy(header->magic, "FLRSLG1", 8);
+  header->nbmode = params->nbmode;
+  header->nbm1 = globalparams->simplegridnbm1;
+  header->nbm2 = globalparams->simplegridnbm2;
+  header->nbtRef = globalparams->simplegridnbtRef;
+  /* A single node means the parameter is pinned to the injection value */
+  header->m1min = (header->nbm1==1) ? params->m1 : params->m1 * (1. - globalparams->simplegriddeltam1);
+  header->m1max = (header->nbm1==1) ? params->m1 : params->m1 * (1. + globalparams->simplegriddeltam1);
+  header->m2min = (header->nbm2==1) ? params->m2 : params->m2 * (1. - globalparams->simplegriddeltam2);
+  header->m2max = (header->nbm2==1) ? params->m2 : params->m2 * (1. + globalparams->simplegriddeltam2);
+  header->tRefmin = (header->nbtRef==1) ? params->tRef : params->tRef - globalparams->simplegriddeltatRef;
+  header->tRefmax = (header->nbtRef==1) ? params->tRef : params->tRef + globalparams->simplegriddeltatRef;
+  header->injparams[0] = params->m1;
+  header->injparams[1] = params->m2;
+  header->injparams[2] = params->tRef;
+  header->injparams[3] = params->distance;
+  header->injparams[4] = params->phiRef;
+  header->injparams[5] = params->inclination;
+  header->injparams[6] = params->lambda;
+  header->injparams[7] = params->beta;
+  header->injparams[8] = params->polarization;
+  header->settings[0] = globalparams->fRef;
+  header->settings[1] = globalparams->deltatobs;
+  header->settings[2] = globalparams->minf;
+  header->settings[3] = globalparams->maxf;
+  header->settings[4] = globalparams->Mfmatch;
+  header->settings[5] = globalparams->variant->ConstL;
+  header->tagextpn = globalparams->tagextpn;
+  header->setphiRefatfRef = globalparams->setphiRefatfRef;
+  header->tagtdi = globalparams->tagtdi;
+}
+
+/* Number of complex values in the arrays of the grid, and pointers into a contiguous block */
+static size_t SimpleLikelihoodGridDataSize(int nbmode, int nbm1, int nbm2, int nbtRef)
+{
+  size_t nb2 = nbmode*nbmode;
+  return 2*nbmode + nb2 + nbm1*nbm2*nb2 + nbm1*nbm2*nbtRef*nb2;
+}
+static void SimpleLikelihoodGridSetPointers(SimpleLikelihoodPrecomputedGridHM* grid, double complex* data)
+{
+  size_t nb2 = grid->nbmode*grid->nbmode;
+  grid->sinj_lm = data;
+  grid->Lambda_inj = grid->sinj_lm + 2*grid->nbmode;
+  grid->Lambda_temp = grid->Lambda_inj + nb2;
+  grid->Lambda_cross = grid->Lambda_temp + grid->nbm1*grid->nbm2*nb2;
+}
+static void SimpleLikelihoodGridFromHeader(SimpleLikelihoodPrecomputedGridHM* grid, SimpleLikelihoodGridFileHeader* header)
+{
+  grid->nbmode = header->nbmode;
+  grid->nbm1 = header->nbm1;
+  grid->nbm2 = header->nbm2;
+  grid->nbtRef = header->nbtRef;
+  grid->m1min = header->m1min;
+  grid->m1max = header->m1max;
+  grid->m2min = header->m2min;
+  grid->m2max = header->m2max;
+  grid->tRefmin = header->tRefmin;
+  grid->tRefmax = header->tRefmax;
+}
+
+/* Complex overlaps <h1lm|h2l'm'> for all pairs of modes, from the real parts given by FDModeByModeFresnelOverlap */
+/* The imaginary part is the real part of the overlap of -i*h1, i.e. h1 with all phases shifted by -pi/2 */
+static void SimpleLikelihoodComplexModeOverlaps(
+  double complex* overlaps,                    /* Output: nbmode*nbmode overlaps, row-major */
+  gsl_matrix* listmodes,                       /* Matrix of modes */
+  ListmodesCAmpPhaseFrequencySeries* listh1,   /* First waveform, list of modes in amplitude/phase form - phases are shifted back and forth */
+  ListmodesCAmpPhaseSpline* listsplines2,      /* Second waveform, list of modes already interpolated in matrix form */
+  ObjectFunction* Snoise,                      /* Noise function */
+  double fLow,                                 /* Lower bound of the frequency window for the detector */
+  double fHigh)                                /* Upper bound of the frequency window for the detector */
+{
+  int nbmode = listmodes->size1;
+  gsl_matrix* overlapsreal = NULL;
+  gsl_matrix* overlapsimag = NULL;
+  FDModeByModeFresnelOverlap(&overlapsreal, listmodes, listmodes, listh1, listsplines2, Snoise, fLow, fHigh, 0., 0., 0);
+  for(ListmodesCAmpPhaseFrequencySeries* listelement=listh1; listelement; listelement=listelement->next)
+    gsl_vector_add_constant(listelement->freqseries->phase, -PI/2);
+  FDModeByModeFresnelOverlap(&overlapsimag, listmodes, listmodes, listh1, listsplines2, Snoise, fLow, fHigh, 0., 0., 0);
+  for(ListmodesCAmpPhaseFrequencySeries* listelement=listh1; listelement; listelement=listelement->next)
+    gsl_vector_add_constant(listelement->freqseries->phase, PI/2);
+  for(int i=0; i<nbmode; i++) {
+    for(int j=0; j<nbmode; j++) {
+      overlaps[i*nbmode+j] = gsl_matrix_get(overlapsreal, i, j) + I*gsl_matrix_get(overlapsimag, i, j);
+    }
+  }
+  gsl_matrix_free(overlapsreal);
+  gsl_matrix_free(overlapsimag);
+}
+
+/* Tolerance on the simplified logL for the interpolation of the grid, and largest number of (m1, m2, tRef) nodes */
+#define SIMPLEGRID_LOGLTOL 0.1
+#define SIMPLEGRID_MAXNODES (1<<20)
+
+/* Injection modes and settings shared by the tabulation, the choice of nodes and the accuracy check */
+typedef struct tagSimpleLikelihoodGridSetup {
+  gsl_matrix* listmodes;
+  ListmodesCAmpPhaseFrequencySeries* listinj;
+  ListmodesCAmpPhaseSpline* listsplinesinj;
+  ObjectFunction NoiseSn;
+  double fLow;
+  double fHigh;
+} SimpleLikelihoodGridSetup;
+
+/* Settings for the overlaps, same as in LISAComputeSimpleLikelihoodPrecomputedValuesHM */
+static int SimpleLikelihoodGridSetup_Init(SimpleLikelihoodGridSetup* setup, LISAParams* params)
+{
+  setup->fLow = fmax(__LISASimFD_Noise_fLow, globalparams->minf);
+  setup->fHigh = fmin(__LISASimFD_Noise_fHigh, globalparams->maxf);
+  setup->NoiseSn = NoiseFunction(globalparams->variant, globalparams->tagtdi, 1);
+  setup->listinj = NULL;
+  setup->listsplinesinj = NULL;
+  if(SimpleLikelihoodGenerateWeightedModes(&(setup->listinj), params)==FAILURE) {
+    printf("Failed to generate injection ROM\n");
+    return FAILURE;
+  }
+  BuildListmodesCAmpPhaseSpline(&(setup->listsplinesinj), setup->listinj);
+  setup->listmodes = gsl_matrix_alloc(params->nbmode, 2);
+  for(int k=0; k<params->nbmode; k++) {
+    gsl_matrix_set(setup->listmodes, k, 0, listmode[k][0]);
+    gsl_matrix_set(setup->listmodes, k, 1, listmode[k][1]);
+  }
+  return SUCCESS;
+}
+
+static void SimpleLikelihoodGridSetup_Cleanup(SimpleLikelihoodGridSetup* setup)
+{
+  gsl_matrix_free(setup->listmodes);
+  ListmodesCAmpPhaseFrequencySeries_Destroy(setup->listinj);
+  ListmodesCAmpPhaseSpline_Destroy(setup->listsplinesinj);
+}
+
+/* Overlaps <hlm|hl'm'> (if Lambda_temp is not NULL) and <hlm|kl'm'> for a template with the masses and time of params, computed directly */
+static int SimpleLikelihoodPointOverlaps(double complex* Lambda_temp, double complex* Lambda_cross, LISAParams* params, SimpleLikelihoodGridSetup* setup)
+{
+  ListmodesCAmpPhaseFrequencySeries* listtemp = NULL;
+  if(SimpleLikelihoodGenerateWeightedModes(&listtemp, params)==FAILURE) return FAILURE;
+  if(Lambda_temp) {
+    ListmodesCAmpPhaseSpline* listsplinestemp = NULL;
+    BuildListmodesCAmpPhaseSpline(&listsplinestemp, listtemp);
+    SimpleLikelihoodComplexModeOverlaps(Lambda_temp, setup->listmodes, listtemp, listsplinestemp, &(setup->NoiseSn), setup->fLow, setup->fHigh);
+    ListmodesCAmpPhaseSpline_Destroy(listsplinestemp);
+  }
+  SimpleLikelihoodComplexModeOverlaps(Lambda_cross, setup->listmodes, listtemp, setup->listsplinesinj, &(setup->NoiseSn), setup->fLow, setup->fHigh);
+  ListmodesCAmpPhaseFrequencySeries_Destroy(listtemp);
+  return SUCCESS;
+}
+
+/* Largest rate of change of the phase of the cross-overlaps <hlm|kl'm'> at the injection, along one parameter (component i of m1, m2, tRef) */
+/* Pairs of modes with overlaps below 1e-3 of the largest one are ignored - central difference of the phase with a step small enough not to wrap */
+static double SimpleLikelihoodGridPhaseRate(LISAParams* params, SimpleLikelihoodGridSetup* setup, int i, double step)
+{
+  int nb2 = params->nbmode*params->nbmode;
+  double complex Lambdap[nb2], Lambdam[nb2];
+  LISAParams paramsp = *params;
+  LISAParams paramsm = *params;
+  double* xp = (i==0) ? &(paramsp.m1) : (i==1) ? &(paramsp.m2) : &(paramsp.tRef);
+  double* xm = (i==0) ? &(paramsm.m1) : (i==1) ? &(paramsm.m2) : &(paramsm.tRef);
+  *xp += step;
+  *xm -= step;
+  if(SimpleLikelihoodPointOverlaps(NULL, Lambdap, &paramsp, setup)==FAILURE || SimpleLikelihoodPointOverlaps(NULL, Lambdam, &paramsm, setup)==FAILURE) return NAN;
+  double Lambdamax = 0.;
+  for(int k=0; k<nb2; k++) Lambdamax = fmax(Lambdamax, cabs(Lambdap[k]));
+  double rate = 0.;
+  for(int k=0; k<nb2; k++) {
+    if(cabs(Lambdap[k]) < 1e-3*Lambdamax || cabs(Lambdam[k]) < 1e-3*Lambdamax) continue;
+    rate = fmax(rate, fabs(carg(Lambdap[k]*conj(Lambdam[k])))/(2*step));
+  }
+  return rate;
+}
+
+/* Raise the numbers of nodes in globalparams so that the phase of the cross-overlaps is resolved by the interpolation */
+/* The cubic Lagrange interpolation of exp(i phi) with a phase step dphi per node has a relative error ~0.023 dphi^4, that enters the logL multiplied by (s|s) */
+/* Fails if the grid needed exceeds SIMPLEGRID_MAXNODES nodes - the half-widths simplegriddelta* have then to be reduced */
+static int SimpleLikelihoodGridSetNodes(LISAParams* params, SimpleLikelihoodGridSetup* setup)
+{
+  int nbmode = params->nbmode;
+  int nb2 = nbmode*nbmode;
+
+  /* (s|s) of the injection */
+  double complex Lambda_inj[nb2];
+  SimpleLikelihoodComplexModeOverlaps(Lambda_inj, setup->listmodes, setup->listinj, setup->listsplinesinj, &(setup->NoiseSn), setup->fLow, setup->fHigh);
+  double phiL = funcphiL(params);
+  double lambdL = funclambdaL(params);
+  double betaL = funcbetaL(params);
+  double psiL = funcpsiL(params);
+  double complex sa_lm[nbmode], se_lm[nbmode];
+  for(int k=0; k<nbmode; k++) {
+    sa_lm[k] = funcsa_lm(listmode[k][0], listmode[k][1], 1., phiL, params->inclination, lambdL, betaL, psiL);
+    se_lm[k] = funcse_lm(listmode[k][0], listmode[k][1], 1., phiL, params->inclination, lambdL, betaL, psiL);
+  }
+  double complex ss = 0.;
+  for(int i=0; i<nbmode; i++)
+    for(int j=0; j<nbmode; j++)
+      ss += (sa_lm[i]*conj(sa_lm[j]) + se_lm[i]*conj(se_lm[j])) * Lambda_inj[i*nbmode+j];
+  double dphimax = fmin(1., pow(SIMPLEGRID_LOGLTOL/(0.023*fmax(creal(ss), 1.)), 0.25));
+
+  /* Nodes in m1, m2 (relative widths) and tRef (s) */
+  int* nb[3] = {&(globalparams->simplegridnbm1), &(globalparams->simplegridnbm2), &(globalparams->simplegridnbtRef)};
+  double halfwidth[3] = {globalparams->simplegriddeltam1*params->m1, globalparams->simplegriddeltam2*params->m2, globalparams->simplegriddeltatRef};
+  double step[3] = {1e-6*params->m1, 1e-6*params->m2, 1e-2};
+  const char* name[3] = {"m1", "m2", "tRef"};
+  double nbnodes = 1.;
+  for(int i=0; i<3; i++) {
+    if(*nb[i]==1) continue;
+    double rate = SimpleLikelihoodGridPhaseRate(params, setup, i, step[i]);
+    if(isnan(rate)) {
+      printf("Error in SimpleLikelihoodGridSetNodes: waveform generation failed around the injection.\n");
+      return FAILURE;
+    }
+    double nbneeded = fmax(4., ceil(2*halfwidth[i]*rate/dphimax) + 1);
+    if(nbneeded > SIMPLEGRID_MAXNODES) nbneeded = SIMPLEGRID_MAXNODES;
+    if(*nb[i] < nbneeded) {
+      printf("Simplified likelihood grid: %d nodes in %s to resolve the phase of the overlaps (was %d).\n", (int) nbneeded, name[i], *nb[i]);
+      *nb[i] = (int) nbneeded;
+    }
+    nbnodes *= *nb[i];
+  }
+  if(nbnodes > SIMPLEGRID_MAXNODES) {
+    printf("Error in SimpleLikelihoodGridSetNodes: the grid needs %g nodes to resolve the phase of the overlaps, more than %d - reduce simplegriddeltam1, simplegriddeltam2 or simplegriddeltatRef.\n", nbnodes, SIMPLEGRID_MAXNODES);
+    return FAILURE;
+  }
+  return SUCCESS;
+}
+
+/* Accuracy check of the grid: at the middle between nodes around the injection, the interpolated logL is compared to the logL from overlaps computed directly */
+/* Also compared at the injection masses and time to CalculateLogLSimpleLikelihoodHM, which drops the imaginary part of the cross-mode overlaps - reported, not enforced */
+/* Fails if an interpolated logL is off by more than SIMPLEGRID_LOGLTOL + 1e-3 |logL| */
+static int SimpleLikelihoodGridCheck(SimpleLikelihoodPrecomputedGridHM* grid, LISAParams* params, SimpleLikelihoodGridSetup* setup)
+{
+  int nbmode = grid->nbmode;
+  int nb2 = nbmode*nbmode;
+  double complex Lambda_temp[nb2], Lambda_cross[nb2];
+
+  /* Template angles and distance away from the injection, so that all the terms enter */
+  LISAParams testparams = *params;
+  testparams.phiRef += 0.5;
+  testparams.inclination += 0.2;
+  testparams.distance *= 1.05;
+
+  /* Points half a node away from the injection along each direction, and in all directions at once */
+  double spacing[3] = {
+    (grid->nbm1==1) ? 0. : (grid->m1max - grid->m1min)/(grid->nbm1 - 1),
+    (grid->nbm2==1) ? 0. : (grid->m2max - grid->m2min)/(grid->nbm2 - 1),
+    (grid->nbtRef==1) ? 0. : (grid->tRefmax - grid->tRefmin)/(grid->nbtRef - 1)};
+  double offsets[7][3] = {{0.5,0,0}, {-0.5,0,0}, {0,0.5,0}, {0,-0.5,0}, {0,0,0.5}, {0,0,-0.5}, {0.5,0.5,0.5}};
+  double errmax = 0.;
+  int ret = SUCCESS;
+  for(int p=0; p<7; p++) {
+    LISAParams pointparams = testparams;
+    pointparams.m1 += offsets[p][0]*spacing[0];
+    pointparams.m2 += offsets[p][1]*spacing[1];
+    pointparams.tRef += offsets[p][2]*spacing[2];
+    double logLgrid = CalculateLogLSimpleLikelihoodGridHM(grid, &pointparams);
+    if(logLgrid==-DBL_MAX) continue;
+    if(SimpleLikelihoodPointOverlaps(Lambda_temp, Lambda_cross, &pointparams, setup)==FAILURE) continue;
+    double logLdirect = SimpleLikelihoodGridLogL(nbmode, Lambda_temp, Lambda_cross, grid->Lambda_inj, grid->sinj_lm, &pointparams);
+    double err = fabs(logLgrid - logLdirect);
+    errmax = fmax(errmax, err);
+    if(err > SIMPLEGRID_LOGLTOL + 1e-3*fabs(logLdirect)) {
+      printf("Error in SimpleLikelihoodGridCheck: interpolated logL %g, direct %g at m1=%g, m2=%g, tRef=%g - increase the numbers of nodes or reduce the half-widths of the grid.\n", logLgrid, logLdirect, pointparams.m1, pointparams.m2, pointparams.tRef);
+      ret = FAILURE;
+    }
+  }
+  printf("Simplified likelihood grid: largest error of the interpolated logL %g.\n", errmax);
+
+  /* Masses and time of the injection, against the pinned simplified likelihood */
+  SimpleLikelihoodPrecomputedValuesHM pinnedvals;
+  if(LISAComputeSimpleLikelihoodPrecomputedValuesHM(&pinnedvals, params)==SUCCESS) {
+    pinnedvals.grid = NULL;
+    double logLgrid = CalculateLogLSimpleLikelihoodGridHM(grid, &testparams);
+    double logLpinned = CalculateLogLSimpleLikelihoodHM(&pinnedvals, &testparams);
+    printf("Simplified likelihood grid: logL at the injection masses and time %g, pinned simplified likelihood %g.\n", logLgrid, logLpinned);
+    if(fabs(logLgrid - logLpinned) > SIMPLEGRID_LOGLTOL + 1e-3*fabs(logLpinned)) printf("Warning in SimpleLikelihoodGridCheck: grid and pinned simplified likelihoods differ by %g.\n", logLgrid - logLpinned);
+  }
+  gsl_matrix_free(pinnedvals.Lambda_lm_lpmp);
+  gsl_vector_free(pinnedvals.sa_lm_real);
+  gsl_vector_free(pinnedvals.sa_lm_imag);
+  gsl_vector_free(pinnedvals.se_lm_real);
+  gsl_vector_free(pinnedvals.se_lm_imag);
+
+  return ret;
+}
+
+/* Tabulate the overlaps of the simplified HM likelihood on the (m1, m2, tRef) grid defined by globalparams, around the injection params */
+/* Nodes where the waveform generation fails (e.g. out of the ROM range) are set to NaN, and templates depending on them are rejected */
+static int SimpleLikelihoodGridCompute(SimpleLikelihoodPrecomputedGridHM** grid, LISAParams* params, SimpleLikelihoodGridSetup* setup)
+{
+  int nbmode = params->nbmode;
+  int nb2 = nbmode*nbmode;
+
+  /* Grid boundaries */
+  SimpleLikelihoodGridFileHeader header;
+  SimpleLikelihoodGridFileHeaderSet(&header, params);
+
+  /* Allocate output - all arrays in one block */
+  *grid = (SimpleLikelihoodPrecomputedGridHM*) malloc(sizeof(SimpleLikelihoodPrecomputedGridHM));
+  memset(*grid, 0, sizeof(SimpleLikelihoodPrecomputedGridHM));
+  SimpleLikelihoodGridFromHeader(*grid, &header);
+  size_t datasize = SimpleLikelihoodGridDataSize(nbmode, header.nbm1, header.nbm2, header.nbtRef);
+  double complex* data = (double complex*) malloc(datasize*sizeof(double complex));
+  if(!data) {
+    printf("Error in LISAComputeSimpleLikelihoodPrecomputedGridHM: failed to allocate the grid.\n");
+    free(*grid);
+    *grid = NULL;
+    return FAILURE;
+  }
+  SimpleLikelihoodGridSetPointers(*grid, data);
+
+  /* Injection values sa_lm, se_lm - same as in LISAComputeSimpleLikelihoodPrecomputedValuesHM */
+  double phiL = funcphiL(params);
+  double lambdL = funclambdaL(params);
+  double betaL = funcbetaL(params);
+  double psiL = funcpsiL(params);
+  double inc = params->inclination;
+  double d = params->distance / injectedparams->distance;
+  for(int k=0; k<nbmode; k++) {
+    (*grid)->sinj_lm[k] = funcsa_lm(listmode[k][0], listmode[k][1], d, phiL, inc, lambdL, betaL, psiL);
+    (*grid)->sinj_lm[nbmode+k] = funcse_lm(listmode[k][0], listmode[k][1], d, phiL, inc, lambdL, betaL, psiL);
+  }
+
+  /* Overlaps of the injection with itself */
+  SimpleLikelihoodComplexModeOverlaps((*grid)->Lambda_inj, setup->listmodes, setup->listinj, setup->listsplinesinj, &(setup->NoiseSn), setup->fLow, setup->fHigh);
+
+  /* Loop over the mass nodes - the masses are the only intrinsic parameters, other template params are set to the injection values */
+  LISAParams nodeparams = *params;
+  double dm1 = (header.nbm1==1) ? 0. : (header.m1max - header.m1min)/(header.nbm1 - 1);
+  double dm2 = (header.nbm2==1) ? 0. : (header.m2max - header.m2min)/(header.nbm2 - 1);
+  double dtRef = (header.nbtRef==1) ? 0. : (header.tRefmax - header.tRefmin)/(header.nbtRef - 1);
+  for(int i1=0; i1<header.nbm1; i1++) {
+    for(int i2=0; i2<header.nbm2; i2++) {
+      int nodem = i1*header.nbm2 + i2;
+      double complex* Lambda_temp = (*grid)->Lambda_temp + nodem*nb2;
+      double complex* Lambda_cross = (*grid)->Lambda_cross + nodem*header.nbtRef*nb2;
+      nodeparams.m1 = header.m1min + i1*dm1;
+      nodeparams.m2 = header.m2min + i2*dm2;
+
+      /* Overlaps of the template with itself - independent of tRef - and with the injection, for each time node */
+      for(int it=0; it<header.nbtRef; it++) {
+        nodeparams.tRef = header.tRefmin + it*dtRef;
+        if(SimpleLikelihoodPointOverlaps((it==0) ? Lambda_temp : NULL, Lambda_cross + it*nb2, &nodeparams, setup)==FAILURE) {
+          if(it==0) for(int k=0; k<nb2; k++) Lambda_temp[k] = NAN;
+          for(int k=0; k<nb2; k++) Lambda_cross[it*nb2+k] = NAN;
+        }
+      }
+    }
+  }
+
+  return SUCCESS;
+}
+
+/* Tabulate the grid for the injection params - see LISALoadOrComputeSimpleLikelihoodPrecomputedGridHM for the choice of nodes and the accuracy check */
+int LISAComputeSimpleLikelihoodPrecomputedGridHM(SimpleLikelihoodPrecomputedGridHM** grid, LISAParams* params)
+{
+  SimpleLikelihoodGridSetup setup;
+  if(SimpleLikelihoodGridSetup_Init(&setup, params)==FAILURE) return FAILURE;
+  int ret = SimpleLikelihoodGridCompute(grid, params, &setup);
+  SimpleLikelihoodGridSetup_Cleanup(&setup);
+  return ret;
+}
+
+/* Write the grid to file, header first - params are the injection params used to compute it */
+int Write_SimpleLikelihoodPrecomputedGridHM(const char* filename, SimpleLikelihoodPrecomputedGridHM* grid, LISAParams* params)
+{
+  SimpleLikelihoodGridFileHeader header;
+  SimpleLikelihoodGridFileHeaderSet(&header, params);
+  size_t datasize = SimpleLikelihoodGridDataSize(grid->nbmode, grid->nbm1, grid->nbm2, grid->nbtRef);
+  FILE* f = fopen(filename, "wb");
+  if(f==NULL) {
+    printf("Error in Write_SimpleLikelihoodPrecomputedGridHM: cannot open file %s.\n", filename);
+    return FAILURE;
+  }
+  int ok = (fwrite(&header, sizeof(SimpleLikelihoodGridFileHeader), 1, f)==1) && (fwrite(grid->sinj_lm, sizeof(double complex), datasize, f)==datasize);
+  fclose(f);
+  if(!ok) {
+    printf("Error in Write_SimpleLikelihoodPrecomputedGridHM: failed writing to file %s.\n", filename);
+    return FAILURE;
+  }
+  return SUCCESS;
+}
+
+/* Map a grid file in memory - fails if the file is missing, or was computed for another injection or other settings */
+int Read_SimpleLikelihoodPrecomputedGridHM(SimpleLikelihoodPrecomputedGridHM** grid, LISAParams* params, const char* filename)
+{
+  SimpleLikelihoodGridFileHeader header;
+  SimpleLikelihoodGridFileHeaderSet(&header, params);
+  size_t mappingsize = sizeof(SimpleLikelihoodGridFileHeader) + SimpleLikelihoodGridDataSize(header.nbmode, header.nbm1, header.nbm2, header.nbtRef)*sizeof(double complex);
+
+  int fd = open(filename, O_RDONLY);
+  if(fd<0) return FAILURE;
+  struct stat st;
+  if(fstat(fd, &st)!=0 || (size_t) st.st_size!=mappingsize) {
+    close(fd);
+    printf("Warning in Read_SimpleLikelihoodPrecomputedGridHM: file %s does not match the grid settings.\n", filename);
+    return FAILURE;
+  }
+  void* mapping = mmap(NULL, mappingsize, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(mapping==MAP_FAILED) {
+    printf("Warning in Read_SimpleLikelihoodPrecomputedGridHM: cannot map file %s.\n", filename);
+    return FAILURE;
+  }
+  if(memcmp(mapping, &header, sizeof(SimpleLikelihoodGridFileHeader))!=0) {
+    munmap(mapping, mappingsize);
+    printf("Warning in Read_SimpleLikelihoodPrecomputedGridHM: file %s was computed for another injection or other settings.\n", filename);
+    return FAILURE;
+  }
+
+  *grid = (SimpleLikelihoodPrecomputedGridHM*) malloc(sizeof(SimpleLikelihoodPrecomputedGridHM));
+  memset(*grid, 0, sizeof(SimpleLikelihoodPrecomputedGridHM));
+  SimpleLikelihoodGridFromHeader(*grid, &header);
+  SimpleLikelihoodGridSetPointers(*grid, (double complex*) ((char*) mapping + sizeof(SimpleLikelihoodGridFileHeader)));
+  (*grid)->mapping = mapping;
+  (*grid)->mappingsize = mappingsize;
+  return SUCCESS;
+}
+
+/* Reuse the grid cached in filename if compatible, otherwise compute it and, if write is set, cache it - empty filename to disable caching */
+/* The numbers of nodes in globalparams are first raised if needed to resolve the phase of the overlaps, and the grid is checked against direct overlaps */
+/* Fails, with the grid freed, if the waveform of the injection cannot be generated, if the grid needs too many nodes, or if the check fails */
+int LISALoadOrComputeSimpleLikelihoodPrecomputedGridHM(SimpleLikelihoodPrecomputedGridHM** grid, LISAParams* params, const char* filename, int write)
+{
+  SimpleLikelihoodGridSetup setup;
+  if(SimpleLikelihoodGridSetup_Init(&setup, params)==FAILURE) return FAILURE;
+  int ret = SimpleLikelihoodGridSetNodes(params, &setup);
+  if(ret==SUCCESS) {
+    if(!(strlen(filename)>0 && Read_SimpleLikelihoodPrecomputedGridHM(grid, params, filename)==SUCCESS)) {
+      ret = SimpleLikelihoodGridCompute(grid, params, &setup);
+      if(ret==SUCCESS && strlen(filename)>0 && write) Write_SimpleLikelihoodPrecomputedGridHM(filename, *grid, params);
+    }
+  }
+  if(ret==SUCCESS && SimpleLikelihoodGridCheck(*grid, params, &setup)==FAILURE) {
+    SimpleLikelihoodPrecomputedGridHM_Cleanup(*grid);
+    *grid = NULL;
+    ret = FAILURE;
+  }
+  SimpleLikelihoodGridSetup_Cleanup(&setup);
+  return ret;
+}
+
+void SimpleLikelihoodPrecomputedGridHM_Cleanup(SimpleLikelihoodPrecomputedGridHM* grid)
+{
+  if(grid->mapping) munmap(grid->mapping, grid->mappingsize);
+  else free(grid->sinj_lm);
+  free(grid);
+}
+
 /***************************** Functions handling the prior ******************************/
 
 /* Functions to check that returned parameter values fit in prior boundaries */
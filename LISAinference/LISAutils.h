@@ -80,6 +80,15 @@ typedef struct tagLISAGlobalParams {
   ResponseApproxtag responseapprox;    /* Approximation in the GAB and orb response - choices are full (full response, default), lowfL (keep orbital delay frequency-dependence but simplify constellation response) and lowf (simplify constellation and orbital response) - WARNING : at the moment noises are not consistent, and TDI combinations from the GAB are unchanged */
   int tagsimplelikelihood22; /* Tag to use simplified, frozen-LISA and lowf likelihood where mode overlaps are precomputed - 22-mode only - can only be used when the masses and time (tL) are pinned to injection values (Note: when using --snr, distance adjustment done using responseapprox, not the simple response) */
   int tagsimplelikelihoodHM; /* Tag to use simplified, frozen-LISA and lowf likelihood where mode overlaps are precomputed - set of modes - can only be used when the masses and time (tL) are pinned to injection values (Note: when using --snr, distance adjustment done using responseapprox, not the simple response) */
+  int tagsimplelikelihoodgrid; /* Tag to tabulate the mode overlaps of the simplified HM likelihood on a grid of (m1, m2, tRef) around the injection, lifting the pinning of masses and time (default 0) */
+  int simplegridnbm1;        /* Number of grid nodes in m1 (default 5) - 1 requires m1 pinned */
+  int simplegridnbm2;        /* Number of grid nodes in m2 (default 5) - 1 requires m2 pinned */
+  int simplegridnbtRef;      /* Number of grid nodes in tRef (default 33) - 1 requires tRef pinned */
+                             /* The numbers of nodes are raised at setup to resolve the phase of the overlaps, see LISALoadOrComputeSimpleLikelihoodPrecomputedGridHM */
+  double simplegriddeltam1;  /* Relative half-width of the grid in m1 (default 0.01) */
+  double simplegriddeltam2;  /* Relative half-width of the grid in m2 (default 0.01) */
+  double simplegriddeltatRef; /* Half-width of the grid in tRef (s, default 100) */
+  char simplegridfile[256];  /* File caching the grid - reused (memory-mapped) if compatible, written otherwise - empty to disable (default empty) */
 } LISAGlobalParams;
 
 typedef struct tagLISASignalCAmpPhase
@@ -200,7 +209,7 @@ typedef struct tagLISAAddParams {
   double inclination;        /* inclination of L relative to line of sight (rad, default PI/3) */
   double polarization;       /* polarization angle (rad, default 0) */
   int loadparamsfile;        /* Option to load physical parameters from file for LISAlikelihood and to output resulting likelihoods to file (default 0) */
-  int nlinesparams;          /* Number of lines in params file for LISAlikelihood */
+  int nlinesparams;          /* Number of lines in params file for LISAlikelihood (0: counted from the file) */
   char indir[256];           /* Input directory for LISAlikelihood */
   char infile[256];          /* Input file for LISAlikelihood */
   char outdir[256];          /* Output directory for LISAlikelihood */
@@ -222,7 +231,31 @@ typedef struct tagSimpleLikelihoodPrecomputedValuesHM {
   gsl_vector* sa_lm_imag;         /* Vector s_a^{lm}, imaginary part */
   gsl_vector* se_lm_real;         /* Vector s_e^{lm}, real part*/
   gsl_vector* se_lm_imag;         /* Vector s_e^{lm}, imaginary part */
+  struct tagSimpleLikelihoodPrecomputedGridHM* grid; /* If not NULL, overlaps tabulated in (m1, m2, tRef) - masses and time need not be pinned */
 } SimpleLikelihoodPrecomputedValuesHM;
+/* Mode overlaps for the simplified HM likelihood, tabulated on a regular grid of (m1, m2, tRef) nodes around the injection */
+/* Template and injection differ in masses and time, so that three sets of complex overlaps enter: */
+/* <hlm|hl'm'> for the template with itself (depends on m1, m2 only), <hlm|kl'm'> for the template with the injection, <klm|kl'm'> for the injection with itself */
+/* Same convention as SimpleLikelihoodPrecomputedValuesHM, <lm|l'm'> = \int df/Sn (3L/2 * 2\pi f)^2 h_{lm} h_{l'm'}^{*} */
+/* Arrays are contiguous, and point either to malloc'ed memory or into a memory-mapped file */
+typedef struct tagSimpleLikelihoodPrecomputedGridHM {
+  int nbmode;                     /* Number of modes, following listmode */
+  int nbm1;                       /* Number of nodes in m1 */
+  int nbm2;                       /* Number of nodes in m2 */
+  int nbtRef;                     /* Number of nodes in tRef */
+  double m1min;                   /* Grid boundaries - nodes are uniformly spaced, boundaries included */
+  double m1max;
+  double m2min;
+  double m2max;
+  double tRefmin;
+  double tRefmax;
+  double complex* sinj_lm;        /* s_a^{lm} then s_e^{lm} for the injection, 2*nbmode */
+  double complex* Lambda_inj;     /* <klm|kl'm'>, nbmode*nbmode */
+  double complex* Lambda_temp;    /* <hlm|hl'm'> on the (m1, m2) nodes, nbm1*nbm2*nbmode*nbmode - NaN where the waveform generation failed */
+  double complex* Lambda_cross;   /* <hlm|kl'm'> on the (m1, m2, tRef) nodes, nbm1*nbm2*nbtRef*nbmode*nbmode - NaN where the waveform generation failed */
+  void* mapping;                  /* Memory-mapped file holding the arrays, NULL if they were allocated */
+  size_t mappingsize;             /* Size of the mapping */
+} SimpleLikelihoodPrecomputedGridHM;
 
 /************ Functions for LISA parameters, injection, likelihood, prior ************/
 
@@ -271,11 +304,43 @@ int LISAGenerateSignalCAmpPhase(
 int LISAGenerateInjectionCAmpPhase(
   struct tagLISAParams* injectedparams,    /* Input: set of LISA parameters of the signal */
   struct tagLISAInjectionCAmpPhase* signal);  /* Output: structure for the generated signal */
+/* Same as above, with the approximations for the response given explicitly instead of read from globalparams */
+int LISAGenerateSignalCAmpPhaseResponse(
+  struct tagLISAParams* params,                 /* Input: set of LISA parameters of the signal */
+  struct tagLISASignalCAmpPhase* signal,        /* Output: structure for the generated signal */
+  int frozenLISA,                               /* Input: tag for treating LISA as frozen at its position at tRef */
+  ResponseApproxtag responseapprox);            /* Input: approximation used in the response (full, lowfL, lowf) */
+/* Same as above, with the reference time of the injection given explicitly instead of read from injectedparams - can be called concurrently for different injections */
+int LISAGenerateSignalCAmpPhaseRefTime(
+  struct tagLISAParams* params,                 /* Input: set of LISA parameters of the signal */
+  struct tagLISASignalCAmpPhase* signal,        /* Output: structure for the generated signal */
+  double tRefinj,                               /* Input: reference time of the injection, the ROM is shifted by params->tRef - tRefinj */
+  int frozenLISA,                               /* Input: tag for treating LISA as frozen at its position at tRef */
+  ResponseApproxtag responseapprox);            /* Input: approximation used in the response (full, lowfL, lowf) */
+/* Core of the generation, with all the settings given explicitly - does not read any global variable, safe to call concurrently */
+int LISAGenerateSignalCAmpPhaseSettings(
+  struct tagLISAParams* params,                 /* Input: set of LISA parameters of the signal */
+  struct tagLISASignalCAmpPhase* signal,        /* Output: structure for the generated signal */
+  double tRefinj,                               /* Input: reference time of the injection, the ROM is shifted by params->tRef - tRefinj */
+  const LISAGlobalParams* settings);            /* Input: settings of the generation, in place of globalparams */
+/* Same as LISAGenerateInjectionCAmpPhase, with the reference time and the approximations for the response given explicitly - the ROM is shifted by params->tRef - tRefinj */
+int LISAGenerateInjectionCAmpPhaseResponse(
+  struct tagLISAParams* injectedparams,         /* Input: set of LISA parameters of the signal */
+  struct tagLISAInjectionCAmpPhase* signal,     /* Output: structure for the generated signal */
+  double tRefinj,                               /* Input: reference time of the injection - params->tRef for a standalone injection */
+  int frozenLISA,                               /* Input: tag for treating LISA as frozen at its position at tRef */
+  ResponseApproxtag responseapprox);            /* Input: approximation used in the response (full, lowfL, lowf) */
 /* Function generating a LISA signal as a frequency series in Re/Im form where the modes have been summed, from LISA parameters - takes as argument the frequencies on which to evaluate */
 int LISAGenerateSignalReIm(
   struct tagLISAParams* params,       /* Input: set of LISA parameters of the template */
   gsl_vector* freq,                   /* Input: frequencies on which evaluating the waveform (from the injection) */
   struct tagLISASignalReIm* signal);  /* Output: structure for the generated signal */
+/* Same as above, with the reference time of the injection given explicitly instead of read from injectedparams - can be called concurrently */
+int LISAGenerateSignalReImRefTime(
+  struct tagLISAParams* params,       /* Input: set of LISA parameters of the template */
+  gsl_vector* freq,                   /* Input: frequencies on which evaluating the waveform (from the injection) */
+  struct tagLISASignalReIm* signal,   /* Output: structure for the generated signal */
+  double tRefinj);                    /* Input: reference time of the injection, the ROM is shifted by params->tRef - tRefinj */
 /* Function generating a LISA injection as a frequency series in Re/Im form where the modes have been summed, from LISA parameters - frequencies on which to evaluate are to be determined internally */
 int LISAGenerateInjectionReIm(
   struct tagLISAParams* injectedparams,       /* Input: set of LISA parameters of the injection */
@@ -283,6 +348,14 @@ int LISAGenerateInjectionReIm(
   int nbpts,                                  /* Input: number of frequency samples */
   int tagsampling,                            /* Input: tag for using linear (0) or logarithmic (1) sampling */
   struct tagLISAInjectionReIm* signal);       /* Output: structure for the generated signal */
+/* Same as above, with the reference time of the injection given explicitly instead of read from injectedparams */
+int LISAGenerateInjectionReImRefTime(
+  struct tagLISAParams* injectedparams,       /* Input: set of LISA parameters of the injection */
+  double fLow,                                /* Input: starting frequency */
+  int nbpts,                                  /* Input: number of frequency samples */
+  int tagsampling,                            /* Input: tag for using linear (0) or logarithmic (1) sampling */
+  struct tagLISAInjectionReIm* signal,        /* Output: structure for the generated signal */
+  double tRefinj);                            /* Input: reference time of the injection - params->tRef for a standalone injection */
 
 /*Wrapper for waveform generation with possibly a combination of EOBNRv2HMROM and TaylorF2*/
 /* Note: GenerateWaveform accepts masses and distances in SI units, whereas LISA params is in solar masses and Mpc */
@@ -338,6 +411,13 @@ double CosPriorToCube(double y, double x1, double x2);
 /* log-Likelihood functions */
 double CalculateLogLCAmpPhase(LISAParams *params, LISAInjectionCAmpPhase* injection);
 double CalculateLogLReIm(LISAParams *params, LISAInjectionReIm* injection);
+double CalculateLogLCAmpPhaseResponse(LISAParams *params, LISAInjectionCAmpPhase* injection, int frozenLISA, ResponseApproxtag responseapprox);
+
+/* Cheap surrogate log-likelihood (22 mode only, frozen-LISA and lowf response), and the matching injection */
+double CalculateLogLCAmpPhaseSurrogate(LISAParams *params, LISAInjectionCAmpPhase* surrogateinjection);
+int LISAGenerateInjectionCAmpPhaseSurrogate(LISAParams *params, LISAInjectionCAmpPhase* surrogateinjection);
+/* Report allocation counts of the arena used by CalculateLogLCAmpPhase in the calling thread */
+void ReportLikelihoodArena(FILE* f);
 
 /* Functions for simplified likelihood using precomputing relevant values */
 int LISAComputeSimpleLikelihoodPrecomputedValues22(SimpleLikelihoodPrecomputedValues22* simplelikelihoodvals22, LISAParams* params);
@@ -345,6 +425,14 @@ int LISAComputeSimpleLikelihoodPrecomputedValuesHM(SimpleLikelihoodPrecomputedVa
 double CalculateLogLSimpleLikelihood22(SimpleLikelihoodPrecomputedValues22* simplelikelihoodvals22, LISAParams* params);
 double CalculateLogLSimpleLikelihoodHM(SimpleLikelihoodPrecomputedValuesHM* simplelikelihoodvalsHM, LISAParams* params);
 
+/* Functions for the simplified HM likelihood with overlaps tabulated over (m1, m2, tRef) */
+int LISAComputeSimpleLikelihoodPrecomputedGridHM(SimpleLikelihoodPrecomputedGridHM** grid, LISAParams* params);
+int LISALoadOrComputeSimpleLikelihoodPrecomputedGridHM(SimpleLikelihoodPrecomputedGridHM** grid, LISAParams* params, const char* filename, int write);
+int Write_SimpleLikelihoodPrecomputedGridHM(const char* filename, SimpleLikelihoodPrecomputedGridHM* grid, LISAParams* params);
+int Read_SimpleLikelihoodPrecomputedGridHM(SimpleLikelihoodPrecomputedGridHM** grid, LISAParams* params, const char* filename);
+void SimpleLikelihoodPrecomputedGridHM_Cleanup(SimpleLikelihoodPrecomputedGridHM* grid);
+double CalculateLogLSimpleLikelihoodGridHM(SimpleLikelihoodPrecomputedGridHM* grid, LISAParams* params);
+
 /************ Global Parameters ************/
 
 extern LISAParams* injectedparams;
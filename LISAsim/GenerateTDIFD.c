@@ -67,11 +67,18 @@ Arguments are as follows:\n\
  --FFTfromtdfile       Option for loading time series and FFTing (default: false)\n\
  --nsamplesinfile      Number of lines of input file when loading TDI time series from file\n\
  --binaryin            Tag for loading the data in gsl binary form instead of text (default false)\n\
+ --columnarin          Tag for loading the data in binary columnar form, self-describing and mapped without copy - --nsamplesinfile is then not needed (default false)\n\
  --binaryout           Tag for outputting the data in gsl binary form instead of text (default false)\n\
+ --columnarout         Tag for outputting the data in binary columnar form (default false)\n\
+ --streamfft           With TDIFFT, output the downsampled spectrum of overlapping windowed segments instead of the full FFT, without loading the file - h_real holds sqrt of the segment-summed power, h_imag is 0 (default false)\n\
+ --nsegment            Number of samples in the segments for streamfft, power of 2 - sets the output deltaf to 1/(nsegment*deltat) (default 65536)\n\
  --indir               Input directory when loading TDI time series from file\n\
  --infile              Input file name when loading TDI time series from file\n\
  --outdir              Output directory\n\
  --outfileprefix       Output file name prefix, will output one file for each TDI channel with a built-in postfix\n\
+ --fftplanner          FFTW planning effort for the FFTs: estimate, measure or patient - plans are cached and reused for transforms of the same size (default estimate)\n\
+ --fftwisdom           File to import FFTW wisdom from, and to export it to at exit - makes measure/patient planning cheap in later runs (default none)\n\
+ --fftthreads          Number of threads for large FFTs, needs compiling with FFTW_THREADS (default 1)\n\
 \n";
 
     ssize_t i;
@@ -108,11 +115,17 @@ Arguments are as follows:\n\
     params->restorescaledfactor = 0;
     params->FFTfromtdfile = 0;
     params->nsamplesinfile = 0;    /* No default; has to be provided */
+    params->streamfft = 0;
+    params->nsegment = 65536;
     strcpy(params->indir, "");   /* No default; has to be provided */
     strcpy(params->infile, "");  /* No default; has to be provided */
     strcpy(params->outdir, ".");
     strcpy(params->outfileprefix, "generated_tdiFD");
 
+    params->fftplanner = FFTestimate;
+    strcpy(params->fftwisdom, "");
+    params->fftthreads = 1;
+
     /* Consume command line */
     for (i = 1; i < argc; ++i) {
         if (strcmp(argv[i], "--help") == 0) {
@@ -178,8 +191,16 @@ Arguments are as follows:\n\
             params->nsamplesinfile = atoi(argv[++i]);
         } else if (strcmp(argv[i], "--binaryin") == 0) {
           params->binaryin = 1;
+        } else if (strcmp(argv[i], "--columnarin") == 0) {
+          params->binaryin = FILE_COLUMNAR;
         } else if (strcmp(argv[i], "--binaryout") == 0) {
           params->binaryout = 1;
+        } else if (strcmp(argv[i], "--columnarout") == 0) {
+          params->binaryout = FILE_COLUMNAR;
+        } else if (strcmp(argv[i], "--streamfft") == 0) {
+          params->streamfft = 1;
+        } else if (strcmp(argv[i], "--nsegment") == 0) {
+          params->nsegment = atoi(argv[++i]);
         } else if (strcmp(argv[i], "--indir") == 0) {
             strcpy(params->indir, argv[++i]);
         } else if (strcmp(argv[i], "--infile") == 0) {
@@ -188,6 +209,12 @@ Arguments are as follows:\n\
             strcpy(params->outdir, argv[++i]);
         } else if (strcmp(argv[i], "--outfileprefix") == 0) {
             strcpy(params->outfileprefix, argv[++i]);
+        } else if (strcmp(argv[i], "--fftplanner") == 0) {
+            params->fftplanner = ParseFFTPlannertag(argv[++i]);
+        } else if (strcmp(argv[i], "--fftwisdom") == 0) {
+            strcpy(params->fftwisdom, argv[++i]);
+        } else if (strcmp(argv[i], "--fftthreads") == 0) {
+            params->fftthreads = atoi(argv[++i]);
         } else {
 	  printf("Error: invalid option: %s\n", argv[i]);
 	  goto fail;
@@ -283,20 +310,17 @@ static char* TDIFilePostfix(TDItag tditag, int channel, int binary)
 /* NOTE: assumes Amp/Phase format in the file, i.e. no complex amplitude */
 static void Read_Wave_h22(const char dir[], const char file[], ListmodesCAmpPhaseFrequencySeries** listhlm, int nsamples, int binary)
 {
-  /* Initalize and read input */
-  gsl_matrix* inmatrix =  gsl_matrix_alloc(nsamples, 3);
-  if (!binary) Read_Text_Matrix(dir, file, inmatrix);
-  else Read_Matrix(dir, file, inmatrix);
-  gsl_vector_view freqview = gsl_matrix_column(inmatrix, 0);
-  gsl_vector_view ampview = gsl_matrix_column(inmatrix, 1);
-  gsl_vector_view phaseview = gsl_matrix_column(inmatrix, 2);
-
-  /* Copy in frequency series */
-  CAmpPhaseFrequencySeries* h22 = NULL;
-  CAmpPhaseFrequencySeries_Init(&h22, nsamples);
-  gsl_vector_memcpy(h22->freq, &freqview.vector);
-  gsl_vector_memcpy(h22->amp_real, &ampview.vector);
-  gsl_vector_memcpy(h22->phase, &phaseview.vector);
+  /* Read input */
+  gsl_vector* columns[3];
+  int nbrows;
+  if(Read_Columns(columns, 3, &nbrows, dir, file, nsamples, binary)==FAILURE) exit(1);
+
+  /* Set frequency series - the columns are taken over */
+  CAmpPhaseFrequencySeries* h22 = ArenaMalloc(sizeof(CAmpPhaseFrequencySeries));
+  h22->freq = columns[0];
+  h22->amp_real = columns[1];
+  h22->phase = columns[2];
+  h22->amp_imag = ArenaVectorAlloc(nbrows);
   gsl_vector_set_zero(h22->amp_imag);
 
   /* Output */
@@ -306,30 +330,23 @@ static void Read_Wave_h22(const char dir[], const char file[], ListmodesCAmpPhas
 /* NOTE: assumes the same number of points is used to represent each mode */
 static void Read_TDITD3Chan( RealTimeSeries** TDI1, RealTimeSeries** TDI2, RealTimeSeries** TDI3, const char dir[], const char file[], const int nblines, const int binary)
 {
-  /* Initalize and read input */
-  gsl_matrix* inmatrix =  gsl_matrix_alloc(nblines, 4);
-  if(!binary) Read_Text_Matrix(dir, file, inmatrix);
-  else Read_Matrix(dir, file, inmatrix);
-
-  /* Initialize structures */
-  RealTimeSeries_Init(TDI1, nblines);
-  RealTimeSeries_Init(TDI2, nblines);
-  RealTimeSeries_Init(TDI3, nblines);
-
-  /* Set values */
-  gsl_vector_view timesview = gsl_matrix_column(inmatrix, 0);
-  gsl_vector_view TDI1view = gsl_matrix_column(inmatrix, 1);
-  gsl_vector_view TDI2view = gsl_matrix_column(inmatrix, 2);
-  gsl_vector_view TDI3view = gsl_matrix_column(inmatrix, 3);
-  gsl_vector_memcpy((*TDI1)->times, &timesview.vector);
-  gsl_vector_memcpy((*TDI2)->times, &timesview.vector);
-  gsl_vector_memcpy((*TDI3)->times, &timesview.vector);
-  gsl_vector_memcpy((*TDI1)->h, &TDI1view.vector);
-  gsl_vector_memcpy((*TDI2)->h, &TDI2view.vector);
-  gsl_vector_memcpy((*TDI3)->h, &TDI3view.vector);
-
-  /* Clean up */
-  gsl_matrix_free(inmatrix);
+  /* Read input - zero-copy for columnar files */
+  gsl_vector* columns[4];
+  int nbrows;
+  if(Read_Columns(columns, 4, &nbrows, dir, file, nblines, binary)==FAILURE) exit(1);
+
+  /* Set structures - the columns are taken over, each series but the first gets its own copy of the times */
+  *TDI1 = ArenaMalloc(sizeof(RealTimeSeries));
+  *TDI2 = ArenaMalloc(sizeof(RealTimeSeries));
+  *TDI3 = ArenaMalloc(sizeof(RealTimeSeries));
+  (*TDI1)->times = columns[0];
+  (*TDI2)->times = ArenaVectorAlloc(nbrows);
+  (*TDI3)->times = ArenaVectorAlloc(nbrows);
+  gsl_vector_memcpy((*TDI2)->times, columns[0]);
+  gsl_vector_memcpy((*TDI3)->times, columns[0]);
+  (*TDI1)->h = columns[1];
+  (*TDI2)->h = columns[2];
+  (*TDI3)->h = columns[3];
 }
 /* Output TDI mode contributions in downsampled form, FD AmpReal/AmpIm/Phase, all hlm modes in a single file */
 /* NOTE: assumes the same number of points is used to represent each mode */
@@ -360,8 +377,7 @@ static void Write_TDIhlm(const char dir[], const char file[], ListmodesCAmpPhase
   }
 
   /* Output */
-  if (!binary) Write_Text_Matrix(dir, file, outmatrix);
-  else Write_Matrix(dir, file, outmatrix);
+  Write_Table(dir, file, outmatrix, binary);
 }
 
 /***************** Main program *****************/
@@ -380,9 +396,40 @@ int main(int argc, char *argv[])
   /* Parse commandline to read parameters */
   parse_args_GenerateTDIFD(argc, argv, params);
 
+  /* Setup of the FFTW plans */
+  FFTSetup(params->fftplanner, params->fftwisdom, params->fftthreads);
+
   if(params->FFTfromtdfile) {
 
-    if(params->taggenwave==TDIFFT) {
+    if(params->taggenwave==TDIFFT && params->streamfft) {
+      /* Stream TD TDI from file by segments */
+      double t0 = 0., deltat = 0.;
+      int nsamples = params->nsamplesinfile;
+      if(Read_TimeSeriesFileSampling(&t0, &deltat, &nsamples, params->indir, params->infile, 4, params->binaryin)==FAILURE) exit(1);
+      double tend = t0 + (nsamples - 1)*deltat;
+      double twindowbeg = (params->twindowbeg==0.) ? 0.05 * (tend - t0) : params->twindowbeg; /* Here hardcoded relative window lengths */
+      double twindowend = (params->twindowend==0.) ? 0.01 * (tend - t0) : params->twindowend; /* Here hardcoded relative window lengths */
+      StreamingSpectrum* spectrum = NULL;
+      StreamingSpectrum_Init(&spectrum, 3, params->nsegment, deltat, t0, tend, twindowbeg, twindowend);
+      if(StreamingSpectrum_PushFile(spectrum, params->indir, params->infile, nsamples, params->binaryin)==FAILURE) exit(1);
+      StreamingSpectrum_Finalize(spectrum);
+
+      /* Output - one downsampled spectrum per channel */
+      int nbchan = (params->tagtdi==y12) ? 1 : 3;
+      char *outfileTDI = malloc(256);
+      for(int chan=0; chan<nbchan; chan++) {
+        ReImFrequencySeries* TDIspectrum = NULL;
+        StreamingSpectrum_GetFrequencySeries(&TDIspectrum, spectrum, chan);
+        sprintf(outfileTDI, "%s%s", params->outfileprefix, TDIFilePostfix(params->tagtdi, chan+1, params->binaryout));
+        Write_ReImFrequencySeries(params->outdir, outfileTDI, TDIspectrum, params->binaryout);
+        ReImFrequencySeries_Cleanup(TDIspectrum);
+      }
+      free(outfileTDI);
+      StreamingSpectrum_Cleanup(spectrum);
+
+      exit(0);
+    }
+    else if(params->taggenwave==TDIFFT) {
       /* Load TD TDI from file */
       RealTimeSeries* TDI1 = NULL;
       RealTimeSeries* TDI2 = NULL;
@@ -83,12 +83,17 @@ typedef struct tagGenTDIFDparams {
   int restorescaledfactor;   /* If 1, restore the factors that were scaled out of TDI observables */
   int FFTfromtdfile;         /* Option for loading time series and FFTing (default: false) */
   int nsamplesinfile;        /* Number of lines of input file */
-  int binaryin;              /* Tag for loading the data in gsl binary form instead of text (default false) */
-  int binaryout;             /* Tag for outputting the data in gsl binary form instead of text (default false) */
+  int binaryin;              /* Format of the input data: FILE_TEXT, FILE_BINARY (gsl binary) or FILE_COLUMNAR (default text) */
+  int binaryout;             /* Format of the output data: FILE_TEXT, FILE_BINARY (gsl binary) or FILE_COLUMNAR (default text) */
+  int streamfft;             /* With TDIFFT, output the downsampled power spectrum of overlapping windowed segments, without loading the file (default false) */
+  int nsegment;              /* Number of samples in the segments of the streamed FFT, power of 2 (default 65536) */
   char indir[256];           /* Path for the input directory */
   char infile[256];          /* Path for the input file */
   char outdir[256];          /* Path for the output directory */
   char outfileprefix[256];   /* Path for the output file */
+  FFTPlannertag fftplanner;  /* FFTW planning effort for the FFTs: estimate (default), measure or patient */
+  char fftwisdom[256];       /* File to import FFTW wisdom from and to export it to at exit (default none) */
+  int fftthreads;            /* Number of threads for large FFTs, needs FFTW_THREADS at compile time (default 1) */
 } GenTDIFDparams;
 
 
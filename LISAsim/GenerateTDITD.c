@@ -29,10 +29,18 @@ Arguments are as follows:\n\
  --nsamplesinfile      Number of lines of inputs file\n\
  --binaryin            Tag for loading the data in gsl binary form instead of text (default false)\n\
  --binaryout           Tag for outputting the data in gsl binary form instead of text (default false)\n\
+ --columnarin          Tag for loading the data in binary columnar form, self-describing and mapped without copy - --nsamplesinfile is then not needed (default false)\n\
+ --columnarout         Tag for outputting the data in binary columnar form (default false)\n\
  --indir               Input directory\n\
  --infile              Input file name\n\
  --outdir              Output directory\n\
  --outfile             Output file name\n\
+ --interp              Interpolation of the input on its uniform time grid: cspline (same as gsl_interp_cspline), lagrange or sinc (default cspline)\n\
+ --interporder         Number of points of the stencil for lagrange and sinc interpolation, even (default 8)\n\
+ --benchmarkinterp     Compare the interpolation of the input with the gsl cspline, in accuracy and time, print the result, and exit with an error if the maximal difference relative to max|input| exceeds --benchmarkinterptol (default false)\n\
+ --benchmarkinterptol  Tolerance of the comparison with the gsl cspline (default 1e-10 for cspline, which is the same interpolant up to rounding, 1e-3 for lagrange and sinc, which differ by their interpolation errors)\n\
+ --streaming           Process the hplus, hcross input by overlapping chunks and write the output as it goes, memory is bounded by the chunk size - same output as the full processing for lagrange and sinc; for cspline an approximation, each chunk having its own natural spline: the relative difference is at the level of rounding for a time step below ~15 s, and grows as 0.27^(500s/deltat) above (~2e-6 at 50 s) (default false)\n\
+ --chunksize           Number of output samples per chunk in streaming mode (default 1048576)\n\
 \n";
 
     ssize_t i;
@@ -51,6 +59,12 @@ Arguments are as follows:\n\
     strcpy(params->infile, "");  /* No default; has to be provided */
     strcpy(params->outdir, ".");
     strcpy(params->outfile, "generated_tdiTD.txt");
+    params->interp = UIcspline;
+    params->interporder = 8;
+    params->benchmarkinterp = 0;
+    params->benchmarkinterptol = 0.;
+    params->streaming = 0;
+    params->chunksize = 1048576;
 
     /* Consume command line */
     for (i = 1; i < argc; ++i) {
@@ -75,6 +89,10 @@ Arguments are as follows:\n\
             params->binaryin = 1;
         } else if (strcmp(argv[i], "--binaryout") == 0) {
             params->binaryout = 1;
+        } else if (strcmp(argv[i], "--columnarin") == 0) {
+            params->binaryin = FILE_COLUMNAR;
+        } else if (strcmp(argv[i], "--columnarout") == 0) {
+            params->binaryout = FILE_COLUMNAR;
         } else if (strcmp(argv[i], "--indir") == 0) {
             strcpy(params->indir, argv[++i]);
         } else if (strcmp(argv[i], "--infile") == 0) {
@@ -83,6 +101,18 @@ Arguments are as follows:\n\
             strcpy(params->outdir, argv[++i]);
         } else if (strcmp(argv[i], "--outfile") == 0) {
             strcpy(params->outfile, argv[++i]);
+        } else if (strcmp(argv[i], "--interp") == 0) {
+            params->interp = ParseUniformInterptag(argv[++i]);
+        } else if (strcmp(argv[i], "--interporder") == 0) {
+            params->interporder = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--benchmarkinterp") == 0) {
+            params->benchmarkinterp = 1;
+        } else if (strcmp(argv[i], "--benchmarkinterptol") == 0) {
+            params->benchmarkinterptol = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--streaming") == 0) {
+            params->streaming = 1;
+        } else if (strcmp(argv[i], "--chunksize") == 0) {
+            params->chunksize = atoi(argv[++i]);
         } else {
 	  printf("Error: invalid option: %s\n", argv[i]);
 	  goto fail;
@@ -101,47 +131,233 @@ Arguments are as follows:\n\
 /* NOTE: assumes the same number of points is used to represent each mode */
 static void Read_Wave_hphcTD( RealTimeSeries** hptd, RealTimeSeries** hctd, const char dir[], const char file[], const int nsamples, int binary)
 {
-  /* Initalize and read input */
-  gsl_matrix* inmatrix =  gsl_matrix_alloc(nsamples, 3);
-  if (!binary) Read_Text_Matrix(dir, file, inmatrix);
-  else Read_Matrix(dir, file, inmatrix);
-
-  /* Initialize structures */
-  RealTimeSeries_Init(hptd, nsamples);
-  RealTimeSeries_Init(hctd, nsamples);
-
-  /* Set values */
-  gsl_vector_view timesview = gsl_matrix_column(inmatrix, 0);
-  gsl_vector_view hptdview = gsl_matrix_column(inmatrix, 1);
-  gsl_vector_view hctdview = gsl_matrix_column(inmatrix, 2);
-  gsl_vector_memcpy((*hptd)->times, &timesview.vector);
-  gsl_vector_memcpy((*hctd)->times, &timesview.vector);
-  gsl_vector_memcpy((*hptd)->h, &hptdview.vector);
-  gsl_vector_memcpy((*hctd)->h, &hctdview.vector);
-
-  /* Clean up */
-  gsl_matrix_free(inmatrix);
+  /* Read input - zero-copy for columnar files */
+  gsl_vector* columns[3];
+  int nbrows;
+  if(Read_Columns(columns, 3, &nbrows, dir, file, nsamples, binary)==FAILURE) exit(1);
+
+  /* Set structures - the columns are taken over, hc gets its own copy of the times */
+  *hptd = ArenaMalloc(sizeof(RealTimeSeries));
+  *hctd = ArenaMalloc(sizeof(RealTimeSeries));
+  (*hptd)->times = columns[0];
+  (*hptd)->h = columns[1];
+  (*hctd)->times = ArenaVectorAlloc(nbrows);
+  gsl_vector_memcpy((*hctd)->times, columns[0]);
+  (*hctd)->h = columns[2];
 }
 /* Output TDI 3 channels TD - real time series */
 /* NOTE: assumes 3 channels with same times */
 static void Write_TDITD(const char dir[], const char file[], RealTimeSeries* TDI1, RealTimeSeries* TDI2, RealTimeSeries* TDI3, int binary)
 {
-  /* Initialize output */
   /* NOTE: assumes identical times for all 3 TDI observables */
-  int nbtimes = TDI1->times->size;
-  gsl_matrix* outmatrix = gsl_matrix_alloc(nbtimes, 4);
-
-  /* Set data */
-  gsl_matrix_set_col(outmatrix, 0, TDI1->times);
-  gsl_matrix_set_col(outmatrix, 1, TDI1->h);
-  gsl_matrix_set_col(outmatrix, 2, TDI2->h);
-  gsl_matrix_set_col(outmatrix, 3, TDI3->h);
-
-  /* Output */
-  if(!binary) Write_Text_Matrix(dir, file, outmatrix);
-  else Write_Matrix(dir, file, outmatrix);
+  gsl_vector* columns[4] = {TDI1->times, TDI1->h, TDI2->h, TDI3->h};
+  Write_Columns(dir, file, columns, 4, binary);
+}
+
+/* Compare the uniform-grid interpolation with the gsl cspline at off-grid times, in accuracy and time */
+/* Returns FAILURE if the maximal difference, relative to the maximal value, exceeds tol */
+static int BenchmarkUniformInterp(const char* name, gsl_vector* times, gsl_vector* values, UniformInterp* interp, double tol)
+{
+  int n = times->size;
+  int nbeval = 10*n;
+  double* tval = times->data;
+  double* x = (double*) malloc(sizeof(double)*nbeval);
+  double* valuesinterp = (double*) malloc(sizeof(double)*nbeval);
+  double* valuesgsl = (double*) malloc(sizeof(double)*nbeval);
+  /* Quasi-random fractional positions in the domain, visited in a random-access order as for delayed times */
+  for(int k=0; k<nbeval; k++) {
+    double u = fmod(k*0.6180339887498949, 1.);
+    x[k] = tval[0] + u*(tval[n-1] - tval[0]);
+  }
+
+  gsl_interp_accel* accel = gsl_interp_accel_alloc();
+  gsl_spline* spline = gsl_spline_alloc(gsl_interp_cspline, n);
+  gsl_spline_init(spline, tval, values->data, n);
+  clock_t begin = clock();
+  for(int k=0; k<nbeval; k++) valuesgsl[k] = gsl_spline_eval(spline, x[k], accel);
+  double timegsl = (double) (clock() - begin)/CLOCKS_PER_SEC;
+  begin = clock();
+  UniformInterp_EvalArray(interp, x, valuesinterp, nbeval);
+  double timeinterp = (double) (clock() - begin)/CLOCKS_PER_SEC;
+
+  double maxerr = 0., maxval = 0.;
+  for(int k=0; k<nbeval; k++) {
+    maxerr = fmax(maxerr, fabs(valuesinterp[k] - valuesgsl[k]));
+    maxval = fmax(maxval, fabs(valuesgsl[k]));
+  }
+  double reldiff = (maxval>0.) ? maxerr/maxval : maxerr;
+  printf("%s: %d evaluations, max relative difference to gsl cspline %g (tolerance %g), time gsl %g s, time uniform grid %g s\n", name, nbeval, reldiff, tol, timegsl, timeinterp);
+
+  gsl_spline_free(spline);
+  gsl_interp_accel_free(accel);
+  free(x);
+  free(valuesinterp);
+  free(valuesgsl);
+  return (reldiff <= tol) ? SUCCESS : FAILURE;
+}
+
+/* Runs the comparison with the gsl cspline for the two interpolated inputs, exits on failure */
+static void CheckUniformInterp(const char* name1, const char* name2, gsl_vector* times, gsl_vector* values1, gsl_vector* values2, UniformInterp* interp1, UniformInterp* interp2, GenTDITDparams* params)
+{
+  double tol = params->benchmarkinterptol;
+  if(tol<=0.) tol = (params->interp==UIcspline) ? 1e-10 : 1e-3;
+  int ret = BenchmarkUniformInterp(name1, times, values1, interp1, tol);
+  ret |= BenchmarkUniformInterp(name2, times, values2, interp2, tol);
+  if(ret==FAILURE) {
+    printf("Error in GenerateTDITD: the interpolation differs from the gsl cspline by more than the tolerance %g.\n", tol);
+    exit(1);
+  }
+}
+
+/* Read nrows rows of nbcols values, in text or binary (gsl_matrix_fwrite) format - or from the mapped columns of a columnar file cf, starting at row *next */
+static int Read_Rows(FILE* f, ColumnarFile* cf, int* next, double* rows, int nrows, int nbcols, int binary)
+{
+  if(cf) {
+    if(*next + nrows > cf->header.nrows) return FAILURE;
+    for(int j=0; j<nbcols; j++) {
+      const double* column = ColumnarFile_Column(cf, j) + *next;
+      for(int k=0; k<nrows; k++) rows[k*nbcols + j] = column[k];
+    }
+    *next += nrows;
+    return SUCCESS;
+  }
+  if(binary) return (fread(rows, sizeof(double), nrows*nbcols, f) == (size_t) (nrows*nbcols)) ? SUCCESS : FAILURE;
+  for(int k=0; k<nrows*nbcols; k++) {
+    if(fscanf(f, "%lg", &(rows[k])) != 1) return FAILURE;
+  }
+  return SUCCESS;
 }
 
+/* Streaming version of the processing of hplus, hcross into TDI */
+/* Output chunks of chunksize samples are computed from the input extended by the margin nptmargin on both sides, so that delays never reach outside */
+/* The margins of the full series are set to 0 as in the non-streaming case - the output is identical for lagrange and sinc, whose stencils stay inside the window */
+/* For cspline the natural end conditions of the window change the spline by ~0.27^k at k samples from its edges, and output times are evaluated at least nptmargin/2 = R/(c deltat) samples inside: differences are at the level of rounding for deltat below ~15 s */
+/* Columnar input is read from the mapped columns; columnar output is not supported, as columns are written one after the other */
+static void GenerateTDITD_Streaming(LISAconstellation* variant, GenTDITDparams* params)
+{
+  int nsamples = params->nsamplesinfile;
+  int nchunk = params->chunksize;
+  if(params->binaryout==FILE_COLUMNAR) {
+    printf("Error in GenerateTDITD_Streaming: columnar output is not supported in streaming mode.\n");
+    exit(1);
+  }
+  char *pathin = malloc(strlen(params->indir)+strlen(params->infile)+2);
+  char *pathout = malloc(strlen(params->outdir)+strlen(params->outfile)+2);
+  sprintf(pathin, "%s/%s", params->indir, params->infile);
+  sprintf(pathout, "%s/%s", params->outdir, params->outfile);
+  FILE* fin = NULL;
+  ColumnarFile* cfin = NULL;
+  int nextrow = 0;
+  if(params->binaryin==FILE_COLUMNAR || IsColumnarFile(params->indir, params->infile)) {
+    if(ColumnarFile_Open(&cfin, params->indir, params->infile, 1)==FAILURE || cfin->header.ncols!=3) {
+      printf("Error in GenerateTDITD_Streaming: could not read %s as a columnar file with 3 columns.\n", pathin);
+      exit(1);
+    }
+    nsamples = (int) cfin->header.nrows;
+  }
+  else fin = fopen(pathin, "rb");
+  FILE* fout = fopen(pathout, params->binaryout ? "wb" : "w");
+  if((!fin && !cfin) || !fout) {
+    printf("Error in GenerateTDITD_Streaming: could not open %s or %s.\n", pathin, pathout);
+    exit(1);
+  }
+
+  /* The first two rows give the time step, and with it the margin */
+  double firstrows[6];
+  if(nsamples<2 || Read_Rows(fin, cfin, &nextrow, firstrows, 2, 3, params->binaryin)==FAILURE) {
+    printf("Error in GenerateTDITD_Streaming: could not read %s.\n", pathin);
+    exit(1);
+  }
+  double maxdelay = variant->OrbitR/C_SI;
+  double deltat = firstrows[3] - firstrows[0];
+  int nptmargin = 2 * (int)(maxdelay/deltat);
+
+  /* Input window, holding at most the chunk and the margins on both sides - first index of the window in the full series is w0 */
+  int capacity = nchunk + 2*nptmargin;
+  double* rows = (double*) malloc(sizeof(double)*3*capacity);
+  double* tbuf = (double*) malloc(sizeof(double)*capacity);
+  double* hpbuf = (double*) malloc(sizeof(double)*capacity);
+  double* hcbuf = (double*) malloc(sizeof(double)*capacity);
+  for(int k=0; k<2; k++) {
+    tbuf[k] = firstrows[3*k];
+    hpbuf[k] = firstrows[3*k+1];
+    hcbuf[k] = firstrows[3*k+2];
+  }
+  int w0 = 0;
+  int nbuf = 2;
+
+  /* Interpolations of the window - reinitialized in place for each chunk, reusing their buffers */
+  UniformInterp* interp_hp = NULL;
+  UniformInterp* interp_hc = NULL;
+
+  for(int i0=0; i0<nsamples; i0+=nchunk) {
+    int i1 = min(i0 + nchunk, nsamples);
+
+    /* Slide the window: drop what is before i0 - nptmargin, read up to i1 + nptmargin */
+    int shift = max(0, i0 - nptmargin) - w0;
+    if(shift>0) {
+      memmove(tbuf, &(tbuf[shift]), sizeof(double)*(nbuf-shift));
+      memmove(hpbuf, &(hpbuf[shift]), sizeof(double)*(nbuf-shift));
+      memmove(hcbuf, &(hcbuf[shift]), sizeof(double)*(nbuf-shift));
+      nbuf -= shift;
+      w0 += shift;
+    }
+    int nnew = min(nsamples, i1 + nptmargin) - (w0 + nbuf);
+    if(nnew>0) {
+      if(Read_Rows(fin, cfin, &nextrow, rows, nnew, 3, params->binaryin)==FAILURE) {
+        printf("Error in GenerateTDITD_Streaming: could not read %s.\n", pathin);
+        exit(1);
+      }
+      for(int k=0; k<nnew; k++) {
+        tbuf[nbuf+k] = rows[3*k];
+        hpbuf[nbuf+k] = rows[3*k+1];
+        hcbuf[nbuf+k] = rows[3*k+2];
+      }
+      nbuf += nnew;
+    }
+
+    /* Evaluate TDI on the window - samples within nptmargin of the window edges are set to 0, and are only kept at the edges of the full series */
+    RealTimeSeries* TDI1 = NULL;
+    RealTimeSeries* TDI2 = NULL;
+    RealTimeSeries* TDI3 = NULL;
+    UniformInterp_Init(&interp_hp, tbuf, hpbuf, nbuf, params->interp, params->interporder);
+    UniformInterp_Init(&interp_hc, tbuf, hcbuf, nbuf, params->interp, params->interporder);
+    gsl_vector_view timesview = gsl_vector_view_array(tbuf, nbuf);
+    GenerateTDITD3Chanhphc(variant, &TDI1, &TDI2, &TDI3, interp_hp, interp_hc, &timesview.vector, nptmargin, params->tagtdi);
+
+    /* Output of the samples [i0, i1) - same format as Write_TDITD */
+    int ret = 0;
+    for(int i=i0-w0; i<i1-w0; i++) {
+      double outrow[4] = {tbuf[i], gsl_vector_get(TDI1->h, i), gsl_vector_get(TDI2->h, i), gsl_vector_get(TDI3->h, i)};
+      if(params->binaryout) ret |= (fwrite(outrow, sizeof(double), 4, fout) != 4);
+      else {
+        if(i+w0>0) ret |= (fprintf(fout, "\n") < 0);
+        for(int j=0; j<4; j++) ret |= (fprintf(fout, "%.16e ", outrow[j]) < 0);
+      }
+    }
+    if(ret) {
+      printf("Error in GenerateTDITD_Streaming: could not write to %s.\n", pathout);
+      exit(1);
+    }
+
+    RealTimeSeries_Cleanup(TDI1);
+    RealTimeSeries_Cleanup(TDI2);
+    RealTimeSeries_Cleanup(TDI3);
+  }
+
+  /* Clean up */
+  UniformInterp_Cleanup(interp_hp);
+  UniformInterp_Cleanup(interp_hc);
+  if(fin) fclose(fin);
+  if(cfin) ColumnarFile_Close(cfin);
+  fclose(fout);
+  free(pathin);
+  free(pathout);
+  free(rows);
+  free(tbuf);
+  free(hpbuf);
+  free(hcbuf);
+}
 
 /***************** Main program *****************/
 
@@ -164,23 +380,30 @@ int main(int argc, char *argv[])
 
   /* Set aside the cases of the orbital delay and constellation response - written with TD amp/phase */
   /* If not using those tags, use the old processing that uses TD hplus, hcross interpolated */
-  if(!(params->tagtdi==delayO) && !(params->tagtdi==y12L) && !(params->tagtdi==y12)) {
+  if(params->streaming) {
+    if((params->tagtdi==delayO) || (params->tagtdi==y12L) || (params->tagtdi==y12)) {
+      printf("Error in GenerateTDITD: streaming mode supports only hplus, hcross input (TDIXYZ, TDIAETXYZ).\n");
+      exit(1);
+    }
+    GenerateTDITD_Streaming(variant, params);
+  }
+
+  else if(!(params->tagtdi==delayO) && !(params->tagtdi==y12L) && !(params->tagtdi==y12)) {
 
     /* Load TD hp, hc from file */
     RealTimeSeries* hptd = NULL;
     RealTimeSeries* hctd = NULL;
     Read_Wave_hphcTD(&hptd, &hctd, params->indir, params->infile, params->nsamplesinfile, params->binaryin);
 
-    /* Interpolate hp, hc with gsl spline */
+    /* Interpolate hp, hc on their uniform time grid */
     /* NOTE: assumes indentical times vector */
     gsl_vector* times = hptd->times;
     int nbtimes = times->size;
-    gsl_interp_accel* accel_hp = gsl_interp_accel_alloc();
-    gsl_interp_accel* accel_hc = gsl_interp_accel_alloc();
-    gsl_spline* spline_hp = gsl_spline_alloc(gsl_interp_cspline, nbtimes);
-    gsl_spline* spline_hc = gsl_spline_alloc(gsl_interp_cspline, nbtimes);
-    gsl_spline_init(spline_hp, gsl_vector_const_ptr(hptd->times,0), gsl_vector_const_ptr(hptd->h,0), nbtimes);
-    gsl_spline_init(spline_hc, gsl_vector_const_ptr(hctd->times,0), gsl_vector_const_ptr(hctd->h,0), nbtimes);
+    UniformInterp* interp_hp = NULL;
+    UniformInterp* interp_hc = NULL;
+    UniformInterp_Init(&interp_hp, gsl_vector_const_ptr(hptd->times,0), gsl_vector_const_ptr(hptd->h,0), nbtimes, params->interp, params->interporder);
+    UniformInterp_Init(&interp_hc, gsl_vector_const_ptr(hctd->times,0), gsl_vector_const_ptr(hctd->h,0), nbtimes, params->interp, params->interporder);
+    if(params->benchmarkinterp) CheckUniformInterp("hplus", "hcross", hptd->times, hptd->h, hctd->h, interp_hp, interp_hc, params);
 
     /* Here, hardcoded time margin that we will set to 0 on both sides, to avoid problems with delays extending past the input values */
     /* We take R/c as the maximum delay that can occur in the response, and adjust the margin accordingly */
@@ -192,10 +415,14 @@ int main(int argc, char *argv[])
     RealTimeSeries* TDI1 = NULL;
     RealTimeSeries* TDI2 = NULL;
     RealTimeSeries* TDI3 = NULL;
-    GenerateTDITD3Chanhphc(variant, &TDI1, &TDI2, &TDI3, spline_hp, spline_hc, accel_hp, accel_hc, times, nptmargin, params->tagtdi);
+    GenerateTDITD3Chanhphc(variant, &TDI1, &TDI2, &TDI3, interp_hp, interp_hc, times, nptmargin, params->tagtdi);
 
     /* Output */
     Write_TDITD(params->outdir, params->outfile, TDI1, TDI2, TDI3, params->binaryout);
+
+    /* Clean up */
+    UniformInterp_Cleanup(interp_hp);
+    UniformInterp_Cleanup(interp_hc);
   }
 
   /* Set aside the cases of the orbital delay and constellation response - written with TD amp/phase */
@@ -205,15 +432,14 @@ int main(int argc, char *argv[])
     AmpPhaseTimeSeries* h22td = NULL;
     Read_AmpPhaseTimeSeries(&h22td, params->indir, params->infile, params->nsamplesinfile, params->binaryin);
 
-    /* Interpolate amp, phase with gsl spline */
+    /* Interpolate amp, phase on their uniform time grid */
     gsl_vector* times = h22td->times;
     int nbtimes = times->size;
-    gsl_interp_accel* accel_amp = gsl_interp_accel_alloc();
-    gsl_interp_accel* accel_phase = gsl_interp_accel_alloc();
-    gsl_spline* spline_amp = gsl_spline_alloc(gsl_interp_cspline, nbtimes);
-    gsl_spline* spline_phase = gsl_spline_alloc(gsl_interp_cspline, nbtimes);
-    gsl_spline_init(spline_amp, gsl_vector_const_ptr(h22td->times,0), gsl_vector_const_ptr(h22td->h_amp,0), nbtimes);
-    gsl_spline_init(spline_phase, gsl_vector_const_ptr(h22td->times,0), gsl_vector_const_ptr(h22td->h_phase,0), nbtimes);
+    UniformInterp* interp_amp = NULL;
+    UniformInterp* interp_phase = NULL;
+    UniformInterp_Init(&interp_amp, gsl_vector_const_ptr(h22td->times,0), gsl_vector_const_ptr(h22td->h_amp,0), nbtimes, params->interp, params->interporder);
+    UniformInterp_Init(&interp_phase, gsl_vector_const_ptr(h22td->times,0), gsl_vector_const_ptr(h22td->h_phase,0), nbtimes, params->interp, params->interporder);
+    if(params->benchmarkinterp) CheckUniformInterp("amplitude", "phase", h22td->times, h22td->h_amp, h22td->h_phase, interp_amp, interp_phase, params);
 
     /* Here, hardcoded time margin that we will set to 0 on both sides, to avoid problems with delays extending past the input values */
     /* We take R/c as the maximum delay that can occur in the response, and adjust the margin accordingly */
@@ -224,7 +450,7 @@ int main(int argc, char *argv[])
     if(params->tagtdi==delayO) {
       /* Evaluate orbital-delayed signal */
       AmpPhaseTimeSeries* h22tdO = NULL;
-      Generateh22TDO(variant, &h22tdO, spline_amp, spline_phase, accel_amp, accel_phase, times, nptmargin);
+      Generateh22TDO(variant, &h22tdO, interp_amp, interp_phase, times, nptmargin);
 
       /* Output */
       Write_AmpPhaseTimeSeries(params->outdir, params->outfile, h22tdO, params->binaryout);
@@ -233,7 +459,7 @@ int main(int argc, char *argv[])
     else if(params->tagtdi==y12L) {
       /* Evaluate y12 signal - constellation response only, input assumed to be h22tdO already */
       RealTimeSeries* y12td = NULL;
-      Generatey12LTD(variant, &y12td, spline_amp, spline_phase, accel_amp, accel_phase, times, params->inclination, params->phiRef, nptmargin);
+      Generatey12LTD(variant, &y12td, interp_amp, interp_phase, times, params->inclination, params->phiRef, nptmargin);
 
       /* Output */
       Write_RealTimeSeries(params->outdir, params->outfile, y12td, params->binaryout);
@@ -242,10 +468,14 @@ int main(int argc, char *argv[])
     else if(params->tagtdi==y12) {
       /* Evaluate y12 signal - constellation response only, input assumed to be h22tdO already */
       RealTimeSeries* y12td = NULL;
-      Generatey12TD(variant, &y12td, spline_amp, spline_phase, accel_amp, accel_phase, times, params->inclination, params->phiRef, nptmargin);
+      Generatey12TD(variant, &y12td, interp_amp, interp_phase, times, params->inclination, params->phiRef, nptmargin);
 
       /* Output */
       Write_RealTimeSeries(params->outdir, params->outfile, y12td, params->binaryout);
     }
+
+    /* Clean up */
+    UniformInterp_Cleanup(interp_amp);
+    UniformInterp_Cleanup(interp_phase);
   }
 }
@@ -55,12 +55,18 @@ typedef struct tagGenTDITDparams {
   double polarization;       /* polarization angle (rad, default 0) */
   int tagtdi;                /* Tag selecting the desired output format */
   int nsamplesinfile;        /* Number of lines of input file */
-  int binaryin;              /* Tag for loading the data in gsl binary form instead of text (default false) */
-  int binaryout;             /* Tag for outputting the data in gsl binary form instead of text (default false) */
+  int binaryin;              /* Format of the input data: FILE_TEXT, FILE_BINARY (gsl binary) or FILE_COLUMNAR (default text) */
+  int binaryout;             /* Format of the output data: FILE_TEXT, FILE_BINARY (gsl binary) or FILE_COLUMNAR (default text) */
   char indir[256];           /* Path for the input directory */
   char infile[256];          /* Path for the input file */
   char outdir[256];          /* Path for the output directory */
   char outfile[256];         /* Path for the output file */
+  UniformInterptag interp;   /* Interpolation of the input on its uniform grid: cspline (default, as gsl_interp_cspline), lagrange or sinc */
+  int interporder;           /* Number of points of the stencil for lagrange and sinc interpolation (default 8) */
+  int benchmarkinterp;       /* Option to compare the interpolation with the gsl cspline, in accuracy and time, print the result and fail above benchmarkinterptol (default false) */
+  double benchmarkinterptol; /* Tolerance on the maximal difference to the gsl cspline, relative to the maximal value (default 0: 1e-10 for cspline, 1e-3 for lagrange and sinc) */
+  int streaming;             /* Option to process the hplus, hcross input by chunks and to write the output incrementally, with memory bounded by the chunk size (default false) */
+  int chunksize;             /* Number of output samples per chunk in streaming mode (default 2^20) */
 } GenTDITDparams;
 
 
@@ -275,6 +275,21 @@ int LISASimFDResponseTDI3Chan(
   /* Chirp mass for resampling */
   double mchirp = Mchirpofm1m2(m1, m2);
 
+  /* Fast paths - for a constellation frozen at torb, the geometry is computed once for all modes and frequencies, and tf is not needed */
+  /* The R-delay phase is then linear in f - it vanishes for lowf, and when tRef refers to the arrival at LISA */
+  /* If in addition the response is lowf or lowfL, the G_AB's and the TDI factors (without delays) are linear in f: one complex factor per mode and channel */
+  int lowfresponse = (responseapprox==lowf)||(responseapprox==lowfL);
+  LISAGABGeometry geometryfrozen;
+  double coeffRdelayfrozen = 0.;
+  if(tagfrozenLISA) {
+    EvaluateGABGeometry(variant, &geometryfrozen, torb);
+    if(tagtRefatLISA==0 && !(responseapprox==lowf)) {
+      double phaseorb = variant->OrbitOmega*torb + variant->OrbitPhi0 - lambda;
+      double OrbitRoC = variant->OrbitR/C_SI;
+      coeffRdelayfrozen = -2*PI*OrbitRoC*cos(beta)*cos(phaseorb) * (1 + cos(beta)*OrbitRoC*variant->OrbitOmega*sin(phaseorb));
+    }
+  }
+
   /* Main loop over the modes - goes through all the modes present, stopping when encountering NULL */
   ListmodesCAmpPhaseFrequencySeries* listelement = *list;
   while(listelement) {
@@ -296,19 +311,9 @@ int LISASimFDResponseTDI3Chan(
     //      if(l==2&&m==1) {for(int i=0; i<len; i++) printf("%d, %g, %g, %g, %g\n", i, gsl_vector_get(freq, i), gsl_vector_get(amp_real, i), gsl_vector_get(amp_imag, i), gsl_vector_get(phase, i));};
 
     double f, tf, tforb;
-    double complex g21mode = 0.;
-    double complex g12mode = 0.;
-    double complex g32mode = 0.;
-    double complex g23mode = 0.;
-    double complex g13mode = 0.;
-    double complex g31mode = 0.;
-    double complex camp;
     double complex camp1;
     double complex camp2;
     double complex camp3;
-    double complex factor1 = 0.;
-    double complex factor2 = 0.;
-    double complex factor3 = 0.;
 
     /* Computing the Ylm combined factors for plus and cross for this mode */
     /* Capital Phi is set to 0 by convention */
@@ -323,10 +328,14 @@ int LISASimFDResponseTDI3Chan(
       Yfactorcross = I/2 * (SpinWeightedSphericalHarmonic(inclination, 0., -2, l, m) + conj(SpinWeightedSphericalHarmonic(inclination, 0., -2, l, -m)));
     }
 
-    /* Initializing spline for the phase - will be used to compute tf */
-    gsl_spline* spline_phi = gsl_spline_alloc(gsl_interp_cspline, len);
-    gsl_interp_accel* accel_phi = gsl_interp_accel_alloc();
-    gsl_spline_init(spline_phi, gsl_vector_const_ptr(freq, 0), gsl_vector_const_ptr(phase, 0), len);
+    /* Initializing spline for the phase - will be used to compute tf - not needed if the orbit is frozen */
+    gsl_spline* spline_phi = NULL;
+    gsl_interp_accel* accel_phi = NULL;
+    if(!(tagfrozenLISA)) {
+      spline_phi = gsl_spline_alloc(gsl_interp_cspline, len);
+      accel_phi = gsl_interp_accel_alloc();
+      gsl_spline_init(spline_phi, gsl_vector_const_ptr(freq, 0), gsl_vector_const_ptr(phase, 0), len);
+    }
 
     /* Resampling at high f to achieve a deltaf of at most 0.002 Hz */
     /* Resample linearly at this deltaf when this threshold is reached */
@@ -449,58 +458,94 @@ int LISASimFDResponseTDI3Chan(
     gsl_vector* amp_imag3 = modefreqseries3->amp_imag;
     gsl_vector* phase3 = modefreqseries3->phase;
 
-    /* Loop over the frequencies */
-    //clock_t tbegcontesllation = clock();
-    //double timingcumulativeGABmode = 0;
-    for(int j=0; j<len_resample; j++) {
-      f = gsl_vector_get(freq_resample, j);
-      tf = (gsl_spline_eval_deriv(spline_phi, f, accel_phi))/(2*PI);
-      /* tf read from hlm is t-tinj - here convert to orbital time using torb - ignore tf if orbit is frozen */
-      if(!(tagfrozenLISA)) {
-        tforb = tf + torb;
-      } else {
-        tforb = torb;
+    /* GAB's and TDI factors for all frequencies - the TDI combination is applied afterwards, by a kernel specialized for the TDI tag and approximation */
+    double complex* G = ArenaMalloc(6*len_resample*sizeof(double complex));
+    double complex* factors = ArenaMalloc(3*len_resample*sizeof(double complex));
+
+    if(tagfrozenLISA && lowfresponse) {
+      /* Frozen and lowf/lowfL: G_AB's and TDI factors evaluated once at f=1, and scaled by f */
+      double complex Gunit[6];
+      double complex factorunit1, factorunit2, factorunit3;
+      EvaluateGABmodeFromGeometry(variant, &Gunit[0], &Gunit[1], &Gunit[2], &Gunit[3], &Gunit[4], &Gunit[5], &geometryfrozen, 1., Yfactorplus, Yfactorcross, 0, responseapprox);
+      EvaluateTDIfactor3Chan(variant, &factorunit1, &factorunit2, &factorunit3, Gunit[0], Gunit[1], Gunit[2], Gunit[3], Gunit[4], Gunit[5], 1., tditag, responseapprox);
+      for(int j=0; j<len_resample; j++) {
+        f = gsl_vector_get(freq_resample, j);
+        factors[j] = f * factorunit1;
+        factors[len_resample + j] = f * factorunit2;
+        factors[2*len_resample + j] = f * factorunit3;
+        double phasewithRdelay = gsl_vector_get(phase_resample, j) + coeffRdelayfrozen*f;
+        gsl_vector_set(phase1, j, phasewithRdelay);
+        gsl_vector_set(phase2, j, phasewithRdelay);
+        gsl_vector_set(phase3, j, phasewithRdelay);
       }
-      //clock_t tbegGAB = clock();
-      EvaluateGABmode(variant, &g12mode, &g21mode, &g23mode, &g32mode, &g31mode, &g13mode, f, tforb, Yfactorplus, Yfactorcross, 0, responseapprox); /* does not include the R-delay term */
-      //clock_t tendGAB = clock();
-      //timingcumulativeGABmode += (double) (tendGAB-tbegGAB) /CLOCKS_PER_SEC;
-      /**/
-      EvaluateTDIfactor3Chan(variant, &factor1, &factor2, &factor3, g12mode, g21mode, g23mode, g32mode, g31mode, g13mode, f, tditag, responseapprox);
-      double complex amphtilde = gsl_vector_get(amp_real_resample, j) + I * gsl_vector_get(amp_imag_resample, j);
-      camp1 = factor1 * amphtilde;
-      camp2 = factor2 * amphtilde;
-      camp3 = factor3 * amphtilde;
-      /* Phase term due to the R-delay, including correction to first order */
-      double phase=variant->OrbitOmega*tforb + variant->OrbitPhi0 - lambda;
-      double OrbitRoC=variant->OrbitR/C_SI;
-      //double phaseRdelay = -2*PI*R_SI/C_SI*f*cos(beta)*cos(Omega_SI*tf - lambda) * (1 + R_SI/C_SI*cos(beta)*Omega_SI*sin(Omega_SI*tf - lambda));
-      double phaseRdelay;
-      if(tagtRefatLISA==0){//delay so that tinj=torb refers to arrival time at SSB
-        phaseRdelay = -2*PI*OrbitRoC*f*cos(beta)*cos(phase) * (1 + cos(beta)*OrbitRoC*variant->OrbitOmega*sin(phase));
-      } else {
-        //In this version we delay so that tinj=torb is relative to LISAcenter arrival time, so there is no orbital delay when tf = tinj
-        //If the original delay realized td=t+d(t), now we want td=t+d(t)-d(t0), that we we change d(t) -> d(t) + d(t0)
-        //Then with the approximation d(td)=d(t)(1-ddot(t)),
-        double phase0 = variant->OrbitOmega*torb + variant->OrbitPhi0 - lambda;
-        phaseRdelay = -2*PI*OrbitRoC*f*cos(beta)*( cos(phase)-cos(phase0) ) * (1 + cos(beta)*OrbitRoC*variant->OrbitOmega*sin(phase));
+    }
+    else if(tagfrozenLISA) {
+      /* Frozen: only the frequency-dependent transfer factors are evaluated */
+      for(int j=0; j<len_resample; j++) {
+        f = gsl_vector_get(freq_resample, j);
+        EvaluateGABmodeFromGeometry(variant, &G[6*j], &G[6*j+1], &G[6*j+2], &G[6*j+3], &G[6*j+4], &G[6*j+5], &geometryfrozen, f, Yfactorplus, Yfactorcross, 0, responseapprox); /* does not include the R-delay term */
+        double phasewithRdelay = gsl_vector_get(phase_resample, j) + coeffRdelayfrozen*f;
+        gsl_vector_set(phase1, j, phasewithRdelay);
+        gsl_vector_set(phase2, j, phasewithRdelay);
+        gsl_vector_set(phase3, j, phasewithRdelay);
       }
-      if(responseapprox==lowf) { /* In the full low-f approximation, ignore this delay term */
-        phaseRdelay = 0.;
+      EvaluateTDIfactor3ChanSeries(variant, factors, factors + len_resample, factors + 2*len_resample, G, gsl_vector_const_ptr(freq_resample, 0), len_resample, tditag, responseapprox);
+    }
+    else {
+      /* Loop over the frequencies */
+      //clock_t tbegcontesllation = clock();
+      //double timingcumulativeGABmode = 0;
+      for(int j=0; j<len_resample; j++) {
+        f = gsl_vector_get(freq_resample, j);
+        tf = (gsl_spline_eval_deriv(spline_phi, f, accel_phi))/(2*PI);
+        /* tf read from hlm is t-tinj - here convert to orbital time using torb */
+        tforb = tf + torb;
+        //clock_t tbegGAB = clock();
+        EvaluateGABmode(variant, &G[6*j], &G[6*j+1], &G[6*j+2], &G[6*j+3], &G[6*j+4], &G[6*j+5], f, tforb, Yfactorplus, Yfactorcross, 0, responseapprox); /* does not include the R-delay term */
+        //clock_t tendGAB = clock();
+        //timingcumulativeGABmode += (double) (tendGAB-tbegGAB) /CLOCKS_PER_SEC;
+        /* Phase term due to the R-delay, including correction to first order - in the full low-f approximation, ignore this delay term */
+        double phaseRdelay = 0.;
+        if(!(responseapprox==lowf)) {
+          double phase=variant->OrbitOmega*tforb + variant->OrbitPhi0 - lambda;
+          double OrbitRoC=variant->OrbitR/C_SI;
+          //double phaseRdelay = -2*PI*R_SI/C_SI*f*cos(beta)*cos(Omega_SI*tf - lambda) * (1 + R_SI/C_SI*cos(beta)*Omega_SI*sin(Omega_SI*tf - lambda));
+          if(tagtRefatLISA==0){//delay so that tinj=torb refers to arrival time at SSB
+            phaseRdelay = -2*PI*OrbitRoC*f*cos(beta)*cos(phase) * (1 + cos(beta)*OrbitRoC*variant->OrbitOmega*sin(phase));
+          } else {
+            //In this version we delay so that tinj=torb is relative to LISAcenter arrival time, so there is no orbital delay when tf = tinj
+            //If the original delay realized td=t+d(t), now we want td=t+d(t)-d(t0), that we we change d(t) -> d(t) + d(t0)
+            //Then with the approximation d(td)=d(t)(1-ddot(t)),
+            double phase0 = variant->OrbitOmega*torb + variant->OrbitPhi0 - lambda;
+            phaseRdelay = -2*PI*OrbitRoC*f*cos(beta)*( cos(phase)-cos(phase0) ) * (1 + cos(beta)*OrbitRoC*variant->OrbitOmega*sin(phase));
+          }
+        }
+        double phasewithRdelay = gsl_vector_get(phase_resample, j) + phaseRdelay;
+
+        /**/
+        gsl_vector_set(phase1, j, phasewithRdelay);
+        gsl_vector_set(phase2, j, phasewithRdelay);
+        gsl_vector_set(phase3, j, phasewithRdelay);
       }
-      double phasewithRdelay = gsl_vector_get(phase_resample, j) + phaseRdelay;
+      /* TDI factors, dispatched once for the mode */
+      EvaluateTDIfactor3ChanSeries(variant, factors, factors + len_resample, factors + 2*len_resample, G, gsl_vector_const_ptr(freq_resample, 0), len_resample, tditag, responseapprox);
+    }
 
-      /**/
+    /* Complex amplitudes of the three channels */
+    for(int j=0; j<len_resample; j++) {
+      double complex amphtilde = gsl_vector_get(amp_real_resample, j) + I * gsl_vector_get(amp_imag_resample, j);
+      camp1 = factors[j] * amphtilde;
+      camp2 = factors[len_resample + j] * amphtilde;
+      camp3 = factors[2*len_resample + j] * amphtilde;
       gsl_vector_set(amp_real1, j, creal(camp1));
       gsl_vector_set(amp_imag1, j, cimag(camp1));
       gsl_vector_set(amp_real2, j, creal(camp2));
       gsl_vector_set(amp_imag2, j, cimag(camp2));
       gsl_vector_set(amp_real3, j, creal(camp3));
       gsl_vector_set(amp_imag3, j, cimag(camp3));
-      gsl_vector_set(phase1, j, phasewithRdelay);
-      gsl_vector_set(phase2, j, phasewithRdelay);
-      gsl_vector_set(phase3, j, phasewithRdelay);
     }
+    ArenaFree(factors);
+    ArenaFree(G);
     //clock_t tendconstellation = clock();
     //printf("Set constellation time: %g s\n", (double)(tendconstellation - tbegconstellation) / CLOCKS_PER_SEC);
     //printf("GAB cumulated time: %g s\n", timingcumulativeGABmode);
@@ -520,10 +565,10 @@ int LISASimFDResponseTDI3Chan(
     listelement = listelement->next;
 
     /* Clean up */
-    gsl_spline_free(spline_phi);
-    gsl_interp_accel_free(accel_phi);
-    gsl_vector_free(freqrhigh);
-    gsl_vector_free(freqr);
+    if(spline_phi) gsl_spline_free(spline_phi);
+    if(accel_phi) gsl_interp_accel_free(accel_phi);
+    ArenaVectorFree(freqrhigh);
+    ArenaVectorFree(freqr);
     CAmpPhaseFrequencySeries_Cleanup(freqseriesr);
     // /* If we used resampling, then we need to free the additional resources that were allocated */
     // if(resampled) {
@@ -708,22 +708,12 @@ double complex G31mode(const LISAconstellation *variant, const double f, const d
   return I*PI*f*variant->ConstL/C_SI * (n2Pn2plus*Yfactorplus + n2Pn2cross*Yfactorcross) * sinc( PI*f*variant->ConstL/C_SI * (1.-kn2)) * cexp( I*PI*f*variant->ConstL/C_SI * (1.+kp3plusp1) );
 }
 
-/* Function evaluating all coefficients G12, G21, G23, G32, G31, G13, combining the two polarization with the spherical harmonics factors */
-/* Note: includes orbital delay */
-int EvaluateGABmode(
+/* Function evaluating the time-dependent geometry of the constellation entering the G_AB's - the sky position is set beforehand by SetCoeffsG */
+/* Independent of the frequency and of the mode: evaluated once for a frozen constellation */
+void EvaluateGABGeometry(
   const LISAconstellation *variant,    /* Description of LISA variant */
-  double complex* G12,                     /* Output for G12 */
-  double complex* G21,                     /* Output for G21 */
-  double complex* G23,                     /* Output for G23 */
-  double complex* G32,                     /* Output for G32 */
-  double complex* G31,                     /* Output for G31 */
-  double complex* G13,                     /* Output for G13 */
-  const double f,                          /* Frequency */
-  const double t,                          /* Time */
-  const double complex Yfactorplus,        /* Spin-weighted spherical harmonic factor for plus */
-  const double complex Yfactorcross,       /* Spin-weighted spherical harmonic factor for cross */
-  const int tagdelayR,                     /* Tag: when 1, include the phase term of the R-delay */
-  const ResponseApproxtag responseapprox)  /* Tag to select possible low-f approximation level in FD response */
+  LISAGABGeometry* geometry,               /* Output: geometry of the constellation */
+  const double t)                          /* Time */
 {
   double phase = variant->ConstOmega*t + variant->ConstPhi0;
 
@@ -764,55 +754,134 @@ int EvaluateGABmode(
     kp3plusp1 += cosarray[j] * coeffkp3plusp1cos[j] + sinarray[j] * coeffkp3plusp1sin[j];
     kR += cosarray[j] * coeffkRcos[j] + sinarray[j] * coeffkRsin[j];
   }
+
+  /* Output result */
+  geometry->n1Pn1plus = n1Pn1plus;
+  geometry->n1Pn1cross = n1Pn1cross;
+  geometry->n2Pn2plus = n2Pn2plus;
+  geometry->n2Pn2cross = n2Pn2cross;
+  geometry->n3Pn3plus = n3Pn3plus;
+  geometry->n3Pn3cross = n3Pn3cross;
+  geometry->kn1 = kn1;
+  geometry->kn2 = kn2;
+  geometry->kn3 = kn3;
+  geometry->kp1plusp2 = kp1plusp2;
+  geometry->kp2plusp3 = kp2plusp3;
+  geometry->kp3plusp1 = kp3plusp1;
+  geometry->kR = kR;
+}
+
+/* Function evaluating all coefficients G12, G21, G23, G32, G31, G13 from the geometry of the constellation, combining the two polarization with the spherical harmonics factors */
+/* Only the frequency-dependent transfer factors are computed here - none of them in the lowf and lowfL approximations */
+int EvaluateGABmodeFromGeometry(
+  const LISAconstellation *variant,    /* Description of LISA variant */
+  double complex* G12,                     /* Output for G12 */
+  double complex* G21,                     /* Output for G21 */
+  double complex* G23,                     /* Output for G23 */
+  double complex* G32,                     /* Output for G32 */
+  double complex* G31,                     /* Output for G31 */
+  double complex* G13,                     /* Output for G13 */
+  const LISAGABGeometry* geometry,         /* Geometry of the constellation at the time considered */
+  const double f,                          /* Frequency */
+  const double complex Yfactorplus,        /* Spin-weighted spherical harmonic factor for plus */
+  const double complex Yfactorcross,       /* Spin-weighted spherical harmonic factor for cross */
+  const int tagdelayR,                     /* Tag: when 1, include the phase term of the R-delay */
+  const ResponseApproxtag responseapprox)  /* Tag to select possible low-f approximation level in FD response */
+{
   /* Common factors */
-  double complex factn1Pn1 = n1Pn1plus*Yfactorplus + n1Pn1cross*Yfactorcross;
-  double complex factn2Pn2 = n2Pn2plus*Yfactorplus + n2Pn2cross*Yfactorcross;
-  double complex factn3Pn3 = n3Pn3plus*Yfactorplus + n3Pn3cross*Yfactorcross;
+  double complex factn1Pn1 = geometry->n1Pn1plus*Yfactorplus + geometry->n1Pn1cross*Yfactorcross;
+  double complex factn2Pn2 = geometry->n2Pn2plus*Yfactorplus + geometry->n2Pn2cross*Yfactorcross;
+  double complex factn3Pn3 = geometry->n3Pn3plus*Yfactorplus + geometry->n3Pn3cross*Yfactorcross;
   double prefactor = PI*f*variant->ConstL/C_SI;
-  double prefactorR = 2*PI*f*variant->OrbitR/C_SI;
-  double complex factorcexp12 = cexp(I*prefactor * (1.+kp1plusp2));
-  double complex factorcexp23 = cexp(I*prefactor * (1.+kp2plusp3));
-  double complex factorcexp31 = cexp(I*prefactor * (1.+kp3plusp1));
-  double factorsinc12 = sinc( prefactor * (1.-kn3));
-  double factorsinc21 = sinc( prefactor * (1.+kn3));
-  double factorsinc23 = sinc( prefactor * (1.-kn1));
-  double factorsinc32 = sinc( prefactor * (1.+kn1));
-  double factorsinc31 = sinc( prefactor * (1.-kn2));
-  double factorsinc13 = sinc( prefactor * (1.+kn2));
-  /* The tag tagdelayR allows to choose to include or not the R-delay phase term (here leading order) */
-  double complex factorcexpkR;
-  if(tagdelayR) factorcexpkR = cexp(I*prefactorR * kR);
-  else factorcexpkR = 1.;
+  double complex prefactorkR = I*prefactor;
+  /* The tag tagdelayR allows to choose to include or not the R-delay phase term (here leading order) - ignored in the lowf approximation */
+  if(tagdelayR && !(responseapprox==lowf)) {
+    double prefactorR = 2*PI*f*variant->OrbitR/C_SI;
+    prefactorkR *= cexp(I*prefactorR * geometry->kR);
+  }
 
   /* Take into account level of approximation in for low-f response - choices are full, lowfL or lowf */
-  if(responseapprox==lowf) {
-    factorcexpkR = 1.;
-  }
+  /* In the lowfL and lowf approximations, the G_AB's reduce to the prefactor and the projections of the polarizations */
   if((responseapprox==lowfL)||(responseapprox==lowf)) {
-    factorsinc12 = 1.;
-    factorsinc21 = 1.;
-    factorsinc23 = 1.;
-    factorsinc32 = 1.;
-    factorsinc31 = 1.;
-    factorsinc13 = 1.;
-    factorcexp12 = 1.;
-    factorcexp23 = 1.;
-    factorcexp31 = 1.;
-  }
+    *G12 = prefactorkR * factn3Pn3;
+    *G21 = prefactorkR * factn3Pn3;
+    *G23 = prefactorkR * factn1Pn1;
+    *G32 = prefactorkR * factn1Pn1;
+    *G31 = prefactorkR * factn2Pn2;
+    *G13 = prefactorkR * factn2Pn2;
+    return SUCCESS;
+  }
+
+  double complex factorcexp12 = cexp(I*prefactor * (1.+geometry->kp1plusp2));
+  double complex factorcexp23 = cexp(I*prefactor * (1.+geometry->kp2plusp3));
+  double complex factorcexp31 = cexp(I*prefactor * (1.+geometry->kp3plusp1));
+  double factorsinc12 = sinc( prefactor * (1.-geometry->kn3));
+  double factorsinc21 = sinc( prefactor * (1.+geometry->kn3));
+  double factorsinc23 = sinc( prefactor * (1.-geometry->kn1));
+  double factorsinc32 = sinc( prefactor * (1.+geometry->kn1));
+  double factorsinc31 = sinc( prefactor * (1.-geometry->kn2));
+  double factorsinc13 = sinc( prefactor * (1.+geometry->kn2));
 
   /* Output result */
-  *G12 = I*prefactor * factorcexpkR * factn3Pn3 * factorsinc12 * factorcexp12;
-  *G21 = I*prefactor * factorcexpkR * factn3Pn3 * factorsinc21 * factorcexp12;
-  *G23 = I*prefactor * factorcexpkR * factn1Pn1 * factorsinc23 * factorcexp23;
-  *G32 = I*prefactor * factorcexpkR * factn1Pn1 * factorsinc32 * factorcexp23;
-  *G31 = I*prefactor * factorcexpkR * factn2Pn2 * factorsinc31 * factorcexp31;
-  *G13 = I*prefactor * factorcexpkR * factn2Pn2 * factorsinc13 * factorcexp31;
+  *G12 = prefactorkR * factn3Pn3 * factorsinc12 * factorcexp12;
+  *G21 = prefactorkR * factn3Pn3 * factorsinc21 * factorcexp12;
+  *G23 = prefactorkR * factn1Pn1 * factorsinc23 * factorcexp23;
+  *G32 = prefactorkR * factn1Pn1 * factorsinc32 * factorcexp23;
+  *G31 = prefactorkR * factn2Pn2 * factorsinc31 * factorcexp31;
+  *G13 = prefactorkR * factn2Pn2 * factorsinc13 * factorcexp31;
 
   return SUCCESS;
 }
 
+/* Function evaluating all coefficients G12, G21, G23, G32, G31, G13, combining the two polarization with the spherical harmonics factors */
+/* Note: includes orbital delay */
+/* Geometry at the time t, followed by the transfer factors at the frequency f */
+int EvaluateGABmode(
+  const LISAconstellation *variant,    /* Description of LISA variant */
+  double complex* G12,                     /* Output for G12 */
+  double complex* G21,                     /* Output for G21 */
+  double complex* G23,                     /* Output for G23 */
+  double complex* G32,                     /* Output for G32 */
+  double complex* G31,                     /* Output for G31 */
+  double complex* G13,                     /* Output for G13 */
+  const double f,                          /* Frequency */
+  const double t,                          /* Time */
+  const double complex Yfactorplus,        /* Spin-weighted spherical harmonic factor for plus */
+  const double complex Yfactorcross,       /* Spin-weighted spherical harmonic factor for cross */
+  const int tagdelayR,                     /* Tag: when 1, include the phase term of the R-delay */
+  const ResponseApproxtag responseapprox)  /* Tag to select possible low-f approximation level in FD response */
+{
+  LISAGABGeometry geometry;
+  EvaluateGABGeometry(variant, &geometry, t);
+  return EvaluateGABmodeFromGeometry(variant, G12, G21, G23, G32, G31, G13, &geometry, f, Yfactorplus, Yfactorcross, tagdelayR, responseapprox);
+}
+
 /*********************** Fourier-domain TDI factors ************************/
 
+/* Combinations of the GAB's for each set of TDI observables, as (tag, channel 1, channel 2, channel 3), in terms of G12...G13 and z=e^2ix with x=pifL */
+/* The same table generates the evaluation at one frequency and the specialized kernels on series of frequencies below */
+/* NOTE: factors have been scaled out, in parallel of what is done for the noise function - for one channel, channels 2 and 3 are simply set to 0 */
+/* y12, y12L: for testing purposes, basic yAB and yABL observables - no factor */
+/* TDIAETXYZ, TDIAXYZ, TDIEXYZ, TDITXYZ: first-generation rescaled TDI aet from X,Y,Z - with x=pifL, factors scaled out: A,E I*sqrt2*sin2x*e2ix - T 2*sqrt2*sin2x*sinx*e3ix */
+/* TDIAETalphabetagamma, TDIAalphabetagamma, TDIEalphabetagamma, TDITalphabetagamma: first-generation rescaled TDI aet from alpha, beta, gamma - with x=pifL, factors scaled out: A,E -I*2sqrt2*sinx*eix - T sinx/(sin3x*eix) */
+/* TDIXYZ, TDIX: first-generation TDI XYZ - with x=pifL, factor scaled out: 2I*sin2x*e2ix */
+/* TDIalphabetagamma, TDIalpha: first-generation TDI alpha beta gamma */
+#define LISA_TDI_COMBINATIONS(X) \
+  X(y12, G12, 0., 0.) \
+  X(y12L, G12, 0., 0.) \
+  X(TDIAETXYZ, 0.5 * ( (1.+z)*(G31+G13) - G23 - z*G32 - G21 - z*G12 ), 0.5*invsqrt3 * ( (1.-z)*(G13-G31) + (2.+z)*(G12-G32) + (1.+2*z)*(G21-G23) ), invsqrt6 * ( G21-G12 + G32-G23 + G13-G31)) \
+  X(TDIAETalphabetagamma, 0.5 * (G13+G31 + z*(G12+G32) - (1.+z)*(G21+G13)), 0.5*invsqrt3 * ((2.+z)*(G12-G32) + (1.+z)*(G21-G23) + (1.+2*z)*(G13-G31)), invsqrt3 * (G21-G12 + G32-G23 + G13-G31)) \
+  X(TDIXYZ, G21 + z*G12 - G31 - z*G13, G32 + z*G23 - G12 - z*G21, G13 + z*G31 - G23 - z*G32) \
+  X(TDIalphabetagamma, G21-G31 + z*(G13-G12) + z*z*(G32-G23), G32-G12 + z*(G21-G23) + z*z*(G13-G31), G13-G23 + z*(G32-G31) + z*z*(G21-G12)) \
+  X(TDIX, G21 + z*G12 - G31 - z*G13, 0., 0.) \
+  X(TDIalpha, G21-G31 + z*(G13-G12) + z*z*(G32-G23), 0., 0.) \
+  X(TDIAXYZ, 0.5 * ( (1.+z)*(G31+G13) - G23 - z*G32 - G21 - z*G12 ), 0., 0.) \
+  X(TDIEXYZ, 0.5*invsqrt3 * ( (1.-z)*(G13-G31) + (2.+z)*(G12-G32) + (1.+2*z)*(G12-G23) ), 0., 0.) \
+  X(TDITXYZ, invsqrt6 * ( G21-G12 + G32-G23 + G13-G31), 0., 0.) \
+  X(TDIAalphabetagamma, 0.5 * (G13+G31 + z*(G12+G32) - (1.+z)*(G21+G13)), 0., 0.) \
+  X(TDIEalphabetagamma, 0.5*invsqrt3 * ((2.+z)*(G12-G32) + (1.+z)*(G21-G23) + (1.+2*z)*(G13-G31)), 0., 0.) \
+  X(TDITalphabetagamma, invsqrt3 * (G21-G12 + G32-G23 + G13-G31), 0., 0.)
+
 /* Functions evaluating the Fourier-domain factors (combinations of the GAB's) for TDI observables */
 /* NOTE: factors have been scaled out, in parallel of what is done for the noise function */
 /* Note: in case only one channel is considered, amplitudes for channels 2 and 3 are simply set to 0 */
@@ -841,91 +910,14 @@ int EvaluateTDIfactor3Chan(
     z = 1.;
   }
   switch(tditag) {
-    /* For testing purposes: basic yAB observable - no factor */
-  case y12:
-    *factor1 = G12;
-    *factor2 = 0.;
-    *factor3 = 0.;
-    break;
-    /* For testing purposes: basic yABL observable - no factor, same as for yAB */
-  case y12L:
-    *factor1 = G12;
-    *factor2 = 0.;
-    *factor3 = 0.;
-    break;
-    /* First-generation rescaled TDI aet from X,Y,Z */
-    /* With x=pifL, factors scaled out: A,E I*sqrt2*sin2x*e2ix - T 2*sqrt2*sin2x*sinx*e3ix */
-  case TDIAETXYZ:
-    *factor1 = 0.5 * ( (1.+z)*(G31+G13) - G23 - z*G32 - G21 - z*G12 );
-    *factor2 = 0.5*invsqrt3 * ( (1.-z)*(G13-G31) + (2.+z)*(G12-G32) + (1.+2*z)*(G21-G23) );
-    *factor3 = invsqrt6 * ( G21-G12 + G32-G23 + G13-G31);
-    break;
-    /* First-generation rescaled TDI aet from alpha, beta, gamma */
-    /* With x=pifL, factors scaled out: A,E -I*2sqrt2*sinx*eix - T sinx/(sin3x*eix) */
-  case TDIAETalphabetagamma:
-    *factor1 = 0.5 * (G13+G31 + z*(G12+G32) - (1.+z)*(G21+G13));
-    *factor2 = 0.5*invsqrt3 * ((2.+z)*(G12-G32) + (1.+z)*(G21-G23) + (1.+2*z)*(G13-G31));
-    *factor3 = invsqrt3 * (G21-G12 + G32-G23 + G13-G31);
-    break;
-    /* First-generation TDI XYZ */
-    /* With x=pifL, factor scaled out: 2I*sin2x*e2ix */
-  case TDIXYZ:
-    *factor1 = G21 + z*G12 - G31 - z*G13;
-    *factor2 = G32 + z*G23 - G12 - z*G21;
-    *factor3 = G13 + z*G31 - G23 - z*G32;
-    break;
-    /* First-generation TDI alpha beta gamma */
-  case TDIalphabetagamma:
-    *factor1 = G21-G31 + z*(G13-G12) + z*z*(G32-G23);
-    *factor2 = G32-G12 + z*(G21-G23) + z*z*(G13-G31);
-    *factor3 = G13-G23 + z*(G32-G31) + z*z*(G21-G12);
-    break;
-  /* First-generation TDI XYZ */
-  case TDIX:
-    *factor1 = G21 + z*G12 - G31 - z*G13;
-    *factor2 = 0.;
-    *factor3 = 0.;
-    break;
-  /* First-generation TDI alpha beta gamma */
-  case TDIalpha:
-    *factor1 = G21-G31 + z*(G13-G12) + z*z*(G32-G23);
-    *factor2 = 0.;
-    *factor3 = 0.;
-    break;
-  /* First-generation rescaled TDI aet from X,Y,Z */
-  /* With x=pifL, factors scaled out: A,E I*sqrt2*sin2x*eix - T 2*sqrt2*sin2x*sinx*e2ix */
-  case TDIAXYZ:
-    *factor1 = 0.5 * ( (1.+z)*(G31+G13) - G23 - z*G32 - G21 - z*G12 );
-    *factor2 = 0.;
-    *factor3 = 0.;
-    break;
-  case TDIEXYZ:
-    *factor1 = 0.5*invsqrt3 * ( (1.-z)*(G13-G31) + (2.+z)*(G12-G32) + (1.+2*z)*(G12-G23) );
-    *factor2 = 0.;
-    *factor3 = 0.;
-    break;
-  case TDITXYZ:
-    *factor1 = invsqrt6 * ( G21-G12 + G32-G23 + G13-G31);
-    *factor2 = 0.;
-    *factor3 = 0.;
-    break;
-  /* First-generation rescaled TDI aet from alpha, beta, gamma */
-  /* With x=pifL, factors scaled out: A,E -I*2sqrt2*sinx*eix - T sinx/(sin3x*eix) */
-  case TDIAalphabetagamma:
-    *factor1 = 0.5 * (G13+G31 + z*(G12+G32) - (1.+z)*(G21+G13));
-    *factor2 = 0.;
-    *factor3 = 0.;
-    break;
-  case TDIEalphabetagamma:
-    *factor1 = 0.5*invsqrt3 * ((2.+z)*(G12-G32) + (1.+z)*(G21-G23) + (1.+2*z)*(G13-G31));
-    *factor2 = 0.;
-    *factor3 = 0.;
-    break;
-  case TDITalphabetagamma:
-    *factor1 = invsqrt3 * (G21-G12 + G32-G23 + G13-G31);
-    *factor2 = 0.;
-    *factor3 = 0.;
+#define LISA_TDI_CASE(tag, e1, e2, e3) \
+  case tag: \
+    *factor1 = e1; \
+    *factor2 = e2; \
+    *factor3 = e3; \
     break;
+  LISA_TDI_COMBINATIONS(LISA_TDI_CASE)
+#undef LISA_TDI_CASE
   default:
     printf("Error in EvaluateTDIfactor3Chan: tditag not recognized.\n");
     exit(1);
@@ -933,6 +925,66 @@ int EvaluateTDIfactor3Chan(
   return SUCCESS;
 }
 
+/* Kernels of EvaluateTDIfactor3ChanSeries, one per TDI tag and per treatment of the TDI delays - no branch in the loop over frequencies */
+/* Without delays (lowf and lowfL approximations) z=1 is a constant, and the combinations fold at compile time */
+#define LISA_TDI_KERNEL_LOOP(zexpr, e1, e2, e3) \
+  for(int j=0; j<n; j++) { \
+    const double complex G12 = G[6*j]; \
+    const double complex G21 = G[6*j+1]; \
+    const double complex G23 = G[6*j+2]; \
+    const double complex G32 = G[6*j+3]; \
+    const double complex G31 = G[6*j+4]; \
+    const double complex G13 = G[6*j+5]; \
+    const double complex z = zexpr; \
+    (void) G12; (void) G21; (void) G23; (void) G32; (void) G31; (void) G13; (void) z; \
+    factor1[j] = e1; \
+    factor2[j] = e2; \
+    factor3[j] = e3; \
+  }
+#define LISA_TDI_KERNEL(tag, e1, e2, e3) \
+static void TDIfactorSeries_##tag##_delays(double complex* factor1, double complex* factor2, double complex* factor3, const double complex* G, const double* freq, const int n, const double piLoverc) \
+{ \
+  LISA_TDI_KERNEL_LOOP(cexp(2*I*piLoverc*freq[j]), e1, e2, e3) \
+} \
+static void TDIfactorSeries_##tag##_nodelays(double complex* factor1, double complex* factor2, double complex* factor3, const double complex* G, const double* UNUSED freq, const int n, const double UNUSED piLoverc) \
+{ \
+  LISA_TDI_KERNEL_LOOP(1., e1, e2, e3) \
+}
+LISA_TDI_COMBINATIONS(LISA_TDI_KERNEL)
+#undef LISA_TDI_KERNEL
+#undef LISA_TDI_KERNEL_LOOP
+
+/* Same as EvaluateTDIfactor3Chan for a series of n frequencies, the GAB's being given as G12, G21, G23, G32, G31, G13 for each frequency */
+/* The TDI tag and the approximation of the response are dispatched once for the series, to the specialized kernels above */
+int EvaluateTDIfactor3ChanSeries(
+  const LISAconstellation *variant,    /* Description of LISA variant */
+  double complex* factor1,                       /* Output for factors for TDI channel 1, n values */
+  double complex* factor2,                       /* Output for factors for TDI channel 2, n values */
+  double complex* factor3,                       /* Output for factors for TDI channel 3, n values */
+  const double complex* G,                       /* Input for the GAB's, 6n values G12, G21, G23, G32, G31, G13 for each frequency */
+  const double* freq,                            /* Frequencies, n values */
+  const int n,                                   /* Number of frequencies */
+  const TDItag tditag,                           /* Selector for the TDI observables */
+  const ResponseApproxtag responseapprox)        /* Tag to select possible low-f approximation level in FD response */
+{
+  const double piLoverc = PI*variant->ConstL/C_SI;
+  /* In both lowf and lowf-L approximations, ignore z factors - consitently ignore all TDI delays */
+  const int delays = !((responseapprox==lowf)||(responseapprox==lowfL));
+  switch(tditag) {
+#define LISA_TDI_DISPATCH(tag, e1, e2, e3) \
+  case tag: \
+    if(delays) TDIfactorSeries_##tag##_delays(factor1, factor2, factor3, G, freq, n, piLoverc); \
+    else TDIfactorSeries_##tag##_nodelays(factor1, factor2, factor3, G, freq, n, piLoverc); \
+    break;
+  LISA_TDI_COMBINATIONS(LISA_TDI_DISPATCH)
+#undef LISA_TDI_DISPATCH
+  default:
+    printf("Error in EvaluateTDIfactor3ChanSeries: tditag not recognized.\n");
+    exit(1);
+  }
+  return SUCCESS;
+}
+
 /* Function evaluating the Fourier-domain factors that have been scaled out of TDI observables */
 /* The factors scaled out, parallel what is done for the noise functions */
 /* Note: in case only one channel is considered, factors for channels 2 and 3 are simply set to 0 */
@@ -1124,10 +1176,8 @@ static double hOTDAmpPhase(
   const LISAconstellation *variant,    /* Description of LISA variant */
   double* amp,                             /* Output: amplitude */
   double* phase,                           /* Output: phase */
-  gsl_spline* splineamp,                   /* Input spline for TD mode amplitude */
-  gsl_spline* splinephase,                 /* Input spline for TD mode phase */
-  gsl_interp_accel* accelamp,              /* Accelerator for amp spline */
-  gsl_interp_accel* accelphase,            /* Accelerator for phase spline */
+  UniformInterp* interpamp,                /* Input interpolation for TD mode amplitude */
+  UniformInterp* interpphase,              /* Input interpolation for TD mode phase */
   const double t)                          /* Time */
 {
   double tphase=variant->ConstOmega*t + variant->ConstPhi0;
@@ -1145,18 +1195,16 @@ static double hOTDAmpPhase(
   double delay = -(kR*variant->OrbitR)/C_SI;
 
   /* Output result */
-  *amp = gsl_spline_eval(splineamp, t+delay, accelamp);
-  *phase = gsl_spline_eval(splinephase, t+delay, accelphase);
+  *amp = UniformInterp_Eval(interpamp, t+delay);
+  *phase = UniformInterp_Eval(interpphase, t+delay);
 }
 
 /* Functions evaluating yAB observables in time domain - constellation response only */
 /* Note: includes both h22 and h2m2 contributions, assuming planar orbits so that h2-2 = h22* */
 static double y12LTDfromh22AmpPhase(
   const LISAconstellation *variant,    /* Description of LISA variant */
-  gsl_spline* splineamp,                   /* Input spline for h22 TD amp */
-  gsl_spline* splinephase,                 /* Input spline for h22 TD phase */
-  gsl_interp_accel* accelamp,              /* Accelerator for amp spline */
-  gsl_interp_accel* accelphase,            /* Accelerator for phase spline */
+  UniformInterp* interpamp,                /* Input interpolation for h22 TD amp */
+  UniformInterp* interpphase,              /* Input interpolation for h22 TD phase */
   double complex Y22,                      /* Y22 factor needed to convert h22 to hplus, hcross */
   double complex Y2m2,                     /* Y2-2 factor needed to convert h2-2 to hplus, hcross */
   const double t)                          /* Time */
@@ -1191,10 +1239,10 @@ static double y12LTDfromh22AmpPhase(
 
   /* Values of Y22*h22 + Y2-2*h2-2 at 1 and 2 with delays, and hplus, hcross */
   /* Note: includes both h22 and h2m2 contributions, assuming planar orbits so that h2-2 = h22* */
-  double A22at1 = gsl_spline_eval(splineamp, t+firstdelay, accelamp);
-  double phi22at1 = gsl_spline_eval(splinephase, t+firstdelay, accelphase);
-  double A22at2 = gsl_spline_eval(splineamp, t+seconddelay, accelamp);
-  double phi22at2 = gsl_spline_eval(splinephase, t+seconddelay, accelphase);
+  double A22at1 = UniformInterp_Eval(interpamp, t+firstdelay);
+  double phi22at1 = UniformInterp_Eval(interpphase, t+firstdelay);
+  double A22at2 = UniformInterp_Eval(interpamp, t+seconddelay);
+  double phi22at2 = UniformInterp_Eval(interpphase, t+seconddelay);
   double complex Y22h22at1 = Y22 * A22at1 * cexp(I*phi22at1);
   double complex Y22h22at2 = Y22 * A22at2 * cexp(I*phi22at2);
   double complex Y2m2h2m2at1 = Y2m2 * A22at1 * cexp(-I*phi22at1);
@@ -1213,10 +1261,8 @@ static double y12LTDfromh22AmpPhase(
 /* Note: includes both h22 and h2m2 contributions, assuming planar orbits so that h2-2 = h22* */
 static double y12TDfromh22AmpPhase(
   const LISAconstellation *variant,    /* Description of LISA variant */
-  gsl_spline* splineamp,                   /* Input spline for h22 TD amp */
-  gsl_spline* splinephase,                 /* Input spline for h22 TD phase */
-  gsl_interp_accel* accelamp,              /* Accelerator for amp spline */
-  gsl_interp_accel* accelphase,            /* Accelerator for phase spline */
+  UniformInterp* interpamp,                /* Input interpolation for h22 TD amp */
+  UniformInterp* interpphase,              /* Input interpolation for h22 TD phase */
   double complex Y22,                      /* Y22 factor needed to convert h22 to hplus, hcross */
   double complex Y2m2,                     /* Y2-2 factor needed to convert h2-2 to hplus, hcross */
   const double t)                          /* Time */
@@ -1258,10 +1304,10 @@ static double y12TDfromh22AmpPhase(
 
   /* Values of Y22*h22 + Y2-2*h2-2 at 1 and 2 with delays, and hplus, hcross */
   /* Note: includes both h22 and h2m2 contributions, assuming planar orbits so that h2-2 = h22* */
-  double A22at1 = gsl_spline_eval(splineamp, t+firstdelay, accelamp);
-  double phi22at1 = gsl_spline_eval(splinephase, t+firstdelay, accelphase);
-  double A22at2 = gsl_spline_eval(splineamp, t+seconddelay, accelamp);
-  double phi22at2 = gsl_spline_eval(splinephase, t+seconddelay, accelphase);
+  double A22at1 = UniformInterp_Eval(interpamp, t+firstdelay);
+  double phi22at1 = UniformInterp_Eval(interpphase, t+firstdelay);
+  double A22at2 = UniformInterp_Eval(interpamp, t+seconddelay);
+  double phi22at2 = UniformInterp_Eval(interpphase, t+seconddelay);
   double complex Y22h22at1 = Y22 * A22at1 * cexp(I*phi22at1);
   double complex Y22h22at2 = Y22 * A22at2 * cexp(I*phi22at2);
   double complex Y2m2h2m2at1 = Y2m2 * A22at1 * cexp(-I*phi22at1);
@@ -1279,10 +1325,8 @@ static double y12TDfromh22AmpPhase(
 /* Functions evaluating yAB observables in time domain */
 double y12TD(
   const LISAconstellation *variant,    /* Description of LISA variant */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   const double t)                          /* Time */
 {
   /* Precompute array of sine/cosine */
@@ -1316,16 +1360,14 @@ double y12TD(
   double seconddelay = -(kR*variant->OrbitR + kp2*variant->ConstL)/C_SI;
 
   /* Result */
-  double y12 = factorp*(gsl_spline_eval(splinehp, t+firstdelay, accelhp) - gsl_spline_eval(splinehp, t+seconddelay, accelhp)) + factorc*(gsl_spline_eval(splinehc, t+firstdelay, accelhc) - gsl_spline_eval(splinehc, t+seconddelay, accelhc));
+  double y12 = factorp*(UniformInterp_Eval(interphp, t+firstdelay) - UniformInterp_Eval(interphp, t+seconddelay)) + factorc*(UniformInterp_Eval(interphc, t+firstdelay) - UniformInterp_Eval(interphc, t+seconddelay));
   return y12;
 }
 
 double y21TD(
   const LISAconstellation *variant,    /* Description of LISA variant */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   const double t)                          /* Time */
 {
   /* Precompute array of sine/cosine */
@@ -1359,15 +1401,13 @@ double y21TD(
   double seconddelay = -(kR*variant->OrbitR + kp1*variant->ConstL)/C_SI;
 
   /* Result */
-  double y21 = factorp*(gsl_spline_eval(splinehp, t+firstdelay, accelhp) - gsl_spline_eval(splinehp, t+seconddelay, accelhp)) + factorc*(gsl_spline_eval(splinehc, t+firstdelay, accelhc) - gsl_spline_eval(splinehc, t+seconddelay, accelhc));
+  double y21 = factorp*(UniformInterp_Eval(interphp, t+firstdelay) - UniformInterp_Eval(interphp, t+seconddelay)) + factorc*(UniformInterp_Eval(interphc, t+firstdelay) - UniformInterp_Eval(interphc, t+seconddelay));
   return y21;
 }
 double y23TD(
   const LISAconstellation *variant,    /* Description of LISA variant */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   const double t)                          /* Time */
 {
   /* Precompute array of sine/cosine */
@@ -1401,15 +1441,13 @@ double y23TD(
   double seconddelay = -(kR*variant->OrbitR + kp3*variant->ConstL)/C_SI;
 
   /* Result */
-  double y23 = factorp*(gsl_spline_eval(splinehp, t+firstdelay, accelhp) - gsl_spline_eval(splinehp, t+seconddelay, accelhp)) + factorc*(gsl_spline_eval(splinehc, t+firstdelay, accelhc) - gsl_spline_eval(splinehc, t+seconddelay, accelhc));
+  double y23 = factorp*(UniformInterp_Eval(interphp, t+firstdelay) - UniformInterp_Eval(interphp, t+seconddelay)) + factorc*(UniformInterp_Eval(interphc, t+firstdelay) - UniformInterp_Eval(interphc, t+seconddelay));
   return y23;
 }
 double y32TD(
   const LISAconstellation *variant,    /* Description of LISA variant */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   const double t)                          /* Time */
 {
   /* Precompute array of sine/cosine */
@@ -1443,15 +1481,13 @@ double y32TD(
   double seconddelay = -(kR*variant->OrbitR + kp2*variant->ConstL)/C_SI;
 
   /* Result */
-  double y32 = factorp*(gsl_spline_eval(splinehp, t+firstdelay, accelhp) - gsl_spline_eval(splinehp, t+seconddelay, accelhp)) + factorc*(gsl_spline_eval(splinehc, t+firstdelay, accelhc) - gsl_spline_eval(splinehc, t+seconddelay, accelhc));
+  double y32 = factorp*(UniformInterp_Eval(interphp, t+firstdelay) - UniformInterp_Eval(interphp, t+seconddelay)) + factorc*(UniformInterp_Eval(interphc, t+firstdelay) - UniformInterp_Eval(interphc, t+seconddelay));
   return y32;
 }
 double y31TD(
   const LISAconstellation *variant,    /* Description of LISA variant */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   const double t)                          /* Time */
 {
   /* Precompute array of sine/cosine */
@@ -1485,15 +1521,13 @@ double y31TD(
   double seconddelay = -(kR*variant->OrbitR + kp1*variant->ConstL)/C_SI;
 
   /* Result */
-  double y31 = factorp*(gsl_spline_eval(splinehp, t+firstdelay, accelhp) - gsl_spline_eval(splinehp, t+seconddelay, accelhp)) + factorc*(gsl_spline_eval(splinehc, t+firstdelay, accelhc) - gsl_spline_eval(splinehc, t+seconddelay, accelhc));
+  double y31 = factorp*(UniformInterp_Eval(interphp, t+firstdelay) - UniformInterp_Eval(interphp, t+seconddelay)) + factorc*(UniformInterp_Eval(interphc, t+firstdelay) - UniformInterp_Eval(interphc, t+seconddelay));
   return y31;
 }
 double y13TD(
   const LISAconstellation *variant,    /* Description of LISA variant */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   const double t)                          /* Time */
 {
   /* Precompute array of sine/cosine */
@@ -1527,7 +1561,7 @@ double y13TD(
   double seconddelay = -(kR*variant->OrbitR + kp3*variant->ConstL)/C_SI;
 
   /* Result */
-  double y13 = factorp*(gsl_spline_eval(splinehp, t+firstdelay, accelhp) - gsl_spline_eval(splinehp, t+seconddelay, accelhp)) + factorc*(gsl_spline_eval(splinehc, t+firstdelay, accelhc) - gsl_spline_eval(splinehc, t+seconddelay, accelhc));
+  double y13 = factorp*(UniformInterp_Eval(interphp, t+firstdelay) - UniformInterp_Eval(interphp, t+seconddelay)) + factorc*(UniformInterp_Eval(interphc, t+firstdelay) - UniformInterp_Eval(interphc, t+seconddelay));
   return y13;
 }
 
@@ -1537,16 +1571,14 @@ int EvaluateTDIXYZTD(
   double* TDIX,                            /* Output: value of TDI observable X */
   double* TDIY,                            /* Output: value of TDI observable Y */
   double* TDIZ,                            /* Output: value of TDI observable Z */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   const double t)                          /* Time */
 {
   double armdelay = variant->ConstL/C_SI;
-  double X = (y31TD(variant, splinehp, splinehc, accelhp, accelhc, t) + y13TD(variant, splinehp, splinehc, accelhp, accelhc, t - armdelay)) + (y21TD(variant, splinehp, splinehc, accelhp, accelhc, t - 2*armdelay) + y12TD(variant, splinehp, splinehc, accelhp, accelhc, t - 3*armdelay)) - (y21TD(variant, splinehp, splinehc, accelhp, accelhc, t) + y12TD(variant, splinehp, splinehc, accelhp, accelhc, t - armdelay)) - (y31TD(variant, splinehp, splinehc, accelhp, accelhc, t - 2*armdelay) + y13TD(variant, splinehp, splinehc, accelhp, accelhc, t - 3*armdelay));
-  double Y = (y12TD(variant, splinehp, splinehc, accelhp, accelhc, t) + y21TD(variant, splinehp, splinehc, accelhp, accelhc, t - armdelay)) + (y32TD(variant, splinehp, splinehc, accelhp, accelhc, t - 2*armdelay) + y23TD(variant, splinehp, splinehc, accelhp, accelhc, t - 3*armdelay)) - (y32TD(variant, splinehp, splinehc, accelhp, accelhc, t) + y23TD(variant, splinehp, splinehc, accelhp, accelhc, t - armdelay)) - (y12TD(variant, splinehp, splinehc, accelhp, accelhc, t - 2*armdelay) + y21TD(variant, splinehp, splinehc, accelhp, accelhc, t - 3*armdelay));
-  double Z = (y23TD(variant, splinehp, splinehc, accelhp, accelhc, t) + y32TD(variant, splinehp, splinehc, accelhp, accelhc, t - armdelay)) + (y13TD(variant, splinehp, splinehc, accelhp, accelhc, t - 2*armdelay) + y31TD(variant, splinehp, splinehc, accelhp, accelhc, t - 3*armdelay)) - (y13TD(variant, splinehp, splinehc, accelhp, accelhc, t) + y31TD(variant, splinehp, splinehc, accelhp, accelhc, t - armdelay)) - (y23TD(variant, splinehp, splinehc, accelhp, accelhc, t - 2*armdelay) + y32TD(variant, splinehp, splinehc, accelhp, accelhc, t - 3*armdelay));
+  double X = (y31TD(variant, interphp, interphc, t) + y13TD(variant, interphp, interphc, t - armdelay)) + (y21TD(variant, interphp, interphc, t - 2*armdelay) + y12TD(variant, interphp, interphc, t - 3*armdelay)) - (y21TD(variant, interphp, interphc, t) + y12TD(variant, interphp, interphc, t - armdelay)) - (y31TD(variant, interphp, interphc, t - 2*armdelay) + y13TD(variant, interphp, interphc, t - 3*armdelay));
+  double Y = (y12TD(variant, interphp, interphc, t) + y21TD(variant, interphp, interphc, t - armdelay)) + (y32TD(variant, interphp, interphc, t - 2*armdelay) + y23TD(variant, interphp, interphc, t - 3*armdelay)) - (y32TD(variant, interphp, interphc, t) + y23TD(variant, interphp, interphc, t - armdelay)) - (y12TD(variant, interphp, interphc, t - 2*armdelay) + y21TD(variant, interphp, interphc, t - 3*armdelay));
+  double Z = (y23TD(variant, interphp, interphc, t) + y32TD(variant, interphp, interphc, t - armdelay)) + (y13TD(variant, interphp, interphc, t - 2*armdelay) + y31TD(variant, interphp, interphc, t - 3*armdelay)) - (y13TD(variant, interphp, interphc, t) + y31TD(variant, interphp, interphc, t - armdelay)) - (y23TD(variant, interphp, interphc, t - 2*armdelay) + y32TD(variant, interphp, interphc, t - 3*armdelay));
 
   /* Output */
   *TDIX = X;
@@ -1562,16 +1594,14 @@ int EvaluateTDIAETXYZTD(
   double* TDIA,                            /* Output: value of TDI observable X */
   double* TDIE,                            /* Output: value of TDI observable Y */
   double* TDIT,                            /* Output: value of TDI observable Z */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   const double t)                          /* Time */
 {
   double armdelay = variant->ConstL/C_SI;
-  double X = (y31TD(variant, splinehp, splinehc, accelhp, accelhc, t) + y13TD(variant, splinehp, splinehc, accelhp, accelhc, t - armdelay)) + (y21TD(variant, splinehp, splinehc, accelhp, accelhc, t - 2*armdelay) + y12TD(variant, splinehp, splinehc, accelhp, accelhc, t - 3*armdelay)) - (y21TD(variant, splinehp, splinehc, accelhp, accelhc, t) + y12TD(variant, splinehp, splinehc, accelhp, accelhc, t - armdelay)) - (y31TD(variant, splinehp, splinehc, accelhp, accelhc, t - 2*armdelay) + y13TD(variant, splinehp, splinehc, accelhp, accelhc, t - 3*armdelay));
-  double Y = (y12TD(variant, splinehp, splinehc, accelhp, accelhc, t) + y21TD(variant, splinehp, splinehc, accelhp, accelhc, t - armdelay)) + (y32TD(variant, splinehp, splinehc, accelhp, accelhc, t - 2*armdelay) + y23TD(variant, splinehp, splinehc, accelhp, accelhc, t - 3*armdelay)) - (y32TD(variant, splinehp, splinehc, accelhp, accelhc, t) + y23TD(variant, splinehp, splinehc, accelhp, accelhc, t - armdelay)) - (y12TD(variant, splinehp, splinehc, accelhp, accelhc, t - 2*armdelay) + y21TD(variant, splinehp, splinehc, accelhp, accelhc, t - 3*armdelay));
-  double Z = (y23TD(variant, splinehp, splinehc, accelhp, accelhc, t) + y32TD(variant, splinehp, splinehc, accelhp, accelhc, t - armdelay)) + (y13TD(variant, splinehp, splinehc, accelhp, accelhc, t - 2*armdelay) + y31TD(variant, splinehp, splinehc, accelhp, accelhc, t - 3*armdelay)) - (y13TD(variant, splinehp, splinehc, accelhp, accelhc, t) + y31TD(variant, splinehp, splinehc, accelhp, accelhc, t - armdelay)) - (y23TD(variant, splinehp, splinehc, accelhp, accelhc, t - 2*armdelay) + y32TD(variant, splinehp, splinehc, accelhp, accelhc, t - 3*armdelay));
+  double X = (y31TD(variant, interphp, interphc, t) + y13TD(variant, interphp, interphc, t - armdelay)) + (y21TD(variant, interphp, interphc, t - 2*armdelay) + y12TD(variant, interphp, interphc, t - 3*armdelay)) - (y21TD(variant, interphp, interphc, t) + y12TD(variant, interphp, interphc, t - armdelay)) - (y31TD(variant, interphp, interphc, t - 2*armdelay) + y13TD(variant, interphp, interphc, t - 3*armdelay));
+  double Y = (y12TD(variant, interphp, interphc, t) + y21TD(variant, interphp, interphc, t - armdelay)) + (y32TD(variant, interphp, interphc, t - 2*armdelay) + y23TD(variant, interphp, interphc, t - 3*armdelay)) - (y32TD(variant, interphp, interphc, t) + y23TD(variant, interphp, interphc, t - armdelay)) - (y12TD(variant, interphp, interphc, t - 2*armdelay) + y21TD(variant, interphp, interphc, t - 3*armdelay));
+  double Z = (y23TD(variant, interphp, interphc, t) + y32TD(variant, interphp, interphc, t - armdelay)) + (y13TD(variant, interphp, interphc, t - 2*armdelay) + y31TD(variant, interphp, interphc, t - 3*armdelay)) - (y13TD(variant, interphp, interphc, t) + y31TD(variant, interphp, interphc, t - armdelay)) - (y23TD(variant, interphp, interphc, t - 2*armdelay) + y32TD(variant, interphp, interphc, t - 3*armdelay));
 
   /* Output */
   *TDIA = 1./(2*sqrt(2)) * (Z-X);
@@ -1581,20 +1611,108 @@ int EvaluateTDIAETXYZTD(
   return SUCCESS;
 }
 
+/* Number of points of the Lagrange interpolation used for fractional delays of the link series */
+#define TDITD_FRACDELAY_NPTS 8
+
+/* The six yAB observables at the same time t - the constellation phase and the k-projections are computed once */
+/* Ordering of the output: y12, y21, y23, y32, y31, y13 */
+/* The hplus, hcross values at the three delayed points and their arm-delayed versions are shared between links: 12 interpolations instead of 24 */
+static void EvaluateyABTDAllLinks(
+  const LISAconstellation *variant,    /* Description of LISA variant */
+  double* y,                               /* Output: values of the six yAB */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
+  const double t)                          /* Time */
+{
+  /* Precompute array of sine/cosine - local, as this is called in parallel */
+  double cosa[4], sina[4];
+  double phase=variant->ConstOmega*t + variant->ConstPhi0;
+  for(int j=0; j<4; j++) {
+    cosa[j] = cos((j+1) * phase);
+    sina[j] = sin((j+1) * phase);
+  }
+  double n1Pn1plus = coeffn1Hn1plusconst, n1Pn1cross = coeffn1Hn1crossconst;
+  double n2Pn2plus = coeffn2Hn2plusconst, n2Pn2cross = coeffn2Hn2crossconst;
+  double n3Pn3plus = coeffn3Hn3plusconst, n3Pn3cross = coeffn3Hn3crossconst;
+  for(int j=0; j<4; j++) {
+    n1Pn1plus += cosa[j] * coeffn1Hn1pluscos[j] + sina[j] * coeffn1Hn1plussin[j];
+    n1Pn1cross += cosa[j] * coeffn1Hn1crosscos[j] + sina[j] * coeffn1Hn1crosssin[j];
+    n2Pn2plus += cosa[j] * coeffn2Hn2pluscos[j] + sina[j] * coeffn2Hn2plussin[j];
+    n2Pn2cross += cosa[j] * coeffn2Hn2crosscos[j] + sina[j] * coeffn2Hn2crosssin[j];
+    n3Pn3plus += cosa[j] * coeffn3Hn3pluscos[j] + sina[j] * coeffn3Hn3plussin[j];
+    n3Pn3cross += cosa[j] * coeffn3Hn3crosscos[j] + sina[j] * coeffn3Hn3crosssin[j];
+  }
+  double kn1 = coeffkn1const, kn2 = coeffkn2const, kn3 = coeffkn3const;
+  double kp1 = coeffkp1const, kp2 = coeffkp2const, kp3 = coeffkp3const;
+  double kR = coeffkRconst;
+  for(int j=0; j<2; j++) {
+    kn1 += cosa[j] * coeffkn1cos[j] + sina[j] * coeffkn1sin[j];
+    kn2 += cosa[j] * coeffkn2cos[j] + sina[j] * coeffkn2sin[j];
+    kn3 += cosa[j] * coeffkn3cos[j] + sina[j] * coeffkn3sin[j];
+    kp1 += cosa[j] * coeffkp1cos[j] + sina[j] * coeffkp1sin[j];
+    kp2 += cosa[j] * coeffkp2cos[j] + sina[j] * coeffkp2sin[j];
+    kp3 += cosa[j] * coeffkp3cos[j] + sina[j] * coeffkp3sin[j];
+    kR += cosa[j] * coeffkRcos[j] + sina[j] * coeffkRsin[j];
+  }
+
+  /* hplus, hcross at the spacecraft A (delay kpA) and one arm later (delay kpA+1) - see y12TD...y13TD */
+  double armdelay = variant->ConstL/C_SI;
+  double delayR = -kR*variant->OrbitR/C_SI;
+  double tA[3] = {t + delayR - kp1*armdelay, t + delayR - kp2*armdelay, t + delayR - kp3*armdelay};
+  double hp[3], hc[3], hpL[3], hcL[3];
+  for(int a=0; a<3; a++) {
+    hp[a] = UniformInterp_Eval(interphp, tA[a]);
+    hc[a] = UniformInterp_Eval(interphc, tA[a]);
+    hpL[a] = UniformInterp_Eval(interphp, tA[a] - armdelay);
+    hcL[a] = UniformInterp_Eval(interphc, tA[a] - armdelay);
+  }
+
+  /* Results */
+  y[0] = (1./(1.-kn3)) * 0.5 * (n3Pn3plus*(hpL[0] - hp[1]) + n3Pn3cross*(hcL[0] - hc[1])); /* y12 */
+  y[1] = (1./(1.+kn3)) * 0.5 * (n3Pn3plus*(hpL[1] - hp[0]) + n3Pn3cross*(hcL[1] - hc[0])); /* y21 */
+  y[2] = (1./(1.-kn1)) * 0.5 * (n1Pn1plus*(hpL[1] - hp[2]) + n1Pn1cross*(hcL[1] - hc[2])); /* y23 */
+  y[3] = (1./(1.+kn1)) * 0.5 * (n1Pn1plus*(hpL[2] - hp[1]) + n1Pn1cross*(hcL[2] - hc[1])); /* y32 */
+  y[4] = (1./(1.-kn2)) * 0.5 * (n2Pn2plus*(hpL[2] - hp[0]) + n2Pn2cross*(hcL[2] - hc[0])); /* y31 */
+  y[5] = (1./(1.+kn2)) * 0.5 * (n2Pn2plus*(hpL[0] - hp[2]) + n2Pn2cross*(hcL[0] - hc[2])); /* y13 */
+}
+
+/* Weights and offset of the Lagrange interpolation for the delay D (in samples) on a uniform grid */
+/* y(t_i - D*deltat) = sum_m weights[m] y[i + offset + m] - the same for all i */
+static void FractionalDelayWeights(double* weights, int* offset, const double D)
+{
+  int n = TDITD_FRACDELAY_NPTS;
+  double x = -D;
+  int j0 = (int) floor(x) - n/2 + 1;
+  *offset = j0;
+  for(int m=0; m<n; m++) {
+    double w = 1.;
+    for(int l=0; l<n; l++) {
+      if(l!=m) w *= (x - (j0+l)) / (double) (m-l);
+    }
+    weights[m] = w;
+  }
+}
+
 /**/
+/* The six link series yAB are computed once on the time grid, and the TDI combinations are formed by delaying them with a fractional-delay Lagrange interpolation */
+/* NOTE: assumes a uniform time grid - samples of yAB that fall in the margins are set to 0 */
+/* NOTE: with OpenMP, parallelized over contiguous blocks of samples */
 int GenerateTDITD3Chanhphc(
   const LISAconstellation *variant,    /* Description of LISA variant */
   RealTimeSeries** TDI1,                   /* Output: real time series for TDI channel 1 */
   RealTimeSeries** TDI2,                   /* Output: real time series for TDI channel 2 */
   RealTimeSeries** TDI3,                   /* Output: real time series for TDI channel 3 */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   gsl_vector* times,                       /* Vector of times to evaluate */
   int nbptmargin,                          /* Margin set to 0 on both side to avoid problems with delays out of the domain */
   TDItag tditag)                           /* Tag selecting the TDI observables */
 {
+  if(!(tditag==y12 || tditag==TDIXYZ || tditag==TDIAETXYZ)) {
+    printf("Error: in GenerateTDITD3Chan, TDI tag not recognized.\n");
+    return FAILURE;
+  }
+
   /* Initialize output */
   int nbpt = times->size;
   RealTimeSeries_Init(TDI1, nbpt);
@@ -1606,46 +1724,87 @@ int GenerateTDITD3Chanhphc(
   gsl_vector_set_zero((*TDI1)->h);
   gsl_vector_set_zero((*TDI2)->h);
   gsl_vector_set_zero((*TDI3)->h);
-
-  /* Loop over time samples - we take a margin to avoid problems with the domain */
-  double t;
   double* tval = times->data;
   double* tdi1 = (*TDI1)->h->data;
   double* tdi2 = (*TDI2)->h->data;
   double* tdi3 = (*TDI3)->h->data;
-  double tdi1val = 0, tdi2val = 0, tdi3val = 0;
 
-  /* For testing purposes: basic observable yAB */
-  if(tditag==y12) {
-    for(int i=nbptmargin; i<nbpt-nbptmargin; i++) {
-      t = tval[i];
-      tdi1[i] = y12TD(variant, splinehp, splinehc, accelhp, accelhc, t);
-      tdi2[i] = 0.;
-      tdi3[i] = 0.;
-    }
-  }
-  else if(tditag==TDIXYZ) {
-    for(int i=nbptmargin; i<nbpt-nbptmargin; i++) {
-      t = tval[i];
-      EvaluateTDIXYZTD(variant, &tdi1val, &tdi2val, &tdi3val, splinehp, splinehc, accelhp, accelhc, t);
-      tdi1[i] = tdi1val;
-      tdi2[i] = tdi2val;
-      tdi3[i] = tdi3val;
+  /* Fractional delays by 1, 2, 3 arm lengths - the delays are constant here, so are the interpolation weights */
+  /* Warning: assumes linear sampling in time */
+  double deltat = tval[1] - tval[0];
+  double armdelay = variant->ConstL/C_SI;
+  double weights[4][TDITD_FRACDELAY_NPTS];
+  int offset[4];
+  for(int k=0; k<4; k++) FractionalDelayWeights(weights[k], &(offset[k]), k*armdelay/deltat);
+
+  /* Range of samples where the TDI observables are computed, and where the link series are needed for them */
+  int minreach = (tditag==y12) ? 0 : offset[3];
+  int maxreach = (tditag==y12) ? 0 : max(0, offset[1] + TDITD_FRACDELAY_NPTS - 1);
+  int itdimin = max(nbptmargin, -minreach);
+  int itdimax = min(nbpt - nbptmargin, nbpt - maxreach);
+  if(itdimax <= itdimin) return SUCCESS;
+  int imin = itdimin + minreach;
+  int imax = itdimax + maxreach;
+
+  /* Link series - ordering y12, y21, y23, y32, y31, y13 - set to 0 outside [imin, imax) */
+  double** yAB = (double**) malloc(6*sizeof(double*));
+  for(int l=0; l<6; l++) yAB[l] = (double*) calloc(nbpt, sizeof(double));
+
+  /* The geometric coefficients are threadprivate: copied from the calling thread */
+  #pragma omp parallel copyin(coeffn1Hn1crossconst, coeffn1Hn1plusconst, coeffn2Hn2crossconst, coeffn2Hn2plusconst, coeffn3Hn3crossconst, coeffn3Hn3plusconst, \
+    coeffn1Hn1pluscos, coeffn1Hn1plussin, coeffn2Hn2pluscos, coeffn2Hn2plussin, coeffn3Hn3pluscos, coeffn3Hn3plussin, \
+    coeffn1Hn1crosscos, coeffn1Hn1crosssin, coeffn2Hn2crosscos, coeffn2Hn2crosssin, coeffn3Hn3crosscos, coeffn3Hn3crosssin, \
+    coeffkn1const, coeffkn2const, coeffkn3const, coeffkp1const, coeffkp2const, coeffkp3const, coeffkRconst, \
+    coeffkn1cos, coeffkn1sin, coeffkn2cos, coeffkn2sin, coeffkn3cos, coeffkn3sin, \
+    coeffkp1cos, coeffkp1sin, coeffkp2cos, coeffkp2sin, coeffkp3cos, coeffkp3sin, coeffkRcos, coeffkRsin)
+  {
+    double y[6];
+    #pragma omp for schedule(static)
+    for(int i=imin; i<imax; i++) {
+      EvaluateyABTDAllLinks(variant, y, interphp, interphc, tval[i]);
+      for(int l=0; l<6; l++) yAB[l][i] = y[l];
     }
   }
-  else if(tditag==TDIAETXYZ) {
-    for(int i=nbptmargin; i<nbpt-nbptmargin; i++) {
-      t = tval[i];
-      EvaluateTDIAETXYZTD(variant, &tdi1val, &tdi2val, &tdi3val, splinehp, splinehc, accelhp, accelhc, t);
-      tdi1[i] = tdi1val;
-      tdi2[i] = tdi2val;
-      tdi3[i] = tdi3val;
-    }
+
+  /* For testing purposes: basic observable yAB */
+  if(tditag==y12) {
+    memcpy(&(tdi1[imin]), &(yAB[0][imin]), (imax-imin)*sizeof(double));
   }
   else {
-    printf("Error: in GenerateTDITD3Chan, TDI tag not recognized.\n");
+    #pragma omp parallel for schedule(static)
+    for(int i=itdimin; i<itdimax; i++) {
+      /* Values of the links delayed by k arm lengths, D_k y(t_i) = y(t_i - k*armdelay) */
+      double D[4][6];
+      for(int l=0; l<6; l++) D[0][l] = yAB[l][i];
+      for(int k=1; k<4; k++) {
+        for(int l=0; l<6; l++) {
+          double val = 0.;
+          const double* yl = &(yAB[l][i + offset[k]]);
+          for(int m=0; m<TDITD_FRACDELAY_NPTS; m++) val += weights[k][m] * yl[m];
+          D[k][l] = val;
+        }
+      }
+      /* Same combinations as in EvaluateTDIXYZTD - second index ordered as y12, y21, y23, y32, y31, y13 */
+      double X = (D[0][4] + D[1][5]) + (D[2][1] + D[3][0]) - (D[0][1] + D[1][0]) - (D[2][4] + D[3][5]);
+      double Y = (D[0][0] + D[1][1]) + (D[2][3] + D[3][2]) - (D[0][3] + D[1][2]) - (D[2][0] + D[3][1]);
+      double Z = (D[0][2] + D[1][3]) + (D[2][5] + D[3][4]) - (D[0][5] + D[1][4]) - (D[2][2] + D[3][3]);
+      if(tditag==TDIXYZ) {
+        tdi1[i] = X;
+        tdi2[i] = Y;
+        tdi3[i] = Z;
+      }
+      else {
+        tdi1[i] = 1./(2*sqrt(2)) * (Z-X);
+        tdi2[i] = 1./(2*sqrt(6)) * (X-2*Y+Z);
+        tdi3[i] = 1./(2*sqrt(3)) * (X+Y+Z);
+      }
+    }
   }
 
+  /* Clean up */
+  for(int l=0; l<6; l++) free(yAB[l]);
+  free(yAB);
+
   return SUCCESS;
 }
 
@@ -1653,10 +1812,8 @@ int GenerateTDITD3Chanhphc(
 int Generateh22TDO(
   const LISAconstellation *variant,    /* Description of LISA variant */
   AmpPhaseTimeSeries** h22tdO,             /* Output: amp/phase time series for h22TDO */
-  gsl_spline* splineamp,                   /* Input spline for TD mode amplitude */
-  gsl_spline* splinephase,                 /* Input spline for TD mode phase */
-  gsl_interp_accel* accelamp,              /* Accelerator for amp spline */
-  gsl_interp_accel* accelphase,            /* Accelerator for phase spline */
+  UniformInterp* interpamp,                /* Input interpolation for TD mode amplitude */
+  UniformInterp* interpphase,              /* Input interpolation for TD mode phase */
   gsl_vector* times,                       /* Vector of times to evaluate */
   int nbptmargin)                          /* Margin set to 0 on both side to avoid problems with delays out of the domain */
 {
@@ -1676,7 +1833,7 @@ int Generateh22TDO(
   /* Loop over time samples */
   for(int i=nbptmargin; i<nbpt-nbptmargin; i++) {
     t = tval[i];
-    hOTDAmpPhase(variant,&(amp[i]), &(phase[i]), splineamp, splinephase, accelamp, accelphase, t);
+    hOTDAmpPhase(variant,&(amp[i]), &(phase[i]), interpamp, interpphase, t);
   }
 
   return SUCCESS;
@@ -1688,10 +1845,8 @@ int Generateh22TDO(
 int Generatey12LTD(
   const LISAconstellation *variant,    /* Description of LISA variant */
   RealTimeSeries** y12Ltd,                 /* Output: real time series for y12L */
-  gsl_spline* splineamp,                   /* Input spline for h22 TD amplitude */
-  gsl_spline* splinephase,                 /* Input spline for h22 TD phase */
-  gsl_interp_accel* accelamp,              /* Accelerator for h22 amp spline */
-  gsl_interp_accel* accelphase,            /* Accelerator for h22 phase spline */
+  UniformInterp* interpamp,                /* Input interpolation for h22 TD amplitude */
+  UniformInterp* interpphase,              /* Input interpolation for h22 TD phase */
   gsl_vector* times,                       /* Vector of times to evaluate */
   double Theta,                            /* Inclination */
   double Phi,                              /* Phase */
@@ -1715,7 +1870,7 @@ int Generatey12LTD(
   /* Loop over time samples */
   for(int i=nbptmargin; i<nbpt-nbptmargin; i++) {
     t = tval[i];
-    y12val[i] = y12LTDfromh22AmpPhase(variant, splineamp, splinephase, accelamp, accelphase, Y22, Y2m2, t);
+    y12val[i] = y12LTDfromh22AmpPhase(variant, interpamp, interpphase, Y22, Y2m2, t);
   }
 
   return SUCCESS;
@@ -1727,10 +1882,8 @@ int Generatey12LTD(
 int Generatey12TD(
   const LISAconstellation *variant,    /* Description of LISA variant */
   RealTimeSeries** y12td,                 /* Output: real time series for y12L */
-  gsl_spline* splineamp,                   /* Input spline for h22 TD amplitude */
-  gsl_spline* splinephase,                 /* Input spline for h22 TD phase */
-  gsl_interp_accel* accelamp,              /* Accelerator for h22 amp spline */
-  gsl_interp_accel* accelphase,            /* Accelerator for h22 phase spline */
+  UniformInterp* interpamp,                /* Input interpolation for h22 TD amplitude */
+  UniformInterp* interpphase,              /* Input interpolation for h22 TD phase */
   gsl_vector* times,                       /* Vector of times to evaluate */
   double Theta,                            /* Inclination */
   double Phi,                              /* Phase */
@@ -1754,7 +1907,7 @@ int Generatey12TD(
   /* Loop over time samples */
   for(int i=nbptmargin; i<nbpt-nbptmargin; i++) {
     t = tval[i];
-    y12val[i] = y12TDfromh22AmpPhase(variant, splineamp, splinephase, accelamp, accelphase, Y22, Y2m2, t);
+    y12val[i] = y12TDfromh22AmpPhase(variant, interpamp, interpphase, Y22, Y2m2, t);
   }
 
   return SUCCESS;
@@ -35,6 +35,7 @@
 
 #include "constants.h"
 #include "struct.h"
+#include "uniforminterp.h"
 
 #if defined(__cplusplus)
 #define complex _Complex
@@ -97,6 +98,23 @@ extern LISAconstellation tinyOrbitLISA;
 extern LISAconstellation fastOrbitLISA;
 extern LISAconstellation bigOrbitLISA;
 
+/* Time-dependent geometry of the constellation entering the G_AB's, for the sky position set by SetCoeffsG - independent of the frequency and of the mode */
+typedef struct tagLISAGABGeometry {
+  double n1Pn1plus;          /* Projections of the plus and cross polarization tensors on the arms */
+  double n1Pn1cross;
+  double n2Pn2plus;
+  double n2Pn2cross;
+  double n3Pn3plus;
+  double n3Pn3cross;
+  double kn1;                /* Scalar products of the propagation vector with the arms */
+  double kn2;
+  double kn3;
+  double kp1plusp2;          /* Scalar products of the propagation vector with the sums of positions of the spacecraft */
+  double kp2plusp3;
+  double kp3plusp1;
+  double kR;                 /* Scalar product of the propagation vector with the position of the center of the constellation */
+} LISAGABGeometry;
+
 
 /**************************************************/
 /**************** Prototypes **********************/
@@ -163,7 +181,27 @@ int EvaluateGABmode(
   const double complex Yfactorplus,        /* Spin-weighted spherical harmonic factor for plus */
   const double complex Yfactorcross,       /* Spin-weighted spherical harmonic factor for cross */
   const int tagdelayR,                     /* Tag: when 1, include the phase term of the R-delay */
+  const ResponseApproxtag responseapprox); /* Function evaluating the time-dependent geometry of the constellation entering the G_AB's - the sky position is set beforehand by SetCoeffsG */
+void EvaluateGABGeometry(
+  const LISAconstellation *variant,    /* Description of LISA variant */
+  LISAGABGeometry* geometry,               /* Output: geometry of the constellation */
+  const double t);                         /* Time */
+/* Function evaluating the G_AB's from the geometry of the constellation, applying only the frequency-dependent transfer factors */
+int EvaluateGABmodeFromGeometry(
+  const LISAconstellation *variant,    /* Description of LISA variant */
+  double complex* G12,                     /* Output for G12 */
+  double complex* G21,                     /* Output for G21 */
+  double complex* G23,                     /* Output for G23 */
+  double complex* G32,                     /* Output for G32 */
+  double complex* G31,                     /* Output for G31 */
+  double complex* G13,                     /* Output for G13 */
+  const LISAGABGeometry* geometry,         /* Geometry of the constellation at the time considered */
+  const double f,                          /* Frequency */
+  const double complex Yfactorplus,        /* Spin-weighted spherical harmonic factor for plus */
+  const double complex Yfactorcross,       /* Spin-weighted spherical harmonic factor for cross */
+  const int tagdelayR,                     /* Tag: when 1, include the phase term of the R-delay */
   const ResponseApproxtag responseapprox); /* Tag to select possible low-f approximation level in FD response */
+/* Tag to select possible low-f approximation level in FD response */
 
 /* Functions evaluating the Fourier-domain factors (combinations of the GAB's) for TDI observables */
 /* NOTE: factors have been scaled out, in parallel of what is done for the noise function */
@@ -183,6 +221,17 @@ int EvaluateTDIfactor3Chan(
   const double f,                                /* Frequency */
   const TDItag tditag,                           /* Selector for the TDI observables */
   const ResponseApproxtag responseapprox);       /* Tag to select possible low-f approximation level in FD response */
+/* Same as EvaluateTDIfactor3Chan for a series of n frequencies - the TDI tag and approximation are dispatched once, to kernels specialized at compile time */
+int EvaluateTDIfactor3ChanSeries(
+  const LISAconstellation *variant,    /* Description of LISA variant */
+  double complex* factor1,                       /* Output for factors for TDI channel 1, n values */
+  double complex* factor2,                       /* Output for factors for TDI channel 2, n values */
+  double complex* factor3,                       /* Output for factors for TDI channel 3, n values */
+  const double complex* G,                       /* Input for the GAB's, 6n values G12, G21, G23, G32, G31, G13 for each frequency */
+  const double* freq,                            /* Frequencies, n values */
+  const int n,                                   /* Number of frequencies */
+  const TDItag tditag,                           /* Selector for the TDI observables */
+  const ResponseApproxtag responseapprox);       /* Tag to select possible low-f approximation level in FD response */
 /* int EvaluateTDIfactor1Chan( */
 /*   double complex* factor,                       /\* Output for factor for TDI channel *\/ */
 /*   const double complex G12,                      /\* Input for G12 *\/ */
@@ -216,45 +265,33 @@ int RestoreInPlaceScaledFactorTDI(
 /* Basic yslr observables (including orbital delay) from hplus, hcross */
 double y12TD(
   const LISAconstellation *variant,    /* Description of LISA variant */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   const double t);                         /* Time */
 double y21TD(
   const LISAconstellation *variant,    /* Description of LISA variant */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   const double t);                         /* Time */
 double y23TD(
   const LISAconstellation *variant,    /* Description of LISA variant */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   const double t);                         /* Time */
 double y32TD(
   const LISAconstellation *variant,    /* Description of LISA variant */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   const double t);                         /* Time */
 double y31TD(
   const LISAconstellation *variant,    /* Description of LISA variant */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   const double t);                         /* Time */
 double y13TD(
   const LISAconstellation *variant,    /* Description of LISA variant */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   const double t);                         /* Time */
 /* TDI observables (including orbital delay) from hplus, hcross */
 int EvaluateTDIXYZTDhphc(
@@ -262,40 +299,32 @@ int EvaluateTDIXYZTDhphc(
   double* TDIX,                            /* Output: value of TDI observable X */
   double* TDIY,                            /* Output: value of TDI observable Y */
   double* TDIZ,                            /* Output: value of TDI observable Z */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   const double t);                         /* Time */
 int EvaluateTDIAETXYZTDhphc(
   const LISAconstellation *variant,    /* Description of LISA variant */
   double* TDIA,                            /* Output: value of TDI observable X */
   double* TDIE,                            /* Output: value of TDI observable Y */
   double* TDIT,                            /* Output: value of TDI observable Z */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   const double t);                         /* Time */
 
 /* Generate hO orbital-delayed for one mode contribution from amp, phase */
 int Generateh22TDO(
   const LISAconstellation *variant,    /* Description of LISA variant */
   AmpPhaseTimeSeries** h22tdO,             /* Output: amp/phase time series for h22TDO */
-  gsl_spline* splineamp,                   /* Input spline for TD mode amplitude */
-  gsl_spline* splinephase,                 /* Input spline for TD mode phase */
-  gsl_interp_accel* accelamp,              /* Accelerator for amp spline */
-  gsl_interp_accel* accelphase,            /* Accelerator for phase spline */
+  UniformInterp* interpamp,                /* Input interpolation for TD mode amplitude */
+  UniformInterp* interpphase,              /* Input interpolation for TD mode phase */
   gsl_vector* times,                       /* Vector of times to evaluate */
   int nbptmargin);                         /* Margin set to 0 on both side to avoid problems with delays out of the domain */
 /* Generate y12L from orbital-delayed h22 in amp/phase form */
 int Generatey12LTD(
   const LISAconstellation *variant,    /* Description of LISA variant */
   RealTimeSeries** y12Ltd,                 /* Output: real time series for y12L */
-  gsl_spline* splineamp,                   /* Input spline for TD mode amplitude */
-  gsl_spline* splinephase,                 /* Input spline for TD mode phase */
-  gsl_interp_accel* accelamp,              /* Accelerator for amp spline */
-  gsl_interp_accel* accelphase,            /* Accelerator for phase spline */
+  UniformInterp* interpamp,                /* Input interpolation for TD mode amplitude */
+  UniformInterp* interpphase,              /* Input interpolation for TD mode phase */
   gsl_vector* times,                       /* Vector of times to evaluate */
   double Theta,                            /* Inclination */
   double Phi,                              /* Phase */
@@ -308,10 +337,8 @@ int GenerateTDITD3Chanhlm(
   AmpPhaseTimeSeries** hlm,                /* Output: real time series for TDI channel 1 */
   RealTimeSeries** TDI2,                   /* Output: real time series for TDI channel 2 */
   RealTimeSeries** TDI3,                   /* Output: real time series for TDI channel 3 */
-  gsl_spline* splineamp,                   /* Input spline for TD mode amplitude */
-  gsl_spline* splinephase,                 /* Input spline for TD mode phase */
-  gsl_interp_accel* accelamp,              /* Accelerator for amp spline */
-  gsl_interp_accel* accelphase,            /* Accelerator for phase spline */
+  UniformInterp* interpamp,                /* Input interpolation for TD mode amplitude */
+  UniformInterp* interpphase,              /* Input interpolation for TD mode phase */
   gsl_vector* times,                       /* Vector of times to evaluate */
   int nbptsmargin,                         /* Margin set to 0 on both side to avoid problems with delays out of the domain */
   double theta,                            /* Inclination angle - used to convert hlm to hplus, hcross for y12L - ignored for dO */
@@ -320,15 +347,14 @@ int GenerateTDITD3Chanhlm(
 
 
 /* Generate TDI observables (including orbital delay) for one mode contritbution from hplus, hcross */
+/* NOTE: the six yAB are computed once per sample and delayed by Lagrange interpolation on the (assumed uniform) time grid - parallelized with OpenMP */
 int GenerateTDITD3Chanhphc(
   const LISAconstellation *variant,    /* Description of LISA variant */
   RealTimeSeries** TDI1,                   /* Output: real time series for TDI channel 1 */
   RealTimeSeries** TDI2,                   /* Output: real time series for TDI channel 2 */
   RealTimeSeries** TDI3,                   /* Output: real time series for TDI channel 3 */
-  gsl_spline* splinehp,                    /* Input spline for TD hplus */
-  gsl_spline* splinehc,                    /* Input spline for TD hcross */
-  gsl_interp_accel* accelhp,               /* Accelerator for hp spline */
-  gsl_interp_accel* accelhc,               /* Accelerator for hc spline */
+  UniformInterp* interphp,                 /* Input interpolation for TD hplus */
+  UniformInterp* interphc,                 /* Input interpolation for TD hcross */
   gsl_vector* times,                       /* Vector of times to evaluate */
   int nbptsmargin,                         /* Margin set to 0 on both side to avoid problems with delays out of the domain */
   TDItag tditag);                          /* Tag selecting the TDI observables */
@@ -0,0 +1,314 @@
+#include "ComputeLLVSNR.h"
+
+/* Initial size of the arena of each thread - grows after the first sources that overflow */
+#define COMPUTELLVSNR_ARENA_SIZE (16*1024*1024)
+
+/************ Parsing arguments function ************/
+
+/* Parse command line to initialize ComputeLLVSNRparams object */
+static void parse_args_ComputeLLVSNR(ssize_t argc, char **argv, ComputeLLVSNRparams* params)
+{
+  char help[] = "\
+ComputeLLVSNR by Sylvain Marsat, John Baker, and Philip Graff\n\
+\n\
+This program computes the SNRs of a catalogue of injections in a network of ground-based detectors, in a single process.\n\
+Each injection is generated with EOBNRv2HMROM, processed through the Fourier domain response, and its SNR is computed with accelerated Fresnel overlaps (follows LLVinference internals).\n\
+The sources are processed in parallel by the OpenMP threads, sharing the data of the ROM and the noise tables of the network - lines differing only by their distance share one waveform.\n\
+The catalogue has one line per injection, in the format of the internals: m1 (solar masses), m2 (solar masses), tRef (s), dist (Mpc), phase (rad), inc (rad), ra (rad), dec (rad), pol (rad).\n\
+The results table has one line per injection, in the order of the catalogue: the 9 parameters, the network SNR, the horizon distance (Mpc) at which the network SNR equals --snrthreshold, the SNR in each detector of the network, and with --loglikelihood the log-likelihood ln L = -1/2 (h-s|h-s) of a template with --nbmodetemp modes at the parameters of the injection.\n\
+Lines for which the generation failed (e.g. parameters out of the bounds of the ROM) are set to nan.\n\
+Arguments are as follows:\n\
+\n\
+--------------------------------------------------\n\
+----- Generation and network ---------------------\n\
+--------------------------------------------------\n\
+ --tagnetwork          Detectors of the network, one letter each: H (LIGO Hanford), L (LIGO Livingston), V (VIRGO), K (KAGRA), I (LIGO India) (default LHV)\n\
+ --nbmode              Number of modes of the injections, starting with 22 (default=5, all modes)\n\
+ --nbmodetemp          Number of modes of the templates of the likelihood diagnostic, starting with 22 (default=1)\n\
+ --fRef                Reference frequency (Hz, default=0, interpreted as Mf=0.14)\n\
+ --setphiRefatfRef     Flag for adjusting the FD phase at phiRef at the given fRef, which depends also on tRef (default=1)\n\
+ --minf                Minimal frequency (Hz, default=10)\n\
+ --maxf                Maximal frequency (Hz, default=4096)\n\
+\n\
+--------------------------------------------------\n\
+----- Campaign -----------------------------------\n\
+--------------------------------------------------\n\
+ --snrthreshold        Network SNR defining the horizon distance (default=8)\n\
+ --loglikelihood       Also compute the log-likelihood of the template with --nbmodetemp modes (default false)\n\
+ --paramsdir           Directory of the catalogue and of the results table (default current directory)\n\
+ --paramsfile          Catalogue of injections\n\
+ --nlinesparams        Number of lines of the catalogue (default 0, counted from the file)\n\
+ --binaryin            Tag for loading the catalogue in gsl binary form instead of text (default false)\n\
+ --columnarin          Tag for loading the catalogue in binary columnar form (default false)\n\
+ --outputfile          Results table\n\
+ --textout             Tag for writing the results table in text form (default gsl binary)\n\
+ --columnarout         Tag for writing the results table in binary columnar form (default gsl binary)\n\
+\n";
+
+  ssize_t i;
+
+  /* Set default values for the generation params */
+  strcpy(params->network, "LHV");
+  params->nbmode = 5;
+  params->nbmodetemp = 1;
+  params->fRef = 0.;
+  params->setphiRefatfRef = 1;
+  params->minf = 10.;
+  params->maxf = 4096.;
+
+  /* Set default values for the campaign params */
+  params->snrthreshold = 8.;
+  params->loglikelihood = 0;
+  params->nlinesparams = 0;
+  params->binaryin = FILE_TEXT;
+  params->binaryout = FILE_BINARY;
+  strcpy(params->paramsdir, ".");
+  strcpy(params->paramsfile, "");  /* No default; has to be provided */
+  strcpy(params->outputfile, "");  /* No default; has to be provided */
+
+  /* Consume command line */
+  for (i = 1; i < argc; ++i) {
+
+    if (strcmp(argv[i], "--help") == 0) {
+      fprintf(stdout,"%s", help);
+      exit(0);
+    } else if (strcmp(argv[i], "--tagnetwork") == 0) {
+      i++;
+      if(strlen(argv[i]) > LLV_NDETMAX) {
+        printf("Error in parse_args_ComputeLLVSNR: at most %d detectors in the network.\n", LLV_NDETMAX);
+        goto fail;
+      }
+      strcpy(params->network, argv[i]);
+    } else if (strcmp(argv[i], "--nbmode") == 0) {
+      params->nbmode = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--nbmodetemp") == 0) {
+      params->nbmodetemp = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--fRef") == 0) {
+      params->fRef = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--setphiRefatfRef") == 0) {
+      params->setphiRefatfRef = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--minf") == 0) {
+      params->minf = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--maxf") == 0) {
+      params->maxf = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--snrthreshold") == 0) {
+      params->snrthreshold = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--loglikelihood") == 0) {
+      params->loglikelihood = 1;
+    } else if (strcmp(argv[i], "--paramsdir") == 0) {
+      strcpy(params->paramsdir, argv[++i]);
+    } else if (strcmp(argv[i], "--paramsfile") == 0) {
+      strcpy(params->paramsfile, argv[++i]);
+    } else if (strcmp(argv[i], "--nlinesparams") == 0) {
+      params->nlinesparams = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--binaryin") == 0) {
+      params->binaryin = FILE_BINARY;
+    } else if (strcmp(argv[i], "--columnarin") == 0) {
+      params->binaryin = FILE_COLUMNAR;
+    } else if (strcmp(argv[i], "--outputfile") == 0) {
+      strcpy(params->outputfile, argv[++i]);
+    } else if (strcmp(argv[i], "--textout") == 0) {
+      params->binaryout = FILE_TEXT;
+    } else if (strcmp(argv[i], "--columnarout") == 0) {
+      params->binaryout = FILE_COLUMNAR;
+    } else {
+      printf("Error: invalid option: %s\n", argv[i]);
+      goto fail;
+    }
+  }
+
+  if(strcmp(params->paramsfile, "")==0 || strcmp(params->outputfile, "")==0) {
+    printf("Error in parse_args_ComputeLLVSNR: --paramsfile and --outputfile have to be provided.\n");
+    goto fail;
+  }
+  if(params->nbmode<1 || params->nbmode>nbmodemax || params->nbmodetemp<1 || params->nbmodetemp>nbmodemax) {
+    printf("Error in parse_args_ComputeLLVSNR: the numbers of modes must be between 1 and %d.\n", nbmodemax);
+    goto fail;
+  }
+
+  return;
+
+ fail:
+  exit(1);
+}
+
+/***************** Functions for the SNR of the injections *****************/
+
+/* Squared SNRs in each detector, and optionally ln L = (h|s) - (h|h)/2 - (s|s)/2 for a template with nbmodetemp modes, for the parameters of one line of the catalogue */
+/* The globals of LLVutils are not used, so that this can be called by several threads - the waveforms are not time-shifted, which leaves the overlaps unchanged */
+static int ComputeSourceSNR(
+  double* SNR2det,                        /* Output: squared SNRs in each detector of the network */
+  double* logL,                           /* Output: log-likelihood of the template, if params->loglikelihood */
+  const double* p,                        /* Parameters of the source, COMPUTELLVSNR_NPARAMS values */
+  const ComputeLLVSNRparams* params,      /* Settings of the campaign */
+  const LLVNetwork* network,              /* Network of detectors */
+  ObjectFunction* Snoises)                /* Noise functions of the detectors of the network */
+{
+  int ndet = network->ndet;
+  double complex factors[LLV_NDETMAX*nbmodemax];
+  double twopidelays[LLV_NDETMAX];
+
+  /* Generate the injection with the ROM, and reduce the response to factors and delays for each detector */
+  ListmodesCAmpPhaseFrequencySeries* listROM = NULL;
+  if(SimEOBNRv2HMROM(&listROM, params->nbmode, 0., p[4], params->fRef, p[0]*MSUN_SI, p[1]*MSUN_SI, p[3]*1e6*PC_SI, params->setphiRefatfRef)==FAILURE) return FAILURE;
+  LLVSimFDResponseFactorsNetwork(factors, twopidelays, listROM, p[2], p[6], p[7], p[5], p[8], network);
+  ListmodesCAmpPhaseSpline* listsplines = NULL;
+  BuildListmodesCAmpPhaseSpline(&listsplines, listROM);
+
+  /* SNR of the network and of each detector, in a single pass */
+  double SNR2 = FDListmodesFresnelOverlapNetworkDet(SNR2det, listROM, listsplines, ndet, factors, factors, twopidelays, twopidelays, Snoises, params->minf, params->maxf, 0., 0.);
+
+  /* Log-likelihood of the template at the parameters of the injection - measures the bias of templates with fewer modes */
+  int ret = SUCCESS;
+  if(params->loglikelihood) {
+    double complex factorstemp[LLV_NDETMAX*nbmodemax];
+    double twopidelaystemp[LLV_NDETMAX];
+    ListmodesCAmpPhaseFrequencySeries* listtemp = NULL;
+    ret = SimEOBNRv2HMROM(&listtemp, params->nbmodetemp, 0., p[4], params->fRef, p[0]*MSUN_SI, p[1]*MSUN_SI, p[3]*1e6*PC_SI, params->setphiRefatfRef);
+    if(ret==SUCCESS) {
+      LLVSimFDResponseFactorsNetwork(factorstemp, twopidelaystemp, listtemp, p[2], p[6], p[7], p[5], p[8], network);
+      ListmodesCAmpPhaseSpline* listsplinestemp = NULL;
+      BuildListmodesCAmpPhaseSpline(&listsplinestemp, listtemp);
+      double hh = FDListmodesFresnelOverlapNetwork(listtemp, listsplinestemp, ndet, factorstemp, factorstemp, twopidelaystemp, twopidelaystemp, Snoises, params->minf, params->maxf, 0., 0.);
+      double hs = FDListmodesFresnelOverlapNetwork(listtemp, listsplines, ndet, factorstemp, factors, twopidelaystemp, twopidelays, Snoises, params->minf, params->maxf, 0., 0.);
+      *logL = hs - 0.5*hh - 0.5*SNR2;
+      ListmodesCAmpPhaseSpline_Destroy(listsplinestemp);
+      ListmodesCAmpPhaseFrequencySeries_Destroy(listtemp);
+    }
+  }
+
+  /* Clean up */
+  ListmodesCAmpPhaseSpline_Destroy(listsplines);
+  ListmodesCAmpPhaseFrequencySeries_Destroy(listROM);
+
+  return ret;
+}
+
+/* Ordering of the lines of the catalogue on all parameters but the distance (column 3), to group lines sharing the same waveform up to the amplitude */
+static gsl_vector* const* paramscolumns = NULL;
+static int CompareParamsNoDistance(size_t i, size_t j)
+{
+  for(int k=0; k<COMPUTELLVSNR_NPARAMS; k++) {
+    if(k==3) continue;
+    double vi = gsl_vector_get(paramscolumns[k], i);
+    double vj = gsl_vector_get(paramscolumns[k], j);
+    if(vi<vj) return -1;
+    if(vi>vj) return 1;
+  }
+  return 0;
+}
+static int CompareParamsLinesNoDistance(const void* a, const void* b)
+{
+  size_t i = *((const size_t*) a);
+  size_t j = *((const size_t*) b);
+  int c = CompareParamsNoDistance(i, j);
+  if(c!=0) return c;
+  return (i<j) ? -1 : (i>j);
+}
+
+/***************** Main program *****************/
+
+int main(int argc, char *argv[])
+{
+  /* Initialize structure for parameters */
+  ComputeLLVSNRparams* params;
+  params = (ComputeLLVSNRparams*) malloc(sizeof(ComputeLLVSNRparams));
+  memset(params, 0, sizeof(ComputeLLVSNRparams));
+
+  /* Parse commandline to read parameters */
+  parse_args_ComputeLLVSNR(argc, argv, params);
+
+  /* Network and noise tables, shared read-only by the threads - no GMST cache, the times of the catalogue are arbitrary */
+  LLVNetwork* network = NULL;
+  LLVNetwork_Init(&network, params->network);
+  LLVNetwork_InitNoise(network);
+  int ndet = network->ndet;
+  ObjectFunction Snoises[LLV_NDETMAX];
+  for(int k=0; k<ndet; k++) Snoises[k] = LLVNetwork_NoiseFunction(network, k);
+
+  /* Load the catalogue - the lines are counted if nlinesparams is 0 */
+  gsl_vector* columns[COMPUTELLVSNR_NPARAMS];
+  int nlines = 0;
+  if(Read_Columns(columns, COMPUTELLVSNR_NPARAMS, &nlines, params->paramsdir, params->paramsfile, params->nlinesparams, params->binaryin)==FAILURE) exit(1);
+
+  /* Initialize output matrix */
+  /* Format: m1, m2, tRef, dist, phase, inc, ra, dec, pol, SNR, horizon distance, SNR of each detector, [logL] */
+  int colsnrdet = COMPUTELLVSNR_NPARAMS + 2;
+  int collogL = colsnrdet + ndet;
+  int ncolsout = params->loglikelihood ? collogL + 1 : collogL;
+  gsl_matrix* outmatrix = gsl_matrix_alloc(nlines, ncolsout);
+  for(int k=0; k<COMPUTELLVSNR_NPARAMS; k++) gsl_matrix_set_col(outmatrix, k, columns[k]);
+
+  /* The SNRs scale as 1/distance and the log-likelihood as 1/distance^2: lines differing only by their distance are grouped, and one waveform is generated per group */
+  size_t* order = (size_t*) malloc(nlines*sizeof(size_t));
+  for(int i=0; i<nlines; i++) order[i] = i;
+  paramscolumns = columns;
+  qsort(order, nlines, sizeof(size_t), CompareParamsLinesNoDistance);
+  int* groupstart = (int*) malloc((nlines+1)*sizeof(int));
+  int ngroups = 0;
+  for(int i=0; i<nlines; i++) {
+    if(i==0 || CompareParamsNoDistance(order[i-1], order[i])!=0) groupstart[ngroups++] = i;
+  }
+  groupstart[ngroups] = nlines;
+
+  /* Load the ROM data before entering the parallel region - shared read-only by the threads */
+  if(EOBNRv2HMROM_Init_DATA()==FAILURE) exit(1);
+
+  /* Each thread draws the temporaries of its sources from its own arena, reset after each group */
+  int nfailed = 0;
+  #pragma omp parallel reduction(+:nfailed)
+  {
+    Arena* arena = NULL;
+    Arena_Init(&arena, COMPUTELLVSNR_ARENA_SIZE);
+    Arena* previous = Arena_Bind(arena);
+
+    #pragma omp for schedule(dynamic)
+    for(int g=0; g<ngroups; g++) {
+      double p[COMPUTELLVSNR_NPARAMS];
+      size_t iref = order[groupstart[g]];
+      for(int k=0; k<COMPUTELLVSNR_NPARAMS; k++) p[k] = gsl_vector_get(columns[k], iref);
+
+      double SNR2det[LLV_NDETMAX];
+      double logLref = 0.;
+      int ret = ComputeSourceSNR(SNR2det, &logLref, p, params, network, Snoises);
+      Arena_Reset(arena);
+
+      /* Set values in output matrix */
+      for(int i=groupstart[g]; i<groupstart[g+1]; i++) {
+        size_t line = order[i];
+        if(ret==FAILURE) {
+          for(int k=COMPUTELLVSNR_NPARAMS; k<ncolsout; k++) gsl_matrix_set(outmatrix, line, k, NAN);
+          nfailed++;
+          continue;
+        }
+        double ratio = p[3] / gsl_vector_get(columns[3], line);
+        double SNR2 = 0.;
+        for(int k=0; k<ndet; k++) {
+          gsl_matrix_set(outmatrix, line, colsnrdet + k, sqrt(SNR2det[k]) * ratio);
+          SNR2 += SNR2det[k];
+        }
+        double SNR = sqrt(SNR2) * ratio;
+        gsl_matrix_set(outmatrix, line, COMPUTELLVSNR_NPARAMS, SNR);
+        gsl_matrix_set(outmatrix, line, COMPUTELLVSNR_NPARAMS + 1, gsl_vector_get(columns[3], line) * SNR / params->snrthreshold);
+        if(params->loglikelihood) gsl_matrix_set(outmatrix, line, collogL, logLref * ratio*ratio);
+      }
+    }
+
+    Arena_Bind(previous);
+    Arena_Cleanup(arena);
+  }
+  if(nfailed>0) printf("Warning in ComputeLLVSNR: generation failed for %d lines, set to nan.\n", nfailed);
+  free(order);
+  free(groupstart);
+
+  /* Output matrix */
+  if(Write_Table(params->paramsdir, params->outputfile, outmatrix, params->binaryout)==FAILURE) exit(1);
+
+  /* Clean up */
+  gsl_matrix_free(outmatrix);
+  for(int k=0; k<COMPUTELLVSNR_NPARAMS; k++) ArenaVectorFree(columns[k]);
+  LLVNetwork_Cleanup(network);
+  free(params);
+
+  return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * \author Sylvain Marsat, University of Maryland - NASA GSFC
+ *
+ * \brief C header for the computation of the SNRs of a catalogue of injections in a network of ground-based detectors.
+ *
+ */
+
+#ifndef __COMPUTELLVSNR_H__
+#define __COMPUTELLVSNR_H__ 1
+
+#ifdef __GNUC__
+#define UNUSED __attribute__ ((unused))
+#else
+#define UNUSED
+#endif
+
+#define _XOPEN_SOURCE 500
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include <time.h>
+#include <unistd.h>
+#include <string.h>
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_spline.h>
+
+#include "constants.h"
+#include "struct.h"
+#include "waveform.h"
+#include "splinecoeffs.h"
+#include "likelihood.h"
+#include "EOBNRv2HMROMstruct.h"
+#include "EOBNRv2HMROM.h"
+#include "LLVgeometry.h"
+#include "LLVnoise.h"
+#include "LLVnetwork.h"
+#include "LLVFDresponse.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#elif 0
+} /* so that editors will match preceding brace */
+#endif
+
+/* Number of parameters per line of the catalogue, in the order of the internals: */
+/* m1 (solar masses), m2 (solar masses), tRef (s), dist (Mpc), phase (rad), inc (rad), ra (rad), dec (rad), pol (rad) */
+#define COMPUTELLVSNR_NPARAMS 9
+
+/********************************** Structures ******************************************/
+
+/* Settings of the campaign - the parameters of the sources are read from the catalogue */
+typedef struct tagComputeLLVSNRparams {
+  char network[LLV_NDETMAX+1]; /* Detectors of the network, one letter each (H, L, V, K, I) - defaults to LHV */
+  int nbmode;                /* number of modes of the injections (starting with 22) - defaults to 5 (all modes) */
+  int nbmodetemp;            /* number of modes of the templates for the likelihood diagnostic (starting with 22) - defaults to 1 */
+  double fRef;               /* reference frequency at which phiRef is set (Hz, default 0 which is interpreted as Mf=0.14) */
+  int setphiRefatfRef;       /* Flag for adjusting the FD phase at phiRef at the given fRef (default 1) */
+  double minf;               /* Minimal frequency (Hz, default=10) */
+  double maxf;               /* Maximal frequency (Hz, default=4096) */
+  double snrthreshold;       /* Network SNR defining the horizon distance of each source (default 8) */
+  int loglikelihood;         /* Option to also compute ln L = -1/2 (h-s|h-s) for a template with nbmodetemp modes at the parameters of the injection (default 0) */
+  int nlinesparams;          /* Number of lines in the catalogue (0: counted from the file) */
+  int binaryin;              /* Format of the catalogue: FILE_TEXT, FILE_BINARY (gsl binary) or FILE_COLUMNAR (default text) */
+  int binaryout;             /* Format of the results table: FILE_TEXT, FILE_BINARY (gsl binary) or FILE_COLUMNAR (default gsl binary) */
+  char paramsdir[256];       /* Directory for the input/output files */
+  char paramsfile[256];      /* Catalogue of injections */
+  char outputfile[256];      /* Results table */
+} ComputeLLVSNRparams;
+
+#if 0
+{ /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif /* _COMPUTELLVSNR_H */
@@ -289,8 +289,11 @@ int main(int argc, char *argv[])
   injectedparams->nbmode = globalparams->nbmodeinj;
 	if(myid == 0) print_parameters_to_file_LLV(injectedparams, globalparams, priorParams, &runParams);
 
-  /* Load and initialize the detector noise */
-  LLVSimFD_Noise_Init_ParsePath();
+  /* Set up the network of detectors, and load and initialize the noise of each detector */
+  LLVNetwork_Init(&network, globalparams->network);
+  LLVNetwork_InitNoise(network);
+  /* Linearized GMST angle over the prior range of tRef */
+  LLVNetwork_InitGMSTCache(network, injectedparams->tRef, priorParams->deltaT);
 
 	/* Initialize the data structure for the injection */
   LLVInjectionCAmpPhase* injectedsignalCAmpPhase = NULL;
@@ -307,19 +310,17 @@ int main(int argc, char *argv[])
     LLVGenerateInjectionCAmpPhase(injectedparams, injectedsignalCAmpPhase);
   }
   else if(globalparams->tagint==1) {
-    LLVGenerateInjectionReIm(injectedparams, globalparams->minf, globalparams->maxf, globalparams->nbptsoverlap, 1, injectedsignalReIm); /* Use here logarithmic sampling as a default */
+    LLVGenerateInjectionReIm(injectedparams, globalparams->minf, globalparams->maxf, globalparams->nbptsoverlap, !globalparams->margtime, injectedsignalReIm); /* Use here logarithmic sampling as a default - linear for the FFT of the time marginalization */
   }
 
 	/* Define SNRs */
-	double SNR123, SNR1, SNR2, SNR3;
+	double SNR123 = 0.;
 	if(globalparams->tagint==0) {
 		SNR123 = sqrt(injectedsignalCAmpPhase->LLVss);
 	}
 	else if(globalparams->tagint==1) {
-		SNR1 = sqrt(FDOverlapReImvsReIm(injectedsignalReIm->LHOSignal, injectedsignalReIm->LHOSignal, injectedsignalReIm->noisevaluesLHO));
-		SNR2 = sqrt(FDOverlapReImvsReIm(injectedsignalReIm->LLOSignal, injectedsignalReIm->LLOSignal, injectedsignalReIm->noisevaluesLLO));
-		SNR3 = sqrt(FDOverlapReImvsReIm(injectedsignalReIm->VIRGOSignal, injectedsignalReIm->VIRGOSignal, injectedsignalReIm->noisevaluesVIRGO));
-		SNR123 = sqrt(SNR1*SNR1 + SNR2*SNR2 + SNR3*SNR3);
+		for(int k=0; k<network->ndet; k++) SNR123 += FDOverlapReImvsReIm(injectedsignalReIm->DetSignal[k], injectedsignalReIm->DetSignal[k], injectedsignalReIm->noisevalues[k]);
+		SNR123 = sqrt(SNR123);
 	}
 
 	/* Rescale distance to match SNR */
@@ -338,14 +339,16 @@ int main(int argc, char *argv[])
       SNR123 = sqrt(injectedsignalCAmpPhase->LLVss);
     }
     else if(globalparams->tagint==1) {
-      LLVGenerateInjectionReIm(injectedparams, globalparams->minf, globalparams->maxf, globalparams->nbptsoverlap, 1, injectedsignalReIm); /* tagsampling fixed to 1, i.e. logarithmic sampling - could be made another global parameter */
-      SNR1 = sqrt(FDOverlapReImvsReIm(injectedsignalReIm->LHOSignal, injectedsignalReIm->LHOSignal, injectedsignalReIm->noisevaluesLHO));
-      SNR2 = sqrt(FDOverlapReImvsReIm(injectedsignalReIm->LLOSignal, injectedsignalReIm->LLOSignal, injectedsignalReIm->noisevaluesLLO));
-      SNR3 = sqrt(FDOverlapReImvsReIm(injectedsignalReIm->VIRGOSignal, injectedsignalReIm->VIRGOSignal, injectedsignalReIm->noisevaluesVIRGO));
-      SNR123 = sqrt(SNR1*SNR1 + SNR2*SNR2 + SNR3*SNR3);
+      LLVGenerateInjectionReIm(injectedparams, globalparams->minf, globalparams->maxf, globalparams->nbptsoverlap, !globalparams->margtime, injectedsignalReIm); /* Use here logarithmic sampling as a default - linear for the FFT of the time marginalization */
+      SNR123 = 0.;
+      for(int k=0; k<network->ndet; k++) SNR123 += FDOverlapReImvsReIm(injectedsignalReIm->DetSignal[k], injectedsignalReIm->DetSignal[k], injectedsignalReIm->noisevalues[k]);
+      SNR123 = sqrt(SNR123);
     }
   }
 
+  /* Check the FFT range of the time marginalization against the prior window */
+  if(globalparams->margtime && LLVCheckMargTimeWindow(injectedsignalReIm)==FAILURE) exit(1);
+
   /* print SNRs */
   if (myid == 0) {
     printf("SNR Network: %g\n", SNR123);
@@ -393,6 +396,12 @@ int main(int argc, char *argv[])
 	if (priorParams->pin_time)
 		priorParams->fix_time = injectedparams->tRef;
 
+  /* Time and phase are not sampled when the likelihood is marginalized over them - the time window is centered on the injection */
+  if (globalparams->margtime)
+    priorParams->fix_time = injectedparams->tRef;
+  if (globalparams->margphase)
+    priorParams->fix_phase = injectedparams->phiRef;
+
 	/* Check for fixed parameters, and build the map from the free cube parameters to the orignal 9 parameters */
 	/* Order of the 9 original parameters (fixed): m1, m2, tRef, dist, phase, inc, ra, dec, pol */
 	/* Order of the 9 cube parameters (modified for clustering): ra, dec, tRef, phase, pol, inc, dist, m1, m2 */
@@ -439,6 +448,7 @@ int main(int argc, char *argv[])
 
     free(injectedparams);
     free(priorParams);
+    LLVNetwork_Cleanup(network);
 
 #ifdef PARALLEL
     MPI_Finalize();
@@ -594,6 +604,7 @@ int main(int argc, char *argv[])
 
   free(injectedparams);
   free(priorParams);
+  LLVNetwork_Cleanup(network);
 
 #ifdef PARALLEL
  	MPI_Finalize();
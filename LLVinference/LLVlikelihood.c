@@ -32,8 +32,11 @@ int main(int argc, char *argv[])
   injectedparams->nbmode = globalparams->nbmodeinj;
   addparams->nbmode = globalparams->nbmodetemp;
 
-  /* Load and initialize the detector noise */
-  LLVSimFD_Noise_Init_ParsePath();
+  /* Set up the network of detectors, and load and initialize the noise of each detector */
+  LLVNetwork_Init(&network, globalparams->network);
+  LLVNetwork_InitNoise(network);
+  /* Linearized GMST angle over the prior range of tRef */
+  LLVNetwork_InitGMSTCache(network, injectedparams->tRef, priorParams->deltaT);
 
   /* Initialize the data structure for the injection */
   LLVInjectionCAmpPhase* injectedsignalCAmpPhase = NULL;
@@ -50,9 +53,12 @@ int main(int argc, char *argv[])
     LLVGenerateInjectionCAmpPhase(injectedparams, injectedsignalCAmpPhase);
   }
   else if(globalparams->tagint==1) {
-    LLVGenerateInjectionReIm(injectedparams, globalparams->minf, globalparams->maxf, globalparams->nbptsoverlap, 1, injectedsignalReIm); /* Use here logarithmic sampling as a default */
+    LLVGenerateInjectionReIm(injectedparams, globalparams->minf, globalparams->maxf, globalparams->nbptsoverlap, !globalparams->margtime, injectedsignalReIm); /* Use here logarithmic sampling as a default - linear for the FFT of the time marginalization */
   }
 
+  /* Check the FFT range of the time marginalization against the prior window */
+  if(globalparams->margtime && LLVCheckMargTimeWindow(injectedsignalReIm)==FAILURE) exit(1);
+
   /* Print parameters */
   printf("--------------------------------------------------------\n");
   printf("Params |       Injection        |       Template        \n");
@@ -89,4 +95,12 @@ int main(int argc, char *argv[])
   }
   printf("logZtemp = %.16e\n", logZtemp);
 
+  /* Validation of the time marginalization against a direct quadrature over tRef, with a step of 1e-6 s */
+  if(globalparams->margtime) {
+    int nbtimes = (int) ceil(2*priorParams->deltaT/1e-6) + 1;
+    double logZtempdirect = CalculateLogLReImMarginalizedDirect(addparams, injectedsignalReIm, nbtimes);
+    printf("logZtemp (direct quadrature over tRef, %d times) = %.16e\n", nbtimes, logZtempdirect);
+    printf("difference = %.3e\n", logZtemp - logZtempdirect);
+  }
+
 }
@@ -6,13 +6,12 @@ LLVParams* injectedparams = NULL;
 LLVGlobalParams* globalparams = NULL;
 LLVPrior* priorParams = NULL;
 LLVParams* addparams = NULL;
+LLVNetwork* network = NULL;
 
 /************ Functions to initalize and clean up structure for the signals ************/
 
 void LLVSignalCAmpPhase_Cleanup(LLVSignalCAmpPhase* signal) {
-  if(signal->LHOSignal) ListmodesCAmpPhaseFrequencySeries_Destroy(signal->LHOSignal);
-  if(signal->LLOSignal) ListmodesCAmpPhaseFrequencySeries_Destroy(signal->LLOSignal);
-  if(signal->VIRGOSignal) ListmodesCAmpPhaseFrequencySeries_Destroy(signal->VIRGOSignal);
+  if(signal->ROMSignal) ListmodesCAmpPhaseFrequencySeries_Destroy(signal->ROMSignal);
   free(signal);
 }
 
@@ -24,15 +23,11 @@ void LLVSignalCAmpPhase_Init(LLVSignalCAmpPhase** signal) {
   {
     LLVSignalCAmpPhase_Cleanup(*signal);
   }
-  (*signal)->LHOSignal = NULL;
-  (*signal)->LLOSignal = NULL;
-  (*signal)->VIRGOSignal = NULL;
+  (*signal)->ROMSignal = NULL;
 }
 
 void LLVInjectionCAmpPhase_Cleanup(LLVInjectionCAmpPhase* signal) {
-  if(signal->LHOSplines) ListmodesCAmpPhaseSpline_Destroy(signal->LHOSplines);
-  if(signal->LLOSplines) ListmodesCAmpPhaseSpline_Destroy(signal->LLOSplines);
-  if(signal->VIRGOSplines) ListmodesCAmpPhaseSpline_Destroy(signal->VIRGOSplines);
+  if(signal->ROMSplines) ListmodesCAmpPhaseSpline_Destroy(signal->ROMSplines);
   free(signal);
 }
 
@@ -44,15 +39,11 @@ void LLVInjectionCAmpPhase_Init(LLVInjectionCAmpPhase** signal) {
   {
     LLVInjectionCAmpPhase_Cleanup(*signal);
   }
-  (*signal)->LHOSplines = NULL;
-  (*signal)->LLOSplines = NULL;
-  (*signal)->VIRGOSplines = NULL;
+  (*signal)->ROMSplines = NULL;
 }
 
 void LLVSignalReIm_Cleanup(LLVSignalReIm* signal) {
-  if(signal->LHOSignal) ReImFrequencySeries_Cleanup(signal->LHOSignal);
-  if(signal->LLOSignal) ReImFrequencySeries_Cleanup(signal->LLOSignal);
-  if(signal->VIRGOSignal) ReImFrequencySeries_Cleanup(signal->VIRGOSignal);
+  for(int k=0; k<LLV_NDETMAX; k++) if(signal->DetSignal[k]) ReImFrequencySeries_Cleanup(signal->DetSignal[k]);
   free(signal);
 }
 
@@ -64,19 +55,16 @@ void LLVSignalReIm_Init(LLVSignalReIm** signal) {
   {
     LLVSignalReIm_Cleanup(*signal);
   }
-  (*signal)->LHOSignal = NULL;
-  (*signal)->LLOSignal = NULL;
-  (*signal)->VIRGOSignal = NULL;
+  (*signal)->ndet = 0;
+  for(int k=0; k<LLV_NDETMAX; k++) (*signal)->DetSignal[k] = NULL;
 }
 
 void LLVInjectionReIm_Cleanup(LLVInjectionReIm* signal) {
-  if(signal->LHOSignal) ReImFrequencySeries_Cleanup(signal->LHOSignal);
-  if(signal->LLOSignal) ReImFrequencySeries_Cleanup(signal->LLOSignal);
-  if(signal->VIRGOSignal) ReImFrequencySeries_Cleanup(signal->VIRGOSignal);
+  for(int k=0; k<LLV_NDETMAX; k++) {
+    if(signal->DetSignal[k]) ReImFrequencySeries_Cleanup(signal->DetSignal[k]);
+    if(signal->noisevalues[k]) gsl_vector_free(signal->noisevalues[k]);
+  }
   if(signal->freq) gsl_vector_free(signal->freq);
-  if(signal->noisevaluesLLO) gsl_vector_free(signal->noisevaluesLLO);
-  if(signal->noisevaluesLHO) gsl_vector_free(signal->noisevaluesLHO);
-  if(signal->noisevaluesVIRGO) gsl_vector_free(signal->noisevaluesVIRGO);
   free(signal);
 }
 
@@ -88,13 +76,13 @@ void LLVInjectionReIm_Init(LLVInjectionReIm** signal) {
   {
     LLVInjectionReIm_Cleanup(*signal);
   }
-  (*signal)->LHOSignal = NULL;
-  (*signal)->LLOSignal = NULL;
-  (*signal)->VIRGOSignal = NULL;
+  (*signal)->ndet = 0;
+  for(int k=0; k<LLV_NDETMAX; k++) {
+    (*signal)->DetSignal[k] = NULL;
+    (*signal)->noisevalues[k] = NULL;
+  }
   (*signal)->freq = NULL;
-  (*signal)->noisevaluesLHO = NULL;
-  (*signal)->noisevaluesLLO = NULL;
-  (*signal)->noisevaluesVIRGO = NULL;
+  (*signal)->LLVss = 0.;
 }
 
 /************ Functions for LLV parameters, injection, likelihood, prior ************/
@@ -144,8 +132,12 @@ Arguments are as follows:\n\
  --nbmodeinj           Number of modes of radiation to use for the injection (1-5, default=5)\n\
  --nbmodetemp          Number of modes of radiation to use for the templates (1-5, default=5)\n\
  --tagint              Tag choosing the integrator: 0 for Fresnel (default), 1 for linear integration\n\
- --tagnetwork          Tag choosing the network of detectors to use (default LHV)\n\
+ --tagnetwork          Detectors of the network, one letter each: H (LIGO Hanford), L (LIGO Livingston), V (VIRGO), K (KAGRA), I (LIGO India) (default LHV)\n\
  --nbptsoverlap        Number of points to use for linear integration (default 32768)\n\
+ --margtime            Marginalize the likelihood over the time of arrival in the prior window, with an FFT - requires --tagint 1, tRef is then not sampled (no option, default off)\n\
+ --margphase           Marginalize the likelihood over a constant phase of the signal - requires --tagint 1, phiRef is then not sampled and is pinned to the injected value (no option, default off)\n\
+                       Note: for templates with higher modes, the constant phase differs from the orbital phase and the marginalization is approximate\n\
+ --nzeropadmarg        0-padding of the FFT for --margtime, length will be (upper power of 2 of nbptsoverlap)*2^nzeropadmarg (default 2)\n\
  --constL              Set all logLikelihood to 0 - allows to sample from the prior for testing (no option, default off)\n\
 \n\
 --------------------------------------------------\n\
@@ -224,8 +216,11 @@ Syntax: --PARAM-min\n\
     globalparams->nbmodeinj = 5;
     globalparams->nbmodetemp = 5;
     globalparams->tagint = 0;
-    globalparams->tagnetwork = LHV;
+    strcpy(globalparams->network, "LHV");
     globalparams->nbptsoverlap = 32768;
+    globalparams->margtime = 0;
+    globalparams->margphase = 0;
+    globalparams->nzeropadmarg = 2;
     globalparams->constL = 0;
 
     /* set default values for the prior limits */
@@ -322,9 +317,19 @@ Syntax: --PARAM-min\n\
         } else if (strcmp(argv[i], "--tagint") == 0) {
             globalparams->tagint = atoi(argv[++i]);
         } else if (strcmp(argv[i], "--tagnetwork") == 0) {
-            globalparams->tagnetwork = ParseNetworktag(argv[++i]);
+            if(strlen(argv[++i])>LLV_NDETMAX) {
+              printf("Error in parse_args_LLV: at most %d detectors in the network.\n", LLV_NDETMAX);
+              exit(1);
+            }
+            strcpy(globalparams->network, argv[i]);
         } else if (strcmp(argv[i], "--nbptsoverlap") == 0) {
             globalparams->nbptsoverlap = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--margtime") == 0) {
+            globalparams->margtime = 1;
+        } else if (strcmp(argv[i], "--margphase") == 0) {
+            globalparams->margphase = 1;
+        } else if (strcmp(argv[i], "--nzeropadmarg") == 0) {
+            globalparams->nzeropadmarg = atoi(argv[++i]);
         } else if (strcmp(argv[i], "--constL") == 0) {
             globalparams->constL = 1;
         } else if (strcmp(argv[i], "--deltaT") == 0) {
@@ -448,6 +453,12 @@ Syntax: --PARAM-min\n\
         }
     }
 
+    /* The marginalized likelihoods are built on the Re/Im frequency series */
+    if((globalparams->margtime || globalparams->margphase) && globalparams->tagint!=1) {
+        printf("Error in parse_args_LLV: --margtime and --margphase require --tagint 1.\n");
+        goto fail;
+    }
+
     return;
 
     fail:
@@ -492,8 +503,11 @@ int print_parameters_to_file_LLV(
   fprintf(f, "nbmodeinj:    %d\n", globalparams->nbmodeinj);
   fprintf(f, "nbmodetemp:   %d\n", globalparams->nbmodetemp);
   fprintf(f, "tagint:       %d\n", globalparams->tagint);
-  fprintf(f, "tagnetwork:   %d\n", globalparams->tagnetwork); //Translation back from enum to string not implemented yet
+  fprintf(f, "tagnetwork:   %s\n", globalparams->network);
   fprintf(f, "nbptsoverlap: %d\n", globalparams->nbptsoverlap);
+  fprintf(f, "margtime:     %d\n", globalparams->margtime);
+  fprintf(f, "margphase:    %d\n", globalparams->margphase);
+  fprintf(f, "nzeropadmarg: %d\n", globalparams->nzeropadmarg);
   fprintf(f, "constL:       %d\n", globalparams->constL);
   fprintf(f, "-----------------------------------------------\n");
   fprintf(f, "\n");
@@ -603,9 +617,6 @@ int LLVGenerateSignalCAmpPhase(
 {
   int ret;
   ListmodesCAmpPhaseFrequencySeries* listROM = NULL;
-  ListmodesCAmpPhaseFrequencySeries* listDet1 = NULL;
-  ListmodesCAmpPhaseFrequencySeries* listDet2 = NULL;
-  ListmodesCAmpPhaseFrequencySeries* listDet3 = NULL;
 
   /* Checking that the global injectedparams has been set up */
   if (!injectedparams) {
@@ -620,45 +631,24 @@ int LLVGenerateSignalCAmpPhase(
   /* If the ROM waveform generation failed (e.g. parameters were out of bounds) return FAILURE */
   if(ret==FAILURE) return FAILURE;
 
-  /* Process the waveform through the LLV response */
-  //TESTING
-  //clock_t tbeg, tend;
-  //tbeg = clock();
-  LLVSimFDResponse3Det(&listDet1, &listDet2, &listDet3, &listROM, params->tRef, params->ra, params->dec, params->inclination, params->polarization, globalparams->tagnetwork);
-  //tend = clock();
-  //printf("time LLVSimFDResponse: %g\n", (double) (tend-tbeg)/CLOCKS_PER_SEC);
-  //
+  /* LLV response, reduced to factors and delays for each detector - the modes themselves are not processed */
+  LLVSimFDResponseFactorsNetwork(signal->factors, signal->twopidelays, listROM, params->tRef, params->ra, params->dec, params->inclination, params->polarization, network);
 
-  /* Pre-interpolate the injection, building the spline matrices */
-  ListmodesCAmpPhaseSpline* listsplinesgen1 = NULL;
-  ListmodesCAmpPhaseSpline* listsplinesgen2 = NULL;
-  ListmodesCAmpPhaseSpline* listsplinesgen3 = NULL;
-  BuildListmodesCAmpPhaseSpline(&listsplinesgen1, listDet1);
-  BuildListmodesCAmpPhaseSpline(&listsplinesgen2, listDet2);
-  BuildListmodesCAmpPhaseSpline(&listsplinesgen3, listDet3);
+  /* Pre-interpolate the modes, building the spline matrices - once for all the detectors */
+  ListmodesCAmpPhaseSpline* listsplinesgen = NULL;
+  BuildListmodesCAmpPhaseSpline(&listsplinesgen, listROM);
 
-  /* Precompute the inner product (h|h) */
-  //TESTING
-  //tbeg = clock();
-  /* Note: we ignore fstartobs and assume (for the noises) that the detectors are LHO, LLO and VIRGO */
-  /* Note: beacause the response induces a difference in the phases (the time delay to each detector), we have to compute three separate overlaps - which is not optimal*/
-  double LHOhh =  FDListmodesFresnelOverlap(listDet1, listsplinesgen1, NoiseSnLHO, globalparams->minf, globalparams->maxf, 0., 0.);
-  double LLOhh =  FDListmodesFresnelOverlap(listDet2, listsplinesgen2, NoiseSnLLO, globalparams->minf, globalparams->maxf, 0., 0.);
-  double VIRGOhh =  FDListmodesFresnelOverlap(listDet3, listsplinesgen3, NoiseSnVIRGO, globalparams->minf, globalparams->maxf, 0., 0.);
-  double Det123hh = LHOhh + LLOhh + VIRGOhh;
-  //tend = clock();
-  //printf("time SNRs: %g\n", (double) (tend-tbeg)/CLOCKS_PER_SEC);
+  /* Precompute the inner product (h|h) - we ignore fstartobs */
+  /* Note: the detectors are combined in a single overlap, the delays entering the Fresnel integrals as linear phases */
+  ObjectFunction Snoises[LLV_NDETMAX];
+  for(int k=0; k<network->ndet; k++) Snoises[k] = LLVNetwork_NoiseFunction(network, k);
+  double LLVhh = FDListmodesFresnelOverlapNetwork(listROM, listsplinesgen, network->ndet, signal->factors, signal->factors, signal->twopidelays, signal->twopidelays, Snoises, globalparams->minf, globalparams->maxf, 0., 0.);
 
   /* Output and clean up */
-  signal->LHOSignal = listDet1;
-  signal->LLOSignal = listDet2;
-  signal->VIRGOSignal = listDet3;
-  signal->LLVhh = Det123hh;
+  signal->ROMSignal = listROM;
+  signal->LLVhh = LLVhh;
 
-  ListmodesCAmpPhaseFrequencySeries_Destroy(listROM);
-  ListmodesCAmpPhaseSpline_Destroy(listsplinesgen1);
-  ListmodesCAmpPhaseSpline_Destroy(listsplinesgen2);
-  ListmodesCAmpPhaseSpline_Destroy(listsplinesgen3);
+  ListmodesCAmpPhaseSpline_Destroy(listsplinesgen);
 
   return SUCCESS;
 }
@@ -670,9 +660,6 @@ int LLVGenerateInjectionCAmpPhase(
 {
   int ret;
   ListmodesCAmpPhaseFrequencySeries* listROM = NULL;
-  ListmodesCAmpPhaseFrequencySeries* listDet1 = NULL;
-  ListmodesCAmpPhaseFrequencySeries* listDet2 = NULL;
-  ListmodesCAmpPhaseFrequencySeries* listDet3 = NULL;
 
   /* Should add more error checking ? */
   /* Generate the waveform with the ROM */
@@ -682,45 +669,24 @@ int LLVGenerateInjectionCAmpPhase(
   /* If the ROM waveform generation failed (e.g. parameters were out of bounds) return FAILURE */
   if(ret==FAILURE) return FAILURE;
 
-  /* Process the waveform through the LLV response */
-  //TESTING
-  //clock_t tbeg, tend;
-  //tbeg = clock();
-  LLVSimFDResponse3Det(&listDet1, &listDet2, &listDet3, &listROM, params->tRef, params->ra, params->dec, params->inclination, params->polarization, globalparams->tagnetwork);
-  //tend = clock();
-  //printf("time LLVSimFDResponse: %g\n", (double) (tend-tbeg)/CLOCKS_PER_SEC);
-  //
+  /* LLV response, reduced to factors and delays for each detector - the modes themselves are not processed */
+  LLVSimFDResponseFactorsNetwork(signal->factors, signal->twopidelays, listROM, params->tRef, params->ra, params->dec, params->inclination, params->polarization, network);
 
-  /* Pre-interpolate the injection, building the spline matrices */
-  ListmodesCAmpPhaseSpline* listsplinesinj1 = NULL;
-  ListmodesCAmpPhaseSpline* listsplinesinj2 = NULL;
-  ListmodesCAmpPhaseSpline* listsplinesinj3 = NULL;
-  BuildListmodesCAmpPhaseSpline(&listsplinesinj1, listDet1);
-  BuildListmodesCAmpPhaseSpline(&listsplinesinj2, listDet2);
-  BuildListmodesCAmpPhaseSpline(&listsplinesinj3, listDet3);
+  /* Pre-interpolate the injection, building the spline matrices - once for all the detectors */
+  ListmodesCAmpPhaseSpline* listsplinesinj = NULL;
+  BuildListmodesCAmpPhaseSpline(&listsplinesinj, listROM);
 
   /* Precompute the inner product (h|h) - we ignore deltatobs */
-  /* Note: for the noise functions we assume the detectors are L,H,V */
-  //TESTING
-  //tbeg = clock();
-  /* Note: beacause the response induces a difference in the phases (the time delay to each detector), we have to compute three separate overlaps - which is not optimal*/
-  double LHOss =  FDListmodesFresnelOverlap(listDet1, listsplinesinj1, NoiseSnLHO, globalparams->minf, globalparams->maxf, 0., 0.);
-  double LLOss =  FDListmodesFresnelOverlap(listDet2, listsplinesinj2, NoiseSnLLO, globalparams->minf, globalparams->maxf, 0., 0.);
-  double VIRGOss =  FDListmodesFresnelOverlap(listDet3, listsplinesinj3, NoiseSnVIRGO, globalparams->minf, globalparams->maxf, 0., 0.);
-  double Det123ss = LHOss + LLOss + VIRGOss;
-  //tend = clock();
-  //printf("time SNRs: %g\n", (double) (tend-tbeg)/CLOCKS_PER_SEC);
+  /* Note: the detectors are combined in a single overlap, the delays entering the Fresnel integrals as linear phases */
+  ObjectFunction Snoises[LLV_NDETMAX];
+  for(int k=0; k<network->ndet; k++) Snoises[k] = LLVNetwork_NoiseFunction(network, k);
+  double LLVss = FDListmodesFresnelOverlapNetwork(listROM, listsplinesinj, network->ndet, signal->factors, signal->factors, signal->twopidelays, signal->twopidelays, Snoises, globalparams->minf, globalparams->maxf, 0., 0.);
 
   /* Output and clean up */
-  signal->LHOSplines = listsplinesinj1;
-  signal->LLOSplines = listsplinesinj2;
-  signal->VIRGOSplines = listsplinesinj3;
-  signal->LLVss = Det123ss;
+  signal->ROMSplines = listsplinesinj;
+  signal->LLVss = LLVss;
 
   ListmodesCAmpPhaseFrequencySeries_Destroy(listROM);
-  ListmodesCAmpPhaseFrequencySeries_Destroy(listDet1);
-  ListmodesCAmpPhaseFrequencySeries_Destroy(listDet2);
-  ListmodesCAmpPhaseFrequencySeries_Destroy(listDet3);
 
   return SUCCESS;
 }
@@ -733,9 +699,6 @@ int LLVGenerateSignalReIm(
 {
   int ret;
   ListmodesCAmpPhaseFrequencySeries* listROM = NULL;
-  ListmodesCAmpPhaseFrequencySeries* listDet1 = NULL;
-  ListmodesCAmpPhaseFrequencySeries* listDet2 = NULL;
-  ListmodesCAmpPhaseFrequencySeries* listDet3 = NULL;
 
   /* Checking that the global injectedparams has been set up */
   if (!injectedparams) {
@@ -750,43 +713,19 @@ int LLVGenerateSignalReIm(
   /* If the ROM waveform generation failed (e.g. parameters were out of bounds) return FAILURE */
   if(ret==FAILURE) return FAILURE;
 
-  /* Process the waveform through the LLV response */
-  //TESTING
-  //clock_t tbeg, tend;
-  //tbeg = clock();
-  LLVSimFDResponse3Det(&listDet1, &listDet2, &listDet3, &listROM, params->tRef, params->ra, params->dec, params->inclination, params->polarization, globalparams->tagnetwork);
-  //tend = clock();
-  //printf("time LLVSimFDResponse: %g\n", (double) (tend-tbeg)/CLOCKS_PER_SEC);
-  //
+  /* LLV response, reduced to factors and delays for each detector - computed once for the network */
+  double complex factors[LLV_NDETMAX*nbmodemax];
+  double twopidelays[LLV_NDETMAX];
+  LLVSimFDResponseFactorsNetwork(factors, twopidelays, listROM, params->tRef, params->ra, params->dec, params->inclination, params->polarization, network);
 
-  /* Initialize structures for the ReIm frequency series */
+  /* Compute the Re/Im frequency series in each detector, applying the factors and delays on the fly to the modes of the ROM - we ignore fstartobs, minf, maxf */
   int nbpts = (int) freq->size;
-  ReImFrequencySeries* freqseriesDet1 = NULL;
-  ReImFrequencySeries* freqseriesDet2 = NULL;
-  ReImFrequencySeries* freqseriesDet3 = NULL;
-  ReImFrequencySeries_Init(&freqseriesDet1, nbpts);
-  ReImFrequencySeries_Init(&freqseriesDet2, nbpts);
-  ReImFrequencySeries_Init(&freqseriesDet3, nbpts);
-
-  /* Compute the Re/Im frequency series - we ignore fstartobs, minf, maxf */
-  //TESTING
-  //tbeg = clock();
-  ReImFrequencySeries_SumListmodesCAmpPhaseFrequencySeries(freqseriesDet1, listDet1, freq, 0., 0., 0.);
-  ReImFrequencySeries_SumListmodesCAmpPhaseFrequencySeries(freqseriesDet2, listDet2, freq, 0., 0., 0.);
-  ReImFrequencySeries_SumListmodesCAmpPhaseFrequencySeries(freqseriesDet3, listDet3, freq, 0., 0., 0.);
-  //tend = clock();
-  //printf("time ReIm: %g\n", (double) (tend-tbeg)/CLOCKS_PER_SEC);
-  //
-
-  /* Output and clean up */
-  signal->LHOSignal = freqseriesDet1;
-  signal->LLOSignal = freqseriesDet2;
-  signal->VIRGOSignal = freqseriesDet3;
+  signal->ndet = network->ndet;
+  for(int k=0; k<network->ndet; k++) ReImFrequencySeries_Init(&(signal->DetSignal[k]), nbpts);
+  ReImFrequencySeries_SumListmodesNetwork(signal->DetSignal, listROM, freq, network->ndet, factors, twopidelays, 0., 0., 0.);
 
+  /* Clean up */
   ListmodesCAmpPhaseFrequencySeries_Destroy(listROM);
-  ListmodesCAmpPhaseFrequencySeries_Destroy(listDet1);
-  ListmodesCAmpPhaseFrequencySeries_Destroy(listDet2);
-  ListmodesCAmpPhaseFrequencySeries_Destroy(listDet3);
   return SUCCESS;
 }
 
@@ -801,9 +740,6 @@ int LLVGenerateInjectionReIm(
 {
   int ret;
   ListmodesCAmpPhaseFrequencySeries* listROM = NULL;
-  ListmodesCAmpPhaseFrequencySeries* listDet1 = NULL;
-  ListmodesCAmpPhaseFrequencySeries* listDet2 = NULL;
-  ListmodesCAmpPhaseFrequencySeries* listDet3 = NULL;
 
   /* Should add more error checking ? */
   /* Generate the waveform with the ROM */
@@ -813,59 +749,42 @@ int LLVGenerateInjectionReIm(
   /* If the ROM waveform generation failed (e.g. parameters were out of bounds) return FAILURE */
   if(ret==FAILURE) return FAILURE;
 
-  /* Process the waveform through the LLV response */
-  //TESTING
-  //clock_t tbeg, tend;
-  //tbeg = clock();
-  LLVSimFDResponse3Det(&listDet1, &listDet2, &listDet3, &listROM, injectedparams->tRef, injectedparams->ra, injectedparams->dec, injectedparams->inclination, injectedparams->polarization, globalparams->tagnetwork);
-  //tend = clock();
-  //printf("time LLVSimFDResponse: %g\n", (double) (tend-tbeg)/CLOCKS_PER_SEC);
-  //
+  /* LLV response, reduced to factors and delays for each detector - computed once for the network */
+  double complex factors[LLV_NDETMAX*nbmodemax];
+  double twopidelays[LLV_NDETMAX];
+  LLVSimFDResponseFactorsNetwork(factors, twopidelays, listROM, injectedparams->tRef, injectedparams->ra, injectedparams->dec, injectedparams->inclination, injectedparams->polarization, network);
 
   /* Determine the frequency vector - ignore frequency limits in different detectors */
   gsl_vector* freq = gsl_vector_alloc(nbpts);
   ListmodesSetFrequencies(listROM, fLow, fHigh, nbpts, tagsampling, freq);
 
-  /* Initialize structures for the ReIm frequency series */
-  ReImFrequencySeries* freqseriesDet1 = NULL;
-  ReImFrequencySeries* freqseriesDet2 = NULL;
-  ReImFrequencySeries* freqseriesDet3 = NULL;
-  ReImFrequencySeries_Init(&freqseriesDet1, nbpts);
-  ReImFrequencySeries_Init(&freqseriesDet2, nbpts);
-  ReImFrequencySeries_Init(&freqseriesDet3, nbpts);
-
-  /* Compute the Re/Im frequency series */
-  /* We ignore fstartobs */
-  //TESTING
-  //tbeg = clock();
-  ReImFrequencySeries_SumListmodesCAmpPhaseFrequencySeries(freqseriesDet1, listDet1, freq, 0., 0., 0.);
-  ReImFrequencySeries_SumListmodesCAmpPhaseFrequencySeries(freqseriesDet2, listDet2, freq, 0., 0., 0.);
-  ReImFrequencySeries_SumListmodesCAmpPhaseFrequencySeries(freqseriesDet3, listDet3, freq, 0., 0., 0.);
-  //tend = clock();
-  //printf("time ReIm: %g\n", (double) (tend-tbeg)/CLOCKS_PER_SEC);
-  //
+  /* Compute the Re/Im frequency series in each detector, applying the factors and delays on the fly to the modes of the ROM - we ignore fstartobs */
+  injection->ndet = network->ndet;
+  for(int k=0; k<network->ndet; k++) ReImFrequencySeries_Init(&(injection->DetSignal[k]), nbpts);
+  ReImFrequencySeries_SumListmodesNetwork(injection->DetSignal, listROM, freq, network->ndet, factors, twopidelays, 0., 0., 0.);
+
+  /* Noise values of each detector */
+  for(int k=0; k<network->ndet; k++) {
+    /* Noise values evaluated once for each noise curve, and copied for the detectors sharing it */
+    injection->noisevalues[k] = gsl_vector_alloc(nbpts);
+    int kshared = -1;
+    for(int j=0; j<k; j++) if(network->noise[j]==network->noise[k]) kshared = j;
+    if(kshared>=0) gsl_vector_memcpy(injection->noisevalues[k], injection->noisevalues[kshared]);
+    else {
+      ObjectFunction Snoise = LLVNetwork_NoiseFunction(network, k);
+      EvaluateNoise(injection->noisevalues[k], freq, &Snoise, network->noise[k]->fLow, network->noise[k]->fHigh);
+    }
+  }
 
-  /* Compute the noise values */
-  gsl_vector* noisevalues1 = gsl_vector_alloc(nbpts);
-  gsl_vector* noisevalues2 = gsl_vector_alloc(nbpts);
-  gsl_vector* noisevalues3 = gsl_vector_alloc(nbpts);
-  EvaluateNoise(noisevalues1, freq, NoiseSnLHO, __LLVSimFD_LHONoise_fLow, __LLVSimFD_LHONoise_fHigh);
-  EvaluateNoise(noisevalues2, freq, NoiseSnLLO, __LLVSimFD_LLONoise_fLow, __LLVSimFD_LLONoise_fHigh);
-  EvaluateNoise(noisevalues3, freq, NoiseSnVIRGO, __LLVSimFD_VIRGONoise_fLow, __LLVSimFD_VIRGONoise_fHigh);
+  /* Combined inner product (s|s), used by the marginalized likelihoods */
+  double ss = 0.;
+  for(int k=0; k<network->ndet; k++) ss += FDOverlapReImvsReIm(injection->DetSignal[k], injection->DetSignal[k], injection->noisevalues[k]);
 
   /* Output and clean up */
-  injection->LHOSignal = freqseriesDet1;
-  injection->LLOSignal = freqseriesDet2;
-  injection->VIRGOSignal = freqseriesDet3;
   injection->freq = freq;
-  injection->noisevaluesLHO = noisevalues1;
-  injection->noisevaluesLLO = noisevalues2;
-  injection->noisevaluesVIRGO = noisevalues3;
+  injection->LLVss = ss;
 
   ListmodesCAmpPhaseFrequencySeries_Destroy(listROM);
-  ListmodesCAmpPhaseFrequencySeries_Destroy(listDet1);
-  ListmodesCAmpPhaseFrequencySeries_Destroy(listDet2);
-  ListmodesCAmpPhaseFrequencySeries_Destroy(listDet3);
   return SUCCESS;
 }
 
@@ -892,20 +811,19 @@ double CalculateLogLCAmpPhase(LLVParams *params, LLVInjectionCAmpPhase* injectio
     logL = -DBL_MAX;
   }
   else if(ret==SUCCESS) {
-    /* Computing the likelihood for each detector - fstartobs is ignored, and we assume for the noises that the detectors are LHO, LLO, VIRGO */
+    /* Computing the likelihood for the network - fstartobs is ignored */
     //TESTING
     //tbeg = clock();
-    /* Note: beacause the response induces a difference in the phases (the time delay to each detector), we have to compute three separate overlaps - which is not optimal*/
-    double overlapLHO =  FDListmodesFresnelOverlap(generatedsignal->LHOSignal, injection->LHOSplines, NoiseSnLHO, globalparams->minf, globalparams->maxf, 0., 0.);
-    double overlapLLO =  FDListmodesFresnelOverlap(generatedsignal->LLOSignal, injection->LLOSplines, NoiseSnLLO, globalparams->minf, globalparams->maxf, 0., 0.);
-    double overlapVIRGO =  FDListmodesFresnelOverlap(generatedsignal->VIRGOSignal, injection->VIRGOSplines, NoiseSnVIRGO, globalparams->minf, globalparams->maxf, 0., 0.);
-    double overlapDet123 = overlapLHO + overlapLLO + overlapVIRGO;
+    /* Note: the detectors are combined in a single overlap, the difference of the delays of the template and injection entering the Fresnel integrals as linear phases */
+    ObjectFunction Snoises[LLV_NDETMAX];
+    for(int k=0; k<network->ndet; k++) Snoises[k] = LLVNetwork_NoiseFunction(network, k);
+    double overlapLLV = FDListmodesFresnelOverlapNetwork(generatedsignal->ROMSignal, injection->ROMSplines, network->ndet, generatedsignal->factors, injection->factors, generatedsignal->twopidelays, injection->twopidelays, Snoises, globalparams->minf, globalparams->maxf, 0., 0.);
     //tend = clock();
     //printf("time Overlaps: %g\n", (double) (tend-tbeg)/CLOCKS_PER_SEC);
     //
 
     /* Output: value of the loglikelihood for the combined signals, assuming noise independence */
-    logL = overlapDet123 - 1./2*(injection->LLVss) - 1./2*(generatedsignal->LLVhh);
+    logL = overlapLLV - 1./2*(injection->LLVss) - 1./2*(generatedsignal->LLVhh);
   }
 
   /* Clean up */
@@ -919,6 +837,9 @@ double CalculateLogLReIm(LLVParams *params, LLVInjectionReIm* injection)
   double logL = -DBL_MAX;
   int ret;
 
+  /* Marginalized likelihoods */
+  if(globalparams->margtime || globalparams->margphase) return CalculateLogLReImMarginalized(params, injection);
+
   /* Frequency vector - assumes common to A,E,T, i.e. identical fLow, fHigh in all channels */
   gsl_vector* freq = injection->freq;
 
@@ -941,15 +862,14 @@ double CalculateLogLReIm(LLVParams *params, LLVInjectionReIm* injection)
     /* Computing the likelihood for each TDI channel - fstartobs has already been taken into account */
     //TESTING
     //tbeg = clock();
-    double loglikelihoodDet1 = FDLogLikelihoodReIm(injection->LHOSignal, generatedsignal->LHOSignal, injection->noisevaluesLHO);
-    double loglikelihoodDet2 = FDLogLikelihoodReIm(injection->LLOSignal, generatedsignal->LLOSignal, injection->noisevaluesLLO);
-    double loglikelihoodDet3 = FDLogLikelihoodReIm(injection->VIRGOSignal, generatedsignal->VIRGOSignal, injection->noisevaluesVIRGO);
+    double loglikelihood = 0.;
+    for(int k=0; k<network->ndet; k++) loglikelihood += FDLogLikelihoodReIm(injection->DetSignal[k], generatedsignal->DetSignal[k], injection->noisevalues[k]);
     //tend = clock();
     //printf("time Overlaps: %g\n", (double) (tend-tbeg)/CLOCKS_PER_SEC);
     //
 
     /* Output: value of the loglikelihood for the combined signals, assuming noise independence */
-    logL = loglikelihoodDet1 + loglikelihoodDet2 + loglikelihoodDet3;
+    logL = loglikelihood;
   }
 
   /* Clean up */
@@ -958,6 +878,234 @@ double CalculateLogLReIm(LLVParams *params, LLVInjectionReIm* injection)
   return logL;
 }
 
+/* Term ln <exp(Re(z))> of the likelihood for a complex inner product z, averaged over a constant phase or not */
+/* Average over the phase: 1/2pi int dphi exp(Re(z exp(i phi))) = I0(|z|) - I0 scaled by exp(-|z|) to avoid overflows */
+static double LogPhaseMarginal(double complex z, int margphase)
+{
+  if(margphase) return cabs(z) + log(gsl_sf_bessel_I0_scaled(cabs(z)));
+  else return creal(z);
+}
+
+/* Time-shifted inner product z(t) = int df integrand(f) exp(2ipi f t), and d^2z/dt^2 if d2z is not NULL - trapezoidal rule on the linear grid, as for the FFT */
+static double complex TimeShiftIntegralDirect(double complex* d2z, ReImFrequencySeries* integrand, double t)
+{
+  int n = (int) integrand->freq->size;
+  double* f = integrand->freq->data;
+  double* intreal = integrand->h_real->data;
+  double* intimag = integrand->h_imag->data;
+  double deltaf = f[1] - f[0];
+  double complex z = 0., z2 = 0.;
+  double complex phasor[PHASOR_REANCHOR];
+  for(int ib=0; ib<n; ib+=PHASOR_REANCHOR) {
+    int nb = min(PHASOR_REANCHOR, n - ib);
+    Phasor_Fill(phasor, 2*PI*f[ib]*t, 2*PI*deltaf*t, nb);
+    for(int i=ib; i<ib+nb; i++) {
+      double weight = (i==0 || i==n-1) ? 0.5*deltaf : deltaf;
+      double complex term = weight * (intreal[i] + I*intimag[i]) * phasor[i-ib];
+      z += term;
+      z2 += f[i]*f[i] * term;
+    }
+  }
+  if(d2z) *d2z = -4*PI*PI * z2;
+  return z;
+}
+
+/* Samples per width of the peak in the refined integration of the time marginalization - on a Gaussian of width sigma, the error of the trapezoidal rule is ~exp(-2pi^2 sigma^2/deltat^2), margin left for the oscillations of Re z */
+#define MARGTIME_SAMPLES_PER_WIDTH 4
+/* Range ln(exp(Re z)/max) kept in the refined integration around the peak */
+#define MARGTIME_LOGRANGE 40.
+
+int LLVCheckMargTimeWindow(LLVInjectionReIm* injection)
+{
+  int n = (int) injection->freq->size;
+  if(n<2) {
+    printf("Error in LLVCheckMargTimeWindow: need at least two frequencies.\n");
+    return FAILURE;
+  }
+  double deltaf = gsl_vector_get(injection->freq, 1) - gsl_vector_get(injection->freq, 0);
+  /* Same 0-padded length as in IFFTTimeShiftIntegral */
+  int N = (int) pow(2, ((int) ceil(log(n)/log(2))) + globalparams->nzeropadmarg);
+  double deltat = 1./(N*deltaf);
+  double tmax = (N/2-1)*deltat;
+  if(priorParams->deltaT > tmax) {
+    printf("Error in LLVCheckMargTimeWindow: time window %g s larger than the FFT range %g s - increase nbptsoverlap.\n", priorParams->deltaT, tmax);
+    return FAILURE;
+  }
+  if(priorParams->deltaT < deltat) {
+    printf("Error in LLVCheckMargTimeWindow: time window %g s narrower than the FFT resolution %g s.\n", priorParams->deltaT, deltat);
+    return FAILURE;
+  }
+  return SUCCESS;
+}
+
+/* Likelihood marginalized over the phase and/or the time - margtime passed explicitly for the direct quadrature */
+static double LogLReImMarginalized(LLVParams *params, LLVInjectionReIm* injection, int margtime)
+{
+  double logL = -DBL_MAX;
+  int ret;
+
+  /* Frequency vector - common to all detectors */
+  gsl_vector* freq = injection->freq;
+  int nbpts = (int) freq->size;
+
+  /* Generating the signal in the detectors for the input parameters - the reference time is the center of the time window */
+  LLVSignalReIm* generatedsignal = NULL;
+  LLVSignalReIm_Init(&generatedsignal);
+  ret = LLVGenerateSignalReIm(params, freq, generatedsignal);
+
+  /* If LLVGenerateSignal failed (e.g. parameters out of bound), silently return -Infinity logL */
+  if(ret==FAILURE) {
+    logL = -DBL_MAX;
+  }
+  else if(ret==SUCCESS) {
+    /* Integrand 4 h conj(s)/Sn of the cross-products, summed over the detectors (a time shift is common to all of them), and combined (h|h) */
+    double hh = 0.;
+    ReImFrequencySeries* integrand = NULL;
+    ReImFrequencySeries_Init(&integrand, nbpts);
+    gsl_vector_memcpy(integrand->freq, freq);
+    gsl_vector_set_zero(integrand->h_real);
+    gsl_vector_set_zero(integrand->h_imag);
+    double* intreal = integrand->h_real->data;
+    double* intimag = integrand->h_imag->data;
+    for(int k=0; k<network->ndet; k++) {
+      double* hreal = generatedsignal->DetSignal[k]->h_real->data;
+      double* himag = generatedsignal->DetSignal[k]->h_imag->data;
+      double* sreal = injection->DetSignal[k]->h_real->data;
+      double* simag = injection->DetSignal[k]->h_imag->data;
+      double* noise = injection->noisevalues[k]->data;
+      for(int i=0; i<nbpts; i++) {
+        double complex a = 4. * (hreal[i] + I*himag[i]) * (sreal[i] - I*simag[i]) / noise[i];
+        intreal[i] += creal(a);
+        intimag[i] += cimag(a);
+      }
+      hh += FDOverlapReImvsReIm(generatedsignal->DetSignal[k], generatedsignal->DetSignal[k], injection->noisevalues[k]);
+    }
+
+    /* Marginalized term ln <exp((h|s))> */
+    double lnhs = 0.;
+    if(margtime) {
+      /* Time-shifted inner products z(t), (h|s)(t) = Re z(t), for all shifts with one FFT */
+      ReImTimeSeries* hst = NULL;
+      IFFTTimeShiftIntegral(&hst, integrand, globalparams->nzeropadmarg);
+      int nt = (int) hst->times->size;
+      double* times = hst->times->data;
+      double deltat = times[1] - times[0];
+      double deltaT = priorParams->deltaT;
+      /* Values of ln <exp(Re z)> in the window [-deltaT, deltaT], and their maximum */
+      gsl_vector* lnvalues = gsl_vector_alloc(nt);
+      int jmin = nt, jmax = -1, jpeak = -1;
+      double lnmax = -DBL_MAX;
+      for(int j=0; j<nt; j++) {
+        if(fabs(times[j]) > deltaT) continue;
+        if(j<jmin) jmin = j;
+        jmax = j;
+        double lnval = LogPhaseMarginal(hst->h_real->data[j] + I*hst->h_imag->data[j], globalparams->margphase);
+        gsl_vector_set(lnvalues, j, lnval);
+        if(lnval > lnmax) {
+          lnmax = lnval;
+          jpeak = j;
+        }
+      }
+      /* Window not covered by the FFT - excluded by LLVCheckMargTimeWindow at setup */
+      if(jmax-jmin < 1 || times[jmin] > -deltaT + deltat || times[jmax] < deltaT - deltat) {
+        ReImTimeSeries_Cleanup(hst);
+        gsl_vector_free(lnvalues);
+        ReImFrequencySeries_Cleanup(integrand);
+        LLVSignalReIm_Cleanup(generatedsignal);
+        return -DBL_MAX;
+      }
+
+      /* The peak of exp(Re z) has a width 1/sqrt(|d^2z/dt^2|), narrower than the FFT resolution at high SNR */
+      /* Around the peak, z(t) is evaluated directly on a grid refined to MARGTIME_SAMPLES_PER_WIDTH samples per width (conservative for the envelope |z| of the phase marginalization, which is wider) */
+      double complex d2z = 0.;
+      TimeShiftIntegralDirect(&d2z, integrand, times[jpeak]);
+      double width = 1./sqrt(fmax(cabs(d2z), DBL_MIN));
+      int nref = (int) ceil(MARGTIME_SAMPLES_PER_WIDTH * deltat / width);
+      int ja = jpeak, jb = jpeak;
+      if(nref>1) {
+        for(int j=jmin; j<=jmax; j++) {
+          if(gsl_vector_get(lnvalues, j) - lnmax < -MARGTIME_LOGRANGE) continue;
+          if(j<ja) ja = j;
+          if(j>jb) jb = j;
+        }
+        ja = max(jmin, ja-1);
+        jb = min(jmax, jb+1);
+      }
+
+      /* Trapezoidal integral over the window, factoring out the maximum - flat prior 1/(2 deltaT) */
+      double sum = 0.;
+      for(int j=jmin; j<jmax; j++) {
+        if(nref>1 && j>=ja && j<jb) continue;
+        sum += 0.5 * deltat * (exp(gsl_vector_get(lnvalues, j) - lnmax) + exp(gsl_vector_get(lnvalues, j+1) - lnmax));
+      }
+      if(nref>1) {
+        int nfine = nref*(jb-ja);
+        double deltatfine = deltat/nref;
+        double sumfine = 0.;
+        for(int k=0; k<=nfine; k++) {
+          double lnval = (k%nref==0) ? gsl_vector_get(lnvalues, ja + k/nref) : LogPhaseMarginal(TimeShiftIntegralDirect(NULL, integrand, times[ja] + k*deltatfine), globalparams->margphase);
+          double weight = (k==0 || k==nfine) ? 0.5 : 1.;
+          sumfine += weight * exp(lnval - lnmax);
+        }
+        sum += sumfine * deltatfine;
+      }
+      lnhs = lnmax + log(sum / (2*deltaT));
+      gsl_vector_free(lnvalues);
+      ReImTimeSeries_Cleanup(hst);
+    }
+    else {
+      /* No time shift, z = 4 int h conj(s)/Sn with the trapezoidal rule */
+      double complex z = 0.;
+      double* f = freq->data;
+      for(int i=0; i<nbpts-1; i++) z += 0.5 * (f[i+1] - f[i]) * (intreal[i] + intreal[i+1] + I*(intimag[i] + intimag[i+1]));
+      lnhs = LogPhaseMarginal(z, globalparams->margphase);
+    }
+
+    /* Output: ln L = ln <exp((h|s))> - (h|h)/2 - (s|s)/2, assuming noise independence */
+    logL = lnhs - 0.5*hh - 0.5*injection->LLVss;
+
+    ReImFrequencySeries_Cleanup(integrand);
+  }
+
+  /* Clean up */
+  LLVSignalReIm_Cleanup(generatedsignal);
+
+  return logL;
+}
+
+double CalculateLogLReImMarginalized(LLVParams *params, LLVInjectionReIm* injection)
+{
+  return LogLReImMarginalized(params, injection, globalparams->margtime);
+}
+
+double CalculateLogLReImMarginalizedDirect(LLVParams *params, LLVInjectionReIm* injection, int nbtimes)
+{
+  if(nbtimes<2) {
+    printf("Error in CalculateLogLReImMarginalizedDirect: need at least two times.\n");
+    exit(1);
+  }
+  double deltaT = priorParams->deltaT;
+  double deltatRef = 2*deltaT/(nbtimes-1);
+  double* lnvalues = malloc(nbtimes*sizeof(double));
+  /* Templates generated independently for each time, in parallel */
+  #pragma omp parallel for schedule(static)
+  for(int j=0; j<nbtimes; j++) {
+    LLVParams paramsj = *params;
+    paramsj.tRef = params->tRef - deltaT + j*deltatRef;
+    lnvalues[j] = LogLReImMarginalized(&paramsj, injection, 0);
+  }
+  double lnmax = -DBL_MAX;
+  for(int j=0; j<nbtimes; j++) lnmax = fmax(lnmax, lnvalues[j]);
+  /* Trapezoidal integral, factoring out the maximum - flat prior 1/(2 deltaT) */
+  double sum = 0.;
+  for(int j=0; j<nbtimes; j++) {
+    double weight = (j==0 || j==nbtimes-1) ? 0.5 : 1.;
+    sum += weight * exp(lnvalues[j] - lnmax);
+  }
+  free(lnvalues);
+  return lnmax + log(sum * deltatRef / (2*deltaT));
+}
+
 /* Function generating a LLV signal from LLV parameters */
 // int LLVGenerateSignal(
 //   struct tagLLVParams* params,   /* Input: set of LLV parameters of the signal */
@@ -6,6 +6,7 @@
 #include <math.h>
 #include <string.h>
 #include <gsl/gsl_cdf.h>
+#include <gsl/gsl_sf_bessel.h>
 
 #include "constants.h"
 #include "struct.h"
@@ -13,9 +14,11 @@
 #include "EOBNRv2HMROM.h"
 #include "wip.h"
 #include "likelihood.h"
+#include "fft.h"
 #include "splinecoeffs.h"
 #include "LLVFDresponse.h"
 #include "LLVnoise.h"
+#include "LLVnetwork.h"
 
 /***************** Structures for parameters *****************/
 
@@ -42,8 +45,11 @@ typedef struct tagLLVGlobalParams {
   int nbmodeinj;             /* number of modes to include in the injection (starting with 22) - defaults to 5 (all modes) */
   int nbmodetemp;            /* number of modes to include in the templates (starting with 22) - defaults to 5 (all modes) */
   int tagint;                /* Tag choosing the integrator: 0 for wip (default), 1 for linear integration */
-  int tagnetwork;            /* Tag choosing the network of detectors to use */
+  char network[LLV_NDETMAX+1]; /* Detectors of the network, one letter each (H, L, V, K, I) - defaults to LHV */
   int nbptsoverlap;          /* Number of points to use in loglinear overlaps (default 32768) */
+  int margtime;              /* Marginalize the likelihood over the time of arrival, with an FFT (requires tagint 1) - tRef is not sampled (default 0) */
+  int margphase;             /* Marginalize the likelihood over a constant phase of the signal (requires tagint 1) - phiRef is not sampled (default 0) */
+  int nzeropadmarg;          /* 0-padding of the FFT of the time marginalization: length will be (upper power of 2 of nbptsoverlap)*2^nzeropadmarg (default 2) */
   int constL;                /* set all logLikelihood to 0 - allows to sample from the prior for testing */
 } LLVGlobalParams;
 
@@ -119,36 +125,33 @@ typedef struct tagLLVRunParams {
 
 typedef struct tagLLVSignalCAmpPhase
 {
-  struct tagListmodesCAmpPhaseFrequencySeries* LHOSignal;   /* Signal in LHO, in the form of a list of the contribution of each mode */
-  struct tagListmodesCAmpPhaseFrequencySeries* LLOSignal;   /* Signal in LLO, in the form of a list of the contribution of each mode */
-  struct tagListmodesCAmpPhaseFrequencySeries* VIRGOSignal; /* Signal in VIRGO, in the form of a list of the contribution of each mode */
-  double LLVhh;                                             /* Combined Inner product (h|h) for dectectors LHV */
+  struct tagListmodesCAmpPhaseFrequencySeries* ROMSignal;   /* Signal before the response, in the form of a list of modes - the response of each detector reduces to factors and delays */
+  double complex factors[LLV_NDETMAX*nbmodemax];           /* Factors of the response, ndet values (detectors of the network) for each mode in the order of ROMSignal */
+  double twopidelays[LLV_NDETMAX];                          /* 2pi times the delays from geocenter to the detectors of the network (s) */
+  double LLVhh;                                             /* Combined Inner product (h|h) for the detectors of the network */
 } LLVSignalCAmpPhase;
 
 typedef struct tagLLVInjectionCAmpPhase
 {
-  struct tagListmodesCAmpPhaseSpline* LHOSplines;   /* Signal in LHO, in the form of a list of splines for the contribution of each mode */
-  struct tagListmodesCAmpPhaseSpline* LLOSplines;   /* Signal in LLO, in the form of a list of splines for the contribution of each mode */
-  struct tagListmodesCAmpPhaseSpline* VIRGOSplines;   /* Signal in VIRGO, in the form of a list of splines for the contribution of each mode */
-  double LLVss;                                   /* Combined Inner product (s|s) for dectectors LHV */
+  struct tagListmodesCAmpPhaseSpline* ROMSplines;   /* Signal before the response, in the form of a list of splines for each mode */
+  double complex factors[LLV_NDETMAX*nbmodemax];   /* Factors of the response, ndet values (detectors of the network) for each mode in the order of ROMSplines */
+  double twopidelays[LLV_NDETMAX];                  /* 2pi times the delays from geocenter to the detectors of the network (s) */
+  double LLVss;                                     /* Combined Inner product (s|s) for the detectors of the network */
 } LLVInjectionCAmpPhase;
 
 typedef struct tagLLVSignalReIm /* We don't store the SNRs here, as we will use -1/2(h-s|h-s) for the likelihood */
 {
-  struct tagReImFrequencySeries* LHOSignal;   /* Signal in LHO, in the form of a Re/Im frequency series where the modes have been summed */
-  struct tagReImFrequencySeries* LLOSignal;   /* Signal in LLO, in the form of a Re/Im frequency series where the modes have been summed */
-  struct tagReImFrequencySeries* VIRGOSignal;   /* Signal in VIRGO, in the form of a Re/Im frequency series where the modes have been summed */
+  int ndet;                                                 /* Number of detectors of the network */
+  struct tagReImFrequencySeries* DetSignal[LLV_NDETMAX];    /* Signal in each detector, in the form of a Re/Im frequency series where the modes have been summed */
 } LLVSignalReIm;
 
 typedef struct tagLLVInjectionReIm /* Storing the vectors of frequencies and noise values - We don't store the SNRs here, as we will use -1/2(h-s|h-s) for the likelihood */
 {
-  struct tagReImFrequencySeries* LHOSignal;   /* Signal in LHO, in the form of a Re/Im frequency series where the modes have been summed */
-  struct tagReImFrequencySeries* LLOSignal;   /* Signal in LLO, in the form of a Re/Im frequency series where the modes have been summed */
-  struct tagReImFrequencySeries* VIRGOSignal;   /* Signal in VIRGO, in the form of a Re/Im frequency series where the modes have been summed */
-  gsl_vector* freq;                            /* Vector of frequencies of the injection (assumed to be the same for LHO, LLO, VIRGO) */
-  gsl_vector* noisevaluesLHO;                    /* Vector of noise values on freq LHO */
-  gsl_vector* noisevaluesLLO;                    /* Vector of noise values on freq LLO */
-  gsl_vector* noisevaluesVIRGO;                  /* Vector of noise values on freq VIRGO */
+  int ndet;                                                 /* Number of detectors of the network */
+  struct tagReImFrequencySeries* DetSignal[LLV_NDETMAX];    /* Signal in each detector, in the form of a Re/Im frequency series where the modes have been summed */
+  gsl_vector* freq;                                         /* Vector of frequencies of the injection (assumed to be the same for all detectors) */
+  gsl_vector* noisevalues[LLV_NDETMAX];                     /* Vectors of noise values on freq, for each detector */
+  double LLVss;                                             /* Combined Inner product (s|s) for the detectors of the network */
 } LLVInjectionReIm;
 
 /************ Functions for LLV parameters, injection, likelihood, prior ************/
@@ -230,13 +233,23 @@ double CosPriorToCube(double y, double x1, double x2);
 
 /* log-Likelihood functions */
 double CalculateLogLCAmpPhase(LLVParams *params, LLVInjectionCAmpPhase* injection);
+/* With margtime or margphase, CalculateLogLReIm returns the marginalized likelihood of CalculateLogLReImMarginalized */
 double CalculateLogLReIm(LLVParams *params, LLVInjectionReIm* injection);
+/* Log-likelihood marginalized over the time of arrival in [tRef-deltaT, tRef+deltaT] and/or over a constant phase, with flat priors */
+/* The time-shifted inner products (h|s)(t), summed over the detectors, are computed with one FFT per template - the injection must use a linear sampling */
+/* Around the maximum, where exp(Re z) is narrower than the FFT resolution at high SNR, z(t) is evaluated directly on a grid resolving the peak */
+double CalculateLogLReImMarginalized(LLVParams *params, LLVInjectionReIm* injection);
+/* Same marginalization by direct quadrature over tRef, generating a template for each of nbtimes times in the window - for validation */
+double CalculateLogLReImMarginalizedDirect(LLVParams *params, LLVInjectionReIm* injection, int nbtimes);
+/* Check that the time window of the prior is covered by the FFT of the time marginalization - returns FAILURE otherwise */
+int LLVCheckMargTimeWindow(LLVInjectionReIm* injection);
 
 /************ Global Parameters ************/
 
 extern LLVParams* injectedparams;
 extern LLVGlobalParams* globalparams;
 extern LLVPrior* priorParams;
+extern LLVNetwork* network;
 double logZdata;
 
 #endif
@@ -48,13 +48,15 @@ Arguments are as follows:\n\
  --nbmode              Number of modes of radiation to generate (1-5, default=5)\n\
  --minf                Minimal frequency (Hz, default=0) - when too low, use first frequency covered by the ROM\n\
  --setphiRefatfRef     Flag for adjusting the FD phase at phiRef at the given fRef, which depends also on tRef - if false, treat phiRef simply as an orbital phase shift (minus an observer phase shift) (default=1)\n\
- --tagnetwork          Tag choosing the set of detectors to use (default LHV)\n\
+ --tagnetwork          Detectors of the network, one letter each among H (LIGO Hanford), L (LIGO Livingston), V (VIRGO) - unselected detectors get a zero signal (default HLV)\n\
  --taggenwave          Tag choosing the wf format: LLVhlm (default: downsampled mode contributions to LLV in Amp/Phase form), LLVFD (hlm interpolated and summed accross modes)\n\
  --restorescaledfactor Option to restore the factors scaled out of LLV observables (default: false)\n	\
  --fromLLVtdfile       Option for loading time series for LLV observables and FFTing (default: false)\n\
  --nsamplesinfile      Number of lines of input file when loading LLV time series from file\n\
  --binaryin            Tag for loading the data in gsl binary form instead of text (default false)\n\
+ --columnarin          Tag for loading the data in binary columnar form, self-describing and mapped without copy - --nsamplesinfile is then not needed (default false)\n\
  --binaryout           Tag for outputting the data in gsl binary form instead of text (default false)\n\
+ --columnarout         Tag for outputting the data in binary columnar form (default false)\n\
  --indir               Input directory when loading LLV time series from file\n\
  --infile              Input file name when loading LLV time series from file\n\
  --outdir              Output directory\n\
@@ -79,7 +81,7 @@ Arguments are as follows:\n\
     params->nbmode = 5;
     params->minf = 0.;
     params->setphiRefatfRef = 1;
-    params->tagnetwork = LHV;
+    params->tagnetwork = HLV;
     params->taggenwave = LLVhlm;
     params->fromLLVtdfile = 0;
     params->nsamplesinfile = 0;    /* No default; has to be provided */
@@ -129,8 +131,12 @@ Arguments are as follows:\n\
             params->nsamplesinfile = atoi(argv[++i]);
         } else if (strcmp(argv[i], "--binaryin") == 0) {
           params->binaryin = 1;
+        } else if (strcmp(argv[i], "--columnarin") == 0) {
+          params->binaryin = FILE_COLUMNAR;
         } else if (strcmp(argv[i], "--binaryout") == 0) {
           params->binaryout = 1;
+        } else if (strcmp(argv[i], "--columnarout") == 0) {
+          params->binaryout = FILE_COLUMNAR;
         } else if (strcmp(argv[i], "--indir") == 0) {
             strcpy(params->indir, argv[++i]);
         } else if (strcmp(argv[i], "--infile") == 0) {
@@ -176,30 +182,23 @@ static char* LLVFilePostfix(int channel, int binary)
 /* NOTE: assumes the same number of points is used to represent each mode */
 static void Read_LLVTD3Det( RealTimeSeries** LLV1, RealTimeSeries** LLV2, RealTimeSeries** LLV3, const char dir[], const char file[], const int nblines, const int binary)
 {
-  /* Initalize and read input */
-  gsl_matrix* inmatrix =  gsl_matrix_alloc(nblines, 4);
-  if(!binary) Read_Text_Matrix(dir, file, inmatrix);
-  else Read_Matrix(dir, file, inmatrix);
-
-  /* Initialize structures */
-  RealTimeSeries_Init(LLV1, nblines);
-  RealTimeSeries_Init(LLV2, nblines);
-  RealTimeSeries_Init(LLV3, nblines);
-
-  /* Set values */
-  gsl_vector_view timesview = gsl_matrix_column(inmatrix, 0);
-  gsl_vector_view LLV1view = gsl_matrix_column(inmatrix, 1);
-  gsl_vector_view LLV2view = gsl_matrix_column(inmatrix, 2);
-  gsl_vector_view LLV3view = gsl_matrix_column(inmatrix, 3);
-  gsl_vector_memcpy((*LLV1)->times, &timesview.vector);
-  gsl_vector_memcpy((*LLV2)->times, &timesview.vector);
-  gsl_vector_memcpy((*LLV3)->times, &timesview.vector);
-  gsl_vector_memcpy((*LLV1)->h, &LLV1view.vector);
-  gsl_vector_memcpy((*LLV2)->h, &LLV2view.vector);
-  gsl_vector_memcpy((*LLV3)->h, &LLV3view.vector);
-
-  /* Clean up */
-  gsl_matrix_free(inmatrix);
+  /* Read input - zero-copy for columnar files */
+  gsl_vector* columns[4];
+  int nbrows;
+  if(Read_Columns(columns, 4, &nbrows, dir, file, nblines, binary)==FAILURE) exit(1);
+
+  /* Set structures - the columns are taken over, each series but the first gets its own copy of the times */
+  *LLV1 = ArenaMalloc(sizeof(RealTimeSeries));
+  *LLV2 = ArenaMalloc(sizeof(RealTimeSeries));
+  *LLV3 = ArenaMalloc(sizeof(RealTimeSeries));
+  (*LLV1)->times = columns[0];
+  (*LLV2)->times = ArenaVectorAlloc(nbrows);
+  (*LLV3)->times = ArenaVectorAlloc(nbrows);
+  gsl_vector_memcpy((*LLV2)->times, columns[0]);
+  gsl_vector_memcpy((*LLV3)->times, columns[0]);
+  (*LLV1)->h = columns[1];
+  (*LLV2)->h = columns[2];
+  (*LLV3)->h = columns[3];
 }
 /* Output waveform in frequency series form,Re/Im for hplus and hcross */
 static void Write_FrequencySeries(const char dir[], const char file[], ReImFrequencySeries* freqseries, const int binary)
@@ -215,8 +214,7 @@ static void Write_FrequencySeries(const char dir[], const char file[], ReImFrequ
   gsl_matrix_set_col(outmatrix, 2, freqseries->h_imag);
 
   /* Output */
-  if (!binary) Write_Text_Matrix(dir, file, outmatrix);
-  else Write_Matrix(dir, file, outmatrix);
+  Write_Table(dir, file, outmatrix, binary);
 }
 /* Output LLV mode contributions in downsampled form, FD AmpReal/AmpIm/Phase, all hlm modes in a single file */
 /* NOTE: assumes the same number of points is used to represent each mode */
@@ -238,8 +236,7 @@ static void Write_LLVhlm(const char dir[], const char file[], ListmodesCAmpPhase
   }
 
   /* Output */
-  if (!binary) Write_Text_Matrix(dir, file, outmatrix);
-  else Write_Matrix(dir, file, outmatrix);
+  Write_Table(dir, file, outmatrix, binary);
 }
 
 /***************** Main program *****************/
@@ -23,10 +23,12 @@ Arguments are as follows:\n\
 --------------------------------------------------\n\
 ----- Generation Parameters ----------------------\n\
 --------------------------------------------------\n\
- --tagnetwork          Tag choosing the detector network to use (default LLV)\n\
+ --tagnetwork          Detectors of the network, one letter each among H (LIGO Hanford), L (LIGO Livingston), V (VIRGO) - unselected detectors get a zero signal (default HLV)\n\
  --nsamplesinfile      Number of lines of inputs file\n\
  --binaryin            Tag for loading the data in gsl binary form instead of text (default false)\n\
+ --columnarin          Tag for loading the data in binary columnar form, self-describing and mapped without copy - --nsamplesinfile is then not needed (default false)\n\
  --binaryout           Tag for outputting the data in gsl binary form instead of text (default false)\n\
+ --columnarout         Tag for outputting the data in binary columnar form (default false)\n\
  --indir               Input directory\n\
  --infile              Input file name\n\
  --outdir              Output directory\n\
@@ -41,7 +43,7 @@ Arguments are as follows:\n\
     params->polarization = 0;
 
     /* Set default values for the generation params */
-    params->tagnetwork = LHV;
+    params->tagnetwork = HLV;
     params->nsamplesinfile = 0;    /* No default; has to be provided */
     strcpy(params->indir, "");   /* No default; has to be provided */
     strcpy(params->infile, "");  /* No default; has to be provided */
@@ -60,13 +62,17 @@ Arguments are as follows:\n\
         } else if (strcmp(argv[i], "--polarization") == 0) {
             params->polarization = atof(argv[++i]);
         } else if (strcmp(argv[i], "--tagnetwork") == 0) {
-	  params->tagtdi = ParseNetworktag(argv[++i]); //
+	  params->tagnetwork = ParseNetworktag(argv[++i]);
         } else if (strcmp(argv[i], "--nsamplesinfile") == 0) {
             params->nsamplesinfile = atoi(argv[++i]);
         } else if (strcmp(argv[i], "--binaryin") == 0) {
           params->binaryin = 1;
+        } else if (strcmp(argv[i], "--columnarin") == 0) {
+          params->binaryin = FILE_COLUMNAR;
         } else if (strcmp(argv[i], "--binaryout") == 0) {
           params->binaryout = 1;
+        } else if (strcmp(argv[i], "--columnarout") == 0) {
+          params->binaryout = FILE_COLUMNAR;
         } else if (strcmp(argv[i], "--indir") == 0) {
             strcpy(params->indir, argv[++i]);
         } else if (strcmp(argv[i], "--infile") == 0) {
@@ -93,26 +99,19 @@ Arguments are as follows:\n\
 /* NOTE: assumes the same number of points is used to represent each mode */
 static void Read_Wave_hphcTD( RealTimeSeries** hptd, RealTimeSeries** hctd, const char dir[], const char file[], const int nsamples, int binary)
 {
-  /* Initalize and read input */
-  gsl_matrix* inmatrix =  gsl_matrix_alloc(nsamples, 3);
-  if (!binary) Read_Text_Matrix(dir, file, inmatrix);
-  else Read_Matrix(dir, file, inmatrix);
-
-  /* Initialize structures */
-  RealTimeSeries_Init(hptd, nsamples);
-  RealTimeSeries_Init(hctd, nsamples);
-
-  /* Set values */
-  gsl_vector_view timesview = gsl_matrix_column(inmatrix, 0);
-  gsl_vector_view hptdview = gsl_matrix_column(inmatrix, 1);
-  gsl_vector_view hctdview = gsl_matrix_column(inmatrix, 2);
-  gsl_vector_memcpy((*hptd)->times, &timesview.vector);
-  gsl_vector_memcpy((*hctd)->times, &timesview.vector);
-  gsl_vector_memcpy((*hptd)->h, &hptdview.vector);
-  gsl_vector_memcpy((*hctd)->h, &hctdview.vector);
-
-  /* Clean up */
-  gsl_matrix_free(inmatrix);
+  /* Read input - zero-copy for columnar files */
+  gsl_vector* columns[3];
+  int nbrows;
+  if(Read_Columns(columns, 3, &nbrows, dir, file, nsamples, binary)==FAILURE) exit(1);
+
+  /* Set structures - the columns are taken over, hc gets its own copy of the times */
+  *hptd = ArenaMalloc(sizeof(RealTimeSeries));
+  *hctd = ArenaMalloc(sizeof(RealTimeSeries));
+  (*hptd)->times = columns[0];
+  (*hptd)->h = columns[1];
+  (*hctd)->times = ArenaVectorAlloc(nbrows);
+  gsl_vector_memcpy((*hctd)->times, columns[0]);
+  (*hctd)->h = columns[2];
 }
 /* Output waveform in downsampled form, FD Amp/Pase, all hlm modes in a single file */
 /* NOTE: assumes 3 channels with same times */
@@ -130,8 +129,7 @@ static void Write_LLVTD(const char dir[], const char file[], RealTimeSeries* LLV
   gsl_matrix_set_col(outmatrix, 3, LLV3->h);
 
   /* Output */
-  if(!binary) Write_Text_Matrix(dir, file, outmatrix);
-  else Write_Matrix(dir, file, outmatrix);
+  Write_Table(dir, file, outmatrix, binary);
 }
 
 /***************** Main program *****************/
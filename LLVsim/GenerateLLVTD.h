@@ -53,8 +53,8 @@ typedef struct tagGenLLVTDparams {
   double polarization;       /* polarization angle (rad, default 0) */
   int tagnetwork;            /* Tag selecting the desired detector network */
   int nsamplesinfile;        /* Number of lines of input file */
-  int binaryin;              /* Tag for loading the data in gsl binary form instead of text (default false) */
-  int binaryout;             /* Tag for outputting the data in gsl binary form instead of text (default false) */
+  int binaryin;              /* Format of the input data: FILE_TEXT, FILE_BINARY (gsl binary) or FILE_COLUMNAR (default text) */
+  int binaryout;             /* Format of the output data: FILE_TEXT, FILE_BINARY (gsl binary) or FILE_COLUMNAR (default text) */
   char indir[256];           /* Path for the input directory */
   char infile[256];          /* Path for the input file */
   char outdir[256];          /* Path for the output directory */
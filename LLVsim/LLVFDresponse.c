@@ -34,6 +34,7 @@
 #include "constants.h"
 #include "LLVgeometry.h"
 #include "struct.h"
+#include "LLVnetwork.h"
 #include "LLVFDresponse.h"
 #include "timeconversion.h"
 
@@ -114,11 +115,11 @@ void SetVectorXd(
   }
 }
 
-/* Function setting the cartesian coordinates of the wave frame vectors (X,Y,Z), given the position in the sky and polarization */
-void SetVectorsXYZ(
-  gsl_vector* X,                       /* Output: cartesian vector of the wave frame unit vector X */
-  gsl_vector* Y,                       /* Output: cartesian vector of the wave frame unit vector Y */
-  gsl_vector* Z,                       /* Output: cartesian vector of the wave frame unit vector Z */
+/* Function setting the cartesian coordinates of the wave frame vectors (X,Y,Z) in fixed-size arrays */
+static void SetArraysXYZ(
+  double X[3],                         /* Output: cartesian vector of the wave frame unit vector X */
+  double Y[3],                         /* Output: cartesian vector of the wave frame unit vector Y */
+  double Z[3],                         /* Output: cartesian vector of the wave frame unit vector Z */
   const double theta,                  /* First angle for the position in the sky (Earth-based spherical angle) */
   const double phi,                    /* Second angle for the position in the sky (Earth-based spherical angle) */
   const double psi)                    /* Polarization angle */
@@ -130,37 +131,99 @@ void SetVectorsXYZ(
   double cosphi = cos(phi);
   double sinphi = sin(phi);
   /* Unit vector X */
-  gsl_vector_set(X, 0, -cospsi*sinphi+sinpsi*costheta*cosphi);
-  gsl_vector_set(X, 1, cospsi*cosphi+sinpsi*costheta*sinphi);
-  gsl_vector_set(X, 2, -sinpsi*sintheta);
+  X[0] = -cospsi*sinphi+sinpsi*costheta*cosphi;
+  X[1] = cospsi*cosphi+sinpsi*costheta*sinphi;
+  X[2] = -sinpsi*sintheta;
   /* Unit vector Y */
-  gsl_vector_set(Y, 0, sinpsi*sinphi+cospsi*costheta*cosphi);
-  gsl_vector_set(Y, 1, -sinpsi*cosphi+cospsi*costheta*sinphi);
-  gsl_vector_set(Y, 2, -cospsi*sintheta);
+  Y[0] = sinpsi*sinphi+cospsi*costheta*cosphi;
+  Y[1] = -sinpsi*cosphi+cospsi*costheta*sinphi;
+  Y[2] = -cospsi*sintheta;
   /* Unit vector Z */
-  gsl_vector_set(Z, 0, -sintheta*cosphi);
-  gsl_vector_set(Z, 1, -sintheta*sinphi);
-  gsl_vector_set(Z, 2, -costheta);
+  Z[0] = -sintheta*cosphi;
+  Z[1] = -sintheta*sinphi;
+  Z[2] = -costheta;
+}
+
+/* Function setting the cartesian coordinates of the wave frame vectors (X,Y,Z), given the position in the sky and polarization */
+void SetVectorsXYZ(
+  gsl_vector* X,                       /* Output: cartesian vector of the wave frame unit vector X */
+  gsl_vector* Y,                       /* Output: cartesian vector of the wave frame unit vector Y */
+  gsl_vector* Z,                       /* Output: cartesian vector of the wave frame unit vector Z */
+  const double theta,                  /* First angle for the position in the sky (Earth-based spherical angle) */
+  const double phi,                    /* Second angle for the position in the sky (Earth-based spherical angle) */
+  const double psi)                    /* Polarization angle */
+{
+  double Xa[3], Ya[3], Za[3];
+  SetArraysXYZ(Xa, Ya, Za, theta, phi, psi);
+  for(int i=0; i<3; i++) {
+    gsl_vector_set(X, i, Xa[i]);
+    gsl_vector_set(Y, i, Ya[i]);
+    gsl_vector_set(Z, i, Za[i]);
+  }
+}
+
+/* Function computing the pattern functions and the delay from geocenter of a detector, for the wave frame vectors (X,Y,Z) */
+/* Fixed-size arithmetic on the stack - no allocation */
+static void PatternFunctionsDelay(
+  double* Fplus,                       /* Output: pattern function F+ */
+  double* Fcross,                      /* Output: pattern function Fx */
+  double* twopidelay,                  /* Output: 2pi times the delay from geocenter to the detector (s) */
+  const double D[3][3],                /* Response tensor of the detector */
+  const double Xd[3],                  /* Position of the detector */
+  const double X[3],                   /* Wave frame unit vector X */
+  const double Y[3],                   /* Wave frame unit vector Y */
+  const double Z[3])                   /* Wave frame unit vector Z */
+{
+  *twopidelay = 2*PI*(Xd[0]*Z[0] + Xd[1]*Z[1] + Xd[2]*Z[2])/C_SI;
+  double DX[3], DY[3];
+  for(int i=0; i<3; i++) {
+    DX[i] = D[i][0]*X[0] + D[i][1]*X[1] + D[i][2]*X[2];
+    DY[i] = D[i][0]*Y[0] + D[i][1]*Y[1] + D[i][2]*Y[2];
+  }
+  double XDX = X[0]*DX[0] + X[1]*DX[1] + X[2]*DX[2];
+  double XDY = X[0]*DY[0] + X[1]*DY[1] + X[2]*DY[2];
+  double YDY = Y[0]*DY[0] + Y[1]*DY[1] + Y[2]*DY[2];
+  *Fplus = XDX - YDY;
+  *Fcross = 2*XDY;
+}
+
+/* Detector corresponding to a tag */
+static const LLVDetector* DetectorFromTag(const Detectortag tag)
+{
+  if(tag==LHO) return &LLVDetectorLHO;
+  else if(tag==LLO) return &LLVDetectorLLO;
+  else if(tag==VIRGO) return &LLVDetectorVIRGO;
+  else {
+    printf("Error: invalid detector tag\n");
+    exit(1);
+  }
 }
 
 /***************************************/
 /********* Core functions **************/
 
 /* Function to convert string input network string to Networktag */
+/* The string gives the detectors with the one-letter codes of LLVNetwork_Init (H: LIGO Hanford, L: LIGO Livingston, V: VIRGO), in any order */
 Networktag ParseNetworktag(char* string) {
-  Networktag tag;
-  if(strcmp(string, "L")==0) tag = L;
-  else if(strcmp(string, "H")==0) tag = H;
-  else if(strcmp(string, "V")==0) tag = V;
-  else if(strcmp(string, "LH")==0) tag = LH;
-  else if(strcmp(string, "LV")==0) tag = LV;
-  else if(strcmp(string, "HV")==0) tag = HV;
-  else if(strcmp(string, "LHV")==0) tag = LHV;
-  else {
-    printf("Error in ParseNetworktag: string not recognized.\n");
+  /* Networktag for each set of detectors, indexed by bits 1 (H), 2 (L), 4 (V) - entry 0 (empty set) is never used */
+  static const Networktag tags[8] = {HLV, H, L, HL, V, HV, LV, HLV};
+  int set = 0;
+  for(char* c=string; *c; c++) {
+    int bit = 0;
+    if(*c=='H') bit = 1;
+    else if(*c=='L') bit = 2;
+    else if(*c=='V') bit = 4;
+    if(bit==0 || (set & bit)) {
+      printf("Error in ParseNetworktag: string %s not recognized - expected distinct letters among H, L, V.\n", string);
+      exit(1);
+    }
+    set |= bit;
+  }
+  if(set==0) {
+    printf("Error in ParseNetworktag: empty network string.\n");
     exit(1);
   }
-  return tag;
+  return tags[set];
 }
 
 /* Function evaluating the Fourier-domain factors for LHV detectors */
@@ -174,12 +237,12 @@ static int EvaluateDetectorFactor3Det(
   const Networktag networktag)                  /* Selector for the detector network */
 {
   switch(networktag) {
-    case L:
+    case H:
     *factor1 = 1.;
     *factor2 = 0;
     *factor3 = 0;
     break;
-    case H:
+    case L:
     *factor1 = 0;
     *factor2 = 1.;
     *factor3 = 0;
@@ -189,22 +252,22 @@ static int EvaluateDetectorFactor3Det(
     *factor2 = 0;
     *factor3 = 1.;
     break;
-    case LH:
+    case HL:
     *factor1 = 1.;
     *factor2 = 1.;
     *factor3 = 0;
     break;
-    case LV:
+    case HV:
     *factor1 = 1.;
     *factor2 = 0;
     *factor3 = 1.;
     break;
-    case HV:
+    case LV:
     *factor1 = 0;
     *factor2 = 1.;
     *factor3 = 1.;
     break;
-    case LHV:
+    case HLV:
     *factor1 = 1.;
     *factor2 = 1.;
     *factor3 = 1.;
@@ -227,11 +290,10 @@ int LLVSimFDResponse(
   const double psi,                                       /* Polarization angle (rad) */
   const Detectortag tag)                                  /* Tag identifying the detector */
 {
-  /* Define matrix D and position vector Xd of the detector */
-  gsl_matrix* D = gsl_matrix_alloc(3,3);
-  gsl_vector* Xd = gsl_vector_alloc(3);
-  SetVectorXd(Xd, tag);
-  SetMatrixD(D, tag);
+  /* Response tensor D and position Xd of the detector */
+  const LLVDetector* detector = DetectorFromTag(tag);
+  double D[3][3];
+  LLVDetector_ResponseTensor(D, detector);
 
   /* Conversion from (ra, dec) to the Earth-based spherical angles (theta, phi) - neglecting nutation and precession, and identifying UT1 and UTC, so accurate roughly to a second of time */
   double gmst_angle = gmst_angle_from_gpstime(gpstime);
@@ -239,29 +301,12 @@ int LLVSimFDResponse(
   double phi = ra - gmst_angle;
 
   /* Define waveframe unit vectors (X,Y,Z) */
-  gsl_vector* X = gsl_vector_alloc(3);
-  gsl_vector* Y = gsl_vector_alloc(3);
-  gsl_vector* Z = gsl_vector_alloc(3);
-  SetVectorsXYZ(X, Y, Z, theta, phi, psi);
-
-  /* Compute the delay from geocenter to the detector */
-  double delaylength;
-  gsl_blas_ddot(Xd, Z, &delaylength);
-  double twopidelay = 2*PI*delaylength/C_SI;
-
-  /* Compute the value of pattern functions Fplus, Fcross */
-  gsl_vector* DX = gsl_vector_calloc(3); /* Temporary vector D.X, initialized to 0 */
-  gsl_vector* DY = gsl_vector_calloc(3); /* Temporary vector D.Y, initialized to 0 */
-  gsl_blas_dgemv( CblasNoTrans, 1., D, X, 0, DX);
-  gsl_blas_dgemv( CblasNoTrans, 1., D, Y, 0, DY);
-  double XDX;
-  double XDY;
-  double YDY;
-  gsl_blas_ddot(X, DX, &XDX);
-  gsl_blas_ddot(X, DY, &XDY);
-  gsl_blas_ddot(Y, DY, &YDY);
-  double Fplus = XDX - YDY;
-  double Fcross = 2*XDY;
+  double X[3], Y[3], Z[3];
+  SetArraysXYZ(X, Y, Z, theta, phi, psi);
+
+  /* Compute the delay from geocenter to the detector and the pattern functions Fplus, Fcross */
+  double Fplus, Fcross, twopidelay;
+  PatternFunctionsDelay(&Fplus, &Fcross, &twopidelay, (const double (*)[3]) D, detector->location, X, Y, Z);
 
   /* Main loop over the modes - goes through all the modes present, stopping when encountering NULL */
   ListmodesCAmpPhaseFrequencySeries* listelement = *listhlm;
@@ -321,130 +366,48 @@ int LLVSimFDResponse(
     listelement = listelement->next;
   }
 
-  /* Cleaning */
-  gsl_matrix_free(D);
-  gsl_vector_free(Xd);
-  gsl_vector_free(X);
-  gsl_vector_free(Y);
-  gsl_vector_free(Z);
-  gsl_vector_free(DX);
-  gsl_vector_free(DY);
-
   return SUCCESS;
 }
 
-/* Core function processing a signal (in the form of a list of modes) through the Fourier-domain LLV response for a given detector network, for given values of the inclination, position in the sky and polarization angle */
-/* Note: as for now, asssumes the three detectors are L,H,V - amplitudes simply set to 0 in those that are not selected by networktag */
-int LLVSimFDResponse3Det(
-  struct tagListmodesCAmpPhaseFrequencySeries **list1,    /* Output: list of contributions of each mode in the signal of detector 1, in Frequency-domain amplitude and phase form */
-  struct tagListmodesCAmpPhaseFrequencySeries **list2,    /* Output: list of contributions of each mode in the signal of detector 1, in Frequency-domain amplitude and phase form */
-  struct tagListmodesCAmpPhaseFrequencySeries **list3,    /* Output: list of contributions of each mode in the signal of detector 1, in Frequency-domain amplitude and phase form */
-  struct tagListmodesCAmpPhaseFrequencySeries **listhlm,  /* Input: list of modes in Frequency-domain amplitude and phase form as produced by the ROM */
+/* Function computing the Fourier-domain response for a network of detectors, reduced to constant factors and time delays */
+/* For each mode and detector k, the signal is factors[ndet*imode+k]*hlm(f)*exp(I*twopidelays[k]*f) */
+/* The Ylm factors are computed once per mode and the pattern functions once per detector */
+int LLVSimFDResponseFactorsNetwork(
+  double complex* factors,                                /* Output: factors of the response, ndet values (detectors of the network) for each mode in the order of listhlm */
+  double* twopidelays,                                    /* Output: 2pi times the delays from geocenter to each detector (s), ndet values */
+  struct tagListmodesCAmpPhaseFrequencySeries *listhlm,   /* Input: list of modes in Frequency-domain amplitude and phase form as produced by the ROM */
   const double gpstime,                                   /* GPS time (s) when the signal at coalescence reaches geocenter */
   const double ra,                                        /* Position in the sky: J2000.0 right ascension (rad) */
   const double dec,                                       /* Position in the sky: J2000.0 declination (rad) */
   const double inclination,                               /* Inclination of the source (rad) */
   const double psi,                                       /* Polarization angle (rad) */
-  const Networktag tag)                                   /* Tag identifying the network to use */
+  const LLVNetwork* network)                              /* Network of detectors */
 {
-  /* Read which detectors are to be included in the network */
-  double factor1 = 0;
-  double factor2 = 0;
-  double factor3 = 0;
-  EvaluateDetectorFactor3Det(&factor1, &factor2, &factor3, tag);
-
-  /* Define matrix D and position vector Xd for the 3 detectors */
-  gsl_matrix* D1 = gsl_matrix_alloc(3,3);
-  gsl_matrix* D2 = gsl_matrix_alloc(3,3);
-  gsl_matrix* D3 = gsl_matrix_alloc(3,3);
-  gsl_vector* Xd1 = gsl_vector_alloc(3);
-  gsl_vector* Xd2 = gsl_vector_alloc(3);
-  gsl_vector* Xd3 = gsl_vector_alloc(3);
-  SetVectorXd(Xd1, LHO);
-  SetVectorXd(Xd2, LLO);
-  SetVectorXd(Xd3, VIRGO);
-  SetMatrixD(D1, LHO);
-  SetMatrixD(D2, LLO);
-  SetMatrixD(D3, VIRGO);
+  int ndet = network->ndet;
 
   /* Conversion from (ra, dec) to the Earth-based spherical angles (theta, phi) - neglecting nutation and precession, and identifying UT1 and UTC, so accurate roughly to a second of time */
-  double gmst_angle = gmst_angle_from_gpstime(gpstime);
+  /* The GMST angle is linearized if gpstime is in the range of the GMST cache of the network */
+  double gmst_angle = LLVNetwork_GMST(network, gpstime);
   double theta = PI/2 - dec;
   double phi = ra - gmst_angle;
 
   /* Define waveframe unit vectors (X,Y,Z) */
-  gsl_vector* X = gsl_vector_alloc(3);
-  gsl_vector* Y = gsl_vector_alloc(3);
-  gsl_vector* Z = gsl_vector_alloc(3);
-  SetVectorsXYZ(X, Y, Z, theta, phi, psi);
-
-  /* Compute the delays from geocenter to each detector */
-  double delaylength1 = 0;
-  double delaylength2 = 0;
-  double delaylength3 = 0;
-  gsl_blas_ddot(Xd1, Z, &delaylength1);
-  gsl_blas_ddot(Xd2, Z, &delaylength2);
-  gsl_blas_ddot(Xd3, Z, &delaylength3);
-  double twopidelay1 = 2*PI*delaylength1/C_SI;
-  double twopidelay2 = 2*PI*delaylength2/C_SI;
-  double twopidelay3 = 2*PI*delaylength3/C_SI;
-
-  /* Compute the value of pattern functions Fplus, Fcross for each detector */
-  gsl_vector* DX1 = gsl_vector_calloc(3); /* Temporary vector D.X, initialized to 0 */
-  gsl_vector* DY1 = gsl_vector_calloc(3); /* Temporary vector D.Y, initialized to 0 */
-  gsl_vector* DX2 = gsl_vector_calloc(3); /* Temporary vector D.X, initialized to 0 */
-  gsl_vector* DY2 = gsl_vector_calloc(3); /* Temporary vector D.Y, initialized to 0 */
-  gsl_vector* DX3 = gsl_vector_calloc(3); /* Temporary vector D.X, initialized to 0 */
-  gsl_vector* DY3 = gsl_vector_calloc(3); /* Temporary vector D.Y, initialized to 0 */
-  gsl_blas_dgemv( CblasNoTrans, 1., D1, X, 0, DX1);
-  gsl_blas_dgemv( CblasNoTrans, 1., D1, Y, 0, DY1);
-  gsl_blas_dgemv( CblasNoTrans, 1., D2, X, 0, DX2);
-  gsl_blas_dgemv( CblasNoTrans, 1., D2, Y, 0, DY2);
-  gsl_blas_dgemv( CblasNoTrans, 1., D3, X, 0, DX3);
-  gsl_blas_dgemv( CblasNoTrans, 1., D3, Y, 0, DY3);
-  double XDX1 = 0.;
-  double XDY1 = 0.;
-  double YDY1 = 0.;
-  double XDX2 = 0.;
-  double XDY2 = 0.;
-  double YDY2 = 0.;
-  double XDX3 = 0.;
-  double XDY3 = 0.;
-  double YDY3 = 0.;
-  gsl_blas_ddot(X, DX1, &XDX1);
-  gsl_blas_ddot(X, DY1, &XDY1);
-  gsl_blas_ddot(Y, DY1, &YDY1);
-  gsl_blas_ddot(X, DX2, &XDX2);
-  gsl_blas_ddot(X, DY2, &XDY2);
-  gsl_blas_ddot(Y, DY2, &YDY2);
-  gsl_blas_ddot(X, DX3, &XDX3);
-  gsl_blas_ddot(X, DY3, &XDY3);
-  gsl_blas_ddot(Y, DY3, &YDY3);
-  double Fplus1 = XDX1 - YDY1;
-  double Fcross1 = 2*XDY1;
-  double Fplus2 = XDX2 - YDY2;
-  double Fcross2 = 2*XDY2;
-  double Fplus3 = XDX3 - YDY3;
-  double Fcross3 = 2*XDY3;
+  double X[3], Y[3], Z[3];
+  SetArraysXYZ(X, Y, Z, theta, phi, psi);
+
+  /* Compute the delays from geocenter and the pattern functions Fplus, Fcross for each detector - response tensors are precomputed in the network */
+  double Fplus[LLV_NDETMAX];
+  double Fcross[LLV_NDETMAX];
+  for(int k=0; k<ndet; k++) {
+    PatternFunctionsDelay(&Fplus[k], &Fcross[k], &twopidelays[k], network->D[k], network->detectors[k]->location, X, Y, Z);
+  }
 
-  /* Main loop over the modes - goes through all the modes present, stopping when encountering NULL */
-  ListmodesCAmpPhaseFrequencySeries* listelement = *listhlm;
+  /* Loop over the modes - goes through all the modes present, stopping when encountering NULL */
+  int imode = 0;
+  ListmodesCAmpPhaseFrequencySeries* listelement = listhlm;
   while(listelement) {
-
-    /* Definitions: l,m, frequency series and length */
     int l = listelement->l;
     int m = listelement->m;
-    CAmpPhaseFrequencySeries* freqseries = listelement->freqseries;
-    gsl_vector* freq = freqseries->freq;
-    gsl_vector* amp_real = freqseries->amp_real;
-    gsl_vector* amp_imag = freqseries->amp_imag;
-    gsl_vector* phase = freqseries->phase;
-    int len = (int) freq->size;
-    double f;
-    double complex camp;
-    double complex camp1;
-    double complex camp2;
-    double complex camp3;
 
     /* Computing the Ylm combined factors for plus and cross for this mode */
     /* Capital Phi is set to 0 by convention */
@@ -459,77 +422,132 @@ int LLVSimFDResponse3Det(
       Yfactorcross = I/2 * (SpinWeightedSphericalHarmonic(inclination, 0., -2, l, m) + conj(SpinWeightedSphericalHarmonic(inclination, 0., -2, l, -m)));
     }
 
-    /* Initializing frequency series structure for this mode, for the signal s = F+ h+ + Fx hx in each detector */
-    CAmpPhaseFrequencySeries *modefreqseries1 = NULL;
-    CAmpPhaseFrequencySeries *modefreqseries2 = NULL;
-    CAmpPhaseFrequencySeries *modefreqseries3 = NULL;
-    CAmpPhaseFrequencySeries_Init(&modefreqseries1, len);
-    CAmpPhaseFrequencySeries_Init(&modefreqseries2, len);
-    CAmpPhaseFrequencySeries_Init(&modefreqseries3, len);
-    gsl_vector* freq1 = modefreqseries1->freq;
-    gsl_vector* freq2 = modefreqseries2->freq;
-    gsl_vector* freq3 = modefreqseries3->freq;
-    gsl_vector* amp_real1 = modefreqseries1->amp_real;
-    gsl_vector* amp_real2 = modefreqseries2->amp_real;
-    gsl_vector* amp_real3 = modefreqseries3->amp_real;
-    gsl_vector* amp_imag1 = modefreqseries1->amp_imag;
-    gsl_vector* amp_imag2 = modefreqseries2->amp_imag;
-    gsl_vector* amp_imag3 = modefreqseries3->amp_imag;
-    gsl_vector* phase1 = modefreqseries1->phase;
-    gsl_vector* phase2 = modefreqseries2->phase;
-    gsl_vector* phase3 = modefreqseries3->phase;
+    for(int k=0; k<ndet; k++) factors[ndet*imode + k] = Fplus[k]*Yfactorplus + Fcross[k]*Yfactorcross;
 
-    /* Loop over the frequencies - multiplying by F+, Fx, and add phase due to the delay from geocenter to the detector */
-    double complex factorcamp1 = Fplus1*Yfactorplus + Fcross1*Yfactorcross;
-    double complex factorcamp2 = Fplus2*Yfactorplus + Fcross2*Yfactorcross;
-    double complex factorcamp3 = Fplus3*Yfactorplus + Fcross3*Yfactorcross;
+    listelement = listelement->next;
+    imode++;
+  }
+
+  return SUCCESS;
+}
+
+/* Function computing the Fourier-domain LLV response for a given detector network, reduced to constant factors and time delays */
+/* For each mode and detector, the signal is factor*hlm(f)*exp(I*twopidelay*f) - factors of the detectors that are not selected by networktag are set to 0 */
+int LLVSimFDResponseFactors3Det(
+  double complex* factors,                                /* Output: factors of the response, 3 values (detectors LHO, LLO, VIRGO) for each mode in the order of listhlm */
+  double* twopidelays,                                    /* Output: 2pi times the delays from geocenter to each detector (s), 3 values */
+  struct tagListmodesCAmpPhaseFrequencySeries *listhlm,   /* Input: list of modes in Frequency-domain amplitude and phase form as produced by the ROM */
+  const double gpstime,                                   /* GPS time (s) when the signal at coalescence reaches geocenter */
+  const double ra,                                        /* Position in the sky: J2000.0 right ascension (rad) */
+  const double dec,                                       /* Position in the sky: J2000.0 declination (rad) */
+  const double inclination,                               /* Inclination of the source (rad) */
+  const double psi,                                       /* Polarization angle (rad) */
+  const Networktag tag)                                   /* Tag identifying the network to use */
+{
+  /* Read which detectors are to be included in the network */
+  double factordet[3] = {0., 0., 0.};
+  EvaluateDetectorFactor3Det(&factordet[0], &factordet[1], &factordet[2], tag);
+
+  /* Response of the network of the three detectors, in the order LHO, LLO, VIRGO - set up on the stack, no allocation */
+  LLVNetwork network;
+  LLVNetwork_Set(&network, "HLV");
+  LLVSimFDResponseFactorsNetwork(factors, twopidelays, listhlm, gpstime, ra, dec, inclination, psi, &network);
+
+  /* Note: include factordet as detector selectors, which are simpy 0 or 1 whether the detector is in the array or not */
+  int nbmode = 0;
+  for(ListmodesCAmpPhaseFrequencySeries* listelement = listhlm; listelement; listelement = listelement->next) nbmode++;
+  for(int imode=0; imode<nbmode; imode++)
+    for(int d=0; d<3; d++) factors[3*imode + d] *= factordet[d];
+
+  return SUCCESS;
+}
+
+/* Function applying the factors and delays of the response to the modes hlm, building the list of contributions of each mode in the signal of the detector k */
+int LLVSimFDResponseApplyFactors(
+  struct tagListmodesCAmpPhaseFrequencySeries **list,     /* Output: list of contributions of each mode in the signal of the detector, in Frequency-domain amplitude and phase form */
+  struct tagListmodesCAmpPhaseFrequencySeries *listhlm,   /* Input: list of modes in Frequency-domain amplitude and phase form as produced by the ROM */
+  const double complex* factors,                          /* Input: factors of the response, ndet values for each mode in the order of listhlm */
+  const double twopidelay,                                /* Input: 2pi times the delay from geocenter to the detector (s) */
+  const int ndet,                                         /* Input: number of detectors in factors */
+  const int k)                                            /* Input: index of the detector */
+{
+  /* Main loop over the modes - goes through all the modes present, stopping when encountering NULL */
+  int imode = 0;
+  ListmodesCAmpPhaseFrequencySeries* listelement = listhlm;
+  while(listelement) {
+
+    /* Definitions: l,m, frequency series and length */
+    int l = listelement->l;
+    int m = listelement->m;
+    CAmpPhaseFrequencySeries* freqseries = listelement->freqseries;
+    gsl_vector* freq = freqseries->freq;
+    gsl_vector* amp_real = freqseries->amp_real;
+    gsl_vector* amp_imag = freqseries->amp_imag;
+    gsl_vector* phase = freqseries->phase;
+    int len = (int) freq->size;
+    double f;
+    double complex camp;
+    double complex camps;
+
+    /* Initializing frequency series structure for this mode, for the signal s = F+ h+ + Fx hx in the detector */
+    CAmpPhaseFrequencySeries *modefreqseriess = NULL;
+    CAmpPhaseFrequencySeries_Init(&modefreqseriess, len);
+    gsl_vector* amp_reals = modefreqseriess->amp_real;
+    gsl_vector* amp_imags = modefreqseriess->amp_imag;
+    gsl_vector* phases = modefreqseriess->phase;
+
+    /* Loop over the frequencies - multiplying by the factor, and add phase due to the delay from geocenter to the detector */
+    double complex factorcamp = factors[ndet*imode + k];
     for(int j=0; j<len; j++) {
       f = gsl_vector_get(freq, j);
       camp = gsl_vector_get(amp_real, j) + I*gsl_vector_get(amp_imag, j);
-      /* Note: include factor123 as detector selectors, which are simpy 0 or 1 whether the detector is in the array or not */
-      camp1 = factor1 * camp * factorcamp1;
-      camp2 = factor2 * camp * factorcamp2;
-      camp3 = factor3 * camp * factorcamp3;
-      gsl_vector_set(amp_real1, j, creal(camp1));
-      gsl_vector_set(amp_real2, j, creal(camp2));
-      gsl_vector_set(amp_real3, j, creal(camp3));
-      gsl_vector_set(amp_imag1, j, cimag(camp1));
-      gsl_vector_set(amp_imag2, j, cimag(camp2));
-      gsl_vector_set(amp_imag3, j, cimag(camp3));
-      gsl_vector_set(phase1, j, gsl_vector_get(phase, j) + twopidelay1*f);
-      gsl_vector_set(phase2, j, gsl_vector_get(phase, j) + twopidelay2*f);
-      gsl_vector_set(phase3, j, gsl_vector_get(phase, j) + twopidelay3*f);
+      camps = camp * factorcamp;
+      gsl_vector_set(amp_reals, j, creal(camps));
+      gsl_vector_set(amp_imags, j, cimag(camps));
+      gsl_vector_set(phases, j, gsl_vector_get(phase, j) + twopidelay*f);
     }
     /* Copying the vectors of frequencies */
-    gsl_vector_memcpy(freq1, freq);
-    gsl_vector_memcpy(freq2, freq);
-    gsl_vector_memcpy(freq3, freq);
+    gsl_vector_memcpy(modefreqseriess->freq, freq);
 
-    /* Append the modes to the ouput list-of-modes structures */
-    *list1 = ListmodesCAmpPhaseFrequencySeries_AddModeNoCopy(*list1, modefreqseries1, l, m);
-    *list2 = ListmodesCAmpPhaseFrequencySeries_AddModeNoCopy(*list2, modefreqseries2, l, m);
-    *list3 = ListmodesCAmpPhaseFrequencySeries_AddModeNoCopy(*list3, modefreqseries3, l, m);
+    /* Append the modes to the ouput list-of-modes structure */
+    *list = ListmodesCAmpPhaseFrequencySeries_AddModeNoCopy(*list, modefreqseriess, l, m);
 
     /* Going to the next mode in the list */
     listelement = listelement->next;
+    imode++;
   }
 
+  return SUCCESS;
+}
+
+/* Core function processing a signal (in the form of a list of modes) through the Fourier-domain LLV response for a given detector network, for given values of the inclination, position in the sky and polarization angle */
+/* Note: as for now, asssumes the three detectors are L,H,V - amplitudes simply set to 0 in those that are not selected by networktag */
+int LLVSimFDResponse3Det(
+  struct tagListmodesCAmpPhaseFrequencySeries **list1,    /* Output: list of contributions of each mode in the signal of detector 1, in Frequency-domain amplitude and phase form */
+  struct tagListmodesCAmpPhaseFrequencySeries **list2,    /* Output: list of contributions of each mode in the signal of detector 1, in Frequency-domain amplitude and phase form */
+  struct tagListmodesCAmpPhaseFrequencySeries **list3,    /* Output: list of contributions of each mode in the signal of detector 1, in Frequency-domain amplitude and phase form */
+  struct tagListmodesCAmpPhaseFrequencySeries **listhlm,  /* Input: list of modes in Frequency-domain amplitude and phase form as produced by the ROM */
+  const double gpstime,                                   /* GPS time (s) when the signal at coalescence reaches geocenter */
+  const double ra,                                        /* Position in the sky: J2000.0 right ascension (rad) */
+  const double dec,                                       /* Position in the sky: J2000.0 declination (rad) */
+  const double inclination,                               /* Inclination of the source (rad) */
+  const double psi,                                       /* Polarization angle (rad) */
+  const Networktag tag)                                   /* Tag identifying the network to use */
+{
+  /* Factors and delays of the response - constant for each mode */
+  int nbmode = 0;
+  for(ListmodesCAmpPhaseFrequencySeries* listelement = *listhlm; listelement; listelement = listelement->next) nbmode++;
+  double complex* factors = malloc(3*nbmode*sizeof(double complex));
+  double twopidelays[3];
+  LLVSimFDResponseFactors3Det(factors, twopidelays, *listhlm, gpstime, ra, dec, inclination, psi, tag);
+
+  /* Contributions of the modes in each detector */
+  LLVSimFDResponseApplyFactors(list1, *listhlm, factors, twopidelays[0], 3, 0);
+  LLVSimFDResponseApplyFactors(list2, *listhlm, factors, twopidelays[1], 3, 1);
+  LLVSimFDResponseApplyFactors(list3, *listhlm, factors, twopidelays[2], 3, 2);
+
   /* Cleaning */
-  gsl_matrix_free(D1);
-  gsl_matrix_free(D2);
-  gsl_matrix_free(D3);
-  gsl_vector_free(Xd1);
-  gsl_vector_free(Xd2);
-  gsl_vector_free(Xd3);
-  gsl_vector_free(X);
-  gsl_vector_free(Y);
-  gsl_vector_free(Z);
-  gsl_vector_free(DX1);
-  gsl_vector_free(DX2);
-  gsl_vector_free(DX3);
-  gsl_vector_free(DY1);
-  gsl_vector_free(DY2);
-  gsl_vector_free(DY3);
+  free(factors);
 
   return SUCCESS;
 }
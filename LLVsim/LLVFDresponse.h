@@ -36,6 +36,7 @@
 
 #include "constants.h"
 #include "LLVgeometry.h"
+#include "LLVnetwork.h"
 #include "struct.h"
 #include "waveform.h"
 #include "timeconversion.h"
@@ -71,6 +72,41 @@ int LLVSimFDResponse(
     const double psi,                                           /* Polarization angle */
     const Networktag tag);                               /* Selector for the detector network */
 
+/* Function computing the Fourier-domain LLV response for a given detector network, reduced to constant factors and time delays - for each mode and detector, the signal is factor*hlm(f)*exp(I*twopidelay*f) */
+/* Note: as for now, asssumes the three detectors are LHO, LLO, VIRGO - factors simply set to 0 in those that are not selected by networktag */
+int LLVSimFDResponseFactors3Det(
+  double complex* factors,                                /* Output: factors of the response, 3 values (detectors LHO, LLO, VIRGO) for each mode in the order of listhlm */
+  double* twopidelays,                                    /* Output: 2pi times the delays from geocenter to each detector (s), 3 values */
+  struct tagListmodesCAmpPhaseFrequencySeries *listhlm,   /* Input: list of modes in Frequency-domain amplitude and phase form as produced by the ROM */
+  const double gpstime,                                   /* GPS time (s) when the signal at coalescence reaches geocenter */
+  const double ra,                                        /* Position in the sky: J2000.0 right ascension (rad) */
+  const double dec,                                       /* Position in the sky: J2000.0 declination (rad) */
+  const double inclination,                               /* Inclination of the source (rad) */
+  const double psi,                                       /* Polarization angle (rad) */
+  const Networktag tag);                                  /* Selector for the detector network */
+
+/* Function computing the Fourier-domain response for a network of detectors, reduced to constant factors and time delays */
+/* For each mode and detector k, the signal is factors[ndet*imode+k]*hlm(f)*exp(I*twopidelays[k]*f) */
+int LLVSimFDResponseFactorsNetwork(
+  double complex* factors,                                /* Output: factors of the response, ndet values (detectors of the network) for each mode in the order of listhlm */
+  double* twopidelays,                                    /* Output: 2pi times the delays from geocenter to each detector (s), ndet values */
+  struct tagListmodesCAmpPhaseFrequencySeries *listhlm,   /* Input: list of modes in Frequency-domain amplitude and phase form as produced by the ROM */
+  const double gpstime,                                   /* GPS time (s) when the signal at coalescence reaches geocenter */
+  const double ra,                                        /* Position in the sky: J2000.0 right ascension (rad) */
+  const double dec,                                       /* Position in the sky: J2000.0 declination (rad) */
+  const double inclination,                               /* Inclination of the source (rad) */
+  const double psi,                                       /* Polarization angle (rad) */
+  const LLVNetwork* network);                             /* Network of detectors */
+
+/* Function applying the factors and delays of the response to the modes hlm, building the list of contributions of each mode in the signal of the detector k */
+int LLVSimFDResponseApplyFactors(
+  struct tagListmodesCAmpPhaseFrequencySeries **list,     /* Output: list of contributions of each mode in the signal of the detector, in Frequency-domain amplitude and phase form */
+  struct tagListmodesCAmpPhaseFrequencySeries *listhlm,   /* Input: list of modes in Frequency-domain amplitude and phase form as produced by the ROM */
+  const double complex* factors,                          /* Input: factors of the response, ndet values for each mode in the order of listhlm */
+  const double twopidelay,                                /* Input: 2pi times the delay from geocenter to the detector (s) */
+  const int ndet,                                         /* Input: number of detectors in factors */
+  const int k);                                           /* Input: index of the detector */
+
 /* Function setting the response matrix of a given detector, in cartesian coordinates */
 void SetMatrixD(
   gsl_matrix* D,                       /* Output: matrix of the detector response Dij */
@@ -41,7 +41,8 @@
 
 /* Enumerator for the detector selector and network selector */
 typedef enum {LHO, LLO, VIRGO} Detectortag;
-typedef enum {L, H, V, LH, LV, HV, LHV} Networktag;
+/* Network selector for the three detectors LHO, LLO, VIRGO - letters as in the network strings of LLVnetwork.h (H: LIGO Hanford, L: LIGO Livingston, V: VIRGO) */
+typedef enum {H, L, V, HL, HV, LV, HLV} Networktag;
 
 /*************************************************************/
 /**************** Geometrical constants **********************/
@@ -125,6 +126,49 @@ typedef enum {L, H, V, LH, LV, HV, LHV} Networktag;
 #define LAL_VIRGO_ARM_Y_DIRECTION_Y           	-0.96908180549	/**< VIRGO y-component of unit vector pointing along y arm in Earth-centered frame */
 #define LAL_VIRGO_ARM_Y_DIRECTION_Z           	0.24080451708	/**< VIRGO z-component of unit vector pointing along y arm in Earth-centered frame */
 
+/**
+ * \name KAGRA 3km Interferometric Detector constants
+ * The following constants describe the location and geometry of the
+ * KAGRA 3km Interferometric Detector.
+ */
+#define LAL_KAGRA_DETECTOR_NAME                	"KAGRA"	/**< KAGRA detector name string */
+#define LAL_KAGRA_DETECTOR_PREFIX              	"K1"	/**< KAGRA detector prefix string */
+#define LAL_KAGRA_VERTEX_LOCATION_X_SI         	-3.77733602400e+06	/**< KAGRA x-component of vertex location in Earth-centered frame (m) */
+#define LAL_KAGRA_VERTEX_LOCATION_Y_SI         	3.48489841100e+06	/**< KAGRA y-component of vertex location in Earth-centered frame (m) */
+#define LAL_KAGRA_VERTEX_LOCATION_Z_SI         	3.76531369700e+06	/**< KAGRA z-component of vertex location in Earth-centered frame (m) */
+#define LAL_KAGRA_ARM_X_DIRECTION_X            	-0.37590400000	/**< KAGRA x-component of unit vector pointing along x arm in Earth-centered frame */
+#define LAL_KAGRA_ARM_X_DIRECTION_Y            	-0.83615830000	/**< KAGRA y-component of unit vector pointing along x arm in Earth-centered frame */
+#define LAL_KAGRA_ARM_X_DIRECTION_Z            	0.39941890000	/**< KAGRA z-component of unit vector pointing along x arm in Earth-centered frame */
+#define LAL_KAGRA_ARM_Y_DIRECTION_X            	0.71643780000	/**< KAGRA x-component of unit vector pointing along y arm in Earth-centered frame */
+#define LAL_KAGRA_ARM_Y_DIRECTION_Y            	0.01114076000	/**< KAGRA y-component of unit vector pointing along y arm in Earth-centered frame */
+#define LAL_KAGRA_ARM_Y_DIRECTION_Z            	0.69756200000	/**< KAGRA z-component of unit vector pointing along y arm in Earth-centered frame */
+
+/**
+ * \name LIGO India 4km Interferometric Detector constants
+ * The following constants describe the nominal location and geometry of the
+ * LIGO India 4km Interferometric Detector, at the proposed site of Aundha.
+ * Not from LAL: the vertex is at 19.613N 77.031E (elevation 440m) on the WGS-84 ellipsoid, and the orientation of the
+ * arms (azimuths 117.6 deg and 27.6 deg, horizontal) is an assumption for design studies.
+ */
+#define LAL_LIO_4K_DETECTOR_NAME               	"LIO_4k"	/**< LIO_4k detector name string */
+#define LAL_LIO_4K_DETECTOR_PREFIX             	"I1"	/**< LIO_4k detector prefix string */
+#define LAL_LIO_4K_DETECTOR_LONGITUDE_RAD      	1.34444457610	/**< LIO_4k vertex longitude (rad) */
+#define LAL_LIO_4K_DETECTOR_LATITUDE_RAD       	0.34231142619	/**< LIO_4k vertex latitude (rad) */
+#define LAL_LIO_4K_DETECTOR_ELEVATION_SI       	440.000	/**< LIO_4k vertex elevation (m) */
+#define LAL_LIO_4K_DETECTOR_ARM_X_AZIMUTH_RAD  	2.05250720035	/**< LIO_4k x arm azimuth (rad) */
+#define LAL_LIO_4K_DETECTOR_ARM_Y_AZIMUTH_RAD  	0.48171087355	/**< LIO_4k y arm azimuth (rad) */
+#define LAL_LIO_4K_DETECTOR_ARM_X_ALTITUDE_RAD 	0.00000000000	/**< LIO_4k x arm altitude (rad) */
+#define LAL_LIO_4K_DETECTOR_ARM_Y_ALTITUDE_RAD 	0.00000000000	/**< LIO_4k y arm altitude (rad) */
+#define LAL_LIO_4K_VERTEX_LOCATION_X_SI        	1.34895949966e+06	/**< LIO_4k x-component of vertex location in Earth-centered frame (m) */
+#define LAL_LIO_4K_VERTEX_LOCATION_Y_SI        	5.85744261985e+06	/**< LIO_4k y-component of vertex location in Earth-centered frame (m) */
+#define LAL_LIO_4K_VERTEX_LOCATION_Z_SI        	2.12753733845e+06	/**< LIO_4k z-component of vertex location in Earth-centered frame (m) */
+#define LAL_LIO_4K_ARM_X_DIRECTION_X           	-0.82869728179	/**< LIO_4k x-component of unit vector pointing along x arm in Earth-centered frame */
+#define LAL_LIO_4K_ARM_X_DIRECTION_Y           	0.35043074550	/**< LIO_4k y-component of unit vector pointing along x arm in Earth-centered frame */
+#define LAL_LIO_4K_ARM_X_DIRECTION_Z           	-0.43641620932	/**< LIO_4k z-component of unit vector pointing along x arm in Earth-centered frame */
+#define LAL_LIO_4K_ARM_Y_DIRECTION_X           	-0.51823697370	/**< LIO_4k x-component of unit vector pointing along y arm in Earth-centered frame */
+#define LAL_LIO_4K_ARM_Y_DIRECTION_Y           	-0.18590520509	/**< LIO_4k y-component of unit vector pointing along y arm in Earth-centered frame */
+#define LAL_LIO_4K_ARM_Y_DIRECTION_Z           	0.83478721469	/**< LIO_4k z-component of unit vector pointing along y arm in Earth-centered frame */
+
 #if 0
 { /* so that editors will match succeeding brace */
 #elif defined(__cplusplus)
@@ -0,0 +1,185 @@
+/**
+ * \author Sylvain Marsat, University of Maryland - NASA GSFC
+ *
+ * \brief C code for networks of ground-based detectors: geometry of each detector and noise PSD, for an arbitrary number of detectors.
+ *
+ */
+
+
+#define _XOPEN_SOURCE 500
+
+#ifdef __GNUC__
+#define UNUSED __attribute__ ((unused))
+#else
+#define UNUSED
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include <string.h>
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spline.h>
+
+#include "constants.h"
+#include "struct.h"
+#include "timeconversion.h"
+#include "LLVgeometry.h"
+#include "LLVnoise.h"
+#include "LLVnetwork.h"
+
+
+/*****************************************************/
+/**************** Known detectors ********************/
+
+LLVDetector LLVDetectorLHO = {
+  'H',
+  LAL_LHO_4K_DETECTOR_NAME,
+  {LAL_LHO_4K_VERTEX_LOCATION_X_SI, LAL_LHO_4K_VERTEX_LOCATION_Y_SI, LAL_LHO_4K_VERTEX_LOCATION_Z_SI},
+  {LAL_LHO_4K_ARM_X_DIRECTION_X, LAL_LHO_4K_ARM_X_DIRECTION_Y, LAL_LHO_4K_ARM_X_DIRECTION_Z},
+  {LAL_LHO_4K_ARM_Y_DIRECTION_X, LAL_LHO_4K_ARM_Y_DIRECTION_Y, LAL_LHO_4K_ARM_Y_DIRECTION_Z},
+  "aLIGO_sensitivity.dat"
+};
+
+LLVDetector LLVDetectorLLO = {
+  'L',
+  LAL_LLO_4K_DETECTOR_NAME,
+  {LAL_LLO_4K_VERTEX_LOCATION_X_SI, LAL_LLO_4K_VERTEX_LOCATION_Y_SI, LAL_LLO_4K_VERTEX_LOCATION_Z_SI},
+  {LAL_LLO_4K_ARM_X_DIRECTION_X, LAL_LLO_4K_ARM_X_DIRECTION_Y, LAL_LLO_4K_ARM_X_DIRECTION_Z},
+  {LAL_LLO_4K_ARM_Y_DIRECTION_X, LAL_LLO_4K_ARM_Y_DIRECTION_Y, LAL_LLO_4K_ARM_Y_DIRECTION_Z},
+  "aLIGO_sensitivity.dat"
+};
+
+LLVDetector LLVDetectorVIRGO = {
+  'V',
+  LAL_VIRGO_DETECTOR_NAME,
+  {LAL_VIRGO_VERTEX_LOCATION_X_SI, LAL_VIRGO_VERTEX_LOCATION_Y_SI, LAL_VIRGO_VERTEX_LOCATION_Z_SI},
+  {LAL_VIRGO_ARM_X_DIRECTION_X, LAL_VIRGO_ARM_X_DIRECTION_Y, LAL_VIRGO_ARM_X_DIRECTION_Z},
+  {LAL_VIRGO_ARM_Y_DIRECTION_X, LAL_VIRGO_ARM_Y_DIRECTION_Y, LAL_VIRGO_ARM_Y_DIRECTION_Z},
+  "aVirgo_sensitivity.dat"
+};
+
+/* No dedicated noise data for KAGRA and LIGO India - the aLIGO design sensitivity is used */
+LLVDetector LLVDetectorKAGRA = {
+  'K',
+  LAL_KAGRA_DETECTOR_NAME,
+  {LAL_KAGRA_VERTEX_LOCATION_X_SI, LAL_KAGRA_VERTEX_LOCATION_Y_SI, LAL_KAGRA_VERTEX_LOCATION_Z_SI},
+  {LAL_KAGRA_ARM_X_DIRECTION_X, LAL_KAGRA_ARM_X_DIRECTION_Y, LAL_KAGRA_ARM_X_DIRECTION_Z},
+  {LAL_KAGRA_ARM_Y_DIRECTION_X, LAL_KAGRA_ARM_Y_DIRECTION_Y, LAL_KAGRA_ARM_Y_DIRECTION_Z},
+  "aLIGO_sensitivity.dat"
+};
+
+LLVDetector LLVDetectorLIGOIndia = {
+  'I',
+  LAL_LIO_4K_DETECTOR_NAME,
+  {LAL_LIO_4K_VERTEX_LOCATION_X_SI, LAL_LIO_4K_VERTEX_LOCATION_Y_SI, LAL_LIO_4K_VERTEX_LOCATION_Z_SI},
+  {LAL_LIO_4K_ARM_X_DIRECTION_X, LAL_LIO_4K_ARM_X_DIRECTION_Y, LAL_LIO_4K_ARM_X_DIRECTION_Z},
+  {LAL_LIO_4K_ARM_Y_DIRECTION_X, LAL_LIO_4K_ARM_Y_DIRECTION_Y, LAL_LIO_4K_ARM_Y_DIRECTION_Z},
+  "aLIGO_sensitivity.dat"
+};
+
+static LLVDetector* const LLVKnownDetectors[] = {&LLVDetectorLHO, &LLVDetectorLLO, &LLVDetectorVIRGO, &LLVDetectorKAGRA, &LLVDetectorLIGOIndia};
+static const int LLVnbKnownDetectors = sizeof(LLVKnownDetectors)/sizeof(LLVKnownDetectors[0]);
+
+/* Response tensor D = (nx nx - ny ny)/2 of a detector */
+void LLVDetector_ResponseTensor(double D[3][3], const LLVDetector* detector)
+{
+  const double* nx = detector->armx;
+  const double* ny = detector->army;
+  for(int i=0; i<3; i++)
+    for(int j=0; j<3; j++)
+      D[i][j] = 0.5 * (nx[i]*nx[j] - ny[i]*ny[j]);
+}
+
+/*****************************************************/
+/**************** Networks ***************************/
+
+/* Function setting up an existing network structure from a string of one-letter codes, e.g. "HLV" - no allocation, the noise is not loaded */
+int LLVNetwork_Set(LLVNetwork* network, const char* string)
+{
+  int ndet = (int) strlen(string);
+  if(ndet==0 || ndet>LLV_NDETMAX) {
+    printf("Error in LLVNetwork_Set: the network must have between 1 and %d detectors.\n", LLV_NDETMAX);
+    exit(1);
+  }
+  network->ndet = ndet;
+  for(int k=0; k<ndet; k++) {
+    const LLVDetector* detector = NULL;
+    for(int i=0; i<LLVnbKnownDetectors; i++) if(LLVKnownDetectors[i]->letter==string[k]) detector = LLVKnownDetectors[i];
+    if(!detector) {
+      printf("Error in LLVNetwork_Set: detector %c not recognized.\n", string[k]);
+      exit(1);
+    }
+    for(int j=0; j<k; j++) if(network->detectors[j]==detector) {
+      printf("Error in LLVNetwork_Set: detector %c appears twice.\n", string[k]);
+      exit(1);
+    }
+    network->detectors[k] = detector;
+    network->noise[k] = NULL;
+    LLVDetector_ResponseTensor(network->D[k], detector);
+  }
+  network->gmstcache = 0;
+  return SUCCESS;
+}
+
+/* Function building a network from a string of one-letter codes, e.g. "HLV" */
+int LLVNetwork_Init(LLVNetwork** network, const char* string)
+{
+  *network = malloc(sizeof(LLVNetwork));
+  return LLVNetwork_Set(*network, string);
+}
+void LLVNetwork_Cleanup(LLVNetwork* network)
+{
+  for(int k=0; k<network->ndet; k++) if(network->noise[k]) LLVNoiseTable_Release(network->noise[k]);
+  free(network);
+}
+
+/* Function loading the noise PSD of each detector of the network - each noise curve is loaded once, and shared by the detectors using it */
+int LLVNetwork_InitNoise(LLVNetwork* network)
+{
+  for(int k=0; k<network->ndet; k++) {
+    if(network->noise[k]) continue;
+    network->noise[k] = LLVNoiseTable_Get(network->detectors[k]->noisefile);
+  }
+  return SUCCESS;
+}
+
+/* Noise PSD of the detector k of the network, in the form used by the overlaps */
+ObjectFunction LLVNetwork_NoiseFunction(const LLVNetwork* network, const int k)
+{
+  if(!network->noise[k]) {
+    printf("Error in LLVNetwork_NoiseFunction: noise of the network has not been set up.\n");
+    exit(1);
+  }
+  return LLVNoiseTableFunction(network->noise[k]);
+}
+
+/*****************************************************/
+/**************** GMST cache *************************/
+
+/* Rate of the Earth rotation angle, formula (2.11) of the USNO circular - the time derivative of the GMST correction is negligible */
+#define LLV_ERA_RATE (2*PI*1.00273781191135448/86400.0)
+
+/* Function setting up a linearized GMST angle for the times in [gpstime-halfwidth, gpstime+halfwidth] */
+/* Over a fraction of a second, the GMST angle is linear to machine precision - except across a leap second, where the cache is not used */
+int LLVNetwork_InitGMSTCache(LLVNetwork* network, const double gpstime, const double halfwidth)
+{
+  network->gmsttime = gpstime;
+  network->gmsthalfwidth = halfwidth;
+  network->gmst0 = gmst_angle_from_gpstime(gpstime);
+  network->gmstrate = LLV_ERA_RATE;
+  /* Check the linearization at both ends of the range - differences taken modulo 2pi */
+  double errbeg = remainder(gmst_angle_from_gpstime(gpstime - halfwidth) - (network->gmst0 - network->gmstrate*halfwidth), 2*PI);
+  double errend = remainder(gmst_angle_from_gpstime(gpstime + halfwidth) - (network->gmst0 + network->gmstrate*halfwidth), 2*PI);
+  network->gmstcache = (fabs(errbeg) < 1e-9 && fabs(errend) < 1e-9);
+  return SUCCESS;
+}
+
+/* GMST angle (rad) at a given GPS time (s) - linearized within the range of the cache, exact outside */
+double LLVNetwork_GMST(const LLVNetwork* network, const double gpstime)
+{
+  if(network->gmstcache && fabs(gpstime - network->gmsttime) <= network->gmsthalfwidth) return network->gmst0 + network->gmstrate*(gpstime - network->gmsttime);
+  else return gmst_angle_from_gpstime(gpstime);
+}
@@ -0,0 +1,107 @@
+/**
+ * \author Sylvain Marsat, University of Maryland - NASA GSFC
+ *
+ * \brief C header for networks of ground-based detectors: geometry of each detector and noise PSD, for an arbitrary number of detectors.
+ *
+ */
+
+#ifndef _LLVNETWORK_H
+#define _LLVNETWORK_H
+
+#define _XOPEN_SOURCE 500
+
+#ifdef __GNUC__
+#define UNUSED __attribute__ ((unused))
+#else
+#define UNUSED
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include <string.h>
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spline.h>
+
+#include "constants.h"
+#include "struct.h"
+#include "timeconversion.h"
+#include "LLVgeometry.h"
+#include "LLVnoise.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#elif 0
+} /* so that editors will match preceding brace */
+#endif
+
+/* Maximal number of detectors in a network */
+#define LLV_NDETMAX 8
+
+/********************************************************/
+/**************** Type definitions **********************/
+
+/* Description of a ground-based detector - adding a detector to the networks only requires a new instance */
+typedef struct tagLLVDetector {
+  char letter;                 /* One-letter code of the detector in the network strings */
+  const char* name;            /* Name of the detector */
+  double location[3];          /* Position of the vertex in the Earth-centered frame (m) */
+  double armx[3];              /* Unit vector along the x arm in the Earth-centered frame */
+  double army[3];              /* Unit vector along the y arm in the Earth-centered frame */
+  const char* noisefile;       /* File of the noise data (frequency, sqrt(Sn)), in $LLV_NOISE_DATA_PATH */
+} LLVDetector;
+
+/* Detectors known to the networks */
+extern LLVDetector LLVDetectorLHO;
+extern LLVDetector LLVDetectorLLO;
+extern LLVDetector LLVDetectorVIRGO;
+extern LLVDetector LLVDetectorKAGRA;
+extern LLVDetector LLVDetectorLIGOIndia;
+
+/* Network of detectors, with the quantities shared by all signals */
+typedef struct tagLLVNetwork {
+  int ndet;                                 /* Number of detectors */
+  const LLVDetector* detectors[LLV_NDETMAX]; /* Detectors of the network */
+  double D[LLV_NDETMAX][3][3];              /* Response tensors D = (nx nx - ny ny)/2 of the detectors */
+  const LLVNoiseTable* noise[LLV_NDETMAX];  /* Noise PSD of the detectors, shared between detectors with the same noise curve - NULL until LLVNetwork_InitNoise */
+  int gmstcache;                            /* Flag indicating that the linearized GMST angle below can be used */
+  double gmsttime;                          /* Center of the time range of the GMST cache (GPS time, s) */
+  double gmsthalfwidth;                     /* Half-width of the time range of the GMST cache (s) */
+  double gmst0;                             /* GMST angle at gmsttime (rad) */
+  double gmstrate;                          /* Rate of the GMST angle (rad/s) */
+} LLVNetwork;
+
+/**************************************************/
+/**************** Prototypes **********************/
+
+/* Response tensor D = (nx nx - ny ny)/2 of a detector */
+void LLVDetector_ResponseTensor(double D[3][3], const LLVDetector* detector);
+
+/* Function building a network from a string of one-letter codes, e.g. "HLV" */
+/* H: LIGO Hanford, L: LIGO Livingston, V: VIRGO, K: KAGRA, I: LIGO India */
+int LLVNetwork_Init(LLVNetwork** network, const char* string);
+/* Same, filling an existing structure without allocation (e.g. on the stack) - the noise is not loaded, LLVNetwork_Cleanup must not be called */
+int LLVNetwork_Set(LLVNetwork* network, const char* string);
+void LLVNetwork_Cleanup(LLVNetwork* network);
+
+/* Function loading the noise PSD of each detector of the network */
+int LLVNetwork_InitNoise(LLVNetwork* network);
+
+/* Noise PSD of the detector k of the network, in the form used by the overlaps */
+ObjectFunction LLVNetwork_NoiseFunction(const LLVNetwork* network, const int k);
+
+/* Function setting up a linearized GMST angle for the times in [gpstime-halfwidth, gpstime+halfwidth], e.g. the prior range of tRef */
+/* The cache is not used if the range contains a leap second - the exact conversion is then used for all times */
+int LLVNetwork_InitGMSTCache(LLVNetwork* network, const double gpstime, const double halfwidth);
+/* GMST angle (rad) at a given GPS time (s) - linearized within the range of the cache, exact outside */
+double LLVNetwork_GMST(const LLVNetwork* network, const double gpstime);
+
+#if 0
+{ /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif /* _LLVNETWORK_H */
@@ -59,10 +59,6 @@ double __LLVSimFD_VIRGONoise_fLow = 0;
 double __LLVSimFD_VIRGONoise_fHigh = 0;
 int __LLVSimFD_Noise_setup = FAILURE;
 
-/* The number of points in the noise data files - required as the Read_Vector function needs a gsl vector already initialized to the right length */
-//#define noisedata_pts 3000
-#define noisedata_pts 16365
-
 /**************************************************************/
 /****** Functions loading and evaluating the noise PSD  *******/
 
@@ -102,20 +98,19 @@ int LLVSimFD_Noise_Init(const char dir[]) {
     exit(1);
   }
 
-  /* Loading noise data in gsl_vectors */
+  /* Loading noise data in gsl_vectors - the number of points is read from the files */
+  /* LHO and LLO have the same noise curve - it is loaded once, and the spline shared by the two detectors */
   int ret = SUCCESS;
-  gsl_matrix* noise_LHO = gsl_matrix_alloc(noisedata_pts, 2);
-  gsl_matrix* noise_LLO = gsl_matrix_alloc(noisedata_pts, 2);
-  gsl_matrix* noise_VIRGO = gsl_matrix_alloc(noisedata_pts, 2);
+  gsl_matrix* noise_LIGO = NULL;
+  gsl_matrix* noise_VIRGO = NULL;
   char* file_LIGO = malloc(strlen(dir)+64);
   char* file_VIRGO = malloc(strlen(dir)+64);
   //sprintf(file_LIGO, "%s", "LIGO-P1200087-v18-aLIGO_DESIGN.txt");
   //sprintf(file_VIRGO, "%s", "LIGO-P1200087-v18-AdV_DESIGN.txt");
   sprintf(file_LIGO, "%s", "aLIGO_sensitivity.dat");
   sprintf(file_VIRGO, "%s", "aVirgo_sensitivity.dat");
-  ret |= Read_Text_Matrix(dir, file_LIGO, noise_LHO);
-  ret |= Read_Text_Matrix(dir, file_LIGO, noise_LLO);
-  ret |= Read_Text_Matrix(dir, file_VIRGO, noise_VIRGO);
+  ret |= Read_Text_Table(&noise_LIGO, dir, file_LIGO, 0, 2);
+  ret |= Read_Text_Table(&noise_VIRGO, dir, file_VIRGO, 0, 2);
 
   if(ret==FAILURE) {
     printf("Error: problem reading LLV noise data.");
@@ -125,44 +120,38 @@ int LLVSimFD_Noise_Init(const char dir[]) {
   /* Linear interpolation of the data, after setting the gsl_spline structures */
   else if(ret==SUCCESS) {
     /* Extracting te vectors for the frequencies and data */
-    gsl_vector* noise_LHO_freq = gsl_vector_alloc(noisedata_pts);
-    gsl_vector* noise_LLO_freq = gsl_vector_alloc(noisedata_pts);
-    gsl_vector* noise_VIRGO_freq = gsl_vector_alloc(noisedata_pts);
-    gsl_vector* noise_LHO_data = gsl_vector_alloc(noisedata_pts);
-    gsl_vector* noise_LLO_data = gsl_vector_alloc(noisedata_pts);
-    gsl_vector* noise_VIRGO_data = gsl_vector_alloc(noisedata_pts);
-    gsl_matrix_get_col(noise_LHO_freq, noise_LHO, 0);
-    gsl_matrix_get_col(noise_LLO_freq, noise_LLO, 0);
+    int nLIGO = noise_LIGO->size1;
+    int nVIRGO = noise_VIRGO->size1;
+    gsl_vector* noise_LIGO_freq = gsl_vector_alloc(nLIGO);
+    gsl_vector* noise_VIRGO_freq = gsl_vector_alloc(nVIRGO);
+    gsl_vector* noise_LIGO_data = gsl_vector_alloc(nLIGO);
+    gsl_vector* noise_VIRGO_data = gsl_vector_alloc(nVIRGO);
+    gsl_matrix_get_col(noise_LIGO_freq, noise_LIGO, 0);
     gsl_matrix_get_col(noise_VIRGO_freq, noise_VIRGO, 0);
-    gsl_matrix_get_col(noise_LHO_data, noise_LHO, 1);
-    gsl_matrix_get_col(noise_LLO_data, noise_LLO, 1);
+    gsl_matrix_get_col(noise_LIGO_data, noise_LIGO, 1);
     gsl_matrix_get_col(noise_VIRGO_data, noise_VIRGO, 1);
     /* Setting the global variables that indicate the range in frequency of these splines */
-    __LLVSimFD_LHONoise_fLow = gsl_vector_get(noise_LHO_freq, 0);
-    __LLVSimFD_LHONoise_fHigh = gsl_vector_get(noise_LHO_freq, noise_LHO_freq->size - 1);
-    __LLVSimFD_LLONoise_fLow = gsl_vector_get(noise_LLO_freq, 0);
-    __LLVSimFD_LLONoise_fHigh = gsl_vector_get(noise_LLO_freq, noise_LLO_freq->size - 1);
+    __LLVSimFD_LHONoise_fLow = gsl_vector_get(noise_LIGO_freq, 0);
+    __LLVSimFD_LHONoise_fHigh = gsl_vector_get(noise_LIGO_freq, noise_LIGO_freq->size - 1);
+    __LLVSimFD_LLONoise_fLow = __LLVSimFD_LHONoise_fLow;
+    __LLVSimFD_LLONoise_fHigh = __LLVSimFD_LHONoise_fHigh;
     __LLVSimFD_VIRGONoise_fLow = gsl_vector_get(noise_VIRGO_freq, 0);
     __LLVSimFD_VIRGONoise_fHigh = gsl_vector_get(noise_VIRGO_freq, noise_VIRGO_freq->size - 1);
-    /* Initializing the splines and accelerators */
-    *__LLVSimFD_LHONoiseSpline = gsl_spline_alloc(gsl_interp_linear, noisedata_pts);
-    *__LLVSimFD_LLONoiseSpline = gsl_spline_alloc(gsl_interp_linear, noisedata_pts);
-    *__LLVSimFD_VIRGONoiseSpline = gsl_spline_alloc(gsl_interp_linear, noisedata_pts);
+    /* Initializing the splines and accelerators - shared by LHO and LLO */
+    *__LLVSimFD_LHONoiseSpline = gsl_spline_alloc(gsl_interp_linear, nLIGO);
+    *__LLVSimFD_VIRGONoiseSpline = gsl_spline_alloc(gsl_interp_linear, nVIRGO);
     *__LLVSimFD_LHONoiseAccel = gsl_interp_accel_alloc();
-    *__LLVSimFD_LLONoiseAccel = gsl_interp_accel_alloc();
     *__LLVSimFD_VIRGONoiseAccel = gsl_interp_accel_alloc();
-    gsl_spline_init(*__LLVSimFD_LHONoiseSpline, gsl_vector_const_ptr(noise_LHO_freq, 0), gsl_vector_const_ptr(noise_LHO_data, 0), noisedata_pts);
-    gsl_spline_init(*__LLVSimFD_LLONoiseSpline, gsl_vector_const_ptr(noise_LLO_freq, 0), gsl_vector_const_ptr(noise_LLO_data, 0), noisedata_pts);
-    gsl_spline_init(*__LLVSimFD_VIRGONoiseSpline, gsl_vector_const_ptr(noise_VIRGO_freq, 0), gsl_vector_const_ptr(noise_VIRGO_data, 0), noisedata_pts);
+    gsl_spline_init(*__LLVSimFD_LHONoiseSpline, gsl_vector_const_ptr(noise_LIGO_freq, 0), gsl_vector_const_ptr(noise_LIGO_data, 0), nLIGO);
+    gsl_spline_init(*__LLVSimFD_VIRGONoiseSpline, gsl_vector_const_ptr(noise_VIRGO_freq, 0), gsl_vector_const_ptr(noise_VIRGO_data, 0), nVIRGO);
+    *__LLVSimFD_LLONoiseSpline = *__LLVSimFD_LHONoiseSpline;
+    *__LLVSimFD_LLONoiseAccel = *__LLVSimFD_LHONoiseAccel;
     /* Setting the global tag to success and clean up */
-    gsl_matrix_free(noise_LHO);
-    gsl_matrix_free(noise_LLO);
+    gsl_matrix_free(noise_LIGO);
     gsl_matrix_free(noise_VIRGO);
-    gsl_vector_free(noise_LHO_freq);
-    gsl_vector_free(noise_LLO_freq);
+    gsl_vector_free(noise_LIGO_freq);
     gsl_vector_free(noise_VIRGO_freq);
-    gsl_vector_free(noise_LHO_data);
-    gsl_vector_free(noise_LLO_data);
+    gsl_vector_free(noise_LIGO_data);
     gsl_vector_free(noise_VIRGO_data);
     __LLVSimFD_Noise_setup = SUCCESS;
   }
@@ -213,3 +202,117 @@ double NoiseSnVIRGO(const double f) {
     return sqrtSn * sqrtSn;
   }
 }
+
+/**************************************************************/
+/****** Noise PSD tables, shared between detectors ************/
+
+/* Registry of the noise tables - each file is loaded once, and its table shared by all the detectors using the same noise curve */
+#define LLV_NOISEREGISTRY_MAX 16
+typedef struct tagLLVNoiseRegistryEntry {
+  char file[256];              /* Name of the noise file */
+  LLVNoiseTable* table;        /* Table loaded from the file */
+  int nref;                    /* Number of users of the table */
+} LLVNoiseRegistryEntry;
+static LLVNoiseRegistryEntry LLVNoiseRegistry[LLV_NOISEREGISTRY_MAX];
+static int LLVNoiseRegistry_size = 0;
+
+/* Function loading a table of sqrt(Sn) from a file, looked for in the directories of $LLV_NOISE_DATA_PATH */
+static LLVNoiseTable* LLVNoiseTable_Load(const char file[])
+{
+  char *envpath = NULL;
+  char path[32768];
+  char *brkt, *word;
+  envpath = getenv("LLV_NOISE_DATA_PATH");
+  if(!envpath) {
+    printf("Error: the environment variable LLV_NOISE_DATA_PATH, giving the path to the noise data, seems undefined\n");
+    exit(1);
+  }
+  strncpy(path, envpath, sizeof(path));
+
+  int ret = FAILURE;
+  gsl_matrix* noise = NULL;
+  for(word=strtok_r(path,":",&brkt); word; word=strtok_r(NULL,":",&brkt))
+  {
+    ret = Read_Text_Table(&noise, word, file, 0, 2);
+    if(ret == SUCCESS) break;
+  }
+  if(ret!=SUCCESS) {
+    printf("Error: unable to find the LLV noise data file %s in $LLV_NOISE_DATA_PATH\n", file);
+    exit(1);
+  }
+
+  /* Linear interpolation of sqrt(Sn) - gsl_spline_init copies the data */
+  int n = noise->size1;
+  gsl_vector* noise_freq = gsl_vector_alloc(n);
+  gsl_vector* noise_data = gsl_vector_alloc(n);
+  gsl_matrix_get_col(noise_freq, noise, 0);
+  gsl_matrix_get_col(noise_data, noise, 1);
+  LLVNoiseTable* table = malloc(sizeof(LLVNoiseTable));
+  table->fLow = gsl_vector_get(noise_freq, 0);
+  table->fHigh = gsl_vector_get(noise_freq, n - 1);
+  table->spline = gsl_spline_alloc(gsl_interp_linear, n);
+  gsl_spline_init(table->spline, gsl_vector_const_ptr(noise_freq, 0), gsl_vector_const_ptr(noise_data, 0), n);
+
+  gsl_matrix_free(noise);
+  gsl_vector_free(noise_freq);
+  gsl_vector_free(noise_data);
+  return table;
+}
+
+/* Function returning the table of a noise file, loading it on the first call - the same table is returned for the same file */
+const LLVNoiseTable* LLVNoiseTable_Get(const char file[])
+{
+  for(int i=0; i<LLVNoiseRegistry_size; i++) {
+    if(strcmp(LLVNoiseRegistry[i].file, file)==0) {
+      LLVNoiseRegistry[i].nref++;
+      return LLVNoiseRegistry[i].table;
+    }
+  }
+  if(LLVNoiseRegistry_size==LLV_NOISEREGISTRY_MAX || strlen(file)>=sizeof(LLVNoiseRegistry[0].file)) {
+    printf("Error in LLVNoiseTable_Get: cannot register the noise file %s.\n", file);
+    exit(1);
+  }
+  LLVNoiseRegistryEntry* entry = &(LLVNoiseRegistry[LLVNoiseRegistry_size++]);
+  strcpy(entry->file, file);
+  entry->table = LLVNoiseTable_Load(file);
+  entry->nref = 1;
+  return entry->table;
+}
+/* Function releasing a table obtained from LLVNoiseTable_Get - freed when it has no more users */
+void LLVNoiseTable_Release(const LLVNoiseTable* table)
+{
+  for(int i=0; i<LLVNoiseRegistry_size; i++) {
+    if(LLVNoiseRegistry[i].table!=table) continue;
+    if(--LLVNoiseRegistry[i].nref>0) return;
+    gsl_spline_free(LLVNoiseRegistry[i].table->spline);
+    free(LLVNoiseRegistry[i].table);
+    LLVNoiseRegistry[i] = LLVNoiseRegistry[--LLVNoiseRegistry_size];
+    return;
+  }
+  printf("Error in LLVNoiseTable_Release: table not found in the registry.\n");
+  exit(1);
+}
+
+/* Noise PSD Sn(f) from a table - INFINITY outside of the range of the table */
+/* No accelerator: the table is shared by the threads, and a gsl_interp_accel is mutable - the interval is found by binary search */
+double LLVNoiseTable_Sn(const LLVNoiseTable* table, const double f)
+{
+  if ((f < table->fLow) || (f > table->fHigh)) {
+    return INFINITY;
+  }
+  else {
+    double sqrtSn = gsl_spline_eval(table->spline, f, NULL);
+    return sqrtSn * sqrtSn;
+  }
+}
+
+/* Noise PSD of a table wrapped as ObjectFunction, as used by the overlaps */
+static double LLVNoiseTableObject(const void* object, const double f)
+{
+  return LLVNoiseTable_Sn((const LLVNoiseTable*) object, f);
+}
+ObjectFunction LLVNoiseTableFunction(const LLVNoiseTable* table)
+{
+  ObjectFunction fn = {table, LLVNoiseTableObject};
+  return fn;
+}
@@ -35,6 +35,7 @@
 #include <gsl/gsl_complex.h>
 
 #include "constants.h"
+#include "struct.h"
 
 
 /************************************************************************/
@@ -60,6 +61,28 @@ double NoiseSnLHO(const double f);
 double NoiseSnLLO(const double f);
 double NoiseSnVIRGO(const double f);
 
+/**************************************************************************/
+/****** Noise PSD tables, shared between detectors  *******/
+
+/* Noise PSD of a detector, linearly interpolated from a table of sqrt(Sn) - shared by all the detectors with the same noise curve */
+/* Read-only after loading, so that the same table can be evaluated by several threads - hence no interpolation accelerator */
+typedef struct tagLLVNoiseTable {
+  gsl_spline* spline;          /* Linear interpolation of sqrt(Sn) */
+  double fLow;                 /* Lowest frequency of the table (Hz) */
+  double fHigh;                /* Highest frequency of the table (Hz) */
+} LLVNoiseTable;
+
+/* Function returning the table of sqrt(Sn) of a noise file, looked for in the directories of $LLV_NOISE_DATA_PATH */
+/* Each file is loaded once - all the calls for the same file return the same table, counted as one more user */
+const LLVNoiseTable* LLVNoiseTable_Get(const char file[]);
+/* Function releasing a table obtained from LLVNoiseTable_Get - freed when it has no more users */
+void LLVNoiseTable_Release(const LLVNoiseTable* table);
+
+/* Noise PSD Sn(f) from a table - INFINITY outside of the range of the table */
+double LLVNoiseTable_Sn(const LLVNoiseTable* table, const double f);
+/* Noise PSD of a table, in the form used by the overlaps */
+ObjectFunction LLVNoiseTableFunction(const LLVNoiseTable* table);
+
 #if 0
 { /* so that editors will match succeeding brace */
 #elif defined(__cplusplus)
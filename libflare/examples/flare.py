@@ -1,7 +1,7 @@
 """Python interface to FLARE."""
 
 import numpy as np
-from ctypes import cdll, Structure, c_double, c_int, c_void_p, byref
+from ctypes import cdll, Structure, POINTER, c_double, c_int, c_void_p, byref
 
 
 class LISAParams(Structure):
@@ -28,11 +28,27 @@ class LISAParams(Structure):
             self.nbmode = p['n_modes']
 
 
+class LISAconstellation(Structure):
+    _fields_ = [('OrbitOmega', c_double),
+                ('OrbitPhi0', c_double),
+                ('OrbitR', c_double),
+                ('ConstOmega', c_double),
+                ('ConstPhi0', c_double),
+                ('ConstL', c_double),
+                ('noise', c_int)]
+
+# values of the TDItag and ResponseApproxtag enums in LISAgeometry.h
+TDI_TAGS = {'TDIXYZ': 3, 'TDIAETXYZ': 5, 'TDIAXYZ': 9, 'TDIEXYZ': 10, 'TDITXYZ': 11}
+RESPONSE_APPROX_TAGS = {'full': 0, 'lowfL': 1, 'lowf': 2}
+
+
 lib = cdll.LoadLibrary("libflare.so.1.0.0")
 
 # tell ctypes the return types for the functions we'll use
 lib.CalculateLogLReIm.restype = c_double
 lib.CalculateOverlapReIm.restype = c_double
+lib.LuminosityDistance.restype = c_double
+lib.LuminosityDistance.argtypes = [c_double]
 
 # must initialize flare's global internal variables first
 lib.InitGlobalParams()
@@ -67,4 +83,218 @@ def calculate_overlap_reim(params1, params2, injection):
     p1 = LISAParams(params1)
     p2 = LISAParams(params2)
 
-    return lib.CalculateOverlapReIm(p1, p2, injection)
\ No newline at end of file
+    return lib.CalculateOverlapReIm(p1, p2, injection)
+
+def _as_c_array(a):
+    a = np.ascontiguousarray(a, dtype=np.float64)
+    return a, a.ctypes.data_as(POINTER(c_double))
+
+class SkyAveragedResponse(object):
+    """Noise-weighted LISA response power tabulated over samples of sky
+    position, polarization, inclination and merger time, for each mode, as a
+    function of frequency and time to merger. Build it once and reuse it for
+    all the mass and redshift grids.
+    """
+    def __init__(self, variant='LISAProposal', tdi='TDIAETXYZ',
+                 response_approx='full', n_modes=5, n_sky=256, f_min=1e-5,
+                 f_max=0.5, n_freq=128, deltatobs=5., n_tau=64):
+        self.handle = c_void_p(None)
+        self.variant = LISAconstellation.in_dll(lib, variant)
+        ret = lib.LISASkyAveragedResponse_Init(
+            byref(self.handle), byref(self.variant), c_int(TDI_TAGS[tdi]),
+            c_int(RESPONSE_APPROX_TAGS[response_approx]), c_int(n_modes),
+            c_int(n_sky), c_double(f_min), c_double(f_max), c_int(n_freq),
+            c_double(deltatobs), c_int(n_tau))
+        if ret != 0:
+            raise ValueError("could not build the sky-averaged response")
+
+    def __del__(self):
+        if self.handle:
+            lib.LISASkyAveragedResponse_Cleanup(self.handle)
+            self.handle = c_void_p(None)
+
+    def snr_grid(self, Mtot, q, z, percentiles=(10., 50., 90.), f_min=1e-5,
+                 f_max=0.5, extend_pn=True, Mf_match=0.01):
+        """Mean and percentile SNRs over the samples, for grids of redshifted
+        total mass, mass ratio and redshift. Returns arrays of shape
+        (nM, nq, nz) and (nM, nq, nz, npercentiles), NaN where the ROM failed.
+        """
+        Mtot, Mtot_p = _as_c_array(Mtot)
+        q, q_p = _as_c_array(q)
+        z, z_p = _as_c_array(z)
+        percentiles, perc_p = _as_c_array(percentiles)
+        shape = (len(Mtot), len(q), len(z))
+        snrmean, snrmean_p = _as_c_array(np.zeros(shape))
+        snrperc, snrperc_p = _as_c_array(np.zeros(shape + (len(percentiles),)))
+        ret = lib.LISAHorizonSNRGrid(
+            snrmean_p, snrperc_p, self.handle, Mtot_p, c_int(len(Mtot)),
+            q_p, c_int(len(q)), z_p, c_int(len(z)), perc_p,
+            c_int(len(percentiles)), c_double(f_min), c_double(f_max),
+            c_int(int(extend_pn)), c_double(Mf_match))
+        if ret != 0:
+            raise ValueError("could not compute the SNR grid")
+        return snrmean, snrperc
+
+def luminosity_distance(z):
+    """Luminosity distance in Mpc (flat LambdaCDM, Planck 2015)."""
+    return lib.LuminosityDistance(z)
+
+# persistent-handle API of flare.h: parameters are passed as arrays with one
+# row per source, columns in the order of the params files - float64
+# C-contiguous arrays are passed without copy, and the results are written
+# into caller-provided arrays; none of these calls touches the globals above
+PARAM_COLUMNS = ('mass1', 'mass2', 'tRef', 'distance', 'phase', 'inclination',
+                 'lambda', 'beta', 'polarization')
+
+_double_p = POINTER(c_double)
+lib.FlareROM_Init.argtypes = [POINTER(c_void_p), c_int, c_double, c_int,
+                              c_double, c_int]
+lib.FlareNoise_Init.argtypes = [POINTER(c_void_p), POINTER(LISAconstellation),
+                                c_int, c_double, c_double, c_double, c_int,
+                                c_int, c_int]
+lib.FlareInjection_Init.argtypes = [POINTER(c_void_p), c_void_p, c_void_p,
+                                    _double_p, c_int]
+lib.FlareInjection_SNR.argtypes = [c_void_p]
+lib.FlareInjection_SNR.restype = c_double
+lib.FlareWorkspace_Init.argtypes = [POINTER(c_void_p), c_int]
+lib.FlareLogLikelihood.argtypes = [_double_p, c_void_p, c_void_p, _double_p,
+                                   c_int]
+lib.FlareSNR.argtypes = [_double_p, c_void_p, c_void_p, c_void_p, _double_p,
+                         c_int]
+for _name in ('FlareROM', 'FlareNoise', 'FlareInjection', 'FlareWorkspace'):
+    getattr(lib, _name + '_Cleanup').argtypes = [c_void_p]
+
+def _as_rows(params):
+    params = np.ascontiguousarray(params, dtype=np.float64)
+    if params.ndim == 1:
+        params = params[np.newaxis, :]
+    if params.ndim != 2 or params.shape[1] != len(PARAM_COLUMNS):
+        raise ValueError("parameters must have %d columns" % len(PARAM_COLUMNS))
+    return params
+
+def _as_output(out, n):
+    if out is None:
+        return np.empty(n)
+    if (out.dtype != np.float64 or out.shape != (n,)
+            or not out.flags['C_CONTIGUOUS']):
+        raise ValueError("output must be a contiguous float64 array of %d values" % n)
+    return out
+
+class _Handle(object):
+    _cleanup = None
+
+    def __del__(self):
+        if self.handle:
+            getattr(lib, self._cleanup)(self.handle)
+            self.handle = c_void_p(None)
+
+class ROM(_Handle):
+    """ROM data (loaded once from $ROM_DATA_PATH) and settings of the
+    waveform generation of the templates."""
+    _cleanup = 'FlareROM_Cleanup'
+
+    def __init__(self, n_modes=5, f_ref=0., extend_pn=True, Mf_match=0.,
+                 set_phi_ref_at_f_ref=True):
+        self.handle = c_void_p(None)
+        self.n_modes = n_modes
+        if lib.FlareROM_Init(byref(self.handle), n_modes, f_ref,
+                             int(extend_pn), Mf_match,
+                             int(set_phi_ref_at_f_ref)) != 0:
+            raise ValueError("could not set up the ROM")
+
+class Noise(_Handle):
+    """LISA variant and TDI channels, band and duration of the observation,
+    approximations of the response."""
+    _cleanup = 'FlareNoise_Cleanup'
+
+    def __init__(self, variant='LISAProposal', tdi='TDIAETXYZ', f_min=0.,
+                 f_max=1., deltatobs=2., tref_at_lisa=False, frozen_lisa=False,
+                 response_approx='full'):
+        self.handle = c_void_p(None)
+        if lib.FlareNoise_Init(byref(self.handle),
+                               byref(LISAconstellation.in_dll(lib, variant)),
+                               TDI_TAGS[tdi], f_min, f_max, deltatobs,
+                               int(tref_at_lisa), int(frozen_lisa),
+                               RESPONSE_APPROX_TAGS[response_approx]) != 0:
+            raise ValueError("could not set up the noise")
+
+class Injection(_Handle):
+    """Injected signal, pre-interpolated once for all the likelihoods."""
+    _cleanup = 'FlareInjection_Cleanup'
+
+    def __init__(self, rom, noise, params, n_modes=5):
+        self.handle = c_void_p(None)
+        params = _as_rows(params)
+        if lib.FlareInjection_Init(byref(self.handle), rom.handle,
+                                   noise.handle, params.ctypes.data_as(_double_p),
+                                   n_modes) != 0:
+            raise ValueError("could not generate the injection")
+
+    @property
+    def snr(self):
+        return lib.FlareInjection_SNR(self.handle)
+
+class Workspace(_Handle):
+    """Temporaries of the batched calls - use one per Python thread."""
+    _cleanup = 'FlareWorkspace_Cleanup'
+
+    def __init__(self, n_threads=0):
+        self.handle = c_void_p(None)
+        lib.FlareWorkspace_Init(byref(self.handle), n_threads)
+
+def loglikelihood(injection, workspace, params, out=None):
+    """Log-likelihoods of the rows of params against the injection, written
+    into out if given. The GIL is released during the call."""
+    params = _as_rows(params)
+    out = _as_output(out, len(params))
+    lib.FlareLogLikelihood(out.ctypes.data_as(_double_p), injection.handle,
+                           workspace.handle, params.ctypes.data_as(_double_p),
+                           len(params))
+    return out
+
+def snr(rom, noise, workspace, params, out=None):
+    """Optimal SNRs of the rows of params, NaN where the generation failed."""
+    params = _as_rows(params)
+    out = _as_output(out, len(params))
+    lib.FlareSNR(out.ctypes.data_as(_double_p), rom.handle, noise.handle,
+                 workspace.handle, params.ctypes.data_as(_double_p),
+                 len(params))
+    return out
+
+# bare ROM modes on a frequency grid: rows of (m1, m2, tRef, distance, phase)
+ROM_PARAM_COLUMNS = ('mass1', 'mass2', 'tRef', 'distance', 'phase')
+WAVEFORM_FORMATS = {'ampphase': 0, 'reim': 1}
+
+lib.FlareROMWaveforms.argtypes = [_double_p, _double_p, c_void_p, c_void_p,
+                                  _double_p, c_int, _double_p, c_int, c_int]
+
+def rom_waveforms(rom, workspace, params, freq, format='ampphase', out=None):
+    """Modes of the ROM for each row of params, on the increasing frequency
+    grid freq. Returns two arrays of shape (N, n_modes, n_freq): amplitude
+    and phase, or real and imaginary parts - zero outside of the range of
+    each mode, NaN for the rows where the ROM failed. Passing out=(a, b)
+    writes into preallocated float64 C-contiguous arrays without copy.
+    """
+    params = np.ascontiguousarray(params, dtype=np.float64)
+    if params.ndim == 1:
+        params = params[np.newaxis, :]
+    if params.ndim != 2 or params.shape[1] != len(ROM_PARAM_COLUMNS):
+        raise ValueError("parameters must have %d columns" % len(ROM_PARAM_COLUMNS))
+    freq = np.ascontiguousarray(freq, dtype=np.float64)
+    n_modes = rom.n_modes
+    shape = (len(params), n_modes, len(freq))
+    if out is None:
+        out = (np.empty(shape), np.empty(shape))
+    for a in out:
+        if (a.dtype != np.float64 or a.shape != shape
+                or not a.flags['C_CONTIGUOUS']):
+            raise ValueError("outputs must be contiguous float64 arrays of shape %s" % (shape,))
+    ret = lib.FlareROMWaveforms(out[0].ctypes.data_as(_double_p),
+                                out[1].ctypes.data_as(_double_p), rom.handle,
+                                workspace.handle,
+                                params.ctypes.data_as(_double_p), len(params),
+                                freq.ctypes.data_as(_double_p), len(freq),
+                                WAVEFORM_FORMATS[format])
+    if ret < 0:
+        raise ValueError("frequencies must be strictly increasing")
+    return out
@@ -0,0 +1,38 @@
+import threading
+import numpy as np
+import flare
+
+
+rom = flare.ROM(n_modes=1)
+noise = flare.Noise(deltatobs=1.)
+
+# rows of (m1, m2, tRef, distance, phase, inclination, lambda, beta, polarization)
+inj = np.array([2e6, 1e6, 0., 40e3, 1.3, 0.6459, 3.4435, -0.073604, 1.7436])
+injection = flare.Injection(rom, noise, inj, n_modes=1)
+print("injection SNR: %g" % injection.snr)
+
+# an ensemble of walkers around the injection, evaluated in one call
+nwalkers = 64
+walkers = np.tile(inj, (nwalkers, 1))
+walkers[:, 0] *= 1 + 1e-4 * np.random.randn(nwalkers)
+walkers[:, 1] *= 1 + 1e-4 * np.random.randn(nwalkers)
+workspace = flare.Workspace()
+logl = np.empty(nwalkers)
+flare.loglikelihood(injection, workspace, walkers, out=logl)
+print("ensemble logL: min %g, max %g" % (logl.min(), logl.max()))
+
+# the same from concurrent Python threads, each with its own workspace
+def run(rows, out):
+    flare.loglikelihood(injection, flare.Workspace(n_threads=1), rows, out=out)
+
+logl_threads = np.empty(nwalkers)
+chunks = [np.empty(len(walkers[i::4])) for i in range(4)]
+threads = [threading.Thread(target=run, args=(walkers[i::4], chunks[i]))
+           for i in range(4)]
+for t in threads:
+    t.start()
+for t in threads:
+    t.join()
+for i in range(4):
+    logl_threads[i::4] = chunks[i]
+print("max difference between the two: %g" % np.abs(logl - logl_threads).max())
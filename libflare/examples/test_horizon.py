@@ -0,0 +1,21 @@
+import numpy as np
+import pylab as pl
+import flare
+
+
+# table of the averaged response, shared by all masses and redshifts
+response = flare.SkyAveragedResponse(n_sky=256, deltatobs=5.)
+
+# SNRs over a grid of redshifted total masses and redshifts, for q=2
+Mtot = 1e4 * 10**(np.arange(19) / 3.)
+q = [2.]
+z = 10**np.linspace(-1, 1.3, 24)
+snrmean, snrperc = response.snr_grid(Mtot, q, z, percentiles=[10., 50., 90.])
+
+# plot the median SNR
+pl.contourf(np.log10(Mtot), np.log10(z), np.log10(snrperc[:, 0, :, 1]).T, 50, cmap='gnuplot2_r')
+pl.colorbar(label='log10(median SNR)')
+pl.contour(np.log10(Mtot), np.log10(z), snrperc[:, 0, :, 1].T, [10., 100., 1000.], colors='k')
+pl.xlabel('log10(M/Msun) (redshifted)')
+pl.ylabel('log10(z)')
+pl.show()
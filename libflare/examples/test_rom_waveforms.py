@@ -0,0 +1,32 @@
+import numpy as np
+import pylab as pl
+import flare
+
+
+rom = flare.ROM(n_modes=5)
+workspace = flare.Workspace()
+
+# a training set of random masses and distances, on a log grid of frequencies
+n = 1000
+Mtot = 10**np.random.uniform(5., 7., n)
+q = np.random.uniform(1., 10., n)
+params = np.zeros((n, 5))
+params[:, 0] = Mtot * q / (1 + q)
+params[:, 1] = Mtot / (1 + q)
+params[:, 3] = np.random.uniform(1e3, 1e5, n)
+params[:, 4] = np.random.uniform(0., 2*np.pi, n)
+freq = np.logspace(-5, 0, 2048)
+
+# preallocated buffers, filled in place
+amp = np.empty((n, 5, len(freq)))
+phase = np.empty((n, 5, len(freq)))
+flare.rom_waveforms(rom, workspace, params, freq, out=(amp, phase))
+print("failed: %d" % np.isnan(amp[:, 0, 0]).sum())
+
+# plot the amplitude of the modes of the first waveform
+for i, lm in enumerate(['22', '21', '33', '44', '55']):
+    pl.loglog(freq, amp[0, i], label=lm)
+pl.legend()
+pl.xlabel('f (Hz)')
+pl.ylabel('|h_lm|')
+pl.show()
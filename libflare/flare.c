@@ -0,0 +1,409 @@
+#include "flare.h"
+#include "omp.h"
+
+/* Initial size of the arenas of the workspace - they grow after the first cycles that overflow */
+#define FLARE_ARENA_SIZE (16*1024*1024)
+
+struct tagFlareROM {
+  int nbmode;                /* Number of modes of the templates */
+  double fRef;               /* Reference frequency (Hz) */
+  int tagextpn;              /* Tag to extend the ROM to low frequencies with TaylorF2 */
+  double Mfmatch;            /* Geometric matching frequency when extending */
+  int setphiRefatfRef;       /* Flag for adjusting the FD phase at phiRef at the given fRef */
+};
+
+struct tagFlareNoise {
+  LISAconstellation variant; /* Copy of the description of LISA variant */
+  TDItag tagtdi;             /* Selector for the set of TDI observables */
+  double minf;               /* Minimal frequency (Hz) */
+  double maxf;               /* Maximal frequency (Hz) */
+  double deltatobs;          /* Duration of the observation (years) */
+  int tagtRefatLISA;         /* Tag to reference the time to the arrival at LISA */
+  int frozenLISA;            /* Tag for treating LISA as frozen */
+  ResponseApproxtag responseapprox; /* Approximation used in the response */
+};
+
+struct tagFlareInjection {
+  LISAParams params;         /* Parameters of the injection */
+  FlareNoise noise;          /* Copy of the noise settings, pointed to by settings */
+  LISAGlobalParams settings; /* Settings of the generation, shared by the templates */
+  ListmodesCAmpPhaseSpline* splines1; /* Injection in the TDI channel 1, splines for each mode */
+  ListmodesCAmpPhaseSpline* splines2; /* Injection in the TDI channel 2, splines for each mode */
+  ListmodesCAmpPhaseSpline* splines3; /* Injection in the TDI channel 3, splines for each mode */
+  double ss;                 /* Inner product (s|s) for TDI channels 123 */
+  double fstartobs;          /* Starting frequency of the injection for the duration of the observation */
+};
+
+struct tagFlareWorkspace {
+  int nthreads;              /* Number of threads of the batches */
+  Arena** arenas;            /* One arena per thread */
+};
+
+/* Row of a parameter array to LISAParams */
+static void FlareParamsFromRow(LISAParams* params, const double* row, const int nbmode)
+{
+  params->m1 = row[0];
+  params->m2 = row[1];
+  params->tRef = row[2];
+  params->distance = row[3];
+  params->phiRef = row[4];
+  params->inclination = row[5];
+  params->lambda = row[6];
+  params->beta = row[7];
+  params->polarization = row[8];
+  params->nbmode = nbmode;
+}
+
+/* Settings of the generation in the form expected by LISAGenerateSignalCAmpPhaseSettings - the variant points into noise */
+static void FlareSettings(LISAGlobalParams* settings, const FlareROM* rom, const FlareNoise* noise)
+{
+  memset(settings, 0, sizeof(LISAGlobalParams));
+  settings->fRef = rom->fRef;
+  settings->tagextpn = rom->tagextpn;
+  settings->Mfmatch = rom->Mfmatch;
+  settings->setphiRefatfRef = rom->setphiRefatfRef;
+  settings->nbmodetemp = rom->nbmode;
+  settings->variant = (LISAconstellation*) &(noise->variant);
+  settings->tagtdi = noise->tagtdi;
+  settings->minf = noise->minf;
+  settings->maxf = noise->maxf;
+  settings->deltatobs = noise->deltatobs;
+  settings->tagtRefatLISA = noise->tagtRefatLISA;
+  settings->frozenLISA = noise->frozenLISA;
+  settings->responseapprox = noise->responseapprox;
+}
+
+static double FlareStartFrequency(const LISAParams* params, const LISAGlobalParams* settings)
+{
+  if(settings->deltatobs==0.) return 0.;
+  return Newtonianfoft(params->m1, params->m2, settings->deltatobs);
+}
+
+/* Bind the arena of the current thread of the batch, returning the previous one */
+static Arena* FlareWorkspace_Bind(FlareWorkspace* workspace)
+{
+  int i = omp_get_thread_num();
+  if(!workspace->arenas[i]) Arena_Init(&(workspace->arenas[i]), FLARE_ARENA_SIZE);
+  return Arena_Bind(workspace->arenas[i]);
+}
+
+static void FlareWorkspace_Release(FlareWorkspace* workspace, Arena* previous)
+{
+  Arena_Reset(workspace->arenas[omp_get_thread_num()]);
+  Arena_Bind(previous);
+}
+
+/************ Handles ************/
+
+int FlareROM_Init(
+  FlareROM** rom,
+  const int nbmode,
+  const double fRef,
+  const int tagextpn,
+  const double Mfmatch,
+  const int setphiRefatfRef)
+{
+  if(nbmode<1 || nbmode>nbmodemax) {
+    printf("Error in FlareROM_Init: number of modes must be between 1 and %d.\n", nbmodemax);
+    return FAILURE;
+  }
+  /* Load the ROM data once, before any concurrent call - shared read-only afterwards */
+  if(EOBNRv2HMROM_Init_DATA()==FAILURE) return FAILURE;
+
+  *rom = (FlareROM*) malloc(sizeof(FlareROM));
+  (*rom)->nbmode = nbmode;
+  (*rom)->fRef = fRef;
+  (*rom)->tagextpn = tagextpn;
+  (*rom)->Mfmatch = Mfmatch;
+  (*rom)->setphiRefatfRef = setphiRefatfRef;
+  return SUCCESS;
+}
+
+void FlareROM_Cleanup(FlareROM* rom)
+{
+  free(rom);
+}
+
+int FlareNoise_Init(
+  FlareNoise** noise,
+  const LISAconstellation* variant,
+  const TDItag tagtdi,
+  const double minf,
+  const double maxf,
+  const double deltatobs,
+  const int tagtRefatLISA,
+  const int frozenLISA,
+  const ResponseApproxtag responseapprox)
+{
+  if(!variant) {
+    printf("Error in FlareNoise_Init: variant points to NULL.\n");
+    return FAILURE;
+  }
+  if(!(tagtdi==TDIXYZ || tagtdi==TDIAETXYZ || tagtdi==TDIAXYZ || tagtdi==TDIEXYZ || tagtdi==TDITXYZ)) {
+    printf("Error in FlareNoise_Init: TDI tag not supported, only the sets of three channels from XYZ.\n");
+    return FAILURE;
+  }
+  *noise = (FlareNoise*) malloc(sizeof(FlareNoise));
+  (*noise)->variant = *variant;
+  (*noise)->tagtdi = tagtdi;
+  (*noise)->minf = minf;
+  (*noise)->maxf = maxf;
+  (*noise)->deltatobs = deltatobs;
+  (*noise)->tagtRefatLISA = tagtRefatLISA;
+  (*noise)->frozenLISA = frozenLISA;
+  (*noise)->responseapprox = responseapprox;
+  return SUCCESS;
+}
+
+void FlareNoise_Cleanup(FlareNoise* noise)
+{
+  free(noise);
+}
+
+int FlareInjection_Init(
+  FlareInjection** injection,
+  const FlareROM* rom,
+  const FlareNoise* noise,
+  const double* params,
+  const int nbmode)
+{
+  if(nbmode<1 || nbmode>nbmodemax) {
+    printf("Error in FlareInjection_Init: number of modes must be between 1 and %d.\n", nbmodemax);
+    return FAILURE;
+  }
+  FlareInjection* inj = (FlareInjection*) malloc(sizeof(FlareInjection));
+  FlareParamsFromRow(&(inj->params), params, nbmode);
+  inj->noise = *noise;
+  FlareSettings(&(inj->settings), rom, &(inj->noise));
+  inj->splines1 = NULL;
+  inj->splines2 = NULL;
+  inj->splines3 = NULL;
+
+  /* The injection outlives any call: make sure its allocations do not come from an arena bound by the caller */
+  Arena* previous = Arena_Bind(NULL);
+  LISASignalCAmpPhase* signal = NULL;
+  LISASignalCAmpPhase_Init(&signal);
+  int ret = LISAGenerateSignalCAmpPhaseSettings(&(inj->params), signal, inj->params.tRef, &(inj->settings));
+  if(ret==SUCCESS) {
+    BuildListmodesCAmpPhaseSpline(&(inj->splines1), signal->TDI1Signal);
+    BuildListmodesCAmpPhaseSpline(&(inj->splines2), signal->TDI2Signal);
+    BuildListmodesCAmpPhaseSpline(&(inj->splines3), signal->TDI3Signal);
+    inj->ss = signal->TDI123hh;
+    inj->fstartobs = FlareStartFrequency(&(inj->params), &(inj->settings));
+  }
+  LISASignalCAmpPhase_Cleanup(signal);
+  Arena_Bind(previous);
+
+  if(ret==FAILURE) {
+    printf("Error in FlareInjection_Init: generation of the injection failed.\n");
+    free(inj);
+    return FAILURE;
+  }
+  *injection = inj;
+  return SUCCESS;
+}
+
+void FlareInjection_Cleanup(FlareInjection* injection)
+{
+  if(injection->splines1) ListmodesCAmpPhaseSpline_Destroy(injection->splines1);
+  if(injection->splines2) ListmodesCAmpPhaseSpline_Destroy(injection->splines2);
+  if(injection->splines3) ListmodesCAmpPhaseSpline_Destroy(injection->splines3);
+  free(injection);
+}
+
+double FlareInjection_SNR(const FlareInjection* injection)
+{
+  return sqrt(injection->ss);
+}
+
+int FlareWorkspace_Init(
+  FlareWorkspace** workspace,
+  const int nthreads)
+{
+  *workspace = (FlareWorkspace*) malloc(sizeof(FlareWorkspace));
+  (*workspace)->nthreads = nthreads>0 ? nthreads : omp_get_max_threads();
+  /* Arenas are created lazily, by the thread that uses them */
+  (*workspace)->arenas = (Arena**) calloc((*workspace)->nthreads, sizeof(Arena*));
+  return SUCCESS;
+}
+
+void FlareWorkspace_Cleanup(FlareWorkspace* workspace)
+{
+  for(int i=0; i<workspace->nthreads; i++) {
+    if(workspace->arenas[i]) Arena_Cleanup(workspace->arenas[i]);
+  }
+  free(workspace->arenas);
+  free(workspace);
+}
+
+/************ Batched computations ************/
+
+int FlareLogLikelihood(
+  double* logL,
+  const FlareInjection* injection,
+  FlareWorkspace* workspace,
+  const double* params,
+  const int nsources)
+{
+  const LISAGlobalParams* settings = &(injection->settings);
+  double fLow = fmax(__LISASimFD_Noise_fLow, settings->minf);
+  double fHigh = fmin(__LISASimFD_Noise_fHigh, settings->maxf);
+  ObjectFunction NoiseSn1 = NoiseFunction(settings->variant, settings->tagtdi, 1);
+  ObjectFunction NoiseSn2 = NoiseFunction(settings->variant, settings->tagtdi, 2);
+  ObjectFunction NoiseSn3 = NoiseFunction(settings->variant, settings->tagtdi, 3);
+  int nfailed = 0;
+
+  #pragma omp parallel for num_threads(workspace->nthreads) schedule(dynamic) reduction(+:nfailed)
+  for(int k=0; k<nsources; k++) {
+    Arena* previous = FlareWorkspace_Bind(workspace);
+    LISAParams templateparams;
+    FlareParamsFromRow(&templateparams, &(params[k*FLARE_NPARAMS]), settings->nbmodetemp);
+
+    /* The templates are referenced to the time of the injection, as in CalculateLogLCAmpPhase */
+    LISASignalCAmpPhase* signal = NULL;
+    LISASignalCAmpPhase_Init(&signal);
+    if(LISAGenerateSignalCAmpPhaseSettings(&templateparams, signal, injection->params.tRef, settings)==FAILURE) {
+      logL[k] = -DBL_MAX;
+      nfailed++;
+    }
+    else {
+      double fstartobs = FlareStartFrequency(&templateparams, settings);
+      double overlapTDI123 = FDListmodesFresnelOverlap3Chan(signal->TDI1Signal, signal->TDI2Signal, signal->TDI3Signal, injection->splines1, injection->splines2, injection->splines3, &NoiseSn1, &NoiseSn2, &NoiseSn3, fLow, fHigh, injection->fstartobs, fstartobs);
+      logL[k] = overlapTDI123 - 1./2*(injection->ss) - 1./2*(signal->TDI123hh);
+    }
+    LISASignalCAmpPhase_Cleanup(signal);
+    FlareWorkspace_Release(workspace, previous);
+  }
+  return nfailed;
+}
+
+int FlareSNR(
+  double* snr,
+  const FlareROM* rom,
+  const FlareNoise* noise,
+  FlareWorkspace* workspace,
+  const double* params,
+  const int nsources)
+{
+  LISAGlobalParams settings;
+  FlareSettings(&settings, rom, noise);
+  int nfailed = 0;
+
+  #pragma omp parallel for num_threads(workspace->nthreads) schedule(dynamic) reduction(+:nfailed)
+  for(int k=0; k<nsources; k++) {
+    Arena* previous = FlareWorkspace_Bind(workspace);
+    LISAParams sourceparams;
+    FlareParamsFromRow(&sourceparams, &(params[k*FLARE_NPARAMS]), settings.nbmodetemp);
+
+    /* Each source is its own reference, no time shift */
+    LISASignalCAmpPhase* signal = NULL;
+    LISASignalCAmpPhase_Init(&signal);
+    if(LISAGenerateSignalCAmpPhaseSettings(&sourceparams, signal, sourceparams.tRef, &settings)==FAILURE) {
+      snr[k] = NAN;
+      nfailed++;
+    }
+    else snr[k] = sqrt(signal->TDI123hh);
+    LISASignalCAmpPhase_Cleanup(signal);
+    FlareWorkspace_Release(workspace, previous);
+  }
+  return nfailed;
+}
+
+/* Evaluate the splines of one mode on the grid - the grid is increasing, so the interval of the spline only moves forward */
+static void FlareEvalMode(double* out1, double* out2, CAmpPhaseSpline* splines, const double* freq, const int nfreq, const FlareWaveformtag format)
+{
+  gsl_matrix* phasecoeffs = splines->quadspline_phase;
+  int nspline = (int) phasecoeffs->size1;
+  double fmin = gsl_matrix_get(phasecoeffs, 0, 0);
+  double fmax = gsl_matrix_get(phasecoeffs, nspline-1, 0);
+  int ispline = 0;
+  for(int j=0; j<nfreq; j++) {
+    double f = freq[j];
+    if(f<fmin || f>fmax) {
+      out1[j] = 0.;
+      out2[j] = 0.;
+      continue;
+    }
+    while(ispline<nspline-2 && gsl_matrix_get(phasecoeffs, ispline+1, 0)<f) ispline++;
+    double eps = f - gsl_matrix_get(phasecoeffs, ispline, 0);
+    double eps2 = eps*eps;
+    double eps3 = eps2*eps;
+    gsl_vector_view coeffsampreal = gsl_matrix_row(splines->spline_amp_real, ispline);
+    gsl_vector_view coeffsampimag = gsl_matrix_row(splines->spline_amp_imag, ispline);
+    gsl_vector_view coeffsphase = gsl_matrix_row(phasecoeffs, ispline);
+    double complex A = EvalCubic(&coeffsampreal.vector, eps, eps2, eps3) + I*EvalCubic(&coeffsampimag.vector, eps, eps2, eps3);
+    double phi = EvalQuad(&coeffsphase.vector, eps, eps2);
+    if(format==ampphase) {
+      /* The amplitude is real for the ROM, and has a constant phase in the TaylorF2 extension */
+      out1[j] = cabs(A);
+      out2[j] = phi + carg(A);
+    }
+    else {
+      double complex h = A * cexp(I*phi);
+      out1[j] = creal(h);
+      out2[j] = cimag(h);
+    }
+  }
+}
+
+int FlareROMWaveforms(
+  double* out1,
+  double* out2,
+  const FlareROM* rom,
+  FlareWorkspace* workspace,
+  const double* params,
+  const int nsources,
+  const double* freq,
+  const int nfreq,
+  const FlareWaveformtag format)
+{
+  for(int j=1; j<nfreq; j++) {
+    if(!(freq[j]>freq[j-1])) {
+      printf("Error in FlareROMWaveforms: frequencies must be strictly increasing.\n");
+      return -1;
+    }
+  }
+  int nbmode = rom->nbmode;
+  size_t sizesource = (size_t) nbmode * nfreq;
+  int nfailed = 0;
+
+  #pragma omp parallel for num_threads(workspace->nthreads) schedule(dynamic) reduction(+:nfailed)
+  for(int k=0; k<nsources; k++) {
+    Arena* previous = FlareWorkspace_Bind(workspace);
+    const double* row = &(params[k*FLARE_ROM_NPARAMS]);
+    double m1 = row[0];
+    double m2 = row[1];
+    double tRef = row[2];
+    double distance = row[3];
+    double phiRef = row[4];
+    double* out1source = &(out1[k*sizesource]);
+    double* out2source = &(out2[k*sizesource]);
+
+    int ret;
+    ListmodesCAmpPhaseFrequencySeries* listROM = NULL;
+    if(!(rom->tagextpn)) {
+      ret = SimEOBNRv2HMROM(&listROM, nbmode, tRef, phiRef, rom->fRef, m1*MSUN_SI, m2*MSUN_SI, distance*1e6*PC_SI, rom->setphiRefatfRef);
+    } else {
+      ret = SimEOBNRv2HMROMExtTF2(&listROM, nbmode, rom->Mfmatch, freq[0], 0, tRef, phiRef, rom->fRef, m1*MSUN_SI, m2*MSUN_SI, distance*1e6*PC_SI, rom->setphiRefatfRef);
+    }
+    if(ret==FAILURE) {
+      for(size_t i=0; i<sizesource; i++) {
+        out1source[i] = NAN;
+        out2source[i] = NAN;
+      }
+      nfailed++;
+    }
+    else {
+      for(int i=0; i<nbmode; i++) {
+        ListmodesCAmpPhaseFrequencySeries* mode = ListmodesCAmpPhaseFrequencySeries_GetMode(listROM, listmode[i][0], listmode[i][1]);
+        CAmpPhaseSpline* splines = NULL;
+        BuildSplineCoeffs(&splines, mode->freqseries);
+        FlareEvalMode(&(out1source[i*nfreq]), &(out2source[i*nfreq]), splines, freq, nfreq, format);
+        CAmpPhaseSpline_Cleanup(splines);
+      }
+    }
+    if(listROM) ListmodesCAmpPhaseFrequencySeries_Destroy(listROM);
+    FlareWorkspace_Release(workspace, previous);
+  }
+  return nfailed;
+}
@@ -0,0 +1,139 @@
+/**
+ * \author Sylvain Marsat, University of Maryland - NASA GSFC
+ *
+ * \brief C header for the libflare API: persistent handles for the ROM, noise, injection and workspace, and batched log-likelihoods and SNRs written to buffers of the caller.
+ *
+ */
+
+#ifndef _FLARE_H
+#define _FLARE_H
+
+#define _XOPEN_SOURCE 500
+
+#ifdef __GNUC__
+#define UNUSED __attribute__ ((unused))
+#else
+#define UNUSED
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include <complex.h>
+#include <string.h>
+
+#include "constants.h"
+#include "struct.h"
+#include "LISAgeometry.h"
+#include "LISAutils.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#elif 0
+} /* so that editors will match preceding brace */
+#endif
+
+/* Parameters are passed as contiguous arrays of doubles, one row of FLARE_NPARAMS values per source, in the order of the params files: */
+/* m1 (solar masses), m2 (solar masses), tRef (s), dist (Mpc), phase (rad), inc (rad), lambda (rad), beta (rad), pol (rad) */
+#define FLARE_NPARAMS 9
+
+/* Opaque handles - the functions below never read or write the globals globalparams and injectedparams */
+/* Handles are read-only once initialized and can be shared between threads, except the workspace which belongs to one calling thread */
+typedef struct tagFlareROM FlareROM;
+typedef struct tagFlareNoise FlareNoise;
+typedef struct tagFlareInjection FlareInjection;
+typedef struct tagFlareWorkspace FlareWorkspace;
+
+/* ROM: loads the data of the ROM (from $ROM_DATA_PATH) on the first call, and holds the settings of the waveform generation */
+int FlareROM_Init(
+  FlareROM** rom,                          /* Output: handle */
+  const int nbmode,                        /* Number of modes of the templates (starting with the 22) */
+  const double fRef,                       /* Reference frequency (Hz), 0 for Mf=0.14 */
+  const int tagextpn,                      /* Tag to extend the ROM to low frequencies with TaylorF2 */
+  const double Mfmatch,                    /* Geometric frequency of the matching to TaylorF2 when extending */
+  const int setphiRefatfRef);              /* Flag for adjusting the FD phase at phiRef at the given fRef */
+void FlareROM_Cleanup(FlareROM* rom);
+
+/* Noise: LISA variant and TDI channels, with the band and duration of the observation and the approximations of the response */
+int FlareNoise_Init(
+  FlareNoise** noise,                      /* Output: handle */
+  const LISAconstellation* variant,        /* Description of LISA variant - copied */
+  const TDItag tagtdi,                     /* Selector for the set of TDI observables */
+  const double minf,                       /* Minimal frequency (Hz), 0 for the lower end of the noise model */
+  const double maxf,                       /* Maximal frequency (Hz) */
+  const double deltatobs,                  /* Duration of the observation (years), 0 for no cut */
+  const int tagtRefatLISA,                 /* Tag to reference the time to the arrival at LISA rather than at SSB */
+  const int frozenLISA,                    /* Tag for treating LISA as frozen at its position at tRef */
+  const ResponseApproxtag responseapprox); /* Approximation used in the response (full, lowfL, lowf) */
+void FlareNoise_Cleanup(FlareNoise* noise);
+
+/* Injection: signal pre-interpolated once, with its inner product (s|s) - keeps copies of the settings of rom and noise */
+int FlareInjection_Init(
+  FlareInjection** injection,              /* Output: handle */
+  const FlareROM* rom,                     /* ROM handle, settings shared by the templates */
+  const FlareNoise* noise,                 /* Noise handle */
+  const double* params,                    /* Parameters of the injection, FLARE_NPARAMS values */
+  const int nbmode);                       /* Number of modes of the injection (starting with the 22) */
+void FlareInjection_Cleanup(FlareInjection* injection);
+double FlareInjection_SNR(const FlareInjection* injection);
+
+/* Workspace: one arena of temporaries per thread of the batch, grown on the first calls and reused afterwards */
+/* A workspace must not be used by two calls at the same time - give one to each calling thread */
+int FlareWorkspace_Init(
+  FlareWorkspace** workspace,              /* Output: handle */
+  const int nthreads);                     /* Number of OpenMP threads of the batches, <=0 for the default of OpenMP */
+void FlareWorkspace_Cleanup(FlareWorkspace* workspace);
+
+/* Log-likelihoods of nsources templates against the injection, ln L = (h|s) - (h|h)/2 - (s|s)/2, written to logL */
+/* Templates are processed in parallel on the threads of the workspace - -DBL_MAX where the generation failed */
+/* Returns the number of templates for which the generation failed */
+int FlareLogLikelihood(
+  double* logL,                            /* Output: log-likelihoods, nsources values */
+  const FlareInjection* injection,         /* Injection handle */
+  FlareWorkspace* workspace,               /* Workspace of the calling thread */
+  const double* params,                    /* Parameters of the templates, nsources*FLARE_NPARAMS values */
+  const int nsources);                     /* Number of templates */
+
+/* Optimal SNRs sqrt((h|h)) of nsources sources, written to snr - NAN where the generation failed */
+/* Returns the number of sources for which the generation failed */
+int FlareSNR(
+  double* snr,                             /* Output: SNRs, nsources values */
+  const FlareROM* rom,                     /* ROM handle */
+  const FlareNoise* noise,                 /* Noise handle */
+  FlareWorkspace* workspace,               /* Workspace of the calling thread */
+  const double* params,                    /* Parameters of the sources, nsources*FLARE_NPARAMS values */
+  const int nsources);                     /* Number of sources */
+
+/* Parameters of the bare ROM waveforms, one row of FLARE_ROM_NPARAMS values per source: */
+/* m1 (solar masses), m2 (solar masses), tRef (s, time shift of the peak of the 22 mode), dist (Mpc), phase (rad) */
+#define FLARE_ROM_NPARAMS 5
+
+/* Output format of FlareROMWaveforms */
+typedef enum FlareWaveformtag {
+  ampphase,                  /* Modulus of the amplitude and phase, h_lm = A exp(i phi) */
+  reim                       /* Real and imaginary parts of h_lm */
+} FlareWaveformtag;
+
+/* Modes of the ROM (in the order of listmode, the nbmode of the ROM handle) evaluated on a common grid of frequencies, for nsources sources */
+/* Outputs are indexed by (source*nbmode + mode)*nfreq + ifreq - zero outside of the frequency range of each mode, NAN for the sources where the ROM failed */
+/* Sources are processed in parallel on the threads of the workspace, each with its own arena, sharing the data of the ROM */
+/* Returns the number of sources for which the ROM failed, or -1 if the frequencies are not strictly increasing */
+int FlareROMWaveforms(
+  double* out1,                            /* Output: amplitudes or real parts, nsources*nbmode*nfreq values */
+  double* out2,                            /* Output: phases or imaginary parts, nsources*nbmode*nfreq values */
+  const FlareROM* rom,                     /* ROM handle */
+  FlareWorkspace* workspace,               /* Workspace of the calling thread */
+  const double* params,                    /* Parameters of the sources, nsources*FLARE_ROM_NPARAMS values */
+  const int nsources,                      /* Number of sources */
+  const double* freq,                      /* Frequencies (Hz), strictly increasing - the lowest one sets the start of the TaylorF2 extension */
+  const int nfreq,                         /* Number of frequencies */
+  const FlareWaveformtag format);          /* Output format: ampphase or reim */
+
+#if 0
+{ /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif /* _FLARE_H */
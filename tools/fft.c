@@ -18,6 +18,141 @@
 
 #include "constants.h"
 #include "struct.h"
+#include "fft.h"
+
+/***************** Cache of FFTW plans *****************/
+
+/* Transforms larger than this use multi-threaded plans, if enabled */
+#define FFT_THREADS_MINSIZE (1<<18)
+
+/* Kinds of transforms used below */
+typedef enum FFTKindtag {
+  FFTr2c,
+  FFTc2r,
+  FFTc2cforward,
+  FFTc2cbackward
+} FFTKindtag;
+
+/* Plan with its own aligned buffers - fftw_execute is called on these buffers only */
+typedef struct tagFFTCachedPlan {
+  int N;                            /* Size of the transform */
+  FFTKindtag kind;                  /* Kind of the transform */
+  fftw_plan plan;                   /* Plan */
+  void* in;                         /* Input buffer - N doubles for r2c, N/2+1 complex for c2r, N complex for c2c */
+  void* out;                        /* Output buffer - N/2+1 complex for r2c, N doubles for c2r, N complex for c2c */
+  struct tagFFTCachedPlan* next;    /* Next pointer in the cache of the thread */
+  struct tagFFTCachedPlan* nextall; /* Next pointer in the list of the plans of all threads */
+} FFTCachedPlan;
+
+/* Cache is per thread, so that buffers are never shared - planning itself is serialized as the FFTW planner is not thread-safe */
+/* All plans are also chained in one list, so that FFTPlanCache_Cleanup frees them without access to the other threads - */
+/* a thread finding its generation behind the global one drops its (freed) cache */
+static FFTCachedPlan* plancache = NULL;
+static int plancachegeneration = 0;
+#pragma omp threadprivate(plancache, plancachegeneration)
+static FFTCachedPlan* plancacheall = NULL;
+static int plangeneration = 0;
+static unsigned fftplannerflags = FFTW_ESTIMATE;
+static int fftnthreads = 1;
+static char fftwisdomfile[256] = "";
+
+FFTPlannertag ParseFFTPlannertag(char* string) {
+  FFTPlannertag tag;
+  if(strcmp(string, "estimate")==0) tag = FFTestimate;
+  else if(strcmp(string, "measure")==0) tag = FFTmeasure;
+  else if(strcmp(string, "patient")==0) tag = FFTpatient;
+  else {
+    printf("Error in ParseFFTPlannertag: string not recognized.\n");
+    exit(1);
+  }
+  return tag;
+}
+
+static void FFTExportWisdom(void)
+{
+  if(strlen(fftwisdomfile)>0 && !fftw_export_wisdom_to_filename(fftwisdomfile)) {
+    printf("Warning in FFTExportWisdom: could not write FFTW wisdom to %s.\n", fftwisdomfile);
+  }
+}
+
+void FFTSetup(FFTPlannertag planner, const char* wisdomfile, int nthreads)
+{
+  if(planner==FFTestimate) fftplannerflags = FFTW_ESTIMATE;
+  else if(planner==FFTmeasure) fftplannerflags = FFTW_MEASURE;
+  else if(planner==FFTpatient) fftplannerflags = FFTW_PATIENT;
+#ifdef FFTW_THREADS
+  static int threadsinitialized = 0;
+  if(nthreads>1 && !threadsinitialized) threadsinitialized = fftw_init_threads();
+  fftnthreads = threadsinitialized ? nthreads : 1;
+#else
+  if(nthreads>1) printf("Warning in FFTSetup: compiled without FFTW_THREADS, ignoring nthreads.\n");
+  fftnthreads = 1;
+#endif
+  /* Wisdom is exported when the program exits - registered only once */
+  if(wisdomfile && strlen(wisdomfile)>0) {
+    int registered = strlen(fftwisdomfile)>0;
+    strncpy(fftwisdomfile, wisdomfile, 255);
+    fftw_import_wisdom_from_filename(fftwisdomfile); /* Missing file is not an error, wisdom will be created */
+    if(!registered) atexit(FFTExportWisdom);
+  }
+}
+
+/* Returns the cached plan for this size and kind, creating it if needed */
+static FFTCachedPlan* FFTGetPlan(int N, FFTKindtag kind)
+{
+  if(plancachegeneration!=plangeneration) {
+    plancache = NULL;
+    plancachegeneration = plangeneration;
+  }
+  for(FFTCachedPlan* cached=plancache; cached; cached=cached->next) {
+    if(cached->N==N && cached->kind==kind) return cached;
+  }
+
+  FFTCachedPlan* cached = (FFTCachedPlan*) malloc(sizeof(FFTCachedPlan));
+  cached->N = N;
+  cached->kind = kind;
+  size_t sizein = (kind==FFTr2c) ? sizeof(double)*N : (kind==FFTc2r) ? sizeof(fftw_complex)*(N/2+1) : sizeof(fftw_complex)*N;
+  size_t sizeout = (kind==FFTr2c) ? sizeof(fftw_complex)*(N/2+1) : (kind==FFTc2r) ? sizeof(double)*N : sizeof(fftw_complex)*N;
+  cached->in = fftw_malloc(sizein);
+  cached->out = fftw_malloc(sizeout);
+  /* NOTE: planning with FFTW_MEASURE/FFTW_PATIENT overwrites the buffers - they are filled only after this */
+  #pragma omp critical (fftw_planner)
+  {
+#ifdef FFTW_THREADS
+    fftw_plan_with_nthreads((N>=FFT_THREADS_MINSIZE) ? fftnthreads : 1);
+#endif
+    if(kind==FFTr2c) cached->plan = fftw_plan_dft_r2c_1d(N, (double*) cached->in, (fftw_complex*) cached->out, fftplannerflags);
+    else if(kind==FFTc2r) cached->plan = fftw_plan_dft_c2r_1d(N, (fftw_complex*) cached->in, (double*) cached->out, fftplannerflags);
+    else if(kind==FFTc2cforward) cached->plan = fftw_plan_dft_1d(N, (fftw_complex*) cached->in, (fftw_complex*) cached->out, FFTW_FORWARD, fftplannerflags);
+    else cached->plan = fftw_plan_dft_1d(N, (fftw_complex*) cached->in, (fftw_complex*) cached->out, FFTW_BACKWARD, fftplannerflags);
+    /* Plans are freed at exit if FFTPlanCache_Cleanup was not called before - registered only once */
+    static int registered = 0;
+    if(!registered) registered = !atexit(FFTPlanCache_Cleanup);
+    cached->nextall = plancacheall;
+    plancacheall = cached;
+  }
+  cached->next = plancache;
+  plancache = cached;
+  return cached;
+}
+
+void FFTPlanCache_Cleanup(void)
+{
+  #pragma omp critical (fftw_planner)
+  {
+    while(plancacheall) {
+      FFTCachedPlan* next = plancacheall->nextall;
+      fftw_destroy_plan(plancacheall->plan);
+      fftw_free(plancacheall->in);
+      fftw_free(plancacheall->out);
+      free(plancacheall);
+      plancacheall = next;
+    }
+    plangeneration++;
+  }
+  plancache = NULL;
+  plancachegeneration = plangeneration;
+}
 
 
 /* Window functions */
@@ -68,8 +203,8 @@ int FFTRealTimeSeries(ReImFrequencySeries** freqseries, RealTimeSeries* timeseri
   /* Initialize vector for windowed, 0-padded FFT input */
   int n = (int) timeseries->times->size;
   int nzeros = (int) pow(2, ((int) ceil(log(n)/log(2))) + nzeropad) - n; /* Here defined with ceil, but with floor in IFFT */
-  gsl_vector* hvalues = gsl_vector_alloc(n + nzeros);
-  gsl_vector_set_zero(hvalues);
+  int N = n + nzeros;
+  FFTCachedPlan* cached = FFTGetPlan(N, FFTr2c);
 
   /* Compute input TD values, with windowing */
   int nbptswindowbeg = (int) ceil(twindowbeg/deltat) + 1;
@@ -81,7 +216,7 @@ int FFTRealTimeSeries(ReImFrequencySeries** freqseries, RealTimeSeries* timeseri
   double deltatwindowbeg = t2windowbeg - t1windowbeg;
   double deltatwindowend = t2windowend - t1windowend;
   double* h = timeseries->h->data;
-  double* hval = hvalues->data;
+  double* hval = (double*) cached->in;
 
   for (int i=0; i<nbptswindowbeg; i++) {
     hval[i] = WindowFunctionRight(times[i], t1windowbeg, deltatwindowbeg) * h[i];
@@ -92,15 +227,13 @@ int FFTRealTimeSeries(ReImFrequencySeries** freqseries, RealTimeSeries* timeseri
   for (int i=n-nbptswindowend; i<n; i++) {
     hval[i] = WindowFunctionLeft(times[i], t2windowend, deltatwindowend) * h[i];
   }
+  for (int i=n; i<N; i++) {
+    hval[i] = 0.;
+  }
 
   /* FFT - uses flipped convention (i.e. h(f) = int e^(+2ipift)h(t)) */
-  int N = (int) hvalues->size;
-  fftw_plan p;
-  double* in = hvalues->data;
-  fftw_complex* out;
-  out = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * (N/2+1)); /* Note: N/2+1 elements */
-  p = fftw_plan_dft_r2c_1d(N, in, out, FFTW_ESTIMATE);
-  fftw_execute(p);
+  fftw_complex* out = (fftw_complex*) cached->out; /* Note: N/2+1 elements */
+  fftw_execute(cached->plan);
 
   /* Initialize output structure */
   ReImFrequencySeries_Init(freqseries, N/2); /* Note: N/2+1 elements as output of fftw, we drop the last one (at Nyquist frequency) */
@@ -110,22 +243,21 @@ int FFTRealTimeSeries(ReImFrequencySeries** freqseries, RealTimeSeries* timeseri
   double* freq = (*freqseries)->freq->data;
   double* hreal = (*freqseries)->h_real->data;
   double* himag = (*freqseries)->h_imag->data;
-  double f;
   double complex hcomplex;
   double factorshift = 2*PI*tshift; /* Reminder: Flipped sign convention */
-  for(int i=0; i<N/2; i++) {
-    f = i*deltaf;
-    freq[i] = f;
-    hcomplex = deltat * conj(out[i]) * cexp(I*factorshift*f); /* Note that we convert here the FT sign convention */
-    hreal[i] = creal(hcomplex);
-    himag[i] = cimag(hcomplex);
+  /* The shift phase is linear in i - phasors obtained by recurrence, in blocks of PHASOR_REANCHOR */
+  double complex shift[PHASOR_REANCHOR];
+  for(int ib=0; ib<N/2; ib+=PHASOR_REANCHOR) {
+    int nb = min(PHASOR_REANCHOR, N/2 - ib);
+    Phasor_Fill(shift, factorshift*(ib*deltaf), factorshift*deltaf, nb);
+    for(int i=ib; i<ib+nb; i++) {
+      freq[i] = i*deltaf;
+      hcomplex = deltat * conj(out[i]) * shift[i-ib]; /* Note that we convert here the FT sign convention */
+      hreal[i] = creal(hcomplex);
+      himag[i] = cimag(hcomplex);
+    }
   }
 
-  /* Clean up */
-  gsl_vector_free(hvalues);
-  fftw_destroy_plan(p);
-  fftw_free(out);
-
   return SUCCESS;
 }
 
@@ -157,7 +289,8 @@ int FFTTimeSeries(ReImFrequencySeries** freqseries, ReImTimeSeries* timeseries,
   double* htdreal = timeseries->h_real->data;
   double* htdimag = timeseries->h_imag->data;
 
-  fftw_complex* in = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
+  FFTCachedPlan* cached = FFTGetPlan(N, FFTc2cbackward);
+  fftw_complex* in = (fftw_complex*) cached->in;
   for (int i=0; i<nbptswindowbeg; i++) {
     in[i] = WindowFunctionRight(times[i], t1windowbeg, deltatwindowbeg) * (htdreal[i] + I*htdimag[i]);
   }
@@ -167,14 +300,14 @@ int FFTTimeSeries(ReImFrequencySeries** freqseries, ReImTimeSeries* timeseries,
   for (int i=n-nbptswindowend; i<n; i++) {
     in[i] = WindowFunctionLeft(times[i], t2windowend, deltatwindowend) * (htdreal[i] + I*htdimag[i]);
   }
+  for (int i=n; i<N; i++) {
+    in[i] = 0;
+  }
 
   /* FFT - uses flipped convention (i.e. h(f) = int e^(+2ipift)h(t)) */
   /* Represented here by the use of FFTW_BACKWARD (plus sign in the exp) */
-  fftw_plan p;
-  fftw_complex* out;
-  out = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N); /* Note: N/2+1 elements */
-  p = fftw_plan_dft_1d(N, in, out, FFTW_BACKWARD, FFTW_ESTIMATE);
-  fftw_execute(p);
+  fftw_complex* out = (fftw_complex*) cached->out;
+  fftw_execute(cached->plan);
 
   /* Initialize output structure */
   ReImFrequencySeries_Init(freqseries, N/2); /* NOTE: N/2 first elements of output of fftw are positive freqs, we eliminate negative frequency (the second half of the series) */
@@ -184,22 +317,21 @@ int FFTTimeSeries(ReImFrequencySeries** freqseries, ReImTimeSeries* timeseries,
   double* freq = (*freqseries)->freq->data;
   double* hreal = (*freqseries)->h_real->data;
   double* himag = (*freqseries)->h_imag->data;
-  double f;
   double complex hcomplex;
   double factorshift = 2*PI*tshift; /* Reminder: Flipped sign convention */
-  for(int i=0; i<N/2; i++) {
-    f = i*deltaf;
-    freq[i] = f;
-    hcomplex = deltat * out[i] * cexp(I*factorshift*f); /* Note the FT sign convention  */
-    hreal[i] = creal(hcomplex);
-    himag[i] = cimag(hcomplex);
+  /* The shift phase is linear in i - phasors obtained by recurrence, in blocks of PHASOR_REANCHOR */
+  double complex shift[PHASOR_REANCHOR];
+  for(int ib=0; ib<N/2; ib+=PHASOR_REANCHOR) {
+    int nb = min(PHASOR_REANCHOR, N/2 - ib);
+    Phasor_Fill(shift, factorshift*(ib*deltaf), factorshift*deltaf, nb);
+    for(int i=ib; i<ib+nb; i++) {
+      freq[i] = i*deltaf;
+      hcomplex = deltat * out[i] * shift[i-ib]; /* Note the FT sign convention  */
+      hreal[i] = creal(hcomplex);
+      himag[i] = cimag(hcomplex);
+    }
   }
 
-  /* Clean up */
-  fftw_destroy_plan(p);
-  fftw_free(in);
-  fftw_free(out);
-
   return SUCCESS;
 }
 
@@ -223,40 +355,28 @@ int IFFTFrequencySeriesReal(RealTimeSeries** timeseries, ReImFrequencySeries* fr
   int n = (int) freqseries->freq->size;
   while(freq[n-1] > f2windowend) n--;
   int nzeros = (int) pow(2, ((int) ceil(log(n)/log(2))) + nzeropad) - n; /* Here defined with floor, but with ceil in FFT */
-  gsl_vector* hrealvalues = gsl_vector_alloc(n + nzeros);
-  gsl_vector* himagvalues = gsl_vector_alloc(n + nzeros);
-  gsl_vector_set_zero(hrealvalues);
-  gsl_vector_set_zero(himagvalues);
+  int N = n + nzeros;
+  FFTCachedPlan* cached = FFTGetPlan(N, FFTc2r);
 
-  /* Compute input FD values, with windowing */
+  /* Compute input FD values, with windowing, as array of fftw_complex - the c2r transform only uses the N/2+1 first elements */
   double deltafwindowbeg = f2windowbeg - f1windowbeg;
   double deltafwindowend = f2windowend - f1windowend;
   double* hreal = freqseries->h_real->data;
   double* himag = freqseries->h_imag->data;
-  double* hrealval = hrealvalues->data;
-  double* himagval = himagvalues->data;
-  for (int i=0; i<n; i++) {
-    double window = WindowFunction(freq[i], f1windowbeg, f2windowend, deltafwindowbeg, deltafwindowend);
-    hrealval[i] = window * hreal[i];
-    himagval[i] = window * himag[i];
-  }
-
-  /* Input as array of fftw_complex */
-  int N = (int) hrealvalues->size;
-  fftw_complex* in = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
+  fftw_complex* in = (fftw_complex*) cached->in;
+  int nin = min(n, N/2+1);
   /* NOTE: Restoring the standard sign convention for the FT, used by FFTW - change in convention amounts to f->-f, equivalent to a conjugation only for FFT of a real series  */
-  for(int i=0; i<n; i++) {
-    in[i] = hrealval[i] - I*himagval[i] ;
+  for(int i=0; i<nin; i++) {
+    double window = WindowFunction(freq[i], f1windowbeg, f2windowend, deltafwindowbeg, deltafwindowend);
+    in[i] = window * (hreal[i] - I*himag[i]);
   }
-  for(int i=n; i<N; i++) {
+  for(int i=nin; i<N/2+1; i++) {
     in[i] = 0;
   }
 
   /* FFT - uses flipped convention (i.e. h(f) = int e^(+2ipift)h(t)) */
-  fftw_plan p;
-  double* out = fftw_malloc(sizeof(double) * N);
-  p = fftw_plan_dft_c2r_1d(N, in, out, FFTW_ESTIMATE);
-  fftw_execute(p);
+  double* out = (double*) cached->out;
+  fftw_execute(cached->plan);
 
   /* Initialize output structure */
   RealTimeSeries_Init(timeseries, N);
@@ -273,13 +393,6 @@ int IFFTFrequencySeriesReal(RealTimeSeries** timeseries, ReImFrequencySeries* fr
     h[N/2+i] = fac * out[i];
   }
 
-  /* Clean up */
-  gsl_vector_free(hrealvalues);
-  gsl_vector_free(himagvalues);
-  fftw_destroy_plan(p);
-  fftw_free(in);
-  fftw_free(out);
-
   return SUCCESS;
 }
 
@@ -304,30 +417,19 @@ int IFFTFrequencySeries(ReImTimeSeries** timeseries, ReImFrequencySeries* freqse
   int n = (int) freqseries->freq->size;
   while(freq[n-1] > f2windowend) n--;
   int nzeros = (int) pow(2, ((int) ceil(log(n)/log(2))) + nzeropad) - n; /* Here defined with floor, but with ceil in FFT */
-  gsl_vector* hrealvalues = gsl_vector_alloc(n + nzeros);
-  gsl_vector* himagvalues = gsl_vector_alloc(n + nzeros);
-  gsl_vector_set_zero(hrealvalues);
-  gsl_vector_set_zero(himagvalues);
+  int N = n + nzeros;
+  FFTCachedPlan* cached = FFTGetPlan(N, FFTc2cforward);
 
-  /* Compute input FD values, with windowing */
+  /* Compute input FD values, with windowing, as array of fftw_complex */
   double deltafwindowbeg = f2windowbeg - f1windowbeg;
   double deltafwindowend = f2windowend - f1windowend;
   double* hreal = freqseries->h_real->data;
   double* himag = freqseries->h_imag->data;
-  double* hrealval = hrealvalues->data;
-  double* himagval = himagvalues->data;
-  for (int i=0; i<n; i++) {
-    double window = WindowFunction(freq[i], f1windowbeg, f2windowend, deltafwindowbeg, deltafwindowend);
-    hrealval[i] = window * hreal[i];
-    himagval[i] = window * himag[i];
-  }
-
-  /* Input as array of fftw_complex */
-  int N = (int) hrealvalues->size;
-  fftw_complex* in = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
+  fftw_complex* in = (fftw_complex*) cached->in;
   /* NOTE: the sign convention for the FT used by FFTW is different - change in convention amounts to f->-f, equivalent to a conjugation only for FFT of a real series - for a FFT of a complex series, we do not conjugate and we keep our convention */
   for(int i=0; i<n; i++) {
-    in[i] = hrealval[i] + I*himagval[i] ;
+    double window = WindowFunction(freq[i], f1windowbeg, f2windowend, deltafwindowbeg, deltafwindowend);
+    in[i] = window * (hreal[i] + I*himag[i]);
   }
   for(int i=n; i<N; i++) {
     in[i] = 0;
@@ -335,10 +437,8 @@ int IFFTFrequencySeries(ReImTimeSeries** timeseries, ReImFrequencySeries* freqse
 
   /* FFT - FFTW uses flipped convention (i.e. h(f) = int e^(+2ipift)h(t)) - our convention is h(f) = int e^(-2ipift)h(t) */
   /* NOTE: due to the difference in convention for the FT, we use the FFTW_FORWARD sign (sign - in the exponential) */
-  fftw_plan p;
-  double complex* out = fftw_malloc(sizeof(fftw_complex) * N);
-  p = fftw_plan_dft_1d(N, in, out, FFTW_FORWARD, FFTW_ESTIMATE);
-  fftw_execute(p);
+  double complex* out = (double complex*) cached->out;
+  fftw_execute(cached->plan);
 
   /* Initialize output structure */
   ReImTimeSeries_Init(timeseries, N);
@@ -358,12 +458,295 @@ int IFFTFrequencySeries(ReImTimeSeries** timeseries, ReImFrequencySeries* freqse
     htdimag[N/2+i] = fac * cimag(out[i]);
   }
 
+  return SUCCESS;
+}
+
+/* Integral of a complex frequency series against exp(2ipi f t), for a grid of time shifts t - one FFT for all the shifts */
+/* I(t) = int df a(f) exp(2ipi f t), with the trapezoidal rule on the linear grid of frequencies of a(f) - output times are t_j = j/(N deltaf), for j in [-N/2, N/2[ */
+/* Note: no windowing, a(f) is assumed to vanish at the ends or to be cut there as in the inner products */
+int IFFTTimeShiftIntegral(ReImTimeSeries** timeseries, ReImFrequencySeries* freqseries, int nzeropad)
+{
+  /* deltaf of frequency series */
+  /* Warning: assumes linear sampling in frequency */
+  int n = (int) freqseries->freq->size;
+  if(n<2) {
+    printf("Error in IFFTTimeShiftIntegral: need at least two frequencies.\n");
+    exit(1);
+  }
+  double* freq = freqseries->freq->data;
+  double f0 = freq[0];
+  double deltaf = freq[1] - freq[0];
+
+  /* 0-padded length */
+  int N = (int) pow(2, ((int) ceil(log(n)/log(2))) + nzeropad);
+  FFTCachedPlan* cached = FFTGetPlan(N, FFTc2cbackward);
+
+  /* Input values, with the weights of the trapezoidal rule */
+  double* hreal = freqseries->h_real->data;
+  double* himag = freqseries->h_imag->data;
+  fftw_complex* in = (fftw_complex*) cached->in;
+  for(int i=0; i<n; i++) {
+    in[i] = deltaf * (hreal[i] + I*himag[i]);
+  }
+  in[0] *= 0.5;
+  in[n-1] *= 0.5;
+  for(int i=n; i<N; i++) {
+    in[i] = 0;
+  }
+
+  /* FFT - FFTW_BACKWARD has the sign + in the exponential, sum_i a_i exp(2ipi ij/N) with exp(2ipi i deltaf t_j) = exp(2ipi ij/N) */
+  double complex* out = (double complex*) cached->out;
+  fftw_execute(cached->plan);
+
+  /* Initialize output structure */
+  ReImTimeSeries_Init(timeseries, N);
+
+  /* Extracting data from FFTW output - moving negative times to the left, and restoring the phase exp(2ipi f0 t) of the first frequency */
+  double deltat = 1./(N*deltaf);
+  double* times = (*timeseries)->times->data;
+  double* htdreal = (*timeseries)->h_real->data;
+  double* htdimag = (*timeseries)->h_imag->data;
+  /* The phase is linear in i - phasors obtained by recurrence, in blocks of PHASOR_REANCHOR */
+  double complex phaseneg[PHASOR_REANCHOR];
+  double complex phasepos[PHASOR_REANCHOR];
+  double dphase = 2*PI*f0*deltat;
+  for(int ib=0; ib<N/2; ib+=PHASOR_REANCHOR) {
+    int nb = min(PHASOR_REANCHOR, N/2 - ib);
+    Phasor_Fill(phaseneg, 2*PI*f0*((ib-N/2)*deltat), dphase, nb);
+    Phasor_Fill(phasepos, 2*PI*f0*(ib*deltat), dphase, nb);
+    for(int i=ib; i<ib+nb; i++) {
+      double complex valneg = phaseneg[i-ib] * out[N/2+i];
+      double complex valpos = phasepos[i-ib] * out[i];
+      times[i] = (i-N/2)*deltat;
+      times[N/2+i] = i*deltat;
+      htdreal[i] = creal(valneg);
+      htdimag[i] = cimag(valneg);
+      htdreal[N/2+i] = creal(valpos);
+      htdimag[N/2+i] = cimag(valpos);
+    }
+  }
+
+  return SUCCESS;
+}
+
+/***************** Segmented power spectrum of streamed time series *****************/
+
+void StreamingSpectrum_Init(StreamingSpectrum** spectrum, int nchan, int nseg, double deltat, double t0, double tend, double twindowbeg, double twindowend)
+{
+  if(nseg<4 || (nseg & (nseg-1))!=0) {
+    printf("Error in StreamingSpectrum_Init: nseg must be a power of 2.\n");
+    exit(1);
+  }
+  if(!(*spectrum)) *spectrum = (StreamingSpectrum*) malloc(sizeof(StreamingSpectrum));
+  (*spectrum)->nchan = nchan;
+  (*spectrum)->nseg = nseg;
+  (*spectrum)->deltat = deltat;
+  (*spectrum)->t0 = t0;
+  (*spectrum)->tend = tend;
+  /* Window extents rounded to the sampling, as in FFTRealTimeSeries */
+  (*spectrum)->deltatwindowbeg = ceil(twindowbeg/deltat) * deltat;
+  (*spectrum)->deltatwindowend = ceil(twindowend/deltat) * deltat;
+  /* The first segment starts with nseg/2 zeros, so that all samples are covered by two windows */
+  (*spectrum)->segment = (double*) calloc(nchan*nseg, sizeof(double));
+  (*spectrum)->nfilled = nseg/2;
+  (*spectrum)->nsamples = 0;
+  (*spectrum)->nsegments = 0;
+  (*spectrum)->freq = gsl_vector_alloc(nseg/2);
+  (*spectrum)->power = gsl_matrix_calloc(nchan, nseg/2);
+  double deltaf = 1./(nseg*deltat);
+  for(int i=0; i<nseg/2; i++) gsl_vector_set((*spectrum)->freq, i, i*deltaf);
+}
+
+void StreamingSpectrum_Cleanup(StreamingSpectrum* spectrum)
+{
+  free(spectrum->segment);
+  gsl_vector_free(spectrum->freq);
+  gsl_matrix_free(spectrum->power);
+  free(spectrum);
+}
+
+/* Windows and transforms the current segment of all channels, accumulates the power, and slides by half a segment */
+static void StreamingSpectrum_TransformSegment(StreamingSpectrum* spectrum)
+{
+  int nseg = spectrum->nseg;
+  FFTCachedPlan* cached = FFTGetPlan(nseg, FFTr2c);
+  double* in = (double*) cached->in;
+  fftw_complex* out = (fftw_complex*) cached->out;
+  double deltat2 = spectrum->deltat * spectrum->deltat;
+  for(int chan=0; chan<spectrum->nchan; chan++) {
+    double* seg = &(spectrum->segment[chan*nseg]);
+    for(int j=0; j<nseg; j++) in[j] = sin(PI*(j+0.5)/nseg) * seg[j];
+    fftw_execute(cached->plan);
+    double* power = gsl_matrix_ptr(spectrum->power, chan, 0);
+    for(int i=0; i<nseg/2; i++) {
+      power[i] += deltat2 * (creal(out[i])*creal(out[i]) + cimag(out[i])*cimag(out[i]));
+    }
+    memmove(seg, &(seg[nseg/2]), sizeof(double)*(nseg/2));
+  }
+  spectrum->nsegments++;
+  spectrum->nfilled = nseg/2;
+}
+
+void StreamingSpectrum_Push(StreamingSpectrum* spectrum, double** h, int nsamples)
+{
+  int nseg = spectrum->nseg;
+  double deltat = spectrum->deltat;
+  int i = 0;
+  while(i<nsamples) {
+    int ncopy = min(nsamples - i, nseg - spectrum->nfilled);
+    for(int k=0; k<ncopy; k++) {
+      /* Same tapering of the full series as in FFTRealTimeSeries */
+      double t = spectrum->t0 + (spectrum->nsamples + k)*deltat;
+      double window = WindowFunctionRight(t, spectrum->t0, spectrum->deltatwindowbeg) * WindowFunctionLeft(t, spectrum->tend, spectrum->deltatwindowend);
+      for(int chan=0; chan<spectrum->nchan; chan++) {
+        spectrum->segment[chan*nseg + spectrum->nfilled + k] = window * h[chan][i+k];
+      }
+    }
+    spectrum->nfilled += ncopy;
+    spectrum->nsamples += ncopy;
+    i += ncopy;
+    if(spectrum->nfilled==nseg) StreamingSpectrum_TransformSegment(spectrum);
+  }
+}
+
+void StreamingSpectrum_Finalize(StreamingSpectrum* spectrum)
+{
+  int nseg = spectrum->nseg;
+  if(spectrum->nsamples==0) return;
+  /* Samples in the first half of the current segment have been covered by one window, those in the second half by none */
+  int nfilled = spectrum->nfilled;
+  for(int chan=0; chan<spectrum->nchan; chan++) {
+    for(int j=nfilled; j<nseg; j++) spectrum->segment[chan*nseg + j] = 0.;
+  }
+  StreamingSpectrum_TransformSegment(spectrum);
+  /* Samples in the second half of the last segment need one more, 0-padded segment */
+  if(nfilled>nseg/2) {
+    for(int chan=0; chan<spectrum->nchan; chan++) {
+      for(int j=nseg/2; j<nseg; j++) spectrum->segment[chan*nseg + j] = 0.;
+    }
+    StreamingSpectrum_TransformSegment(spectrum);
+  }
+}
+
+int Read_TimeSeriesFileSampling(double* t0, double* deltat, int* nblines, const char dir[], const char file[], int ncols, int binary)
+{
+  /* Columnar files: sampling from the header, without reading the data */
+  if(binary==FILE_COLUMNAR || IsColumnarFile(dir, file)) {
+    ColumnarFile* cf = NULL;
+    if(ColumnarFile_Open(&cf, dir, file, 0)==FAILURE) return(FAILURE);
+    int ret = SUCCESS;
+    if(cf->header.ncols!=ncols || cf->header.nrows<2 || cf->header.nrows>INT32_MAX) {
+      fprintf(stderr, "Error reading data from %s/%s: expected %d columns and at least 2 rows.\n", dir, file, ncols);
+      ret = FAILURE;
+    }
+    else {
+      *nblines = (int) cf->header.nrows;
+      *t0 = cf->header.x0;
+      *deltat = (cf->header.deltax!=0.) ? cf->header.deltax : ColumnarFile_Column(cf, 0)[1] - ColumnarFile_Column(cf, 0)[0];
+    }
+    ColumnarFile_Close(cf);
+    return ret;
+  }
+
+  char *path=malloc(strlen(dir)+strlen(file)+2);
+  sprintf(path,"%s/%s", dir, file);
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    fprintf(stderr, "Error reading data from %s\n", path);
+    free(path);
+    return(FAILURE);
+  }
+  double* rows = (double*) malloc(sizeof(double)*2*ncols);
+  int ok = 1;
+  if(binary) ok = (fread(rows, sizeof(double), 2*ncols, f) == (size_t) (2*ncols));
+  else for(int k=0; k<2*ncols && ok; k++) ok = (fscanf(f, "%lg", &(rows[k])) == 1);
+  fclose(f);
+  if(!ok) {
+    fprintf(stderr, "Error reading data from %s\n", path);
+    free(path);
+    free(rows);
+    return(FAILURE);
+  }
+  *t0 = rows[0];
+  *deltat = rows[ncols] - rows[0];
+  free(path);
+  free(rows);
+  return(SUCCESS);
+}
+
+int StreamingSpectrum_PushFile(StreamingSpectrum* spectrum, const char dir[], const char file[], int nblines, int binary)
+{
+  /* Columnar files: the mapped columns are pushed in place - pages are loaded by the system as the segments advance */
+  if(binary==FILE_COLUMNAR || IsColumnarFile(dir, file)) {
+    ColumnarFile* cf = NULL;
+    if(ColumnarFile_Open(&cf, dir, file, 1)==FAILURE) return(FAILURE);
+    if(cf->header.ncols!=spectrum->nchan+1) {
+      fprintf(stderr, "Error reading data from %s/%s: expected %d columns.\n", dir, file, spectrum->nchan+1);
+      ColumnarFile_Close(cf);
+      return(FAILURE);
+    }
+    double** h = (double**) malloc(sizeof(double*)*spectrum->nchan);
+    int nblock = spectrum->nseg/2;
+    for(int64_t iline=0; iline<cf->header.nrows; iline+=nblock) {
+      int nrows = (int) (cf->header.nrows - iline < nblock ? cf->header.nrows - iline : nblock);
+      for(int chan=0; chan<spectrum->nchan; chan++) h[chan] = ColumnarFile_Column(cf, chan+1) + iline;
+      StreamingSpectrum_Push(spectrum, h, nrows);
+    }
+    free(h);
+    ColumnarFile_Close(cf);
+    return(SUCCESS);
+  }
+
+  char *path=malloc(strlen(dir)+strlen(file)+2);
+  sprintf(path,"%s/%s", dir, file);
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    fprintf(stderr, "Error reading data from %s\n", path);
+    free(path);
+    return(FAILURE);
+  }
+
+  /* Rows are read by blocks of half a segment - the first column (times) is skipped, assuming linear sampling */
+  int nchan = spectrum->nchan;
+  int ncols = nchan + 1;
+  int nblock = spectrum->nseg/2;
+  double* rows = (double*) malloc(sizeof(double)*nblock*ncols);
+  double** h = (double**) malloc(sizeof(double*)*nchan);
+  for(int chan=0; chan<nchan; chan++) h[chan] = (double*) malloc(sizeof(double)*nblock);
+  int ret = SUCCESS;
+  for(int iline=0; iline<nblines && ret==SUCCESS; iline+=nblock) {
+    int nrows = min(nblock, nblines - iline);
+    int ok = 1;
+    if(binary) ok = (fread(rows, sizeof(double), nrows*ncols, f) == (size_t) (nrows*ncols));
+    else for(int k=0; k<nrows*ncols && ok; k++) ok = (fscanf(f, "%lg", &(rows[k])) == 1);
+    if(!ok) {
+      fprintf(stderr, "Error reading data from %s\n", path);
+      ret = FAILURE;
+      break;
+    }
+    for(int r=0; r<nrows; r++) {
+      for(int chan=0; chan<nchan; chan++) h[chan][r] = rows[r*ncols + 1 + chan];
+    }
+    StreamingSpectrum_Push(spectrum, h, nrows);
+  }
+
   /* Clean up */
-  gsl_vector_free(hrealvalues);
-  gsl_vector_free(himagvalues);
-  fftw_destroy_plan(p);
-  fftw_free(in);
-  fftw_free(out);
+  fclose(f);
+  free(path);
+  free(rows);
+  for(int chan=0; chan<nchan; chan++) free(h[chan]);
+  free(h);
+  return ret;
+}
 
+int StreamingSpectrum_GetFrequencySeries(ReImFrequencySeries** freqseries, StreamingSpectrum* spectrum, int chan)
+{
+  int n = spectrum->nseg/2;
+  ReImFrequencySeries_Init(freqseries, n);
+  gsl_vector_memcpy((*freqseries)->freq, spectrum->freq);
+  for(int i=0; i<n; i++) {
+    gsl_vector_set((*freqseries)->h_real, i, sqrt(gsl_matrix_get(spectrum->power, chan, i)));
+  }
+  gsl_vector_set_zero((*freqseries)->h_imag);
   return SUCCESS;
 }
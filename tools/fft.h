@@ -38,6 +38,22 @@
 #include "constants.h"
 #include "struct.h"
 
+/* Enumerator to choose the FFTW planning effort for the cached plans */
+typedef enum FFTPlannertag {
+  FFTestimate,
+  FFTmeasure,
+  FFTpatient
+} FFTPlannertag;
+
+/* FFTW plans setup */
+/* Plans are cached per (size, kind of transform) and per thread, together with aligned input/output buffers reused across calls */
+FFTPlannertag ParseFFTPlannertag(char* string);
+/* Sets the planning effort of new plans, imports wisdom from wisdomfile and exports it at exit (empty string to ignore), sets the number of threads for large transforms (needs FFTW_THREADS) */
+void FFTSetup(FFTPlannertag planner, const char* wisdomfile, int nthreads);
+/* Destroys the plans and buffers cached by all threads - registered with atexit when the first plan is created, can also be called before */
+/* Must be called outside of parallel regions, when no thread is using the FFT functions - the threads create new plans if they are called again */
+void FFTPlanCache_Cleanup(void);
+
 /* Window functions */
 double WindowFunction(double x, double xi, double xf, double deltaxi, double deltaxf);
 double WindowFunctionLeft(double x, double xf, double deltaxf);
@@ -61,6 +77,46 @@ int FFTTimeSeries(
   double twindowend,                  /* Extent of the window at the end (end at the last point) */
   int nzeropad);                      /* For 0-padding: length will be (upper power of 2)*2^nzeropad */
 
+/* Segmented (Welch-style) power spectrum of real multi-channel time series, fed by chunks */
+/* Segments of nseg samples overlap by 50% and carry sine windows, whose squares sum to one: the sum over segments of |h_k(f)|^2 reproduces the (h|h) of the full FFT for noise smooth on the scale 1/(nseg*deltat) */
+/* Only the current segment of each channel is kept in memory - the full 0-padded series is never built */
+typedef struct tagStreamingSpectrum {
+  int nchan;                 /* Number of channels */
+  int nseg;                  /* Number of samples in a segment - power of 2 */
+  double deltat;             /* Time step of the input */
+  double t0;                 /* Time of the first sample */
+  double tend;               /* Time of the last sample */
+  double deltatwindowbeg;    /* Extent of the tapering window at the beginning (starts at the first point) */
+  double deltatwindowend;    /* Extent of the tapering window at the end (ends at the last point) */
+  double* segment;           /* Current segment, nseg samples for each channel */
+  int nfilled;               /* Number of samples already in the current segment */
+  long nsamples;             /* Number of input samples pushed so far */
+  int nsegments;             /* Number of segments transformed so far */
+  gsl_vector* freq;          /* Frequencies of the segment spectra, nseg/2 values (Nyquist dropped, as in FFTRealTimeSeries) */
+  gsl_matrix* power;         /* Sum over segments of |h_k(f)|^2 - one row per channel */
+} StreamingSpectrum;
+
+void StreamingSpectrum_Init(
+  StreamingSpectrum** spectrum,       /* Output: initialized accumulator */
+  int nchan,                          /* Number of channels */
+  int nseg,                           /* Number of samples in a segment - power of 2 */
+  double deltat,                      /* Time step of the input */
+  double t0,                          /* Time of the first sample */
+  double tend,                        /* Time of the last sample */
+  double twindowbeg,                  /* Extent of the window at beginning (starts at the first point) */
+  double twindowend);                 /* Extent of the window at the end (end at the last point) */
+void StreamingSpectrum_Cleanup(StreamingSpectrum* spectrum);
+/* Feeds nsamples consecutive samples of all channels, h[chan][i] */
+void StreamingSpectrum_Push(StreamingSpectrum* spectrum, double** h, int nsamples);
+/* Transforms the last, 0-padded segments - to be called once all samples have been pushed */
+void StreamingSpectrum_Finalize(StreamingSpectrum* spectrum);
+/* Feeds a file with columns t, h_1, ..., h_nchan, in text, binary (gsl_matrix_fwrite) or columnar format, without loading it - nblines is ignored for columnar files */
+int StreamingSpectrum_PushFile(StreamingSpectrum* spectrum, const char dir[], const char file[], int nblines, int binary);
+/* Reads the first two times of such a file, for the initialization of the accumulator - for columnar files, nblines is also set from the header */
+int Read_TimeSeriesFileSampling(double* t0, double* deltat, int* nblines, const char dir[], const char file[], int ncols, int binary);
+/* Downsampled spectrum of one channel, as sqrt of the accumulated power in h_real and 0 in h_imag (phases are not kept) */
+int StreamingSpectrum_GetFrequencySeries(ReImFrequencySeries** freqseries, StreamingSpectrum* spectrum, int chan);
+
 /* IFFT of frequency series */
 /* Note: assumes frequency series is FT of real data */
 /* Note: FFT uses flipped convention (i.e. h(f) = int e^(+2ipift)h(t)) */
@@ -85,6 +141,14 @@ int IFFTFrequencySeries(
   double f2windowend,                /* End of window at the end */
   int nzeropad);                     /* For 0-padding: length will be (upper power of 2)*2^nzeropad */
 
+/* Integral of a complex frequency series against exp(2ipi f t), for a grid of time shifts t - one FFT for all the shifts */
+/* I(t) = int df a(f) exp(2ipi f t), trapezoidal rule on a linear grid of frequencies - output times are t_j = j/(N deltaf), for j in [-N/2, N/2[ */
+/* Note: gives the time-shifted inner products (h exp(2ipi f t)|s) = Re I(t) for a(f) = 4 h conj(s)/Sn */
+int IFFTTimeShiftIntegral(
+  ReImTimeSeries** timeseries,       /* Output: complex time series I(t) */
+  ReImFrequencySeries* freqseries,   /* Input: complex integrand a(f), on a linear grid of frequencies */
+  int nzeropad);                     /* For 0-padding: length will be (upper power of 2)*2^nzeropad */
+
 #if 0
 { /* so that editors will match succeeding brace */
 #elif defined(__cplusplus)
@@ -390,13 +390,37 @@ double complex ComputeIntCase4(
   return term1 + term2;
 }
 
+/* Branching between cases 1a, 1b, 2, 3 and 4 for one interval rescaled to [0,1], with the constant amplitude term scaled out */
+static double complex ComputeIntInterval(
+  const double complex* coeffsA,         /* Amplitude coefficients, coeffsA[0]=1 */
+  const double p1,                       /* Linear phase coefficient on [0,1] */
+  const double p2,                       /* Quadratic phase coefficient on [0,1] */
+  const double A0abs)                    /* Modulus of the amplitude scaled out, for the accuracy of cases 1a and 1b */
+{
+  double absp1 = fabs(p1); double absp2 = fabs(p2);
+  if(absp1<p1threshold1 && absp2<p2threshold) {
+    return ComputeIntCase1a(coeffsA, p1, p2, A0abs);
+  }
+  else if(p1threshold1<=absp1 && absp1<p1threshold2 && absp2<p2threshold) {
+    return ComputeIntCase1b(coeffsA, p1, p2, A0abs);
+  }
+  else if(absp2>=p2p1slopethreshold*absp1 && absp2>=p2threshold) {
+    return ComputeIntCase2(coeffsA, p1, p2);
+  }
+  else if(absp2<p2p1slopethreshold*absp1 && absp2>=p2threshold && absp1<p1threshold2) {
+    return ComputeIntCase3(coeffsA, p1, p2);
+  }
+  else {
+    return ComputeIntCase4(coeffsA, p1, p2);
+  }
+}
+
 double complex ComputeInt(
   gsl_matrix* splinecoeffsAreal,         /*  */
   gsl_matrix* splinecoeffsAimag,         /*  */
   gsl_matrix* quadsplinecoeffsphase)     /*  */
 {
   double complex res = 0.;
-  double complex resint = 0.;
   /* Number of points - i.e. nb of intervals + 1 */
   /* Assumes that the dimensions match and that the frequency vectors are the same between the different splinecoeffs */
   int nbpts = (int) quadsplinecoeffsphase->size1;
@@ -424,23 +448,57 @@ double complex ComputeInt(
     /* Factor scaled out */
     double complex factor = eps * A0 * cexp(I*p0);
 
-    double absp1 = fabs(p1); double absp2 = fabs(p2);
-    if(absp1<p1threshold1 && absp2<p2threshold) {
-      resint = factor * ComputeIntCase1a(coeffsA, p1, p2, A0abs);
-    }
-    else if(p1threshold1<=absp1 && absp1<p1threshold2 && absp2<p2threshold) {
-      resint = factor * ComputeIntCase1b(coeffsA, p1, p2, A0abs);
-    }
-    else if(absp2>=p2p1slopethreshold*absp1 && absp2>=p2threshold) {
-      resint = factor * ComputeIntCase2(coeffsA, p1, p2);
-    }
-    else if(absp2<p2p1slopethreshold*absp1 && absp2>=p2threshold && absp1<p1threshold2) {
-      resint = factor * ComputeIntCase3(coeffsA, p1, p2);
-    }
-    else {
-      resint = factor * ComputeIntCase4(coeffsA, p1, p2);
+    res += factor * ComputeIntInterval(coeffsA, p1, p2, A0abs);
+  }
+
+  return res;
+}
+
+/* Sum over ndet channels of the integrals of A_k exp(I*(Psi + slope_k*f)), sharing the phase Psi and the frequency grid */
+/* The linear phases slope_k*f (e.g. time delays between detectors) are absorbed in p0 and p1 interval by interval, so they never enter the splines */
+double complex ComputeIntNDet(
+  const int ndet,                        /* Number of channels */
+  gsl_matrix** splinecoeffsAreal,        /* Splines of the real parts of the amplitudes, ndet matrices */
+  gsl_matrix** splinecoeffsAimag,        /* Splines of the imaginary parts of the amplitudes, ndet matrices */
+  gsl_matrix* quadsplinecoeffsphase,     /* Quadratic spline of the common phase */
+  const double* phaseslopes,             /* Slopes of the additional linear phases, ndet values */
+  double complex* resdet)                /* Output: integral of each channel, ndet values - NULL to ignore */
+{
+  double complex res = 0.;
+  if(resdet) for(int k=0; k<ndet; k++) resdet[k] = 0.;
+  /* Number of points - i.e. nb of intervals + 1 */
+  int nbpts = (int) quadsplinecoeffsphase->size1;
+
+  for(int j=0; j<nbpts-1; j++) {
+    double f = gsl_matrix_get(quadsplinecoeffsphase, j, 0);
+    double eps = gsl_matrix_get(quadsplinecoeffsphase, j+1, 0) - f;
+    double epspow[4];
+    epspow[0] = 1.;
+    epspow[1] = eps;
+    epspow[2] = eps*eps;
+    epspow[3] = eps*epspow[2];
+    double p0 = gsl_matrix_get(quadsplinecoeffsphase, j, 1);
+    double p1 = gsl_matrix_get(quadsplinecoeffsphase, j, 2);
+    double p2 = gsl_matrix_get(quadsplinecoeffsphase, j, 3) * epspow[2];
+
+    for(int k=0; k<ndet; k++) {
+      double complex A0 = gsl_matrix_get(splinecoeffsAreal[k], j, 1) + I*gsl_matrix_get(splinecoeffsAimag[k], j, 1);
+      if(A0==0.) continue;
+      double complex A0inv = 1./A0;
+      double A0abs = cabs(A0);
+      double complex coeffsA[4] = {0.,0.,0.,0.};
+      coeffsA[0] = 1.;
+      for(int i=1; i<=3; i++) coeffsA[i] = epspow[i] * A0inv * (gsl_matrix_get(splinecoeffsAreal[k], j, i+1) + I*gsl_matrix_get(splinecoeffsAimag[k], j, i+1));
+
+      /* Shifting the phase of the interval by the linear term of the channel */
+      double p0k = p0 + phaseslopes[k]*f;
+      double p1k = (p1 + phaseslopes[k]) * eps;
+      double complex factor = eps * A0 * cexp(I*p0k);
+
+      double complex resk = factor * ComputeIntInterval(coeffsA, p1k, p2, A0abs);
+      res += resk;
+      if(resdet) resdet[k] += resk;
     }
-    res += resint;
   }
 
   return res;
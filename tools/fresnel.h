@@ -49,6 +49,15 @@ double complex ComputeInt(
   gsl_matrix* splinecoeffsAimag,         /*  */
   gsl_matrix* splinecoeffsphase);        /*  */
 
+/* Sum over ndet channels of the integrals of A_k exp(I*(Psi + slope_k*f)), with amplitude splines on the grid of the common phase Psi */
+double complex ComputeIntNDet(
+  const int ndet,                        /* Number of channels */
+  gsl_matrix** splinecoeffsAreal,        /* Splines of the real parts of the amplitudes, ndet matrices */
+  gsl_matrix** splinecoeffsAimag,        /* Splines of the imaginary parts of the amplitudes, ndet matrices */
+  gsl_matrix* quadsplinecoeffsphase,     /* Quadratic spline of the common phase */
+  const double* phaseslopes,             /* Slopes of the additional linear phases, ndet values */
+  double complex* resdet);               /* Output: integral of each channel, ndet values - NULL to ignore */
+
 double complex ComputeIntCase1a(
   const double complex* coeffsA,         /* */
   const double p1,                       /* */
@@ -186,7 +186,7 @@ double FDSinglemodeLogLinearOverlap(
   double fmax0 = fmin(fHigh, fmin(fmax1, fmax2));
 
   /* Vector of frequencies with logarithmic spacing */
-  gsl_vector* freqvector = gsl_vector_alloc(nbpts);
+  gsl_vector* freqvector = ArenaVectorAlloc(nbpts);
   SetLogFrequencies(freqvector, fmin0, fmax0, nbpts);
 
   /* Initializing the splines */
@@ -203,7 +203,7 @@ double FDSinglemodeLogLinearOverlap(
   gsl_spline* amp2imag = gsl_spline_alloc(gsl_interp_cspline, size2);
   gsl_spline* phase1 = gsl_spline_alloc(gsl_interp_cspline, size1);
   gsl_spline* phase2 = gsl_spline_alloc(gsl_interp_cspline, size2);
-  gsl_vector* valuesvector = gsl_vector_alloc(nbpts);
+  gsl_vector* valuesvector = ArenaVectorAlloc(nbpts);
   gsl_spline_init(amp1real, gsl_vector_const_ptr(freqseries1->freq,0), gsl_vector_const_ptr(freqseries1->amp_real,0), size1);
   gsl_spline_init(amp1imag, gsl_vector_const_ptr(freqseries1->freq,0), gsl_vector_const_ptr(freqseries1->amp_imag,0), size1);
   gsl_spline_init(amp2real, gsl_vector_const_ptr(freqseries2->freq,0), gsl_vector_const_ptr(freqseries2->amp_real,0), size2);
@@ -234,8 +234,8 @@ double FDSinglemodeLogLinearOverlap(
   res = TrapezeIntegrate(freqvector, valuesvector);
 
   /* Clean up */
-  gsl_vector_free(freqvector);
-  gsl_vector_free(valuesvector);
+  ArenaVectorFree(freqvector);
+  ArenaVectorFree(valuesvector);
   gsl_interp_accel_free(accel_amp1real);
   gsl_interp_accel_free(accel_amp2real);
   gsl_interp_accel_free(accel_amp1imag);
@@ -289,7 +289,7 @@ double FDListmodesLogLinearOverlap(
   maxf = fmin(maxf1, maxf2);
 
   /* Vector of frequencies used for the overlap */
-  gsl_vector* freqoverlap = gsl_vector_alloc(nbpts);
+  gsl_vector* freqoverlap = ArenaVectorAlloc(nbpts);
   SetLogFrequencies(freqoverlap, minf, maxf, nbpts);
 
   /* Evaluating each frequency series by interpolating and summing the mode contributions */
@@ -301,7 +301,7 @@ double FDListmodesLogLinearOverlap(
   ReImFrequencySeries_SumListmodesCAmpPhaseFrequencySeries(freqseries2, list2, freqoverlap, fLow, fHigh, fstartobs2);
 
   /* Compute the integrand */
-  gsl_vector* valuesoverlap = gsl_vector_alloc(nbpts);
+  gsl_vector* valuesoverlap = ArenaVectorAlloc(nbpts);
   double* hreal1data = freqseries1->h_real->data;
   double* himag1data = freqseries1->h_imag->data;
   double* hreal2data = freqseries2->h_real->data;
@@ -317,8 +317,8 @@ double FDListmodesLogLinearOverlap(
   /* Clean up */
   ReImFrequencySeries_Cleanup(freqseries1);
   ReImFrequencySeries_Cleanup(freqseries2);
-  gsl_vector_free(freqoverlap);
-  gsl_vector_free(valuesoverlap);
+  ArenaVectorFree(freqoverlap);
+  ArenaVectorFree(valuesoverlap);
 
   return overlap;
 }
@@ -348,7 +348,7 @@ double FDOverlapReImvsListmodesCAmpPhase(
   ReImFrequencySeries_SumListmodesCAmpPhaseFrequencySeries(freqseries2, list2, freqoverlap, fLow, fHigh, fstartobs2);
 
   /* Compute the integrand */
-  gsl_vector* valuesoverlap = gsl_vector_alloc(nbpts);
+  gsl_vector* valuesoverlap = ArenaVectorAlloc(nbpts);
   double* hreal1data = freqseries1->h_real->data;
   double* himag1data = freqseries1->h_imag->data;
   double* hreal2data = freqseries2->h_real->data;
@@ -363,7 +363,7 @@ double FDOverlapReImvsListmodesCAmpPhase(
 
   /* Clean up */
   ReImFrequencySeries_Cleanup(freqseries2);
-  gsl_vector_free(valuesoverlap);
+  ArenaVectorFree(valuesoverlap);
 
   return overlap;
 }
@@ -385,7 +385,7 @@ double FDOverlapReImvsReIm(
   int nbpts = (int) freqoverlap->size;
 
   /* Compute the integrand */
-  gsl_vector* valuesoverlap = gsl_vector_alloc((int) freqoverlap->size);
+  gsl_vector* valuesoverlap = ArenaVectorAlloc((int) freqoverlap->size);
   double* hreal1data = freqseries1->h_real->data;
   double* himag1data = freqseries1->h_imag->data;
   double* hreal2data = freqseries2->h_real->data;
@@ -399,7 +399,7 @@ double FDOverlapReImvsReIm(
   double overlap = TrapezeIntegrate(freqoverlap, valuesoverlap);
 
   /* Clean up */
-  gsl_vector_free(valuesoverlap);
+  ArenaVectorFree(valuesoverlap);
 
   return overlap;
 }
@@ -925,6 +925,251 @@ double FDSinglemodeFresnelOverlap3Chan(
 }
 
 
+/* Function computing the integrand values for a network of non-correlated detectors, from two modes given before the response - single pass on the frequency grid of wf 1 */
+/* The response of each detector is a constant factor and a linear phase (time delay): the common phase phi1-phi2 is returned once, the linear phases are left to the Fresnel kernel */
+static int ComputeIntegrandValuesNetwork(
+  gsl_vector** freq,                        /* Output: common frequencies (allocated in the function) */
+  gsl_vector** phase,                       /* Output: common phase phi1-phi2 (allocated in the function) */
+  gsl_matrix** ampreal,                     /* Output: real parts of the amplitudes, one row per detector (allocated in the function) */
+  gsl_matrix** ampimag,                     /* Output: imaginary parts of the amplitudes, one row per detector (allocated in the function) */
+  CAmpPhaseFrequencySeries* freqseries1,    /* Input: frequency series for wf 1 */
+  CAmpPhaseSpline* splines2,                /* Input: splines in matrix form for wf 2 */
+  const int ndet,                           /* Input: number of detectors */
+  const double complex* factors,            /* Input: products of the factors of the response, factor1*conj(factor2), for each detector */
+  ObjectFunction** Snoises,                 /* Input: noise functions of the detectors */
+  const int* curves,                        /* Input: index of the noise curve of each detector, row in invSn */
+  gsl_matrix* invSn,                        /* Input: 1/Sn for each distinct noise curve, on the frequencies of freqseries1 */
+  double fLow,                              /* Lower bound of the frequency - 0 to ignore */
+  double fHigh)                             /* Upper bound of the frequency - 0 to ignore */
+{
+  gsl_set_error_handler(&Err_Handler);
+
+  /* Determining the boundaries of indices */
+  gsl_vector* freq1 = freqseries1->freq;
+  int imin1 = 0;
+  int imax1 = freq1->size - 1;
+  double* f1 = freq1->data;
+  double f2min = gsl_matrix_get(splines2->quadspline_phase, 0, 0);
+  double f2max = gsl_matrix_get(splines2->quadspline_phase, splines2->quadspline_phase->size1 - 1, 0);
+  if((fLow>0 && (f1[imax1]<=fLow || f2max<=fLow)) || (fHigh>0 && (f1[imin1]>=fHigh || f2min>=fHigh))) return -1;
+  /* If starting outside, move the ends of the frequency series to be just outside the final minf and maxf */
+  double minf = fmax(f1[imin1], f2min);
+  double maxf = fmin(f1[imax1], f2max);
+  if(fLow>0) {minf = fmax(fLow, minf);}
+  if(fHigh>0) {maxf = fmin(fHigh, maxf);}
+  while(f1[imin1+1]<=minf) imin1++;
+  while(f1[imax1-1]>=maxf) imax1--;
+  int nbpts = imax1 + 1 - imin1;
+  if(nbpts<4) return -1;
+  /* Estimate locally values for freqseries1 at the boundaries */
+  double areal1minf = EstimateBoundaryLegendreQuad(freq1, freqseries1->amp_real, imin1, minf);
+  double aimag1minf = EstimateBoundaryLegendreQuad(freq1, freqseries1->amp_imag, imin1, minf);
+  double phi1minf = EstimateBoundaryLegendreQuad(freq1, freqseries1->phase, imin1, minf);
+  double areal1maxf = EstimateBoundaryLegendreQuad(freq1, freqseries1->amp_real, imax1-2, maxf); /* Note the imax1-2 */
+  double aimag1maxf = EstimateBoundaryLegendreQuad(freq1, freqseries1->amp_imag, imax1-2, maxf); /* Note the imax1-2 */
+  double phi1maxf = EstimateBoundaryLegendreQuad(freq1, freqseries1->phase, imax1-2, maxf); /* Note the imax1-2 */
+
+  /* Initializing output */
+  *freq = ArenaVectorAlloc(nbpts);
+  *phase = ArenaVectorAlloc(nbpts);
+  *ampreal = ArenaMatrixAlloc(ndet, nbpts);
+  *ampimag = ArenaMatrixAlloc(ndet, nbpts);
+
+  /* Loop computing integrand values - the product of the modes is computed once, and only weighted by each detector */
+  double f, eps, eps2, eps3, ampreal1, ampimag1, phase1, ampreal2, ampimag2, phase2;
+  double complex camp, campdet;
+  double* areal1 = freqseries1->amp_real->data;
+  double* aimag1 = freqseries1->amp_imag->data;
+  double* phi1 = freqseries1->phase->data;
+  gsl_matrix* splineAreal2 = splines2->spline_amp_real;
+  gsl_matrix* splineAimag2 = splines2->spline_amp_imag;
+  gsl_matrix* quadsplinephase2 = splines2->quadspline_phase;
+  int i2 = 0; int j = 0;
+  for(int i=imin1; i<=imax1; i++) {
+    /* Distinguish the case where we are at minf or maxf */
+    if(i==imin1) {
+      f = minf;
+      ampreal1 = areal1minf;
+      ampimag1 = aimag1minf;
+      phase1 = phi1minf;
+    }
+    else if(i==imax1) {
+      f = maxf;
+      ampreal1 = areal1maxf;
+      ampimag1 = aimag1maxf;
+      phase1 = phi1maxf;
+    }
+    else {
+      f = f1[i];
+      ampreal1 = areal1[i];
+      ampimag1 = aimag1[i];
+      phase1 = phi1[i];
+    }
+    /* Adjust the index in the spline if necessary and compute */
+    while(gsl_matrix_get(quadsplinephase2, i2+1, 0)<f) i2++;
+    eps = f - gsl_matrix_get(quadsplinephase2, i2, 0);
+    eps2 = eps*eps;
+    eps3 = eps2*eps;
+    gsl_vector_view coeffsampreal2 = gsl_matrix_row(splineAreal2, i2);
+    gsl_vector_view coeffsampimag2 = gsl_matrix_row(splineAimag2, i2);
+    gsl_vector_view coeffsphase2 = gsl_matrix_row(quadsplinephase2, i2);
+    ampreal2 = EvalCubic(&coeffsampreal2.vector, eps, eps2, eps3);
+    ampimag2 = EvalCubic(&coeffsampimag2.vector, eps, eps2, eps3);
+    phase2 = EvalQuad(&coeffsphase2.vector, eps, eps2);
+    camp = (ampreal1 + I*ampimag1) * (ampreal2 - I*ampimag2);
+    /* 1/Sn read from the precomputed values, except at minf and maxf which are not on the grid */
+    for(int k=0; k<ndet; k++) {
+      if(i==imin1 || i==imax1) campdet = factors[k] * camp / ObjectFunctionCall(Snoises[k], f);
+      else campdet = factors[k] * camp * gsl_matrix_get(invSn, curves[k], i);
+      gsl_matrix_set(*ampreal, k, j, creal(campdet));
+      gsl_matrix_set(*ampimag, k, j, cimag(campdet));
+    }
+    gsl_vector_set(*freq, j, f);
+    gsl_vector_set(*phase, j, phase1 - phase2);
+    j++;
+  }
+  return 0;
+}
+
+/* Function identifying the distinct noise curves of a network - detectors with the same noise function share a curve - and evaluating 1/Sn once for each curve on a frequency grid */
+/* Returns the number of distinct curves - invSn is allocated in the function, one row per curve */
+static int NetworkInvSn(
+  gsl_matrix** invSn,                       /* Output: 1/Sn for each distinct noise curve, on freq (allocated in the function) */
+  int* curves,                              /* Output: index of the noise curve of each detector, ndet values */
+  gsl_vector* freq,                         /* Input: frequencies */
+  const int ndet,                           /* Input: number of detectors */
+  ObjectFunction* Snoises)                  /* Input: noise functions of the detectors, ndet values */
+{
+  int ncurves = 0;
+  int firstdet[ndet];
+  for(int k=0; k<ndet; k++) {
+    curves[k] = -1;
+    for(int c=0; c<ncurves; c++) {
+      ObjectFunction* Snoisec = &(Snoises[firstdet[c]]);
+      if(Snoises[k].object==Snoisec->object && Snoises[k].function==Snoisec->function) curves[k] = c;
+    }
+    if(curves[k]<0) {
+      firstdet[ncurves] = k;
+      curves[k] = ncurves++;
+    }
+  }
+  int n = (int) freq->size;
+  *invSn = ArenaMatrixAlloc(ncurves, n);
+  for(int c=0; c<ncurves; c++)
+    for(int i=0; i<n; i++)
+      gsl_matrix_set(*invSn, c, i, 1./ObjectFunctionCall(&(Snoises[firstdet[c]]), gsl_vector_get(freq, i)));
+  return ncurves;
+}
+
+/* Function computing the overlap (h1|h2) summed over a network of non-correlated detectors, for two modes given before the response, one being already interpolated */
+/* The response of each detector is a constant factor and a linear phase (time delay), as for ground-based detectors */
+/* One pass on the frequency grid and one phase spline for the whole network - the difference of the delays of h1 and h2 enters the Fresnel kernel */
+/* Version taking the values of 1/Sn precomputed on the frequencies of h1 - shared by the detectors with the same noise curve, and by all the modes h2 */
+/* The contribution of each detector is added to overlapdet, if not NULL */
+static double FDSinglemodeFresnelOverlapNetworkInvSn(
+  struct tagCAmpPhaseFrequencySeries *freqseries1, /* First mode h1 before the response, in amplitude/phase form */
+  struct tagCAmpPhaseSpline *splines2,             /* Second mode h2 before the response, already interpolated in matrix form */
+  const int ndet,                                  /* Number of detectors */
+  const double complex* factors1,                  /* Factors of the response for h1, ndet values */
+  const double complex* factors2,                  /* Factors of the response for h2, ndet values */
+  const double* twopidelays1,                      /* 2pi times the delays from geocenter to each detector for h1 (s), ndet values */
+  const double* twopidelays2,                      /* 2pi times the delays from geocenter to each detector for h2 (s), ndet values */
+  ObjectFunction* Snoises,                         /* Noise functions of the detectors, ndet values */
+  const int* curves,                               /* Index of the noise curve of each detector, row in invSn, ndet values */
+  gsl_matrix* invSn,                               /* 1/Sn for each distinct noise curve, on the frequencies of h1 */
+  double fLow,                                     /* Lower bound of the frequency window for the detectors */
+  double fHigh,                                    /* Upper bound of the frequency window for the detectors */
+  double* overlapdet)                              /* Output: contribution of each detector added to these ndet values - NULL to ignore */
+{
+  /* Keep only the detectors to which both modes contribute */
+  int nact = 0;
+  int detact[ndet];
+  double complex factors[ndet];
+  double slopes[ndet];
+  ObjectFunction* Snoisesact[ndet];
+  int curvesact[ndet];
+  for(int k=0; k<ndet; k++) {
+    double complex factor = factors1[k] * conj(factors2[k]);
+    if(factor==0.) continue;
+    factors[nact] = factor;
+    slopes[nact] = twopidelays1[k] - twopidelays2[k];
+    Snoisesact[nact] = &(Snoises[k]);
+    curvesact[nact] = curves[k];
+    detact[nact] = k;
+    nact++;
+  }
+  if(nact==0) return 0;
+
+  /* Computing the integrand values, on the frequency grid of h1 */
+  gsl_vector* freq = NULL;
+  gsl_vector* phase = NULL;
+  gsl_matrix* ampreal = NULL;
+  gsl_matrix* ampimag = NULL;
+  if(0>ComputeIntegrandValuesNetwork(&freq, &phase, &ampreal, &ampimag, freqseries1, splines2, nact, factors, Snoisesact, curvesact, invSn, fLow, fHigh)) return 0; //if allowed freq range does not exist, return 0 for overlap
+  int nbpts = (int) freq->size;
+
+  /* Rescaling the integrand - the slopes of the linear phases are rescaled accordingly */
+  double scaling = 10./gsl_vector_get(freq, nbpts-1);
+  gsl_vector_scale(freq, scaling);
+  gsl_matrix_scale(ampreal, 1./scaling);
+  gsl_matrix_scale(ampimag, 1./scaling);
+  for(int k=0; k<nact; k++) slopes[k] /= scaling;
+
+  /* Interpolating the integrand - one phase spline, amplitude splines for each detector */
+  gsl_matrix* quadsplinephase = ArenaMatrixAlloc(nbpts, 4);
+  gsl_matrix* splineAreal[nact];
+  gsl_matrix* splineAimag[nact];
+  BuildQuadSpline(quadsplinephase, freq, phase, nbpts);
+  for(int k=0; k<nact; k++) {
+    gsl_vector_view rowreal = gsl_matrix_row(ampreal, k);
+    gsl_vector_view rowimag = gsl_matrix_row(ampimag, k);
+    splineAreal[k] = ArenaMatrixAlloc(nbpts, 5);
+    splineAimag[k] = ArenaMatrixAlloc(nbpts, 5);
+    BuildNotAKnotSpline(splineAreal[k], freq, &rowreal.vector, nbpts);
+    BuildNotAKnotSpline(splineAimag[k], freq, &rowimag.vector, nbpts);
+  }
+
+  /* Computing the integral - including here the factor 4 and the real part */
+  double complex overlapact[nact];
+  double overlap = 4.*creal(ComputeIntNDet(nact, splineAreal, splineAimag, quadsplinephase, slopes, overlapdet ? overlapact : NULL));
+  if(overlapdet) for(int k=0; k<nact; k++) overlapdet[detact[k]] += 4.*creal(overlapact[k]);
+
+  /* Clean up */
+  for(int k=nact-1; k>=0; k--) {
+    ArenaMatrixFree(splineAimag[k]);
+    ArenaMatrixFree(splineAreal[k]);
+  }
+  ArenaMatrixFree(quadsplinephase);
+  ArenaMatrixFree(ampimag);
+  ArenaMatrixFree(ampreal);
+  ArenaVectorFree(phase);
+  ArenaVectorFree(freq);
+
+  return overlap;
+}
+
+/* Function computing the overlap (h1|h2) summed over a network of non-correlated detectors, for two modes given before the response, one being already interpolated */
+/* The response of each detector is a constant factor and a linear phase (time delay), as for ground-based detectors */
+double FDSinglemodeFresnelOverlapNetwork(
+  struct tagCAmpPhaseFrequencySeries *freqseries1, /* First mode h1 before the response, in amplitude/phase form */
+  struct tagCAmpPhaseSpline *splines2,             /* Second mode h2 before the response, already interpolated in matrix form */
+  const int ndet,                                  /* Number of detectors */
+  const double complex* factors1,                  /* Factors of the response for h1, ndet values */
+  const double complex* factors2,                  /* Factors of the response for h2, ndet values */
+  const double* twopidelays1,                      /* 2pi times the delays from geocenter to each detector for h1 (s), ndet values */
+  const double* twopidelays2,                      /* 2pi times the delays from geocenter to each detector for h2 (s), ndet values */
+  ObjectFunction* Snoises,                         /* Noise functions of the detectors, ndet values */
+  double fLow,                                     /* Lower bound of the frequency window for the detectors */
+  double fHigh)                                    /* Upper bound of the frequency window for the detectors */
+{
+  int curves[ndet];
+  gsl_matrix* invSn = NULL;
+  NetworkInvSn(&invSn, curves, freqseries1->freq, ndet, Snoises);
+  double overlap = FDSinglemodeFresnelOverlapNetworkInvSn(freqseries1, splines2, ndet, factors1, factors2, twopidelays1, twopidelays2, Snoises, curves, invSn, fLow, fHigh, NULL);
+  ArenaMatrixFree(invSn);
+  return overlap;
+}
+
 /* Function computing the overlap (h1|h2) between two waveforms given as list of modes, one being already interpolated, for a given noise function - two additional parameters for the starting 22-mode frequencies (then properly scaled for the other modes) for a limited duration of the observations */
 double FDListmodesFresnelOverlap(
   struct tagListmodesCAmpPhaseFrequencySeries *listh1, /* First waveform, list of modes in amplitude/phase form */
@@ -1042,3 +1287,69 @@ double FDListmodesFresnelOverlap3Chan(
 
   return overlap;
 }
+
+/* Function computing the overlap (h1|h2) summed over a network of non-correlated detectors, between two waveforms given as list of modes before the response, one being already interpolated */
+/* The response of each detector reduces to a constant factor per mode and a time delay: the modes are interpolated once for the whole network instead of once per detector */
+/* Two additional parameters for the starting 22-mode frequencies (then properly scaled for the other modes) for a limited duration of the observations */
+double FDListmodesFresnelOverlapNetwork(
+  struct tagListmodesCAmpPhaseFrequencySeries *listh1, /* First waveform before the response, list of modes in amplitude/phase form */
+  struct tagListmodesCAmpPhaseSpline *listsplines2,    /* Second waveform before the response, list of modes already interpolated in matrix form */
+  const int ndet,                                      /* Number of detectors */
+  const double complex* factors1,                      /* Factors of the response for wf 1, ndet values for each mode in the order of listh1 */
+  const double complex* factors2,                      /* Factors of the response for wf 2, ndet values for each mode in the order of listsplines2 */
+  const double* twopidelays1,                          /* 2pi times the delays from geocenter to each detector for wf 1 (s), ndet values */
+  const double* twopidelays2,                          /* 2pi times the delays from geocenter to each detector for wf 2 (s), ndet values */
+  ObjectFunction* Snoises,                             /* Noise functions of the detectors, ndet values */
+  double fLow,                                         /* Lower bound of the frequency window for the detectors */
+  double fHigh,                                        /* Upper bound of the frequency window for the detectors */
+  double fstartobs1,                                   /* Starting frequency for the 22 mode of wf 1 - as determined from a limited duration of the observation - set to 0 to ignore */
+  double fstartobs2)                                   /* Starting frequency for the 22 mode of wf 2 - as determined from a limited duration of the observation - set to 0 to ignore */
+{
+  return FDListmodesFresnelOverlapNetworkDet(NULL, listh1, listsplines2, ndet, factors1, factors2, twopidelays1, twopidelays2, Snoises, fLow, fHigh, fstartobs1, fstartobs2);
+}
+
+/* Same as FDListmodesFresnelOverlapNetwork, also returning the overlap restricted to each detector - the network total is their sum, computed in the same pass */
+double FDListmodesFresnelOverlapNetworkDet(
+  double* overlapdet,                                  /* Output: overlap of each detector, ndet values - NULL to ignore */
+  struct tagListmodesCAmpPhaseFrequencySeries *listh1, /* First waveform before the response, list of modes in amplitude/phase form */
+  struct tagListmodesCAmpPhaseSpline *listsplines2,    /* Second waveform before the response, list of modes already interpolated in matrix form */
+  const int ndet,                                      /* Number of detectors */
+  const double complex* factors1,                      /* Factors of the response for wf 1, ndet values for each mode in the order of listh1 */
+  const double complex* factors2,                      /* Factors of the response for wf 2, ndet values for each mode in the order of listsplines2 */
+  const double* twopidelays1,                          /* 2pi times the delays from geocenter to each detector for wf 1 (s), ndet values */
+  const double* twopidelays2,                          /* 2pi times the delays from geocenter to each detector for wf 2 (s), ndet values */
+  ObjectFunction* Snoises,                             /* Noise functions of the detectors, ndet values */
+  double fLow,                                         /* Lower bound of the frequency window for the detectors */
+  double fHigh,                                        /* Upper bound of the frequency window for the detectors */
+  double fstartobs1,                                   /* Starting frequency for the 22 mode of wf 1 - as determined from a limited duration of the observation - set to 0 to ignore */
+  double fstartobs2)                                   /* Starting frequency for the 22 mode of wf 2 - as determined from a limited duration of the observation - set to 0 to ignore */
+{
+  double overlap = 0;
+  int curves[ndet];
+  if(overlapdet) for(int k=0; k<ndet; k++) overlapdet[k] = 0.;
+
+  /* Main loop over the modes - goes through all the modes present */
+  int imode1 = 0;
+  ListmodesCAmpPhaseFrequencySeries* listelementh1 = listh1;
+  while(listelementh1) {
+    /* 1/Sn on the frequencies of the mode of h1, evaluated once for each distinct noise curve and used for all the modes of h2 */
+    gsl_matrix* invSn = NULL;
+    NetworkInvSn(&invSn, curves, listelementh1->freqseries->freq, ndet, Snoises);
+    int imode2 = 0;
+    ListmodesCAmpPhaseSpline* listelementsplines2 = listsplines2;
+    while(listelementsplines2) {
+      /* Scaling fstartobs1/2 with the appropriate factor of m (for the 21 mode we use m=2) - setting fmin in the overlap accordingly */
+      int mmax1 = max(2, listelementh1->m);
+      int mmax2 = max(2, listelementsplines2->m);
+      double fcutLow = fmax(fLow, fmax(((double) mmax1)/2. * fstartobs1, ((double) mmax2)/2. * fstartobs2));
+      overlap += FDSinglemodeFresnelOverlapNetworkInvSn(listelementh1->freqseries, listelementsplines2->splines, ndet, &(factors1[imode1*ndet]), &(factors2[imode2*ndet]), twopidelays1, twopidelays2, Snoises, curves, invSn, fcutLow, fHigh, overlapdet);
+
+      listelementsplines2 = listelementsplines2->next;
+      imode2++;
+    }
+    ArenaMatrixFree(invSn);
+    listelementh1 = listelementh1->next;
+    imode1++;
+  }
+  return overlap;
+}
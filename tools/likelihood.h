@@ -239,6 +239,47 @@ double FDListmodesFresnelOverlap3Chan(
   double fHigh,                                         /* Upper bound of the frequency window for the detector */
   double fstartobs1,                                    /* Starting frequency for the 22 mode of wf 1 - as determined from a limited duration of the observation - set to 0 to ignore */
   double fstartobs2);                                    /* Starting frequency for the 22 mode of wf 2 - as determined from a limited duration of the observation - set to 0 to ignore */
+/* Function computing the overlap (h1|h2) summed over a network of non-correlated detectors, for two modes given before the response, one being already interpolated - the response of each detector is a constant factor and a time delay */
+double FDSinglemodeFresnelOverlapNetwork(
+  struct tagCAmpPhaseFrequencySeries *freqseries1, /* First mode h1 before the response, in amplitude/phase form */
+  struct tagCAmpPhaseSpline *splines2,             /* Second mode h2 before the response, already interpolated in matrix form */
+  const int ndet,                                  /* Number of detectors */
+  const double complex* factors1,                  /* Factors of the response for h1, ndet values */
+  const double complex* factors2,                  /* Factors of the response for h2, ndet values */
+  const double* twopidelays1,                      /* 2pi times the delays from geocenter to each detector for h1 (s), ndet values */
+  const double* twopidelays2,                      /* 2pi times the delays from geocenter to each detector for h2 (s), ndet values */
+  ObjectFunction* Snoises,                         /* Noise functions of the detectors, ndet values */
+  double fLow,                                     /* Lower bound of the frequency window for the detectors */
+  double fHigh);                                   /* Upper bound of the frequency window for the detectors */
+/* Function computing the overlap (h1|h2) summed over a network of non-correlated detectors, between two waveforms given as list of modes before the response, one being already interpolated - single pass per pair of modes for the whole network, 1/Sn evaluated once per mode of h1 and distinct noise function (same object and function) - two additional parameters for the starting 22-mode frequencies (then properly scaled for the other modes) for a limited duration of the observations */
+double FDListmodesFresnelOverlapNetwork(
+  struct tagListmodesCAmpPhaseFrequencySeries *listh1, /* First waveform before the response, list of modes in amplitude/phase form */
+  struct tagListmodesCAmpPhaseSpline *listsplines2,    /* Second waveform before the response, list of modes already interpolated in matrix form */
+  const int ndet,                                      /* Number of detectors */
+  const double complex* factors1,                      /* Factors of the response for wf 1, ndet values for each mode in the order of listh1 */
+  const double complex* factors2,                      /* Factors of the response for wf 2, ndet values for each mode in the order of listsplines2 */
+  const double* twopidelays1,                          /* 2pi times the delays from geocenter to each detector for wf 1 (s), ndet values */
+  const double* twopidelays2,                          /* 2pi times the delays from geocenter to each detector for wf 2 (s), ndet values */
+  ObjectFunction* Snoises,                             /* Noise functions of the detectors, ndet values */
+  double fLow,                                         /* Lower bound of the frequency window for the detectors */
+  double fHigh,                                        /* Upper bound of the frequency window for the detectors */
+  double fstartobs1,                                   /* Starting frequency for the 22 mode of wf 1 - as determined from a limited duration of the observation - set to 0 to ignore */
+  double fstartobs2);                                  /* Starting frequency for the 22 mode of wf 2 - as determined from a limited duration of the observation - set to 0 to ignore */
+/* Same as FDListmodesFresnelOverlapNetwork, also returning the overlap restricted to each detector - computed in the same pass, the network total being their sum */
+double FDListmodesFresnelOverlapNetworkDet(
+  double* overlapdet,                                  /* Output: overlap of each detector, ndet values - NULL to ignore */
+  struct tagListmodesCAmpPhaseFrequencySeries *listh1, /* First waveform before the response, list of modes in amplitude/phase form */
+  struct tagListmodesCAmpPhaseSpline *listsplines2,    /* Second waveform before the response, list of modes already interpolated in matrix form */
+  const int ndet,                                      /* Number of detectors */
+  const double complex* factors1,                      /* Factors of the response for wf 1, ndet values for each mode in the order of listh1 */
+  const double complex* factors2,                      /* Factors of the response for wf 2, ndet values for each mode in the order of listsplines2 */
+  const double* twopidelays1,                          /* 2pi times the delays from geocenter to each detector for wf 1 (s), ndet values */
+  const double* twopidelays2,                          /* 2pi times the delays from geocenter to each detector for wf 2 (s), ndet values */
+  ObjectFunction* Snoises,                             /* Noise functions of the detectors, ndet values */
+  double fLow,                                         /* Lower bound of the frequency window for the detectors */
+  double fHigh,                                        /* Upper bound of the frequency window for the detectors */
+  double fstartobs1,                                   /* Starting frequency for the 22 mode of wf 1 - as determined from a limited duration of the observation - set to 0 to ignore */
+  double fstartobs2);                                  /* Starting frequency for the 22 mode of wf 2 - as determined from a limited duration of the observation - set to 0 to ignore */
 /* Function computing the mode-by-mode overlap (hlm1|hlm2) between two waveforms given as list of modes, one being already interpolated, for a given noise function - two additional parameters for the starting 22-mode frequencies (then properly scaled for the other modes) for a limited duration of the observations */
 double FDModeByModeFresnelOverlap(
   gsl_matrix** hlm1hlm2_matrix,                        /* Matrix of overlaps (hlm1|hlm2) */
@@ -76,9 +76,9 @@ void BuildNotAKnotSpline(
   double* y = vecty->data;
   
   /* Computing vecth and vectDeltay */
-  gsl_vector* vecth = gsl_vector_alloc(n-1);
-  gsl_vector* vectDeltay = gsl_vector_alloc(n-1);
-  gsl_vector* vectDeltayoverh = gsl_vector_alloc(n-1);
+  gsl_vector* vecth = ArenaVectorAlloc(n-1);
+  gsl_vector* vectDeltay = ArenaVectorAlloc(n-1);
+  gsl_vector* vectDeltayoverh = ArenaVectorAlloc(n-1);
   double* h = vecth->data;
   double* Deltay = vectDeltay->data;
   double* Deltayoverh = vectDeltayoverh->data;
@@ -89,10 +89,10 @@ void BuildNotAKnotSpline(
   }
 
   /* Structures for the tridiagonal system */
-  gsl_vector* vectY = gsl_vector_alloc(n-2);
-  gsl_vector* vecta = gsl_vector_alloc(n-2);
-  gsl_vector* vectb = gsl_vector_alloc(n-3);
-  gsl_vector* vectc = gsl_vector_alloc(n-3);
+  gsl_vector* vectY = ArenaVectorAlloc(n-2);
+  gsl_vector* vecta = ArenaVectorAlloc(n-2);
+  gsl_vector* vectb = ArenaVectorAlloc(n-3);
+  gsl_vector* vectc = ArenaVectorAlloc(n-3);
   double* Y = vectY->data;
   double* a = vecta->data;
   double* b = vectb->data;
@@ -112,7 +112,7 @@ void BuildNotAKnotSpline(
   b[n-4] += -h[n-2]*h[n-2]/h[n-3];
   
   /* Solving the tridiagonal system */
-  gsl_vector* vectp2 = gsl_vector_alloc(n);
+  gsl_vector* vectp2 = ArenaVectorAlloc(n);
   gsl_vector_view viewp2trunc = gsl_vector_subvector(vectp2, 1, n-2);
   SolveTridiagThomas(&viewp2trunc.vector, vecta, vectb, vectc, vectY, n-2);
   double* p2 = vectp2->data;
@@ -120,8 +120,8 @@ void BuildNotAKnotSpline(
   p2[n-1] = p2[n-2] + h[n-2]/h[n-3] * (p2[n-2] - p2[n-3]);
 
   /* Deducing the p1's and the p3's */
-  gsl_vector* vectp1 = gsl_vector_alloc(n);
-  gsl_vector* vectp3 = gsl_vector_alloc(n);
+  gsl_vector* vectp1 = ArenaVectorAlloc(n);
+  gsl_vector* vectp3 = ArenaVectorAlloc(n);
   double* p1 = vectp1->data;
   double* p3 = vectp3->data;
   for(int i=0; i<=n-2; i++) {
@@ -145,16 +145,16 @@ void BuildNotAKnotSpline(
   gsl_vector_memcpy(&viewp3.vector, vectp3);
 
   /* Cleanup*/
-  gsl_vector_free(vecth);
-  gsl_vector_free(vectDeltay);
-  gsl_vector_free(vectDeltayoverh);
-  gsl_vector_free(vectY);
-  gsl_vector_free(vecta);
-  gsl_vector_free(vectb);
-  gsl_vector_free(vectc);
-  gsl_vector_free(vectp1);
-  gsl_vector_free(vectp2);
-  gsl_vector_free(vectp3);
+  ArenaVectorFree(vecth);
+  ArenaVectorFree(vectDeltay);
+  ArenaVectorFree(vectDeltayoverh);
+  ArenaVectorFree(vectY);
+  ArenaVectorFree(vecta);
+  ArenaVectorFree(vectb);
+  ArenaVectorFree(vectc);
+  ArenaVectorFree(vectp1);
+  ArenaVectorFree(vectp2);
+  ArenaVectorFree(vectp3);
 }
 
 void BuildQuadSpline(
@@ -172,9 +172,9 @@ void BuildQuadSpline(
   double* y = vecty->data;
 
   /* Computing vecth and vectDeltay */
-  gsl_vector* vecth = gsl_vector_alloc(n-1);
-  gsl_vector* vectDeltay = gsl_vector_alloc(n-1);
-  gsl_vector* vectDeltayoverh = gsl_vector_alloc(n-1);
+  gsl_vector* vecth = ArenaVectorAlloc(n-1);
+  gsl_vector* vectDeltay = ArenaVectorAlloc(n-1);
+  gsl_vector* vectDeltayoverh = ArenaVectorAlloc(n-1);
   double* h = vecth->data;
   double* Deltay = vectDeltay->data;
   double* Deltayoverh = vectDeltayoverh->data;
@@ -185,7 +185,7 @@ void BuildQuadSpline(
   }
   
   /* Solving for p1 */
-  gsl_vector* vectp1 = gsl_vector_alloc(n);
+  gsl_vector* vectp1 = ArenaVectorAlloc(n);
   double* p1 = vectp1->data;
   double ratio = h[n-2] / h[n-3];
   p1[n-3] = ((2. + ratio)*Deltayoverh[n-3] - Deltayoverh[n-2]) / (1. + ratio);
@@ -196,7 +196,7 @@ void BuildQuadSpline(
   p1[n-1] = (1. + ratio)*p1[n-2] - ratio*p1[n-3];
 
   /* Deducing the p2's */
-  gsl_vector* vectp2 = gsl_vector_alloc(n);
+  gsl_vector* vectp2 = ArenaVectorAlloc(n);
   double* p2 = vectp2->data;
   for(int i=0; i<=n-2; i++) {
     p2[i] = (p1[i+1] - p1[i]) / (2.*h[i]);
@@ -215,11 +215,11 @@ void BuildQuadSpline(
   gsl_vector_memcpy(&viewp2.vector, vectp2);
 
   /* Cleanup*/
-  gsl_vector_free(vecth);
-  gsl_vector_free(vectDeltay);
-  gsl_vector_free(vectDeltayoverh);
-  gsl_vector_free(vectp1);
-  gsl_vector_free(vectp2);
+  ArenaVectorFree(vecth);
+  ArenaVectorFree(vectDeltay);
+  ArenaVectorFree(vectDeltayoverh);
+  ArenaVectorFree(vectp1);
+  ArenaVectorFree(vectp2);
 }
 
 void BuildSplineCoeffs(
@@ -16,12 +16,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <float.h>
 #include <complex.h>
 #include <time.h>
 #include <unistd.h>
 #include <getopt.h>
 #include <stdbool.h>
 #include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_bspline.h>
@@ -42,6 +47,43 @@ double ObjectFunctionCall(const ObjectFunction* this,double f){return this->func
 int max (int a, int b) { return a > b ? a : b; }
 int min (int a, int b) { return a < b ? a : b; }
 
+/**************************************************************/
+/************** Phasors on linear grids ***********************/
+
+/* Fill z[j] = exp(I*(phi0 + j*dphi)) for j=0..n-1 - one cexp every PHASOR_REANCHOR steps instead of one per step */
+/* Rotations written in real arithmetic, to avoid the NaN/Inf checks of the C99 complex product */
+void Phasor_Fill(double complex* z, const double phi0, const double dphi, const int n)
+{
+  double wr = cos(dphi);
+  double wi = sin(dphi);
+  for(int jb=0; jb<n; jb+=PHASOR_REANCHOR) {
+    int je = min(jb + PHASOR_REANCHOR, n);
+    double complex anchor = cexp(I*(phi0 + jb*dphi));
+    double zr = creal(anchor);
+    double zi = cimag(anchor);
+    z[jb] = anchor;
+    for(int j=jb+1; j<je; j++) {
+      double tmp = zr*wr - zi*wi;
+      zi = zr*wi + zi*wr;
+      zr = tmp;
+      z[j] = zr + I*zi;
+    }
+  }
+}
+
+/* Returns 1 if x[j] = x[0] + j*deltax to a few ulps of max|x| for all j - grids built as x0 + j*deltax pass, grids built by accumulation in general do not */
+int IsLinearGrid(double* deltax, const double* x, const int n)
+{
+  *deltax = 0.;
+  if(n<2) return 0;
+  *deltax = (x[n-1] - x[0])/(n-1);
+  double tol = 8*DBL_EPSILON*fmax(fabs(x[0]), fabs(x[n-1]));
+  for(int j=1; j<n-1; j++) {
+    if(fabs(x[j] - (x[0] + j*(*deltax))) > tol) return 0;
+  }
+  return 1;
+}
+
 /************** GSL error handling and I/O ********************/
 
 /* GSL error handler */
@@ -50,27 +92,125 @@ void Err_Handler(const char *reason, const char *file, int line, int gsl_errno)
   exit(1);
 }
 
-/* Functions to read binary data from files */
-int Read_Vector(const char dir[], const char fname[], gsl_vector *v) {
-  char *path=malloc(strlen(dir)+64);
-  sprintf(path,"%s/%s", dir, fname);
-  FILE *f = fopen(path, "rb");
-  if (!f) {
-    fprintf(stderr, "Error reading data from %s\n", path);
-    free(path);
-    return(FAILURE);
+/***************************** Parallel text parser *****************************/
+
+/* Text files are loaded at once, split in chunks at line boundaries, and the chunks are parsed in parallel */
+/* A first pass counts the values of each chunk, which gives where each chunk writes - values are read in row-major order as in gsl_matrix_fscanf, whatever the layout of the lines */
+#define TEXT_CHUNKSIZE (1<<20)
+#define TEXT_MAXCHUNKS 4096
+
+typedef struct tagTextFile
+{
+  char*   text;         /* Content of the file, terminated by 0 */
+  size_t  size;         /* Size of the file */
+  int     nchunks;      /* Number of chunks */
+  size_t* beg;          /* Start of each chunk in text, nchunks+1 values */
+  size_t* offset;       /* Index of the first value of each chunk, nchunks+1 values */
+  size_t  nvalues;      /* Total number of values */
+  int     ncolsfirst;   /* Number of values on the first non-blank line */
+} TextFile;
+
+static inline int Text_IsSpace(const char c) {
+  return c==' ' || c=='\n' || c=='\t' || c=='\r' || c=='\v' || c=='\f';
+}
+
+/* Powers of 10 that are exact in double precision */
+static const double Text_Pow10[23] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+#if LDBL_MANT_DIG >= 64
+/* Powers of 10 that are exact in a 64-bit mantissa long double (5^27 < 2^64) */
+static const long double Text_Pow10L[28] = {1e0L, 1e1L, 1e2L, 1e3L, 1e4L, 1e5L, 1e6L, 1e7L, 1e8L, 1e9L, 1e10L, 1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L, 1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L};
+#endif
+
+/* Parses the number starting at p, returns the end of the number (p if there is none) */
+/* Exact fast paths, taken only when they give the correctly rounded value, as strtod: */
+/* - Clinger: decimal mantissa within 2^53 and exponent within [-22, 22], a single rounding in double */
+/* - up to 19 digits (e.g. the 17 digits of %.16e outputs) and exponent within [-27, 27], where long double has a 64-bit mantissa: a single rounding in long double, then rounding to double, which is exact unless the long double value falls on a midpoint between two doubles */
+/* Everything else (more digits, larger exponents, midpoints, nan/inf/hex) falls back to strtod */
+static const char* Text_ParseDouble(const char* p, double* x) {
+  const char* s = p;
+  int neg = 0;
+  if(*s=='-' || *s=='+') {
+    neg = (*s=='-');
+    s++;
   }
-  int ret = gsl_vector_fread(f, v);
-  if (ret != 0) {
-    fprintf(stderr, "Error reading data from %s.\n",path);
-    free(path);
-    return(FAILURE);
+  uint64_t mant = 0;
+  int ndigits = 0;
+  int nbdigitsread = 0;
+  int exp10 = 0;
+  int truncated = 0;
+  for(; *s>='0' && *s<='9'; s++, nbdigitsread++) {
+    if(ndigits<19) {
+      mant = 10*mant + (*s - '0');
+      if(mant) ndigits++;
+    }
+    else {
+      exp10++;
+      truncated |= (*s!='0');
+    }
   }
-  fclose(f);
-  free(path);
-  return(SUCCESS);
+  if(*s=='.') {
+    for(s++; *s>='0' && *s<='9'; s++, nbdigitsread++) {
+      if(ndigits<19) {
+        mant = 10*mant + (*s - '0');
+        if(mant) ndigits++;
+        exp10--;
+      }
+      else truncated |= (*s!='0');
+    }
+  }
+  int ok = (nbdigitsread>0) && !truncated && *s!='x' && *s!='X';
+  if(ok && (*s=='e' || *s=='E')) {
+    const char* e = s+1;
+    int eneg = 0;
+    if(*e=='-' || *e=='+') {
+      eneg = (*e=='-');
+      e++;
+    }
+    if(*e>='0' && *e<='9') {
+      int ev = 0;
+      for(; *e>='0' && *e<='9'; e++) if(ev<10000) ev = 10*ev + (*e - '0');
+      exp10 += eneg ? -ev : ev;
+      s = e;
+    }
+    else ok = 0;
+  }
+  if(ok && mant <= (UINT64_C(1)<<53) && exp10>=-22 && exp10<=22) {
+    double v = (double) mant;
+    v = (exp10<0) ? v/Text_Pow10[-exp10] : v*Text_Pow10[exp10];
+    *x = neg ? -v : v;
+    return s;
+  }
+#if LDBL_MANT_DIG >= 64
+  if(ok && exp10>=-27 && exp10<=27) {
+    long double vl = (long double) mant;
+    vl = (exp10<0) ? vl/Text_Pow10L[-exp10] : vl*Text_Pow10L[exp10];
+    double v = (double) vl;
+    /* The rounding to double is correct if vl is a double, or if vl is not the midpoint between v and its neighbour towards vl */
+    int exact = ((long double) v == vl);
+    if(!exact) {
+      double w = nextafter(v, ((long double) v < vl) ? DBL_MAX : -DBL_MAX);
+      exact = (((long double) v + (long double) w)/2 != vl);
+    }
+    if(exact) {
+      *x = neg ? -v : v;
+      return s;
+    }
+  }
+#endif
+  char* end;
+  *x = strtod(p, &end);
+  return end;
 }
-int Read_Matrix(const char dir[], const char fname[], gsl_matrix *m) {
+
+static void TextFile_Close(TextFile* tf) {
+  free(tf->text);
+  free(tf->beg);
+  free(tf->offset);
+  free(tf);
+}
+
+/* Loads the file, splits it and counts the values */
+static int TextFile_Open(TextFile** tf, const char dir[], const char fname[]) {
   char *path=malloc(strlen(dir)+64);
   sprintf(path,"%s/%s", dir, fname);
   FILE *f = fopen(path, "rb");
@@ -79,18 +219,94 @@ int Read_Matrix(const char dir[], const char fname[], gsl_matrix *m) {
     free(path);
     return(FAILURE);
   }
-  int ret = gsl_matrix_fread(f, m);
-  if (ret != 0) {
+  fseek(f, 0, SEEK_END);
+  long size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  char* text = (size>=0) ? (char*) malloc(size+1) : NULL;
+  if (!text || fread(text, 1, size, f) != (size_t) size) {
     fprintf(stderr, "Error reading data from %s\n", path);
+    fclose(f);
+    free(text);
     free(path);
     return(FAILURE);
   }
   fclose(f);
   free(path);
+  text[size] = '\0';
+
+  *tf = (TextFile*) malloc(sizeof(TextFile));
+  TextFile* t = *tf;
+  t->text = text;
+  t->size = size;
+
+  /* Chunks, each starting after a newline */
+  t->nchunks = min(TEXT_MAXCHUNKS, max(1, (int) (size/TEXT_CHUNKSIZE)));
+  t->beg = (size_t*) malloc(sizeof(size_t)*(t->nchunks+1));
+  t->offset = (size_t*) malloc(sizeof(size_t)*(t->nchunks+1));
+  t->beg[0] = 0;
+  for(int k=1; k<t->nchunks; k++) {
+    size_t b = (size_t) (((double) size*k)/t->nchunks);
+    if(b<t->beg[k-1]) b = t->beg[k-1];
+    while(b<t->size && text[b-1]!='\n') b++;
+    t->beg[k] = b;
+  }
+  t->beg[t->nchunks] = t->size;
+
+  /* Count the values of each chunk - a value starts wherever a non-space follows a space */
+  #pragma omp parallel for schedule(dynamic)
+  for(int k=0; k<t->nchunks; k++) {
+    size_t count = 0;
+    int inspace = 1;
+    for(size_t i=t->beg[k]; i<t->beg[k+1]; i++) {
+      int sp = Text_IsSpace(text[i]);
+      count += (inspace && !sp);
+      inspace = sp;
+    }
+    t->offset[k+1] = count;
+  }
+  t->offset[0] = 0;
+  for(int k=0; k<t->nchunks; k++) t->offset[k+1] += t->offset[k];
+  t->nvalues = t->offset[t->nchunks];
+
+  /* Values on the first non-blank line */
+  t->ncolsfirst = 0;
+  size_t i = 0;
+  while(i<t->size && Text_IsSpace(text[i])) i++;
+  for(int inspace=1; i<t->size && text[i]!='\n'; i++) {
+    int sp = Text_IsSpace(text[i]);
+    t->ncolsfirst += (inspace && !sp);
+    inspace = sp;
+  }
   return(SUCCESS);
 }
-/* Functions to read text data from files */
-int Read_Text_Vector(const char dir[], const char fname[], gsl_vector *v) {
+
+/* Parses the first nmax values into dest */
+static int TextFile_Parse(TextFile* tf, double* dest, const size_t nmax) {
+  int ret = SUCCESS;
+  #pragma omp parallel for schedule(dynamic)
+  for(int k=0; k<tf->nchunks; k++) {
+    if(tf->offset[k]>=nmax) continue;
+    const char* p = tf->text + tf->beg[k];
+    const char* end = tf->text + tf->beg[k+1];
+    size_t idx = tf->offset[k];
+    while(idx<nmax) {
+      while(p<end && Text_IsSpace(*p)) p++;
+      if(p>=end) break;
+      const char* q = Text_ParseDouble(p, &(dest[idx]));
+      if(q==p || (q<end && !Text_IsSpace(*q))) {
+        #pragma omp atomic write
+        ret = FAILURE;
+        break;
+      }
+      p = q;
+      idx++;
+    }
+  }
+  return ret;
+}
+
+/* Functions to read binary data from files */
+int Read_Vector(const char dir[], const char fname[], gsl_vector *v) {
   char *path=malloc(strlen(dir)+64);
   sprintf(path,"%s/%s", dir, fname);
   FILE *f = fopen(path, "rb");
@@ -99,7 +315,7 @@ int Read_Text_Vector(const char dir[], const char fname[], gsl_vector *v) {
     free(path);
     return(FAILURE);
   }
-  int ret = gsl_vector_fscanf(f, v);
+  int ret = gsl_vector_fread(f, v);
   if (ret != 0) {
     fprintf(stderr, "Error reading data from %s.\n",path);
     free(path);
@@ -109,7 +325,7 @@ int Read_Text_Vector(const char dir[], const char fname[], gsl_vector *v) {
   free(path);
   return(SUCCESS);
 }
-int Read_Text_Matrix(const char dir[], const char fname[], gsl_matrix *m) {
+int Read_Matrix(const char dir[], const char fname[], gsl_matrix *m) {
   char *path=malloc(strlen(dir)+64);
   sprintf(path,"%s/%s", dir, fname);
   FILE *f = fopen(path, "rb");
@@ -118,9 +334,9 @@ int Read_Text_Matrix(const char dir[], const char fname[], gsl_matrix *m) {
     free(path);
     return(FAILURE);
   }
-  int ret = gsl_matrix_fscanf(f, m);
+  int ret = gsl_matrix_fread(f, m);
   if (ret != 0) {
-    fprintf(stderr, "Error reading data from %s.\n",path);
+    fprintf(stderr, "Error reading data from %s\n", path);
     free(path);
     return(FAILURE);
   }
@@ -128,6 +344,61 @@ int Read_Text_Matrix(const char dir[], const char fname[], gsl_matrix *m) {
   free(path);
   return(SUCCESS);
 }
+/* Functions to read text data from files */
+/* Note: parsed in parallel, values are read in the same order as gsl_vector_fscanf/gsl_matrix_fscanf */
+int Read_Text_Vector(const char dir[], const char fname[], gsl_vector *v) {
+  TextFile* tf = NULL;
+  if(TextFile_Open(&tf, dir, fname)==FAILURE) return(FAILURE);
+  size_t n = v->size;
+  int ret = (tf->nvalues < n) ? FAILURE : SUCCESS;
+  if(ret==SUCCESS) {
+    if(v->stride==1) ret = TextFile_Parse(tf, v->data, n);
+    else {
+      double* values = (double*) malloc(sizeof(double)*n);
+      ret = TextFile_Parse(tf, values, n);
+      for(size_t i=0; i<n; i++) v->data[i*v->stride] = values[i];
+      free(values);
+    }
+  }
+  if (ret != SUCCESS) fprintf(stderr, "Error reading data from %s/%s.\n", dir, fname);
+  TextFile_Close(tf);
+  return(ret);
+}
+int Read_Text_Matrix(const char dir[], const char fname[], gsl_matrix *m) {
+  TextFile* tf = NULL;
+  if(TextFile_Open(&tf, dir, fname)==FAILURE) return(FAILURE);
+  size_t n1 = m->size1;
+  size_t n2 = m->size2;
+  int ret = (tf->nvalues < n1*n2) ? FAILURE : SUCCESS;
+  if(ret==SUCCESS) {
+    if(m->tda==n2) ret = TextFile_Parse(tf, m->data, n1*n2);
+    else {
+      double* values = (double*) malloc(sizeof(double)*n1*n2);
+      ret = TextFile_Parse(tf, values, n1*n2);
+      for(size_t i=0; i<n1; i++) memcpy(&(m->data[i*m->tda]), &(values[i*n2]), sizeof(double)*n2);
+      free(values);
+    }
+  }
+  if (ret != SUCCESS) fprintf(stderr, "Error reading data from %s/%s.\n", dir, fname);
+  TextFile_Close(tf);
+  return(ret);
+}
+int Read_Text_Table(gsl_matrix** m, const char dir[], const char fname[], const int nblines, const int ncols) {
+  TextFile* tf = NULL;
+  if(TextFile_Open(&tf, dir, fname)==FAILURE) return(FAILURE);
+  size_t n2 = (ncols>0) ? (size_t) ncols : (size_t) tf->ncolsfirst;
+  size_t n1 = (nblines>0) ? (size_t) nblines : ((n2>0) ? tf->nvalues/n2 : 0);
+  if (n1==0 || n2==0 || tf->nvalues < n1*n2 || (nblines<=0 && tf->nvalues != n1*n2)) {
+    fprintf(stderr, "Error reading data from %s/%s: %zu values do not make a table of %zu columns.\n", dir, fname, tf->nvalues, n2);
+    TextFile_Close(tf);
+    return(FAILURE);
+  }
+  *m = gsl_matrix_alloc(n1, n2);
+  int ret = TextFile_Parse(tf, (*m)->data, n1*n2);
+  if (ret != SUCCESS) fprintf(stderr, "Error reading data from %s/%s.\n", dir, fname);
+  TextFile_Close(tf);
+  return(ret);
+}
 /* Functions to write data to files */
 int Write_Vector(const char dir[], const char fname[], gsl_vector *v) {
   char *path=malloc(strlen(dir)+64);
@@ -217,49 +488,537 @@ int Write_Text_Matrix(const char dir[], const char fname[], gsl_matrix *m) {
   return(SUCCESS);
 }
 
+/***************************** Binary columnar files *****************************/
+
+#define COLUMNAR_MAGIC "FLARECOL"
+/* Alignment of the start of the data in the file */
+#define COLUMNAR_ALIGN 64
+/* Size of the buffer of the writer */
+#define COLUMNAR_BUFSIZE (1<<20)
+/* Relative tolerance for recording column 0 as uniformly sampled */
+#define COLUMNAR_UNIFORMTOL 1e-6
+
+/* FNV-1a checksum, on 64-bit words rather than bytes */
+static uint64_t Columnar_Checksum(const double* data, const size_t n, const size_t stride) {
+  uint64_t hash = 14695981039346656037ULL;
+  for(size_t i=0; i<n; i++) {
+    uint64_t word;
+    memcpy(&word, &(data[i*stride]), sizeof(uint64_t));
+    hash ^= word;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+/* Offset of the data - header, checksums, padding to COLUMNAR_ALIGN */
+static size_t Columnar_DataOffset(const ColumnarHeader* header) {
+  size_t offset = sizeof(ColumnarHeader);
+  if(header->flags & COLUMNAR_CHECKSUMS) offset += header->ncols*sizeof(uint64_t);
+  return ((offset + COLUMNAR_ALIGN - 1)/COLUMNAR_ALIGN)*COLUMNAR_ALIGN;
+}
+/* Step of a uniformly sampled vector, 0 otherwise */
+static double Columnar_UniformStep(const gsl_vector* x) {
+  size_t n = x->size;
+  if(n<2) return 0.;
+  double x0 = gsl_vector_get(x, 0);
+  double deltax = (gsl_vector_get(x, n-1) - x0)/(n-1);
+  if(deltax==0.) return 0.;
+  for(size_t i=0; i<n; i++) {
+    if(fabs(gsl_vector_get(x, i) - (x0 + i*deltax)) > COLUMNAR_UNIFORMTOL*fabs(deltax)) return 0.;
+  }
+  return deltax;
+}
+/* gsl_vector pointing into the mapping of a columnar file, holding a reference to the file */
+/* owner=0, so that gsl never frees the data - block points to Columnar_ViewTag, by which ArenaVectorFree recognizes the views and releases the reference */
+typedef struct tagColumnarVectorView
+{
+  gsl_vector vector;    /* Must come first - the view is handed out as a gsl_vector* */
+  ColumnarFile* cf;     /* File mapping the data */
+} ColumnarVectorView;
+static gsl_block Columnar_ViewTag = {0, NULL};
+static gsl_vector* Columnar_VectorView(ColumnarFile* cf, const int j) {
+  ColumnarVectorView* view = (ColumnarVectorView*) malloc(sizeof(ColumnarVectorView));
+  view->vector.size = (size_t) cf->header.nrows;
+  view->vector.stride = 1;
+  view->vector.data = ColumnarFile_Column(cf, j);
+  view->vector.block = &Columnar_ViewTag;
+  view->vector.owner = 0;
+  view->cf = cf;
+  #pragma omp atomic
+  cf->nbrefs++;
+  return &(view->vector);
+}
+static int Columnar_IsVectorView(const gsl_vector* v) {
+  return v->block==&Columnar_ViewTag;
+}
+static void Columnar_VectorViewFree(gsl_vector* v) {
+  ColumnarVectorView* view = (ColumnarVectorView*) v;
+  ColumnarFile_Release(view->cf);
+  free(view);
+}
+
+int IsColumnarFile(const char dir[], const char fname[]) {
+  char *path=malloc(strlen(dir)+64);
+  sprintf(path,"%s/%s", dir, fname);
+  FILE *f = fopen(path, "rb");
+  free(path);
+  if (!f) return 0;
+  char magic[8];
+  int ret = (fread(magic, 1, 8, f) == 8) && (memcmp(magic, COLUMNAR_MAGIC, 8) == 0);
+  fclose(f);
+  return ret;
+}
+
+/* The file is mapped privately and writable: the data can be modified in place (copy-on-write), the file is never modified */
+int ColumnarFile_Open(ColumnarFile** cf, const char dir[], const char fname[], const int verify) {
+  char *path=malloc(strlen(dir)+64);
+  sprintf(path,"%s/%s", dir, fname);
+  int fd = open(path, O_RDONLY);
+  if (fd<0) {
+    fprintf(stderr, "Error reading data from %s\n", path);
+    free(path);
+    return(FAILURE);
+  }
+  struct stat st;
+  if (fstat(fd, &st)!=0 || st.st_size < (off_t) sizeof(ColumnarHeader)) {
+    fprintf(stderr, "Error reading data from %s: not a columnar file.\n", path);
+    close(fd);
+    free(path);
+    return(FAILURE);
+  }
+  size_t mapsize = (size_t) st.st_size;
+  void* map = mmap(NULL, mapsize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map==MAP_FAILED) {
+    fprintf(stderr, "Error reading data from %s: mmap failed.\n", path);
+    free(path);
+    return(FAILURE);
+  }
+
+  /* Check the header */
+  ColumnarHeader* header = (ColumnarHeader*) map;
+  const char* error = NULL;
+  if(memcmp(header->magic, COLUMNAR_MAGIC, 8)!=0) error = "not a columnar file";
+  else if(header->version!=COLUMNAR_VERSION) error = "version not supported";
+  else if(header->dtype!=COLUMNAR_FLOAT64) error = "data type not supported";
+  else if(header->ncols<0 || header->nrows<0 || Columnar_DataOffset(header) + header->ncols*header->nrows*sizeof(double) > mapsize) error = "file truncated";
+  else if(verify && (header->flags & COLUMNAR_CHECKSUMS)) {
+    const uint64_t* sums = (const uint64_t*) ((char*) map + sizeof(ColumnarHeader));
+    const double* data = (const double*) ((char*) map + Columnar_DataOffset(header));
+    for(int64_t j=0; j<header->ncols; j++) {
+      if(Columnar_Checksum(data + j*header->nrows, header->nrows, 1) != sums[j]) error = "checksum mismatch";
+    }
+  }
+  if (error) {
+    fprintf(stderr, "Error reading data from %s: %s.\n", path, error);
+    munmap(map, mapsize);
+    free(path);
+    return(FAILURE);
+  }
+
+  *cf = (ColumnarFile*) malloc(sizeof(ColumnarFile));
+  (*cf)->header = *header;
+  (*cf)->map = map;
+  (*cf)->mapsize = mapsize;
+  (*cf)->data = (double*) ((char*) map + Columnar_DataOffset(header));
+  (*cf)->nbrefs = 1;
+  free(path);
+  return(SUCCESS);
+}
+void ColumnarFile_Close(ColumnarFile* cf) {
+  ColumnarFile_Release(cf);
+}
+/* Drop one reference - the file is unmapped when the last one, handle or column view, is released */
+void ColumnarFile_Release(ColumnarFile* cf) {
+  int nbrefs;
+  #pragma omp atomic capture
+  nbrefs = --(cf->nbrefs);
+  if(nbrefs>0) return;
+  munmap(cf->map, cf->mapsize);
+  free(cf);
+}
+double* ColumnarFile_Column(ColumnarFile* cf, const int j) {
+  return cf->data + j*cf->header.nrows;
+}
+
+int Write_Columnar(const char dir[], const char fname[], gsl_vector** columns, const int ncols, const int checksums) {
+  size_t n = columns[0]->size;
+  for(int j=1; j<ncols; j++) {
+    if(columns[j]->size != n) {
+      fprintf(stderr, "Error in Write_Columnar: columns have different lengths.\n");
+      return(FAILURE);
+    }
+  }
+  char *path=malloc(strlen(dir)+64);
+  sprintf(path,"%s/%s", dir, fname);
+  FILE *f = fopen(path, "wb");
+  if (!f) {
+    fprintf(stderr, "Error writing data to %s\n", path);
+    free(path);
+    return(FAILURE);
+  }
+  setvbuf(f, NULL, _IOFBF, COLUMNAR_BUFSIZE);
+
+  /* Header, checksums and padding */
+  ColumnarHeader header;
+  memset(&header, 0, sizeof(ColumnarHeader));
+  memcpy(header.magic, COLUMNAR_MAGIC, 8);
+  header.version = COLUMNAR_VERSION;
+  header.dtype = COLUMNAR_FLOAT64;
+  header.ncols = ncols;
+  header.nrows = n;
+  header.flags = checksums ? COLUMNAR_CHECKSUMS : 0;
+  header.x0 = (n>0) ? gsl_vector_get(columns[0], 0) : 0.;
+  header.deltax = Columnar_UniformStep(columns[0]);
+  int ret = (fwrite(&header, sizeof(ColumnarHeader), 1, f) != 1);
+  size_t offset = sizeof(ColumnarHeader);
+  if(checksums) {
+    for(int j=0; j<ncols; j++) {
+      uint64_t sum = Columnar_Checksum(columns[j]->data, n, columns[j]->stride);
+      ret |= (fwrite(&sum, sizeof(uint64_t), 1, f) != 1);
+    }
+    offset += ncols*sizeof(uint64_t);
+  }
+  for(; offset<Columnar_DataOffset(&header); offset++) ret |= (fputc(0, f) == EOF);
+
+  /* Columns - strided columns (e.g. views of matrix columns) are gathered by blocks */
+  double buffer[4096];
+  for(int j=0; j<ncols; j++) {
+    size_t stride = columns[j]->stride;
+    if(stride==1) ret |= (fwrite(columns[j]->data, sizeof(double), n, f) != n);
+    else for(size_t i0=0; i0<n; i0+=4096) {
+      size_t nblock = (n - i0 < 4096) ? n - i0 : 4096;
+      for(size_t i=0; i<nblock; i++) buffer[i] = columns[j]->data[(i0+i)*stride];
+      ret |= (fwrite(buffer, sizeof(double), nblock, f) != nblock);
+    }
+  }
+  ret |= (fclose(f) != 0);
+  if (ret != 0) {
+    fprintf(stderr, "Error writing data to %s\n", path);
+    free(path);
+    return(FAILURE);
+  }
+  free(path);
+  return(SUCCESS);
+}
+
+int Read_Columns(gsl_vector** columns, const int ncols, int* nbrows, const char dir[], const char fname[], const int nblines, const int binary) {
+  if(binary==FILE_COLUMNAR || IsColumnarFile(dir, fname)) {
+    ColumnarFile* cf = NULL;
+    if(ColumnarFile_Open(&cf, dir, fname, 1)==FAILURE) return(FAILURE);
+    if(cf->header.ncols != ncols || cf->header.nrows > INT32_MAX) {
+      fprintf(stderr, "Error reading data from %s/%s: expected %d columns, found %ld.\n", dir, fname, ncols, (long) cf->header.ncols);
+      ColumnarFile_Close(cf);
+      return(FAILURE);
+    }
+    *nbrows = (int) cf->header.nrows;
+    for(int j=0; j<ncols; j++) columns[j] = Columnar_VectorView(cf, j);
+    /* The columns point into the mapping and hold a reference each - the file is unmapped when the last column is freed by ArenaVectorFree */
+    ColumnarFile_Close(cf);
+    return(SUCCESS);
+  }
+
+  gsl_matrix* inmatrix = NULL;
+  if(!binary) {
+    if(Read_Text_Table(&inmatrix, dir, fname, nblines, ncols)==FAILURE) return(FAILURE);
+  }
+  else {
+    /* Without nblines, the number of rows follows from the size of the file */
+    int nrows = nblines;
+    if(nrows<=0) {
+      struct stat st;
+      char *path=malloc(strlen(dir)+64);
+      sprintf(path,"%s/%s", dir, fname);
+      nrows = (stat(path, &st)==0) ? (int) (st.st_size/(sizeof(double)*ncols)) : 0;
+      free(path);
+    }
+    if(nrows<=0) {
+      fprintf(stderr, "Error reading data from %s/%s\n", dir, fname);
+      return(FAILURE);
+    }
+    inmatrix = gsl_matrix_alloc(nrows, ncols);
+    if(Read_Matrix(dir, fname, inmatrix)==FAILURE) {
+      gsl_matrix_free(inmatrix);
+      return(FAILURE);
+    }
+  }
+  *nbrows = (int) inmatrix->size1;
+  for(int j=0; j<ncols; j++) {
+    columns[j] = ArenaVectorAlloc(*nbrows);
+    gsl_vector_view colview = gsl_matrix_column(inmatrix, j);
+    gsl_vector_memcpy(columns[j], &colview.vector);
+  }
+  gsl_matrix_free(inmatrix);
+  return(SUCCESS);
+}
+int Write_Table(const char dir[], const char fname[], gsl_matrix* m, const int binary) {
+  if(binary==FILE_COLUMNAR) {
+    int ncols = (int) m->size2;
+    gsl_vector_view* views = (gsl_vector_view*) malloc(sizeof(gsl_vector_view)*ncols);
+    gsl_vector** columns = (gsl_vector**) malloc(sizeof(gsl_vector*)*ncols);
+    for(int j=0; j<ncols; j++) {
+      views[j] = gsl_matrix_column(m, j);
+      columns[j] = &(views[j].vector);
+    }
+    int ret = Write_Columnar(dir, fname, columns, ncols, 1);
+    free(views);
+    free(columns);
+    return ret;
+  }
+  if(!binary) return Write_Text_Matrix(dir, fname, m);
+  else return Write_Matrix(dir, fname, m);
+}
+int Write_Columns(const char dir[], const char fname[], gsl_vector** columns, const int ncols, const int binary) {
+  if(binary==FILE_COLUMNAR) return Write_Columnar(dir, fname, columns, ncols, 1);
+
+  gsl_matrix* outmatrix = gsl_matrix_alloc(columns[0]->size, ncols);
+  for(int j=0; j<ncols; j++) gsl_matrix_set_col(outmatrix, j, columns[j]);
+  int ret = Write_Table(dir, fname, outmatrix, binary);
+  gsl_matrix_free(outmatrix);
+  return ret;
+}
+
+/***************************** Arena allocator *****************************/
+
+/* Alignment of the blocks handed out by the arena - one cache line */
+#define ARENA_ALIGN 64
+#define ARENA_ROUNDUP(n) (((n) + (ARENA_ALIGN-1)) & ~((size_t) (ARENA_ALIGN-1)))
+
+/* Arena bound to the calling thread - each thread of a parallel region draws from its own */
+static Arena* currentarena = NULL;
+#pragma omp threadprivate(currentarena)
+
+/* List of all live arenas, so that a block can be recognized whatever the arena bound when it is freed */
+/* The list and the blocks of the arenas are changed under critical(arena_registry) */
+static Arena* arenaregistry = NULL;
+static int nbarenas = 0;
+
+static void Arena_Register(Arena* arena) {
+  #pragma omp critical(arena_registry)
+  {
+    arena->next = arenaregistry;
+    arenaregistry = arena;
+    #pragma omp atomic
+    nbarenas++;
+  }
+}
+static void Arena_Unregister(Arena* arena) {
+  #pragma omp critical(arena_registry)
+  {
+    Arena** link = &arenaregistry;
+    while(*link && *link!=arena) link = &((*link)->next);
+    if(*link) {
+      *link = arena->next;
+      #pragma omp atomic
+      nbarenas--;
+    }
+  }
+}
+static inline int Arena_InBlock(const Arena* arena, const void* ptr) {
+  return arena && ((const char*) ptr >= arena->base) && ((const char*) ptr < arena->base + arena->size);
+}
+
+/* Allocate the block of an arena - the raw pointer is kept to free it, the usable block is aligned */
+static void Arena_AllocBlock(Arena* arena, const size_t size) {
+  arena->memory = malloc(size + ARENA_ALIGN);
+  if(!arena->memory) {
+    printf("Error: failed to allocate %zu bytes in Arena_AllocBlock.\n", size);
+    exit(1);
+  }
+  arena->base = (char*) ARENA_ROUNDUP((size_t) arena->memory);
+  arena->size = size;
+}
+
+/* Bump the pointer of the arena - returns NULL (and records the request) if the block is full */
+static void* Arena_Bump(Arena* arena, const size_t size) {
+  size_t bytes = ARENA_ROUNDUP(size);
+  arena->requested += bytes;
+  if(arena->offset + bytes > arena->size) return NULL;
+  void* ptr = arena->base + arena->offset;
+  arena->offset += bytes;
+  arena->nballoc++;
+  return ptr;
+}
+
+void Arena_Init(Arena** arena, const size_t size) {
+  if(!arena) exit(1);
+  /* Create storage for structures */
+  if(!*arena) *arena = malloc(sizeof(Arena));
+  else
+  {
+    Arena_Unregister(*arena);
+    free((*arena)->memory);
+  }
+  memset(*arena, 0, sizeof(Arena));
+  Arena_AllocBlock(*arena, ARENA_ROUNDUP(size));
+  Arena_Register(*arena);
+}
+void Arena_Cleanup(Arena* arena) {
+  if(currentarena==arena) currentarena = NULL;
+  Arena_Unregister(arena);
+  free(arena->memory);
+  free(arena);
+}
+
+/* Release everything at once - objects that overflowed to malloc have been freed individually already */
+/* If the last cycle did not fit, the block is enlarged now, when it holds nothing alive, so that the next cycles do not need malloc */
+void Arena_Reset(Arena* arena) {
+  if(arena->requested > arena->highwater) arena->highwater = arena->requested;
+  if(arena->requested > arena->size) {
+    #pragma omp critical(arena_registry)
+    {
+      free(arena->memory);
+      Arena_AllocBlock(arena, ARENA_ROUNDUP(arena->requested + arena->requested/2));
+    }
+    arena->nbgrow++;
+  }
+  arena->lastnballoc = arena->nballoc;
+  arena->lastnbmalloc = arena->nbmalloc;
+  arena->offset = 0;
+  arena->requested = 0;
+  arena->nballoc = 0;
+  arena->nbmalloc = 0;
+  arena->nbreset++;
+}
+
+void Arena_Report(FILE* f, Arena* arena) {
+  fprintf(f, "Arena: block %zu bytes, highwater %zu bytes, %ld cycles, %ld grows\n", arena->size, arena->highwater, arena->nbreset, arena->nbgrow);
+  fprintf(f, "Arena: last cycle %ld allocations, %ld mallocs - %ld mallocs in total\n", arena->lastnballoc, arena->lastnbmalloc, arena->totalnbmalloc);
+}
+
+Arena* Arena_Bind(Arena* arena) {
+  Arena* previous = currentarena;
+  currentarena = arena;
+  return previous;
+}
+Arena* Arena_Current(void) {
+  return currentarena;
+}
+/* The arena bound to the calling thread is checked first - the other live arenas only for blocks that are not in it, e.g. freed after a change of binding or by another thread */
+int Arena_Owns(const void* ptr) {
+  if(!ptr) return 0;
+  if(Arena_InBlock(currentarena, ptr)) return 1;
+  int nb;
+  #pragma omp atomic read
+  nb = nbarenas;
+  if(nb==0) return 0;
+  int owned = 0;
+  #pragma omp critical(arena_registry)
+  {
+    for(Arena* arena=arenaregistry; arena && !owned; arena=arena->next) owned = Arena_InBlock(arena, ptr);
+  }
+  return owned;
+}
+
+void* ArenaMalloc(const size_t size) {
+  Arena* arena = currentarena;
+  if(arena) {
+    void* ptr = Arena_Bump(arena, size);
+    if(ptr) return ptr;
+    arena->nbmalloc++;
+    arena->totalnbmalloc++;
+  }
+  return malloc(size);
+}
+void ArenaFree(void* ptr) {
+  if(Arena_Owns(ptr)) return;
+  free(ptr);
+}
+
+/* The gsl_vector header and its data are taken in one block - no gsl_block, the vector does not own its data */
+gsl_vector* ArenaVectorAlloc(const size_t n) {
+  Arena* arena = currentarena;
+  if(arena && n>0) {
+    char* ptr = Arena_Bump(arena, ARENA_ROUNDUP(sizeof(gsl_vector)) + n*sizeof(double));
+    if(ptr) {
+      gsl_vector* v = (gsl_vector*) ptr;
+      v->size = n;
+      v->stride = 1;
+      v->data = (double*) (ptr + ARENA_ROUNDUP(sizeof(gsl_vector)));
+      v->block = NULL;
+      v->owner = 0;
+      return v;
+    }
+    arena->nbmalloc++;
+    arena->totalnbmalloc++;
+  }
+  return gsl_vector_alloc(n);
+}
+void ArenaVectorFree(gsl_vector* v) {
+  if(Arena_Owns(v)) return;
+  if(Columnar_IsVectorView(v)) {
+    Columnar_VectorViewFree(v);
+    return;
+  }
+  gsl_vector_free(v);
+}
+gsl_matrix* ArenaMatrixAlloc(const size_t n1, const size_t n2) {
+  Arena* arena = currentarena;
+  if(arena && n1>0 && n2>0) {
+    char* ptr = Arena_Bump(arena, ARENA_ROUNDUP(sizeof(gsl_matrix)) + n1*n2*sizeof(double));
+    if(ptr) {
+      gsl_matrix* m = (gsl_matrix*) ptr;
+      m->size1 = n1;
+      m->size2 = n2;
+      m->tda = n2;
+      m->data = (double*) (ptr + ARENA_ROUNDUP(sizeof(gsl_matrix)));
+      m->block = NULL;
+      m->owner = 0;
+      return m;
+    }
+    arena->nbmalloc++;
+    arena->totalnbmalloc++;
+  }
+  return gsl_matrix_alloc(n1, n2);
+}
+void ArenaMatrixFree(gsl_matrix* m) {
+  if(Arena_Owns(m)) return;
+  gsl_matrix_free(m);
+}
+
 /******** Functions to initialize and clean up CAmpPhaseFrequencySeries structure ********/
 void CAmpPhaseFrequencySeries_Init(CAmpPhaseFrequencySeries **freqseries, const int n) {
   if(!freqseries) exit(1);
   /* Create storage for structures */
-  if(!*freqseries) *freqseries=malloc(sizeof(CAmpPhaseFrequencySeries));
+  if(!*freqseries) *freqseries=ArenaMalloc(sizeof(CAmpPhaseFrequencySeries));
   else
   {
     CAmpPhaseFrequencySeries_Cleanup(*freqseries);
-    *freqseries=malloc(sizeof(CAmpPhaseFrequencySeries));
+    *freqseries=ArenaMalloc(sizeof(CAmpPhaseFrequencySeries));
   }
   gsl_set_error_handler(&Err_Handler);
-  (*freqseries)->freq = gsl_vector_alloc(n);
-  (*freqseries)->amp_real = gsl_vector_alloc(n);
-  (*freqseries)->amp_imag = gsl_vector_alloc(n);
-  (*freqseries)->phase = gsl_vector_alloc(n);
+  (*freqseries)->freq = ArenaVectorAlloc(n);
+  (*freqseries)->amp_real = ArenaVectorAlloc(n);
+  (*freqseries)->amp_imag = ArenaVectorAlloc(n);
+  (*freqseries)->phase = ArenaVectorAlloc(n);
 }
 void CAmpPhaseFrequencySeries_Cleanup(CAmpPhaseFrequencySeries *freqseries) {
-  if(freqseries->freq) gsl_vector_free(freqseries->freq);
-  if(freqseries->amp_real) gsl_vector_free(freqseries->amp_real);
-  if(freqseries->amp_imag) gsl_vector_free(freqseries->amp_imag);
-  if(freqseries->phase) gsl_vector_free(freqseries->phase);
-  free(freqseries);
+  if(freqseries->freq) ArenaVectorFree(freqseries->freq);
+  if(freqseries->amp_real) ArenaVectorFree(freqseries->amp_real);
+  if(freqseries->amp_imag) ArenaVectorFree(freqseries->amp_imag);
+  if(freqseries->phase) ArenaVectorFree(freqseries->phase);
+  ArenaFree(freqseries);
 }
 
 /******** Functions to initialize and clean up CAmpPhaseSpline structure ********/
 void CAmpPhaseSpline_Init(CAmpPhaseSpline **splines, const int n) {
   if(!splines) exit(1);
   /* Create storage for structures */
-  if(!*splines) *splines=malloc(sizeof(CAmpPhaseSpline));
+  if(!*splines) *splines=ArenaMalloc(sizeof(CAmpPhaseSpline));
   else
   {
     CAmpPhaseSpline_Cleanup(*splines);
+    *splines=ArenaMalloc(sizeof(CAmpPhaseSpline));
   }
   gsl_set_error_handler(&Err_Handler);
-  (*splines)->spline_amp_real = gsl_matrix_alloc(n, 5);
-  (*splines)->spline_amp_imag = gsl_matrix_alloc(n, 5);
-  (*splines)->quadspline_phase = gsl_matrix_alloc(n, 4);
+  (*splines)->spline_amp_real = ArenaMatrixAlloc(n, 5);
+  (*splines)->spline_amp_imag = ArenaMatrixAlloc(n, 5);
+  (*splines)->quadspline_phase = ArenaMatrixAlloc(n, 4);
 }
 void CAmpPhaseSpline_Cleanup(CAmpPhaseSpline *splines) {
-  if(splines->spline_amp_real) gsl_matrix_free(splines->spline_amp_real);
-  if(splines->spline_amp_imag) gsl_matrix_free(splines->spline_amp_imag);
-  if(splines->quadspline_phase) gsl_matrix_free(splines->quadspline_phase);
-  free(splines);
+  if(splines->spline_amp_real) ArenaMatrixFree(splines->spline_amp_real);
+  if(splines->spline_amp_imag) ArenaMatrixFree(splines->spline_amp_imag);
+  if(splines->quadspline_phase) ArenaMatrixFree(splines->quadspline_phase);
+  ArenaFree(splines);
 }
 
 /******** Functions to initialize and clean up CAmpPhaseGSLSpline structure ********/
@@ -294,81 +1053,85 @@ void CAmpPhaseGSLSpline_Cleanup(CAmpPhaseGSLSpline *splines) {
 void ReImFrequencySeries_Init(ReImFrequencySeries **freqseries, const int n) {
   if(!freqseries) exit(1);
   /* Create storage for structures */
-  if(!*freqseries) *freqseries=malloc(sizeof(ReImFrequencySeries));
+  if(!*freqseries) *freqseries=ArenaMalloc(sizeof(ReImFrequencySeries));
   else
   {
     ReImFrequencySeries_Cleanup(*freqseries);
+    *freqseries=ArenaMalloc(sizeof(ReImFrequencySeries));
   }
   gsl_set_error_handler(&Err_Handler);
-  (*freqseries)->freq = gsl_vector_alloc(n);
-  (*freqseries)->h_real = gsl_vector_alloc(n);
-  (*freqseries)->h_imag = gsl_vector_alloc(n);
+  (*freqseries)->freq = ArenaVectorAlloc(n);
+  (*freqseries)->h_real = ArenaVectorAlloc(n);
+  (*freqseries)->h_imag = ArenaVectorAlloc(n);
 }
 void ReImFrequencySeries_Cleanup(ReImFrequencySeries *freqseries) {
-  if(freqseries->freq) gsl_vector_free(freqseries->freq);
-  if(freqseries->h_real) gsl_vector_free(freqseries->h_real);
-  if(freqseries->h_imag) gsl_vector_free(freqseries->h_imag);
-  free(freqseries);
+  if(freqseries->freq) ArenaVectorFree(freqseries->freq);
+  if(freqseries->h_real) ArenaVectorFree(freqseries->h_real);
+  if(freqseries->h_imag) ArenaVectorFree(freqseries->h_imag);
+  ArenaFree(freqseries);
 }
 
 /******** Functions to initialize and clean up ReImTimeSeries structure ********/
 void ReImTimeSeries_Init(ReImTimeSeries **timeseries, const int n) {
   if(!timeseries) exit(1);
   /* Create storage for structures */
-  if(!*timeseries) *timeseries=malloc(sizeof(ReImTimeSeries));
+  if(!*timeseries) *timeseries=ArenaMalloc(sizeof(ReImTimeSeries));
   else
   {
     ReImTimeSeries_Cleanup(*timeseries);
+    *timeseries=ArenaMalloc(sizeof(ReImTimeSeries));
   }
   gsl_set_error_handler(&Err_Handler);
-  (*timeseries)->times = gsl_vector_alloc(n);
-  (*timeseries)->h_real = gsl_vector_alloc(n);
-  (*timeseries)->h_imag = gsl_vector_alloc(n);
+  (*timeseries)->times = ArenaVectorAlloc(n);
+  (*timeseries)->h_real = ArenaVectorAlloc(n);
+  (*timeseries)->h_imag = ArenaVectorAlloc(n);
 }
 void ReImTimeSeries_Cleanup(ReImTimeSeries *timeseries) {
-  if(timeseries->times) gsl_vector_free(timeseries->times);
-  if(timeseries->h_real) gsl_vector_free(timeseries->h_real);
-  if(timeseries->h_imag) gsl_vector_free(timeseries->h_imag);
-  free(timeseries);
+  if(timeseries->times) ArenaVectorFree(timeseries->times);
+  if(timeseries->h_real) ArenaVectorFree(timeseries->h_real);
+  if(timeseries->h_imag) ArenaVectorFree(timeseries->h_imag);
+  ArenaFree(timeseries);
 }
 /******** Functions to initialize and clean up AmpPhaseTimeSeries structure ********/
 void AmpPhaseTimeSeries_Init(AmpPhaseTimeSeries **timeseries, const int n) {
   if(!timeseries) exit(1);
   /* Create storage for structures */
-  if(!*timeseries) *timeseries=malloc(sizeof(AmpPhaseTimeSeries));
+  if(!*timeseries) *timeseries=ArenaMalloc(sizeof(AmpPhaseTimeSeries));
   else
   {
     AmpPhaseTimeSeries_Cleanup(*timeseries);
+    *timeseries=ArenaMalloc(sizeof(AmpPhaseTimeSeries));
   }
   gsl_set_error_handler(&Err_Handler);
-  (*timeseries)->times = gsl_vector_alloc(n);
-  (*timeseries)->h_amp = gsl_vector_alloc(n);
-  (*timeseries)->h_phase = gsl_vector_alloc(n);
+  (*timeseries)->times = ArenaVectorAlloc(n);
+  (*timeseries)->h_amp = ArenaVectorAlloc(n);
+  (*timeseries)->h_phase = ArenaVectorAlloc(n);
 }
 void AmpPhaseTimeSeries_Cleanup(AmpPhaseTimeSeries *timeseries) {
-  if(timeseries->times) gsl_vector_free(timeseries->times);
-  if(timeseries->h_amp) gsl_vector_free(timeseries->h_amp);
-  if(timeseries->h_phase) gsl_vector_free(timeseries->h_phase);
-  free(timeseries);
+  if(timeseries->times) ArenaVectorFree(timeseries->times);
+  if(timeseries->h_amp) ArenaVectorFree(timeseries->h_amp);
+  if(timeseries->h_phase) ArenaVectorFree(timeseries->h_phase);
+  ArenaFree(timeseries);
 }
 
 /******** Functions to initialize and clean up RealTimeSeries structure ********/
 void RealTimeSeries_Init(RealTimeSeries **timeseries, const int n) {
   if(!timeseries) exit(1);
   /* Create storage for structures */
-  if(!*timeseries) *timeseries=malloc(sizeof(RealTimeSeries));
+  if(!*timeseries) *timeseries=ArenaMalloc(sizeof(RealTimeSeries));
   else
   {
     RealTimeSeries_Cleanup(*timeseries);
+    *timeseries=ArenaMalloc(sizeof(RealTimeSeries));
   }
   gsl_set_error_handler(&Err_Handler);
-  (*timeseries)->times = gsl_vector_alloc(n);
-  (*timeseries)->h = gsl_vector_alloc(n);
+  (*timeseries)->times = ArenaVectorAlloc(n);
+  (*timeseries)->h = ArenaVectorAlloc(n);
 }
 void RealTimeSeries_Cleanup(RealTimeSeries *timeseries) {
-  if(timeseries->times) gsl_vector_free(timeseries->times);
-  if(timeseries->h) gsl_vector_free(timeseries->h);
-  free(timeseries);
+  if(timeseries->times) ArenaVectorFree(timeseries->times);
+  if(timeseries->h) ArenaVectorFree(timeseries->h);
+  ArenaFree(timeseries);
 }
 
 /***************** Functions for the ListmodesCAmpPhaseFrequencySeries structure ****************/
@@ -393,7 +1156,7 @@ ListmodesCAmpPhaseFrequencySeries* ListmodesCAmpPhaseFrequencySeries_AddModeNoCo
     } else { /* In that case, we do NOT COPY the input interpolated data, which therefore can't be
 		used anywhere else; this will be acceptable as these operations will only be done
 		when interpolating the initialization data */
-      list = malloc( sizeof(ListmodesCAmpPhaseFrequencySeries) );
+      list = ArenaMalloc( sizeof(ListmodesCAmpPhaseFrequencySeries) );
     }
     list->l = l;
     list->m = m;
@@ -435,7 +1198,7 @@ void ListmodesCAmpPhaseFrequencySeries_Destroy(
     }
     /* Notice that the mode indices l and m are not freed, like in SphHarmTimeSeries struct indices l and m */
     list = pop->next;
-    free( pop );
+    ArenaFree( pop );
   }
 }
 
@@ -461,7 +1224,7 @@ ListmodesCAmpPhaseSpline* ListmodesCAmpPhaseSpline_AddModeNoCopy(
     } else { /* In that case, we do NOT COPY the input interpolated data, which therefore can't be
 		used anywhere else; this will be acceptable as these operations will only be done
 		when interpolating the initialization data */
-      list = malloc( sizeof(ListmodesCAmpPhaseSpline) );
+      list = ArenaMalloc( sizeof(ListmodesCAmpPhaseSpline) );
     }
     list->l = l;
     list->m = m;
@@ -503,7 +1266,7 @@ void ListmodesCAmpPhaseSpline_Destroy(
     }
     /* Notice that the mode indices l and m are not freed, like in SphHarmTimeSeries struct indices l and m */
     list = pop->next;
-    free( pop );
+    ArenaFree( pop );
   }
 }
 
@@ -513,155 +1276,81 @@ void ListmodesCAmpPhaseSpline_Destroy(
 /* Read waveform Real time series */
 int Read_RealTimeSeries(RealTimeSeries** timeseries, const char dir[], const char file[], const int nblines, const int binary)
 {
-  /* Initalize and read input */
-  int ret;
-  gsl_matrix* inmatrix =  gsl_matrix_alloc(nblines, 2);
-  if(!binary) ret = Read_Text_Matrix(dir, file, inmatrix);
-  else ret = Read_Matrix(dir, file, inmatrix);
-
-  /* Initialize structures */
-  RealTimeSeries_Init(timeseries, nblines);
-
-  /* Set values */
-  gsl_vector_view timesview = gsl_matrix_column(inmatrix, 0);
-  gsl_vector_view hview = gsl_matrix_column(inmatrix, 1);
-  gsl_vector_memcpy((*timeseries)->times, &timesview.vector);
-  gsl_vector_memcpy((*timeseries)->h, &hview.vector);
-
-  /* Clean up */
-  gsl_matrix_free(inmatrix);
+  /* Read input - zero-copy for columnar files */
+  gsl_vector* columns[2];
+  int nbrows;
+  if(Read_Columns(columns, 2, &nbrows, dir, file, nblines, binary)==FAILURE) return FAILURE;
 
-  return ret;
+  /* Set structure - the columns are taken over */
+  if(*timeseries) RealTimeSeries_Cleanup(*timeseries);
+  *timeseries = ArenaMalloc(sizeof(RealTimeSeries));
+  (*timeseries)->times = columns[0];
+  (*timeseries)->h = columns[1];
+
+  return SUCCESS;
 }
 
 /* Read waveform Amp/Phase time series */
 int Read_AmpPhaseTimeSeries(AmpPhaseTimeSeries** timeseries, const char dir[], const char file[], const int nblines, const int binary)
 {
-  /* Initalize and read input */
-  int ret;
-  gsl_matrix* inmatrix =  gsl_matrix_alloc(nblines, 3);
-  if(!binary) ret = Read_Text_Matrix(dir, file, inmatrix);
-  else ret = Read_Matrix(dir, file, inmatrix);
-
-  /* Initialize structures */
-  AmpPhaseTimeSeries_Init(timeseries, nblines);
-
-  /* Set values */
-  gsl_vector_view timesview = gsl_matrix_column(inmatrix, 0);
-  gsl_vector_view hampview = gsl_matrix_column(inmatrix, 1);
-  gsl_vector_view hphaseview = gsl_matrix_column(inmatrix, 2);
-  gsl_vector_memcpy((*timeseries)->times, &timesview.vector);
-  gsl_vector_memcpy((*timeseries)->h_amp, &hampview.vector);
-  gsl_vector_memcpy((*timeseries)->h_phase, &hphaseview.vector);
-
-  /* Clean up */
-  gsl_matrix_free(inmatrix);
+  /* Read input - zero-copy for columnar files */
+  gsl_vector* columns[3];
+  int nbrows;
+  if(Read_Columns(columns, 3, &nbrows, dir, file, nblines, binary)==FAILURE) return FAILURE;
 
-  return ret;
+  /* Set structure - the columns are taken over */
+  if(*timeseries) AmpPhaseTimeSeries_Cleanup(*timeseries);
+  *timeseries = ArenaMalloc(sizeof(AmpPhaseTimeSeries));
+  (*timeseries)->times = columns[0];
+  (*timeseries)->h_amp = columns[1];
+  (*timeseries)->h_phase = columns[2];
+
+  return SUCCESS;
 }
 
 /* Read waveform Re/Im time series */
 int Read_ReImTimeSeries(ReImTimeSeries** timeseries, const char dir[], const char file[], const int nblines, const int binary)
 {
-  /* Initalize and read input */
-  int ret;
-  gsl_matrix* inmatrix =  gsl_matrix_alloc(nblines, 3);
-  if(!binary) ret = Read_Text_Matrix(dir, file, inmatrix);
-  else ret = Read_Matrix(dir, file, inmatrix);
-
-  /* Initialize structures */
-  ReImTimeSeries_Init(timeseries, nblines);
-
-  /* Set values */
-  gsl_vector_view timesview = gsl_matrix_column(inmatrix, 0);
-  gsl_vector_view hrealview = gsl_matrix_column(inmatrix, 1);
-  gsl_vector_view himagview = gsl_matrix_column(inmatrix, 2);
-  gsl_vector_memcpy((*timeseries)->times, &timesview.vector);
-  gsl_vector_memcpy((*timeseries)->h_real, &hrealview.vector);
-  gsl_vector_memcpy((*timeseries)->h_imag, &himagview.vector);
-
-  /* Clean up */
-  gsl_matrix_free(inmatrix);
+  /* Read input - zero-copy for columnar files */
+  gsl_vector* columns[3];
+  int nbrows;
+  if(Read_Columns(columns, 3, &nbrows, dir, file, nblines, binary)==FAILURE) return FAILURE;
 
-  return ret;
+  /* Set structure - the columns are taken over */
+  if(*timeseries) ReImTimeSeries_Cleanup(*timeseries);
+  *timeseries = ArenaMalloc(sizeof(ReImTimeSeries));
+  (*timeseries)->times = columns[0];
+  (*timeseries)->h_real = columns[1];
+  (*timeseries)->h_imag = columns[2];
+
+  return SUCCESS;
 }
 
 /* Output Re/Im frequency series */
 int Write_ReImFrequencySeries(const char dir[], const char file[], ReImFrequencySeries* freqseries, const int binary)
 {
-  /* Initialize output */
   /* Note: assumes hplus, hcross have same length as expected */
-  int nbfreq = freqseries->freq->size;
-  gsl_matrix* outmatrix = gsl_matrix_alloc(nbfreq, 3);
-
-  /* Set output matrix */
-  gsl_matrix_set_col(outmatrix, 0, freqseries->freq);
-  gsl_matrix_set_col(outmatrix, 1, freqseries->h_real);
-  gsl_matrix_set_col(outmatrix, 2, freqseries->h_imag);
-
-  /* Output */
-  int ret;
-  if (!binary) ret = Write_Text_Matrix(dir, file, outmatrix);
-  else ret = Write_Matrix(dir, file, outmatrix);
-
-  return ret;
+  gsl_vector* columns[3] = {freqseries->freq, freqseries->h_real, freqseries->h_imag};
+  return Write_Columns(dir, file, columns, 3, binary);
 }
 
 /* Output real time series */
 int Write_RealTimeSeries(const char dir[], const char file[], RealTimeSeries* timeseries, int binary)
 {
-  /* Initialize output */
-  int nbtimes = timeseries->times->size;
-  gsl_matrix* outmatrix = gsl_matrix_alloc(nbtimes, 2);
-
-  /* Set data */
-  gsl_matrix_set_col(outmatrix, 0, timeseries->times);
-  gsl_matrix_set_col(outmatrix, 1, timeseries->h);
-
-  /* Output */
-  int ret;
-  if(!binary) ret = Write_Text_Matrix(dir, file, outmatrix);
-  else ret = Write_Matrix(dir, file, outmatrix);
-
-  return ret;
+  gsl_vector* columns[2] = {timeseries->times, timeseries->h};
+  return Write_Columns(dir, file, columns, 2, binary);
 }
 
 /* Output Amp/Phase time series */
 int Write_AmpPhaseTimeSeries(const char dir[], const char file[], AmpPhaseTimeSeries* timeseries, int binary)
 {
-  /* Initialize output */
-  int nbtimes = timeseries->times->size;
-  gsl_matrix* outmatrix = gsl_matrix_alloc(nbtimes, 3);
-
-  /* Set data */
-  gsl_matrix_set_col(outmatrix, 0, timeseries->times);
-  gsl_matrix_set_col(outmatrix, 1, timeseries->h_amp);
-  gsl_matrix_set_col(outmatrix, 2, timeseries->h_phase);
-
-  /* Output */
-  int ret;
-  if(!binary) ret = Write_Text_Matrix(dir, file, outmatrix);
-  else ret = Write_Matrix(dir, file, outmatrix);
-
-  return ret;
+  gsl_vector* columns[3] = {timeseries->times, timeseries->h_amp, timeseries->h_phase};
+  return Write_Columns(dir, file, columns, 3, binary);
 }
 
 /* Output Re/Im time series */
 int Write_ReImTimeSeries(const char dir[], const char file[], ReImTimeSeries* timeseries, int binary)
 {
-  /* Initialize output */
-  int nbtimes = timeseries->times->size;
-  gsl_matrix* outmatrix = gsl_matrix_alloc(nbtimes, 3);
-
-  /* Set data */
-  gsl_matrix_set_col(outmatrix, 0, timeseries->times);
-  gsl_matrix_set_col(outmatrix, 1, timeseries->h_real);
-  gsl_matrix_set_col(outmatrix, 2, timeseries->h_imag);
-
-  /* Output */
-  int ret;
-  if(!binary) ret = Write_Text_Matrix(dir, file, outmatrix);
-  else ret = Write_Matrix(dir, file, outmatrix);
-
-  return ret;
+  gsl_vector* columns[3] = {timeseries->times, timeseries->h_real, timeseries->h_imag};
+  return Write_Columns(dir, file, columns, 3, binary);
 }
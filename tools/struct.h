@@ -25,6 +25,7 @@
 #include <getopt.h>
 #include <stdbool.h>
 #include <string.h>
+#include <stdint.h>
 
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_bspline.h>
@@ -136,11 +137,69 @@ typedef struct tagListmodesCAmpPhaseSpline
   struct tagListmodesCAmpPhaseSpline*    next;    /* Next pointer */
 } ListmodesCAmpPhaseSpline;
 
+/* Arena (bump) allocator, for temporaries that all die together at the end of a computation */
+/* Blocks are handed out by moving a pointer forward, and released all at once by ArenaReset */
+typedef struct tagArena
+{
+  char*  memory;        /* Raw block, as returned by malloc */
+  char*  base;          /* Start of the usable block, aligned */
+  size_t size;          /* Usable size of the block, in bytes */
+  size_t offset;        /* Current position of the bump pointer */
+  size_t requested;     /* Bytes requested since last reset, including those that did not fit */
+  size_t highwater;     /* Maximal number of bytes requested in a single cycle */
+  long   nballoc;       /* Number of allocations served by the arena since last reset */
+  long   nbmalloc;      /* Number of allocations that fell back to malloc since last reset */
+  long   lastnballoc;   /* Same as nballoc, for the last completed cycle */
+  long   lastnbmalloc;  /* Same as nbmalloc, for the last completed cycle */
+  long   totalnbmalloc; /* Number of fallback mallocs since initialization */
+  long   nbreset;       /* Number of resets (cycles) since initialization */
+  long   nbgrow;        /* Number of times the block was enlarged at reset */
+  struct tagArena* next; /* Next arena in the list of all live arenas, used to find the owner of a block */
+} Arena;
+
+/* Header of the binary columnar files - 64 bytes, values in native byte order */
+/* The header is followed by one checksum per column if COLUMNAR_CHECKSUMS is set, then by the columns one after the other, starting at a multiple of 64 bytes */
+typedef struct tagColumnarHeader
+{
+  char    magic[8];     /* "FLARECOL" */
+  int32_t version;      /* Version of the format - 1 */
+  int32_t dtype;        /* Type of the values - only COLUMNAR_FLOAT64 */
+  int64_t ncols;        /* Number of columns */
+  int64_t nrows;        /* Number of rows, i.e. length of each column */
+  int64_t flags;        /* Bit flags, COLUMNAR_CHECKSUMS */
+  double  x0;           /* First value of column 0 (times or frequencies) */
+  double  deltax;       /* Step of column 0 if it is uniform, 0 otherwise */
+  int64_t reserved;     /* Unused, 0 */
+} ColumnarHeader;
+
+/* Binary columnar file mapped in memory - columns are read in place, without parsing or copy */
+/* The mapping is reference-counted: one reference for the handle returned by ColumnarFile_Open, one for each column view handed out by Read_Columns */
+typedef struct tagColumnarFile
+{
+  ColumnarHeader header; /* Copy of the header */
+  void*   map;          /* Start of the mapping */
+  size_t  mapsize;      /* Size of the mapping, in bytes */
+  double* data;         /* Start of the first column in the mapping */
+  int     nbrefs;       /* Number of references to the mapping - unmapped when it drops to 0 */
+} ColumnarFile;
+
 /**************************************************************/
 /* Functions computing the max and min between two int */
 int max (int a, int b);
 int min (int a, int b);
 
+/**************************************************************/
+/************** Phasors on linear grids ***********************/
+
+/* Number of steps of the phasor recurrence between two exact evaluations */
+#define PHASOR_REANCHOR 64
+
+/* Fill z[j] = exp(I*(phi0 + j*dphi)) for j=0..n-1, by successive rotations by exp(I*dphi), re-anchored with an exact cexp every PHASOR_REANCHOR steps */
+/* Rounding errors add up linearly between two anchors - measured below 1e-14 for PHASOR_REANCHOR=64, on top of the rounding of the phase phi0 + j*dphi itself that cexp also has */
+void Phasor_Fill(double complex* z, const double phi0, const double dphi, const int n);
+/* Returns 1 if x[j] = x[0] + j*deltax to a few ulps of max|x| for all j, with deltax=(x[n-1]-x[0])/(n-1) set on output, 0 otherwise */
+int IsLinearGrid(double* deltax, const double* x, const int n);
+
 /**************************************************************/
 /************** GSL error handling and I/O ********************/
 
@@ -152,11 +211,66 @@ int Read_Vector(const char dir[], const char fname[], gsl_vector *v);
 int Read_Matrix(const char dir[], const char fname[], gsl_matrix *m);
 int Read_Text_Vector(const char dir[], const char fname[], gsl_vector *v);
 int Read_Text_Matrix(const char dir[], const char fname[], gsl_matrix *m);
+/* Allocates and reads a text table - nblines<=0 to count the lines, ncols<=0 to take the number of values on the first line */
+int Read_Text_Table(gsl_matrix** m, const char dir[], const char fname[], const int nblines, const int ncols);
 int Write_Vector(const char dir[], const char fname[], gsl_vector *v);
 int Write_Matrix(const char dir[], const char fname[], gsl_matrix *m);
 int Write_Text_Vector(const char dir[], const char fname[], gsl_vector *v);
 int Write_Text_Matrix(const char dir[], const char fname[], gsl_matrix *m);
 
+/* Formats of data files, values of the binary flag of the I/O functions */
+#define FILE_TEXT 0             /* Text, one row per line */
+#define FILE_BINARY 1           /* Raw doubles in row-major order, as gsl_matrix_fwrite */
+#define FILE_COLUMNAR 2         /* Self-describing binary columnar format, see ColumnarHeader */
+
+#define COLUMNAR_VERSION 1
+#define COLUMNAR_FLOAT64 1
+#define COLUMNAR_CHECKSUMS 1
+
+/* Functions for binary columnar files */
+/* Columns are FNV-1a checksums computed on 64-bit words - verify=1 checks them on opening, which reads the whole file once */
+int IsColumnarFile(const char dir[], const char fname[]);
+int ColumnarFile_Open(ColumnarFile** cf, const char dir[], const char fname[], const int verify);
+void ColumnarFile_Close(ColumnarFile* cf);     /* Releases the reference of the handle - pointers from ColumnarFile_Column are invalid afterwards, unless column views still hold the mapping */
+void ColumnarFile_Release(ColumnarFile* cf);   /* Drop one reference, unmapping the file when none is left */
+double* ColumnarFile_Column(ColumnarFile* cf, const int j);
+/* Buffered writer - column 0 is checked for uniform sampling, recorded in the header */
+int Write_Columnar(const char dir[], const char fname[], gsl_vector** columns, const int ncols, const int checksums);
+
+/* Read/write the columns of a data file in any of the formats above - columnar files are recognized from their header, whatever the value of binary */
+/* Read_Columns allocates the columns, except for columnar files where they are views of the mapping (zero-copy) - nblines is then ignored, and is optional (<=0) for the other formats */
+/* In both cases the columns are released by ArenaVectorFree, never by gsl_vector_free - each column view holds a reference to the mapping, which is unmapped with the last column */
+/* The Read_*TimeSeries functions take the columns over: the mapping is released by the corresponding *_Cleanup */
+int Read_Columns(gsl_vector** columns, const int ncols, int* nbrows, const char dir[], const char fname[], const int nblines, const int binary);
+int Write_Columns(const char dir[], const char fname[], gsl_vector** columns, const int ncols, const int binary);
+/* Same for a matrix, one column of the file per column of the matrix */
+int Write_Table(const char dir[], const char fname[], gsl_matrix* m, const int binary);
+
+/**********************************************************/
+/**************** Arena allocator *************************/
+
+/* Functions to initialize, reset and clean up an arena */
+void Arena_Init(
+	 Arena** arena,                         /* double pointer for initialization */
+	 const size_t size );                   /* initial size of the block, in bytes */
+void Arena_Cleanup(Arena* arena);
+void Arena_Reset(Arena* arena);              /* O(1) release of everything allocated since last reset - grows the block if the cycle overflowed */
+void Arena_Report(FILE* f, Arena* arena);    /* Print allocation counts - nbmalloc=0 means no malloc in steady state */
+
+/* Bind an arena to the calling thread (NULL to unbind) - returns the previously bound arena */
+/* NOTE: objects drawn from an arena have to be cleaned up while it is still bound, or simply dropped before the reset */
+Arena* Arena_Bind(Arena* arena);
+Arena* Arena_Current(void);
+int Arena_Owns(const void* ptr);             /* 1 if ptr lies in a live arena - the one bound to the calling thread first, then all the others */
+
+/* Allocation functions drawing from the arena bound to the calling thread, if any, and from malloc/gsl otherwise */
+void* ArenaMalloc(const size_t size);
+void ArenaFree(void* ptr);
+gsl_vector* ArenaVectorAlloc(const size_t n);
+void ArenaVectorFree(gsl_vector* v);
+gsl_matrix* ArenaMatrixAlloc(const size_t n1, const size_t n2);
+void ArenaMatrixFree(gsl_matrix* m);
+
 /**********************************************************/
 /**************** Internal functions **********************/
 
@@ -223,7 +337,7 @@ void RealTimeSeries_Cleanup(RealTimeSeries* timeseries);
 /***********************************************************************/
 /**************** I/O functions for internal structures ****************/
 
-/* Note: at the moment, requires external input for the number of lines in the data */
+/* Note: requires external input for the number of lines in the data, except for columnar files (binary=FILE_COLUMNAR) */
 int Read_RealTimeSeries(RealTimeSeries** timeseries, const char dir[], const char file[], const int nblines, const int binary);
 int Read_AmpPhaseTimeSeries(AmpPhaseTimeSeries** timeseries, const char dir[], const char file[], const int nblines, const int binary);
 int Read_ReImTimeSeries(ReImTimeSeries** timeseries, const char dir[], const char file[], const int nblines, const int binary);
@@ -0,0 +1,314 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+
+#include "constants.h"
+#include "struct.h"
+#include "uniforminterp.h"
+
+/* Relative tolerance on the uniformity of the grid */
+#define UNIFORMINTERP_TOL 1e-6
+
+UniformInterptag ParseUniformInterptag(char* string) {
+  UniformInterptag tag;
+  if(strcmp(string, "cspline")==0) tag = UIcspline;
+  else if(strcmp(string, "lagrange")==0) tag = UIlagrange;
+  else if(strcmp(string, "sinc")==0) tag = UIsinc;
+  else {
+    printf("Error in ParseUniformInterptag: string not recognized.\n");
+    exit(1);
+  }
+  return tag;
+}
+
+/* Second derivatives of the natural cubic spline on a uniform grid - tridiagonal system (1,4,1) solved with the Thomas algorithm */
+static void UniformInterp_BuildCSpline(UniformInterp* interp)
+{
+  int n = interp->n;
+  double* y = interp->y;
+  double* d2y = interp->d2y;
+  double fac = 6./(interp->deltax*interp->deltax);
+  d2y[0] = 0.;
+  d2y[n-1] = 0.;
+  if(n<3) return;
+  double* chat = (double*) malloc(sizeof(double)*n);
+  /* Forward sweep - unknowns are d2y[1..n-2] */
+  chat[1] = 1./4.;
+  d2y[1] = fac*(y[2] - 2*y[1] + y[0]) / 4.;
+  for(int i=2; i<n-1; i++) {
+    double denom = 4. - chat[i-1];
+    chat[i] = 1./denom;
+    d2y[i] = (fac*(y[i+1] - 2*y[i] + y[i-1]) - d2y[i-1]) / denom;
+  }
+  /* Back substitution */
+  for(int i=n-3; i>=1; i--) {
+    d2y[i] -= chat[i]*d2y[i+1];
+  }
+  free(chat);
+}
+
+void UniformInterp_Init(UniformInterp** interp, const double* x, const double* y, int n, UniformInterptag tag, int order)
+{
+  if(n<2) {
+    printf("Error in UniformInterp_Init: need at least 2 samples.\n");
+    exit(1);
+  }
+  if(tag!=UIcspline && (order<2 || order%2!=0 || order>n)) {
+    printf("Error in UniformInterp_Init: order must be even, at least 2 and at most the number of samples.\n");
+    exit(1);
+  }
+  double deltax = (x[n-1] - x[0])/(n-1);
+  for(int i=0; i<n; i++) {
+    if(fabs(x[i] - (x[0] + i*deltax)) > UNIFORMINTERP_TOL*deltax) {
+      printf("Error in UniformInterp_Init: grid is not uniform.\n");
+      exit(1);
+    }
+  }
+
+  /* A new object starts with no buffers - an existing one keeps its buffers, resized for the new samples, and can be reinitialized without a Cleanup */
+  if(!(*interp)) {
+    *interp = (UniformInterp*) malloc(sizeof(UniformInterp));
+    (*interp)->y = NULL;
+    (*interp)->d2y = NULL;
+    (*interp)->lambda = NULL;
+  }
+  (*interp)->tag = tag;
+  (*interp)->order = order;
+  (*interp)->n = n;
+  (*interp)->x0 = x[0];
+  (*interp)->deltax = deltax;
+  (*interp)->xmax = x[n-1];
+  (*interp)->y = (double*) realloc((*interp)->y, sizeof(double)*n);
+  memcpy((*interp)->y, y, sizeof(double)*n);
+
+  if(tag==UIcspline) {
+    (*interp)->d2y = (double*) realloc((*interp)->d2y, sizeof(double)*n);
+    UniformInterp_BuildCSpline(*interp);
+  }
+  else {
+    free((*interp)->d2y);
+    (*interp)->d2y = NULL;
+  }
+  if(tag==UIlagrange) {
+    /* Barycentric weights for equispaced nodes, (-1)^m binomial(order-1, m) */
+    (*interp)->lambda = (double*) realloc((*interp)->lambda, sizeof(double)*order);
+    double binom = 1.;
+    for(int m=0; m<order; m++) {
+      (*interp)->lambda[m] = (m%2==0) ? binom : -binom;
+      binom *= (double) (order-1-m) / (m+1);
+    }
+  }
+  else {
+    free((*interp)->lambda);
+    (*interp)->lambda = NULL;
+  }
+}
+
+void UniformInterp_Cleanup(UniformInterp* interp)
+{
+  free(interp->y);
+  if(interp->d2y) free(interp->d2y);
+  if(interp->lambda) free(interp->lambda);
+  free(interp);
+}
+
+/* Evaluation for each method - x is assumed to be in the domain */
+static inline double UniformInterp_EvalCSpline(const UniformInterp* interp, const double x)
+{
+  double u = (x - interp->x0)/interp->deltax;
+  int i = (int) u;
+  if(i > interp->n-2) i = interp->n-2;
+  double t = u - i;
+  double s = 1. - t;
+  double h2 = interp->deltax*interp->deltax/6.;
+  return s*interp->y[i] + t*interp->y[i+1] + h2*((s*s*s - s)*interp->d2y[i] + (t*t*t - t)*interp->d2y[i+1]);
+}
+static inline double UniformInterp_EvalLagrange(const UniformInterp* interp, const double x)
+{
+  int p = interp->order;
+  double u = (x - interp->x0)/interp->deltax;
+  int j0 = (int) floor(u) - p/2 + 1;
+  if(j0 < 0) j0 = 0;
+  if(j0 > interp->n - p) j0 = interp->n - p;
+  u -= j0;
+  const double* y = &(interp->y[j0]);
+  double num = 0., den = 0.;
+  for(int m=0; m<p; m++) {
+    double d = u - m;
+    if(d==0.) return y[m];
+    double w = interp->lambda[m]/d;
+    num += w*y[m];
+    den += w;
+  }
+  return num/den;
+}
+static inline double UniformInterp_EvalSinc(const UniformInterp* interp, const double x)
+{
+  int a = interp->order/2;
+  double u = (x - interp->x0)/interp->deltax;
+  int i = (int) floor(u);
+  double num = 0., den = 0.;
+  for(int j=i-a+1; j<=i+a; j++) {
+    if(j<0 || j>interp->n-1) continue;
+    double s = u - j;
+    double w = (s==0.) ? 1. : (sin(PI*s)/(PI*s)) * (sin(PI*s/a)/(PI*s/a));
+    num += w*interp->y[j];
+    den += w;
+  }
+  return num/den;
+}
+
+double UniformInterp_Eval(const UniformInterp* interp, const double x)
+{
+  if(x < interp->x0 || x > interp->xmax) return 0.;
+  if(interp->tag==UIcspline) return UniformInterp_EvalCSpline(interp, x);
+  else if(interp->tag==UIlagrange) return UniformInterp_EvalLagrange(interp, x);
+  else return UniformInterp_EvalSinc(interp, x);
+}
+
+/* Array evaluation, by blocks of abscissas: the loops over the block are simd loops without control flow - abscissas outside of the domain are evaluated at x0 and their value set to 0 */
+/* Where gcc would compile a select of a computed value as a branch (without -fno-trapping-math), the discarded values are multiplied by a 0/1 mask instead */
+/* The loads of the samples are gathers: the loops are vectorized for targets that have them (e.g. -mavx2), and stay scalar for the default x86-64 target */
+/* For Lagrange and sinc the loop over the stencil is outside of the loop over the block */
+#define UNIFORMINTERP_BLOCK 256
+
+static void UniformInterp_EvalArrayCSpline(const UniformInterp* interp, const double* x, double* values, int nx)
+{
+  double x0 = interp->x0;
+  double xmax = interp->xmax;
+  double deltax = interp->deltax;
+  double h2 = deltax*deltax/6.;
+  int n = interp->n;
+  const double* y = interp->y;
+  const double* d2y = interp->d2y;
+  #pragma omp simd
+  for(int k=0; k<nx; k++) {
+    int in = (x[k] >= x0) & (x[k] <= xmax);
+    double u = ((in ? x[k] : x0) - x0)/deltax;
+    int i = (int) u;
+    i = (i > n-2) ? n-2 : i;
+    double t = u - i;
+    double s = 1. - t;
+    double v = s*y[i] + t*y[i+1] + h2*((s*s*s - s)*d2y[i] + (t*t*t - t)*d2y[i+1]);
+    values[k] = v*in + 0.; /* + 0. turns -0. into 0. */
+  }
+}
+
+static void UniformInterp_EvalArrayLagrange(const UniformInterp* interp, const double* x, double* values, int nx)
+{
+  double x0 = interp->x0;
+  double xmax = interp->xmax;
+  double deltax = interp->deltax;
+  int p = interp->order;
+  int n = interp->n;
+  const double* y = interp->y;
+  const double* lambda = interp->lambda;
+  double u[UNIFORMINTERP_BLOCK], num[UNIFORMINTERP_BLOCK], den[UNIFORMINTERP_BLOCK], ynode[UNIFORMINTERP_BLOCK];
+  int j0[UNIFORMINTERP_BLOCK], onnode[UNIFORMINTERP_BLOCK], in[UNIFORMINTERP_BLOCK];
+  for(int kb=0; kb<nx; kb+=UNIFORMINTERP_BLOCK) {
+    int nb = min(UNIFORMINTERP_BLOCK, nx-kb);
+    const double* xb = &(x[kb]);
+    #pragma omp simd
+    for(int k=0; k<nb; k++) {
+      in[k] = (xb[k] >= x0) & (xb[k] <= xmax);
+      double uk = ((in[k] ? xb[k] : x0) - x0)/deltax;
+      int j = (int) floor(uk) - p/2 + 1;
+      j = (j < 0) ? 0 : j;
+      j = (j > n - p) ? n - p : j;
+      j0[k] = j;
+      u[k] = uk - j;
+      num[k] = 0.;
+      den[k] = 0.;
+      ynode[k] = 0.;
+      onnode[k] = 0;
+    }
+    for(int m=0; m<p; m++) {
+      #pragma omp simd
+      for(int k=0; k<nb; k++) {
+        double d = u[k] - m;
+        double ym = y[j0[k] + m];
+        onnode[k] |= (d==0.);
+        ynode[k] = (d==0.) ? ym : ynode[k];
+        double w = lambda[m]/((d==0.) ? 1. : d);
+        num[k] += w*ym;
+        den[k] += w;
+      }
+    }
+    #pragma omp simd
+    for(int k=0; k<nb; k++) {
+      double v = onnode[k] ? ynode[k] : num[k]/den[k];
+      values[kb+k] = in[k] ? v : 0.;
+    }
+  }
+}
+
+/* The sines of the stencil are obtained from two sines per abscissa: with t = u - floor(u), for the stencil point m */
+/* sin(pi*s) = (-1)^(a-1-m) sin(pi*t), and sin(pi*s/a) = sin(theta - m*pi/a) with theta = pi*(t+a-1)/a */
+static void UniformInterp_EvalArraySinc(const UniformInterp* interp, const double* x, double* values, int nx)
+{
+  double x0 = interp->x0;
+  double xmax = interp->xmax;
+  double deltax = interp->deltax;
+  int a = interp->order/2;
+  int p = 2*a;
+  int nm1 = interp->n-1;
+  const double* y = interp->y;
+  double* cosm = (double*) malloc(sizeof(double)*p);
+  double* sinm = (double*) malloc(sizeof(double)*p);
+  double* signm = (double*) malloc(sizeof(double)*p);
+  for(int m=0; m<p; m++) {
+    cosm[m] = cos(m*PI/a);
+    sinm[m] = sin(m*PI/a);
+    signm[m] = ((a-1-m)%2==0) ? 1. : -1.;
+  }
+  double t[UNIFORMINTERP_BLOCK], sinpit[UNIFORMINTERP_BLOCK], sintheta[UNIFORMINTERP_BLOCK], costheta[UNIFORMINTERP_BLOCK], num[UNIFORMINTERP_BLOCK], den[UNIFORMINTERP_BLOCK];
+  int jb[UNIFORMINTERP_BLOCK], in[UNIFORMINTERP_BLOCK];
+  for(int kb=0; kb<nx; kb+=UNIFORMINTERP_BLOCK) {
+    int nb = min(UNIFORMINTERP_BLOCK, nx-kb);
+    const double* xb = &(x[kb]);
+    #pragma omp simd
+    for(int k=0; k<nb; k++) {
+      in[k] = (xb[k] >= x0) & (xb[k] <= xmax);
+      double uk = ((in[k] ? xb[k] : x0) - x0)/deltax;
+      double i = floor(uk);
+      jb[k] = (int) i - a + 1;
+      t[k] = uk - i;
+      sinpit[k] = sin(PI*t[k]);
+      double theta = PI*(t[k] + a - 1)/a;
+      sintheta[k] = sin(theta);
+      costheta[k] = cos(theta);
+      num[k] = 0.;
+      den[k] = 0.;
+    }
+    for(int m=0; m<p; m++) {
+      #pragma omp simd
+      for(int k=0; k<nb; k++) {
+        /* Points outside of the grid get a weight 0 */
+        int j = jb[k] + m;
+        int jc = (j<0) ? 0 : ((j>nm1) ? nm1 : j);
+        double s = t[k] + (a-1-m);
+        double sn = (s==0.) ? 1. : s;
+        double sinpis = signm[m]*sinpit[k];
+        double sinpisa = sintheta[k]*cosm[m] - costheta[k]*sinm[m];
+        double w = a*sinpis*sinpisa/(PI*PI*sn*sn);
+        w = ((s==0.) ? 1. : w) * (j==jc);
+        num[k] += w*y[jc];
+        den[k] += w;
+      }
+    }
+    #pragma omp simd
+    for(int k=0; k<nb; k++) values[kb+k] = in[k] ? num[k]/den[k] : 0.;
+  }
+  free(cosm);
+  free(sinm);
+  free(signm);
+}
+
+void UniformInterp_EvalArray(const UniformInterp* interp, const double* x, double* values, int nx)
+{
+  /* Dispatch outside of the loops, so that each loop can be vectorized */
+  if(interp->tag==UIcspline) UniformInterp_EvalArrayCSpline(interp, x, values, nx);
+  else if(interp->tag==UIlagrange) UniformInterp_EvalArrayLagrange(interp, x, values, nx);
+  else UniformInterp_EvalArraySinc(interp, x, values, nx);
+}
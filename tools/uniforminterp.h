@@ -0,0 +1,83 @@
+/**
+ * \author Sylvain Marsat, University of Maryland - NASA GSFC
+ *
+ * \brief C header for interpolation of data sampled on a uniform grid (cubic spline, Lagrange, windowed sinc).
+ *
+ */
+
+#ifndef _UNIFORMINTERP_H
+#define _UNIFORMINTERP_H
+
+#define _XOPEN_SOURCE 500
+
+#ifdef __GNUC__
+#define UNUSED __attribute__ ((unused))
+#else
+#define UNUSED
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "constants.h"
+#include "struct.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#elif 0
+} /* so that editors will match preceding brace */
+#endif
+
+/* Enumerator to choose the interpolation method */
+typedef enum UniformInterptag {
+  UIcspline,      /* Natural cubic spline - same as gsl_interp_cspline */
+  UIlagrange,     /* Lagrange polynomial on order points around x */
+  UIsinc          /* Sinc with Lanczos window, on order points around x */
+} UniformInterptag;
+
+/* Interpolation on a uniform grid: the index of the interval is found in O(1), no search and no accelerator */
+/* Evaluation is read-only, so the same object can be used by several threads */
+typedef struct tagUniformInterp {
+  UniformInterptag tag;    /* Interpolation method */
+  int order;               /* Number of points of the stencil for Lagrange and sinc (even) - ignored for cspline */
+  int n;                   /* Number of samples */
+  double x0;               /* First abscissa */
+  double deltax;           /* Step of the grid */
+  double xmax;             /* Last abscissa */
+  double* y;               /* Samples - copy of the input */
+  double* d2y;             /* Second derivatives for cspline - NULL otherwise */
+  double* lambda;          /* Barycentric weights for Lagrange - NULL otherwise */
+} UniformInterp;
+
+UniformInterptag ParseUniformInterptag(char* string);
+
+/* Initialization - checks that x is uniform */
+/* If *interp is not NULL, the object is reinitialized in place and its buffers are reused */
+void UniformInterp_Init(
+  UniformInterp** interp,       /* Output: interpolation object */
+  const double* x,              /* Input: abscissas, uniformly spaced */
+  const double* y,              /* Input: values */
+  int n,                        /* Number of samples */
+  UniformInterptag tag,         /* Interpolation method */
+  int order);                   /* Number of points for Lagrange and sinc (even, at least 2) - ignored for cspline */
+void UniformInterp_Cleanup(UniformInterp* interp);
+
+/* Evaluation - returns 0 outside of [x0, xmax] */
+double UniformInterp_Eval(const UniformInterp* interp, const double x);
+/* Evaluation for an array of abscissas - the loops of the three methods are simd loops */
+void UniformInterp_EvalArray(const UniformInterp* interp, const double* x, double* values, int nx);
+
+#if 0
+{ /* so that editors will match succeeding brace */
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif /* _UNIFORMINTERP_H */
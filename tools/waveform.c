@@ -231,6 +231,106 @@ void ReImFrequencySeries_SumListmodesCAmpPhaseFrequencySeries(
   }
 }
 
+/* Function evaluating the ReImFrequencySeries of the detectors of a network, where the response of each detector is a constant factor and a delay for each mode */
+/* The signal in the detector k is sum_lm factors[ndet*imode+k] * hlm(f) * exp(I*twopidelays[k]*f) - the modes hlm are interpolated and evaluated once for all the detectors */
+void ReImFrequencySeries_SumListmodesNetwork(
+  struct tagReImFrequencySeries** freqseriesReIm,                   /* Output Re/Im frequency series, ndet values - already initialized */
+  struct tagListmodesCAmpPhaseFrequencySeries* listmodesCAmpPhase,  /* Input CAmp/Phase frequency series of the modes before the response, to be interpolated */
+  gsl_vector* freq,                                                 /* Input set of frequencies on which evaluating */
+  const int ndet,                                                   /* Number of detectors */
+  const double complex* factors,                                    /* Factors of the response, ndet values for each mode in the order of listmodesCAmpPhase */
+  const double* twopidelays,                                        /* 2pi times the delays of the detectors (s), ndet values */
+  double fLow,                                                      /* Minimal frequency - set to 0 to ignore */
+  double fHigh,                                                     /* Maximal frequency - set to 0 to ignore */
+  double fstartobs)                                                 /* Starting frequency in case of limited duration of observations - set to 0 to ignore */
+{
+  /* Check the sizes, initialize and copy frequencies */
+  int sizeout = (int) freq->size;
+  for(int k=0; k<ndet; k++) {
+    if(freq->size != freqseriesReIm[k]->freq->size) {
+      printf("Error: incompatible sizes in ReImFrequencySeries_SumListmodesNetwork.\n");
+      exit(1);
+    }
+    gsl_vector_set_zero(freqseriesReIm[k]->h_real);
+    gsl_vector_set_zero(freqseriesReIm[k]->h_imag);
+    gsl_vector_memcpy(freqseriesReIm[k]->freq, freq);
+  }
+
+  /* On a linear grid of frequencies, the delay phasors exp(I*twopidelays[k]*f) are obtained by recurrence */
+  double deltaf = 0.;
+  int linear = IsLinearGrid(&deltaf, freq->data, sizeout);
+
+  /* Main loop: go through the list of modes, interpolate and add them to the output of each detector */
+  int imode = 0;
+  ListmodesCAmpPhaseFrequencySeries* listelement = listmodesCAmpPhase;
+  while(listelement) {
+    CAmpPhaseFrequencySeries* freqseriesCAmpPhase = listelement->freqseries;
+    gsl_vector* freqin = freqseriesCAmpPhase->freq;
+    int sizein = (int) freqin->size;
+    double fstartobsmode = fmax(fstartobs, ((double) listelement->m)/2. * fstartobs);
+
+    /* Initializing the splines - once for all the detectors */
+    gsl_interp_accel* accel_ampreal = gsl_interp_accel_alloc();
+    gsl_interp_accel* accel_ampimag = gsl_interp_accel_alloc();
+    gsl_interp_accel* accel_phase = gsl_interp_accel_alloc();
+    gsl_spline* ampreal = gsl_spline_alloc(gsl_interp_cspline, sizein);
+    gsl_spline* ampimag = gsl_spline_alloc(gsl_interp_cspline, sizein);
+    gsl_spline* phase = gsl_spline_alloc(gsl_interp_cspline, sizein);
+    gsl_spline_init(ampreal, gsl_vector_const_ptr(freqin,0), gsl_vector_const_ptr(freqseriesCAmpPhase->amp_real,0), sizein);
+    gsl_spline_init(ampimag, gsl_vector_const_ptr(freqin,0), gsl_vector_const_ptr(freqseriesCAmpPhase->amp_imag,0), sizein);
+    gsl_spline_init(phase, gsl_vector_const_ptr(freqin,0), gsl_vector_const_ptr(freqseriesCAmpPhase->phase,0), sizein);
+
+    /* First and last index of the output frequency vector that are covered by the CAmpPhase data */
+    int jStart = 0;
+    int jStop = sizeout - 1;
+    double minfmode = fmax(fLow, fmax(gsl_vector_get(freqin, 0), fstartobsmode));
+    double maxfmode =  0.;
+    if(fHigh==0.) maxfmode = gsl_vector_get(freqin, sizein - 1);
+    else maxfmode = fmin(fHigh, gsl_vector_get(freqin, sizein - 1));
+    while(jStart<sizeout && gsl_vector_get(freq, jStart) < minfmode) jStart++;
+    while( jStop > -1 && gsl_vector_get(freq, jStop) > maxfmode ) jStop--;
+
+    /* Evaluating the mode once, then weighting it by the factor and delay of each detector */
+    /* Done in blocks of PHASOR_REANCHOR frequencies, so that each block of delay phasors costs one cexp on a linear grid */
+    const double complex* factorsmode = &(factors[ndet*imode]);
+    double f;
+    double complex hdet;
+    double complex h[PHASOR_REANCHOR];
+    double complex delay[PHASOR_REANCHOR];
+    double* freqdata = freq->data;
+    for(int jb=jStart; jb<=jStop; jb+=PHASOR_REANCHOR) { /* Note: loop to jStop included */
+      int nb = min(PHASOR_REANCHOR, jStop + 1 - jb);
+      for(int j=0; j<nb; j++) {
+        f = freqdata[jb+j];
+        h[j] = (gsl_spline_eval(ampreal, f, accel_ampreal) + I*gsl_spline_eval(ampimag, f, accel_ampimag)) * cexp(I*gsl_spline_eval(phase, f, accel_phase));
+      }
+      for(int k=0; k<ndet; k++) {
+        if(factorsmode[k]==0.) continue;
+        if(linear) Phasor_Fill(delay, twopidelays[k]*freqdata[jb], twopidelays[k]*deltaf, nb);
+        else for(int j=0; j<nb; j++) delay[j] = cexp(I*twopidelays[k]*freqdata[jb+j]);
+        double* hreal = freqseriesReIm[k]->h_real->data;
+        double* himag = freqseriesReIm[k]->h_imag->data;
+        for(int j=0; j<nb; j++) {
+          hdet = factorsmode[k] * h[j] * delay[j];
+          hreal[jb+j] += creal(hdet);
+          himag[jb+j] += cimag(hdet);
+        }
+      }
+    }
+
+    /* Clean up */
+    gsl_interp_accel_free(accel_ampreal);
+    gsl_interp_accel_free(accel_ampimag);
+    gsl_interp_accel_free(accel_phase);
+    gsl_spline_free(ampreal);
+    gsl_spline_free(ampimag);
+    gsl_spline_free(phase);
+
+    listelement = listelement->next;
+    imode++;
+  }
+}
+
 /* Helper function to add a mode to hplus, hcross in Fourier domain
  * - copies the function XLALSimAddMode, which was done only for TD structures */
 int FDAddMode(
@@ -694,13 +794,13 @@ int SetMaxdeltafResampledFrequencies(
     int index = 0;
     while((index+1<npt) && (f[index+1]<=fHigh)) index++;
     if(f[index]<fHigh) { /* append fHigh - note that we have fHigh<=f[npt-1] */
-      *freqr = gsl_vector_alloc(index+2);
+      *freqr = ArenaVectorAlloc(index+2);
       double* fr = (*freqr)->data;
       for(int j=0; j<=index; j++) fr[j] = f[j];
       fr[index+1] = fHigh;
     }
     else { /* f[index] is already fHigh */
-      *freqr = gsl_vector_alloc(index+1);
+      *freqr = ArenaVectorAlloc(index+1);
       double* fr = (*freqr)->data;
       for(int j=0; j<=index; j++) fr[j] = f[j];
     }
@@ -708,7 +808,7 @@ int SetMaxdeltafResampledFrequencies(
   else { /* here f[indexrs]<fHigh, we keep original frequencies up to indexrs-1, and extend with a linspace(f[indexrs], fHigh, nrs) with nrs chosen so that the linear deltaf meets the requirement */
     int nrs = ceil((fHigh - f[indexrs])/deltaf) + 1;
     int ntot = indexrs + nrs;
-    *freqr = gsl_vector_alloc(ntot);
+    *freqr = ArenaVectorAlloc(ntot);
     double* fr = (*freqr)->data;
     for(int j=0; j<indexrs; j++) fr[j] = f[j];
     double r = 1./(ntot-1-indexrs) * (fHigh - f[indexrs]);
@@ -748,7 +848,7 @@ int SetMaxdeltatResampledFrequencies(
   /* NOTE : computing at highf is wasted computation, but we try to be generic */
   int npt = (int) freq->size;
   double* f = freq->data;
-  gsl_vector* times = gsl_vector_alloc(npt);
+  gsl_vector* times = ArenaVectorAlloc(npt);
   double* t = times->data;
   for(int j=0; j<npt; j++) t[j] = Newtoniantoffchirp(mchirp, f[j]*2./m); /* include rescaling for modes other than 22 */
 
@@ -757,13 +857,13 @@ int SetMaxdeltatResampledFrequencies(
   while((indexrs+1<npt) && ((t[indexrs] - t[indexrs+1])>deltat)) indexrs++;
 
   if(indexrs==0) { /* No resampling */
-    *freqr = gsl_vector_alloc(npt);
+    *freqr = ArenaVectorAlloc(npt);
     gsl_vector_memcpy(*freqr, freq);
   }
   else {
     int nrs = floor((t[0] - t[indexrs]) / deltat);
     int ntot = nrs + npt - indexrs;
-    *freqr = gsl_vector_alloc(ntot);
+    *freqr = ArenaVectorAlloc(ntot);
     double* fr = (*freqr)->data;
     double r = (t[indexrs] - t[0])/nrs;
     fr[0] = f[0]; /* avoid changing the boundary by numerical errors */
@@ -771,7 +871,7 @@ int SetMaxdeltatResampledFrequencies(
     for(int j=nrs; j<ntot; j++) fr[j] = f[j - nrs + indexrs];
   }
   /* Cleanup */
-  gsl_vector_free(times);
+  ArenaVectorFree(times);
 
   return SUCCESS;
 }
@@ -101,6 +101,17 @@ void ReImFrequencySeries_SumListmodesCAmpPhaseFrequencySeries(
   double fLow,                                                      /* Minimal frequency - set to 0 to ignore */
   double fHigh,                                                     /* Maximal frequency - set to 0 to ignore */
   double fstartobs);                                                /* For limited duration of observation, starting frequency for the 22 mode - set to 0 to ignore */
+/* Function evaluating the ReImFrequencySeries of the detectors of a network, where the response of each detector is a constant factor and a delay for each mode - the modes are interpolated and evaluated once for all the detectors */
+void ReImFrequencySeries_SumListmodesNetwork(
+  struct tagReImFrequencySeries** freqseriesReIm,                   /* Output Re/Im frequency series, ndet values - already initialized */
+  struct tagListmodesCAmpPhaseFrequencySeries* listmodesCAmpPhase,  /* Input CAmp/Phase frequency series of the modes before the response, to be interpolated */
+  gsl_vector* freq,                                                 /* Input set of frequencies on which evaluating */
+  const int ndet,                                                   /* Number of detectors */
+  const double complex* factors,                                    /* Factors of the response, ndet values for each mode in the order of listmodesCAmpPhase */
+  const double* twopidelays,                                        /* 2pi times the delays of the detectors (s), ndet values */
+  double fLow,                                                      /* Minimal frequency - set to 0 to ignore */
+  double fHigh,                                                     /* Maximal frequency - set to 0 to ignore */
+  double fstartobs);                                                /* For limited duration of observation, starting frequency for the 22 mode - set to 0 to ignore */
 /* Helper function to add a mode to hplus, hcross in Fourier domain
  * - copies the function XLALSimAddMode, which was done only for TD structures */
 int FDAddMode(